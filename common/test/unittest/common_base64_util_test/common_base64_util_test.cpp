@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base64_util.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+// longer than the blocks of the vectorized encoders, with every tail size
+constexpr size_t MAX_DATA_SIZE = 200;
+const char ENCODE_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string EncodeByBits(const std::vector<uint8_t> &data)
+{
+    std::string text;
+    uint32_t bits = 0;
+    uint32_t bitCount = 0;
+    for (uint8_t byte : data) {
+        bits = (bits << 8) | byte;
+        bitCount += 8;
+        while (bitCount >= 6) {
+            bitCount -= 6;
+            text.push_back(ENCODE_TABLE[(bits >> bitCount) & 0x3F]);
+        }
+    }
+    if (bitCount > 0) {
+        text.push_back(ENCODE_TABLE[(bits << (6 - bitCount)) & 0x3F]);
+    }
+    while (text.size() % 4 != 0) {
+        text.push_back('=');
+    }
+    return text;
+}
+}  // namespace
+
+class CommonBase64UtilTest : public testing::Test {
+public:
+    CommonBase64UtilTest();
+    ~CommonBase64UtilTest();
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+CommonBase64UtilTest::CommonBase64UtilTest()
+{}
+
+CommonBase64UtilTest::~CommonBase64UtilTest()
+{}
+
+void CommonBase64UtilTest::SetUpTestCase()
+{}
+
+void CommonBase64UtilTest::TearDownTestCase()
+{}
+
+void CommonBase64UtilTest::SetUp()
+{}
+
+void CommonBase64UtilTest::TearDown()
+{}
+
+/*
+ * Feature: CommonBase64UtilTest
+ * Function: Encode
+ * SubFunction: NA
+ * FunctionPoints: Encode
+ * EnvConditions: NA
+ * CaseDescription: verify the test vectors of RFC 4648 are encoded and decoded correctly
+ */
+HWTEST_F(CommonBase64UtilTest, Encode_001, TestSize.Level0)
+{
+    const std::vector<std::pair<std::string, std::string>> vectors = {
+        { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+        { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+    };
+    for (const auto &vector : vectors) {
+        std::string text = "prefix";
+        Base64Util::Encode(reinterpret_cast<const uint8_t *>(vector.first.data()), vector.first.size(), text);
+        EXPECT_EQ(text, "prefix" + vector.second);
+        EXPECT_EQ(Base64Util::GetEncodedSize(vector.first.size()), vector.second.size());
+
+        std::vector<uint8_t> data;
+        EXPECT_TRUE(Base64Util::Decode(vector.second, data));
+        EXPECT_EQ(std::string(data.begin(), data.end()), vector.first);
+    }
+}
+
+/*
+ * Feature: CommonBase64UtilTest
+ * Function: Encode
+ * SubFunction: NA
+ * FunctionPoints: Encode
+ * EnvConditions: NA
+ * CaseDescription: verify data of every size is encoded as the bitwise reference and decoded back
+ */
+HWTEST_F(CommonBase64UtilTest, Encode_002, TestSize.Level0)
+{
+    for (size_t size = 0; size <= MAX_DATA_SIZE; size++) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = static_cast<uint8_t>(i * 151 + size);
+        }
+        std::string text;
+        Base64Util::Encode(data.data(), data.size(), text);
+        EXPECT_EQ(text, EncodeByBits(data)) << "size " << size;
+
+        std::vector<uint8_t> decoded;
+        EXPECT_TRUE(Base64Util::Decode(text, decoded));
+        EXPECT_EQ(decoded, data) << "size " << size;
+    }
+}
+
+/*
+ * Feature: CommonBase64UtilTest
+ * Function: Decode
+ * SubFunction: NA
+ * FunctionPoints: Decode
+ * EnvConditions: NA
+ * CaseDescription: verify invalid base64 text is not decoded
+ */
+HWTEST_F(CommonBase64UtilTest, Decode_001, TestSize.Level0)
+{
+    std::vector<uint8_t> data;
+    EXPECT_FALSE(Base64Util::Decode("Zm9", data));
+    EXPECT_FALSE(Base64Util::Decode("Zm*v", data));
+    EXPECT_FALSE(Base64Util::Decode("Z=9v", data));
+    EXPECT_FALSE(Base64Util::Decode("====", data));
+    EXPECT_TRUE(data.empty());
+}
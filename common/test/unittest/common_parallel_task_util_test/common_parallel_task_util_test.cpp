@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "parallel_task_util.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+constexpr size_t TASK_COUNT = 64;
+constexpr size_t MAX_THREADS = 4;
+constexpr int32_t FIRST_ERROR = 10;
+constexpr int32_t LATER_ERROR = 20;
+constexpr int32_t SLOW_TASK_MS = 100;
+
+// Updates the largest number of tasks seen running at the same time.
+class RunningCounter {
+public:
+    void Enter()
+    {
+        size_t running = ++running_;
+        size_t peak = peak_.load();
+        while (running > peak && !peak_.compare_exchange_weak(peak, running)) {}
+    }
+
+    void Leave()
+    {
+        --running_;
+    }
+
+    size_t GetPeak() const
+    {
+        return peak_.load();
+    }
+
+private:
+    std::atomic<size_t> running_ {0};
+    std::atomic<size_t> peak_ {0};
+};
+}  // namespace
+
+class CommonParallelTaskUtilTest : public testing::Test {
+public:
+    CommonParallelTaskUtilTest();
+    ~CommonParallelTaskUtilTest();
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+CommonParallelTaskUtilTest::CommonParallelTaskUtilTest()
+{}
+
+CommonParallelTaskUtilTest::~CommonParallelTaskUtilTest()
+{}
+
+void CommonParallelTaskUtilTest::SetUpTestCase()
+{}
+
+void CommonParallelTaskUtilTest::TearDownTestCase()
+{}
+
+void CommonParallelTaskUtilTest::SetUp()
+{}
+
+void CommonParallelTaskUtilTest::TearDown()
+{}
+
+/*
+ * Feature: CommonParallelTaskUtilTest
+ * Function: Run
+ * SubFunction: NA
+ * FunctionPoints: Run
+ * EnvConditions: NA
+ * CaseDescription: verify every index is run exactly once and no more than maxThreads tasks run at once
+ */
+HWTEST_F(CommonParallelTaskUtilTest, Run_001, TestSize.Level0)
+{
+    std::vector<std::atomic<int32_t>> runCounts(TASK_COUNT);
+    RunningCounter counter;
+    ParallelTaskUtil::Run(TASK_COUNT, MAX_THREADS, [&](size_t index) {
+        counter.Enter();
+        runCounts[index]++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        counter.Leave();
+    });
+    for (size_t i = 0; i < TASK_COUNT; ++i) {
+        EXPECT_EQ(runCounts[i].load(), 1) << "index " << i;
+    }
+    EXPECT_GE(counter.GetPeak(), 1U);
+    EXPECT_LE(counter.GetPeak(), MAX_THREADS);
+}
+
+/*
+ * Feature: CommonParallelTaskUtilTest
+ * Function: Run
+ * SubFunction: NA
+ * FunctionPoints: Run
+ * EnvConditions: NA
+ * CaseDescription: verify two tasks allowed two threads each see the other one started, that is
+ *                  they run at the same time rather than one after the other
+ */
+HWTEST_F(CommonParallelTaskUtilTest, Run_002, TestSize.Level0)
+{
+    if (std::thread::hardware_concurrency() < 2) {
+        GTEST_SKIP() << "a single core runs the tasks serially";
+    }
+    std::atomic<bool> started[2] = { false, false };
+    std::atomic<bool> sawOther[2] = { false, false };
+    ParallelTaskUtil::Run(2, 2, [&](size_t index) {
+        started[index] = true;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SLOW_TASK_MS);
+        while (!started[1 - index] && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        sawOther[index] = started[1 - index].load();
+    });
+    EXPECT_TRUE(sawOther[0]);
+    EXPECT_TRUE(sawOther[1]);
+}
+
+/*
+ * Feature: CommonParallelTaskUtilTest
+ * Function: Run
+ * SubFunction: NA
+ * FunctionPoints: Run
+ * EnvConditions: NA
+ * CaseDescription: verify no task is run for a count of 0, and a maxThreads of 0 runs the tasks on
+ *                  the calling thread
+ */
+HWTEST_F(CommonParallelTaskUtilTest, Run_003, TestSize.Level0)
+{
+    bool called = false;
+    ParallelTaskUtil::Run(0, MAX_THREADS, [&called](size_t) { called = true; });
+    EXPECT_FALSE(called);
+    ParallelTaskUtil::Run(TASK_COUNT, MAX_THREADS, nullptr);
+
+    std::thread::id caller = std::this_thread::get_id();
+    std::vector<size_t> order;
+    bool onCaller = true;
+    ParallelTaskUtil::Run(TASK_COUNT, 0, [&](size_t index) {
+        onCaller = onCaller && std::this_thread::get_id() == caller;
+        order.push_back(index);
+    });
+    EXPECT_TRUE(onCaller);
+    ASSERT_EQ(order.size(), TASK_COUNT);
+    for (size_t i = 0; i < TASK_COUNT; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+/*
+ * Feature: CommonParallelTaskUtilTest
+ * Function: RunForFirstError
+ * SubFunction: NA
+ * FunctionPoints: RunForFirstError
+ * EnvConditions: NA
+ * CaseDescription: verify the error of the lowest failed index is returned even if a later task fails
+ *                  first, and every task is still run
+ */
+HWTEST_F(CommonParallelTaskUtilTest, RunForFirstError_001, TestSize.Level0)
+{
+    const size_t firstFailed = 2;
+    std::atomic<bool> laterFailed(false);
+    std::atomic<size_t> runCount(0);
+    int32_t result = ParallelTaskUtil::RunForFirstError(TASK_COUNT, MAX_THREADS, [&](size_t index) {
+        runCount++;
+        if (index == firstFailed) {
+            // let the later tasks fail before this one
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_TASK_MS));
+            return FIRST_ERROR;
+        }
+        if (index > firstFailed && index % 2 == 1) {
+            laterFailed = true;
+            return LATER_ERROR;
+        }
+        return 0;
+    });
+    EXPECT_EQ(result, FIRST_ERROR);
+    EXPECT_TRUE(laterFailed);
+    EXPECT_EQ(runCount.load(), TASK_COUNT);
+}
+
+/*
+ * Feature: CommonParallelTaskUtilTest
+ * Function: RunForFirstError
+ * SubFunction: NA
+ * FunctionPoints: RunForFirstError
+ * EnvConditions: NA
+ * CaseDescription: verify 0 is returned when every task succeeds or there is no task
+ */
+HWTEST_F(CommonParallelTaskUtilTest, RunForFirstError_002, TestSize.Level0)
+{
+    EXPECT_EQ(ParallelTaskUtil::RunForFirstError(TASK_COUNT, MAX_THREADS, [](size_t) { return 0; }), 0);
+    EXPECT_EQ(ParallelTaskUtil::RunForFirstError(0, MAX_THREADS, [](size_t) { return FIRST_ERROR; }), 0);
+    EXPECT_EQ(ParallelTaskUtil::RunForFirstError(TASK_COUNT, MAX_THREADS, nullptr), 0);
+}
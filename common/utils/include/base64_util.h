@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_BASE64_UTIL_H
+#define FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_BASE64_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+class Base64Util {
+public:
+    /**
+     * @brief Get the size of the padded base64 text of some data.
+     * @param size Indicates the size of the data.
+     * @return Returns the size of the base64 text.
+     */
+    static size_t GetEncodedSize(size_t size);
+    /**
+     * @brief Encode data to padded base64 text, which uses NEON or SSSE3 when available.
+     * @param data Indicates the data to be encoded.
+     * @param size Indicates the size of the data.
+     * @param text Indicates the string the base64 text is appended to.
+     */
+    static void Encode(const uint8_t *data, size_t size, std::string &text);
+    /**
+     * @brief Decode padded base64 text.
+     * @param text Indicates the base64 text to be decoded.
+     * @param data Indicates the decoded data.
+     * @return Returns true if the text is valid base64; returns false otherwise.
+     */
+    static bool Decode(const std::string &text, std::vector<uint8_t> &data);
+};
+} // AppExecFwk
+} // OHOS
+
+#endif // FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_BASE64_UTIL_H
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_PARALLEL_TASK_UTIL_H
+#define FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_PARALLEL_TASK_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace OHOS {
+namespace AppExecFwk {
+class ParallelTaskUtil {
+public:
+    /**
+     * @brief Run task with the indexes [0, taskCount) on up to maxThreads threads, including the calling one,
+     *        and wait for all of them. The threads are also bounded by the number of cores.
+     * @param taskCount Indicates the number of tasks.
+     * @param maxThreads Indicates the maximum number of threads, 0 is taken as 1.
+     * @param task Indicates the task to run, it is called exactly once for every index.
+     */
+    static void Run(size_t taskCount, size_t maxThreads, const std::function<void(size_t)> &task);
+    /**
+     * @brief Run every task as Run does and get the error of the failed task with the lowest index,
+     *        which is the error a serial run would stop at whatever the order the tasks finish in.
+     * @param taskCount Indicates the number of tasks.
+     * @param maxThreads Indicates the maximum number of threads, 0 is taken as 1.
+     * @param task Indicates the task to run, it returns 0 on success and an error code otherwise.
+     * @return Returns 0 if every task succeeds; returns the error of the first failed task otherwise.
+     */
+    static int32_t RunForFirstError(size_t taskCount, size_t maxThreads,
+        const std::function<int32_t(size_t)> &task);
+};
+} // AppExecFwk
+} // OHOS
+
+#endif // FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_PARALLEL_TASK_UTIL_H
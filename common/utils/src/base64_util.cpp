@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "base64_util.h"
+
+#include <array>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace {
+constexpr size_t BLOCK_BYTES = 3;
+constexpr size_t BLOCK_CHARS = 4;
+constexpr uint8_t SIX_BITS = 0x3F;
+constexpr uint8_t FOUR_BITS = 0x0F;
+constexpr uint8_t TWO_BITS = 0x03;
+constexpr int8_t INVALID_CHAR = -1;
+constexpr char PAD_CHAR = '=';
+const char ENCODE_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::array<int8_t, 256> GetDecodeTable()
+{
+    std::array<int8_t, 256> table;
+    table.fill(INVALID_CHAR);
+    for (int8_t i = 0; i <= SIX_BITS; i++) {
+        table[static_cast<uint8_t>(ENCODE_TABLE[i])] = i;
+    }
+    return table;
+}
+
+#if defined(__aarch64__)
+constexpr size_t SIMD_BYTES = 48;
+constexpr size_t SIMD_CHARS = 64;
+
+// encodes 48 bytes, which are split into 3 vectors by vld3 and written from 4 vectors by vst4
+void EncodeSimdBlock(const uint8_t *in, char *out, const uint8x16x4_t &table)
+{
+    uint8x16_t mask = vdupq_n_u8(SIX_BITS);
+    uint8x16x3_t bytes = vld3q_u8(in);
+    uint8x16x4_t indices;
+    indices.val[0] = vshrq_n_u8(bytes.val[0], 2);
+    indices.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), mask);
+    indices.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), mask);
+    indices.val[3] = vandq_u8(bytes.val[2], mask);
+    uint8x16x4_t chars;
+    for (int i = 0; i < 4; i++) {
+        chars.val[i] = vqtbl4q_u8(table, indices.val[i]);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t *>(out), chars);
+}
+#elif defined(__SSSE3__)
+constexpr size_t SIMD_BYTES = 12;
+constexpr size_t SIMD_CHARS = 16;
+// 16 bytes are loaded for the 12 bytes encoded each time
+constexpr size_t SIMD_LOAD_BYTES = 16;
+
+// splits 12 bytes into 16 indices by shuffles and multiplies, then maps each index range to its chars
+void EncodeSimdBlock(const uint8_t *in, char *out)
+{
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    bytes = _mm_shuffle_epi8(bytes, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i high = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i low = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    __m128i indices = _mm_or_si128(high, low);
+    // 0 for A-Z, 1 for a-z, 2-11 for 0-9, 12 for + and 13 for /
+    __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i isUpper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    ranges = _mm_or_si128(ranges, _mm_and_si128(isUpper, _mm_set1_epi8(13)));
+    __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), chars);
+}
+#endif
+} // namespace
+
+namespace OHOS {
+namespace AppExecFwk {
+size_t Base64Util::GetEncodedSize(size_t size)
+{
+    return (size + BLOCK_BYTES - 1) / BLOCK_BYTES * BLOCK_CHARS;
+}
+
+void Base64Util::Encode(const uint8_t *data, size_t size, std::string &text)
+{
+    size_t offset = text.size();
+    text.resize(offset + GetEncodedSize(size));
+    if (size == 0) {
+        return;
+    }
+    char *out = &text[offset];
+    size_t i = 0;
+#if defined(__aarch64__)
+    const uint8_t *tableData = reinterpret_cast<const uint8_t *>(ENCODE_TABLE);
+    uint8x16x4_t table = { { vld1q_u8(tableData), vld1q_u8(tableData + 16),
+        vld1q_u8(tableData + 32), vld1q_u8(tableData + 48) } };
+    for (; i + SIMD_BYTES <= size; i += SIMD_BYTES) {
+        EncodeSimdBlock(data + i, out, table);
+        out += SIMD_CHARS;
+    }
+#elif defined(__SSSE3__)
+    for (; i + SIMD_LOAD_BYTES <= size; i += SIMD_BYTES) {
+        EncodeSimdBlock(data + i, out);
+        out += SIMD_CHARS;
+    }
+#endif
+    for (; i + BLOCK_BYTES <= size; i += BLOCK_BYTES) {
+        uint32_t block = (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) |
+            data[i + 2];
+        *out++ = ENCODE_TABLE[(block >> 18) & SIX_BITS];
+        *out++ = ENCODE_TABLE[(block >> 12) & SIX_BITS];
+        *out++ = ENCODE_TABLE[(block >> 6) & SIX_BITS];
+        *out++ = ENCODE_TABLE[block & SIX_BITS];
+    }
+    size_t rest = size - i;
+    if (rest == 1) {
+        *out++ = ENCODE_TABLE[data[i] >> 2];
+        *out++ = ENCODE_TABLE[(data[i] & TWO_BITS) << 4];
+        *out++ = PAD_CHAR;
+        *out++ = PAD_CHAR;
+    } else if (rest == 2) {
+        *out++ = ENCODE_TABLE[data[i] >> 2];
+        *out++ = ENCODE_TABLE[((data[i] & TWO_BITS) << 4) | (data[i + 1] >> 4)];
+        *out++ = ENCODE_TABLE[(data[i + 1] & FOUR_BITS) << 2];
+        *out++ = PAD_CHAR;
+    }
+}
+
+bool Base64Util::Decode(const std::string &text, std::vector<uint8_t> &data)
+{
+    static const std::array<int8_t, 256> decodeTable = GetDecodeTable();
+    data.clear();
+    if (text.size() % BLOCK_CHARS != 0) {
+        return false;
+    }
+    size_t padding = 0;
+    if (!text.empty() && text.back() == PAD_CHAR) {
+        padding = text[text.size() - 2] == PAD_CHAR ? 2 : 1;
+    }
+    data.reserve(text.size() / BLOCK_CHARS * BLOCK_BYTES);
+    for (size_t i = 0; i < text.size(); i += BLOCK_CHARS) {
+        bool isLast = i + BLOCK_CHARS == text.size();
+        size_t chars = isLast ? BLOCK_CHARS - padding : BLOCK_CHARS;
+        uint32_t block = 0;
+        for (size_t j = 0; j < BLOCK_CHARS; j++) {
+            int8_t value = j < chars ? decodeTable[static_cast<uint8_t>(text[i + j])] : 0;
+            if (value == INVALID_CHAR) {
+                data.clear();
+                return false;
+            }
+            block = (block << 6) | static_cast<uint32_t>(value);
+        }
+        data.push_back(static_cast<uint8_t>(block >> 16));
+        if (chars > 2) {
+            data.push_back(static_cast<uint8_t>(block >> 8));
+        }
+        if (chars > 3) {
+            data.push_back(static_cast<uint8_t>(block));
+        }
+    }
+    return true;
+}
+} // AppExecFwk
+} // OHOS
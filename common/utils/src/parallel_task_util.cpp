@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel_task_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+void ParallelTaskUtil::Run(size_t taskCount, size_t maxThreads, const std::function<void(size_t)> &task)
+{
+    if (taskCount == 0 || task == nullptr) {
+        return;
+    }
+    size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    size_t threadCount = std::min({ taskCount, std::max<size_t>(maxThreads, 1), cores });
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&nextIndex, taskCount, &task]() {
+        for (size_t index = nextIndex++; index < taskCount; index = nextIndex++) {
+            task(index);
+        }
+    };
+    // the calling thread works as well, so one thread less is started
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+int32_t ParallelTaskUtil::RunForFirstError(size_t taskCount, size_t maxThreads,
+    const std::function<int32_t(size_t)> &task)
+{
+    if (task == nullptr) {
+        return 0;
+    }
+    std::vector<int32_t> results(taskCount, 0);
+    Run(taskCount, maxThreads, [&results, &task](size_t index) {
+        results[index] = task(index);
+    });
+    auto iter = std::find_if(results.begin(), results.end(), [](int32_t result) { return result != 0; });
+    return iter == results.end() ? 0 : *iter;
+}
+} // AppExecFwk
+} // OHOS
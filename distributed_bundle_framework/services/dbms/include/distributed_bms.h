@@ -16,16 +16,22 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_D_BUNDLEMGR_INCLUDE_DISTRIBUTED_BMS_H
 #define FOUNDATION_APPEXECFWK_SERVICES_D_BUNDLEMGR_INCLUDE_DISTRIBUTED_BMS_H
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "bundle_info.h"
 #include "bundle_mgr_interface.h"
 #include "distributed_bms_host.h"
+#include "icon_store.h"
+#include "icon_store_monitor.h"
 #include "if_system_ability_manager.h"
 #include "iremote_object.h"
 #include "image_buffer.h"
 #include "resource_manager.h"
 #include "system_ability.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -120,15 +126,88 @@ public:
      * @return
      */
     virtual void OnStop() override;
+    /**
+     * @brief Subscribe the uninstall events once the common event service is started.
+     * @param systemAbilityId Indicates the started system ability.
+     * @param deviceId Indicates the device of the system ability.
+     */
+    virtual void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
 private:
+    struct AbilityInfoTask {
+        RemoteAbilityInfo remoteAbilityInfo;
+        const BundleInfo *bundleInfo = nullptr;
+        std::string cacheKey;
+        std::string iconPath;
+        AbilityInfo abilityInfo;
+        // the ability is enabled in bundleInfo, only then abilityInfoCache_ is read and written
+        bool cacheable = false;
+        // the label and icon are taken from abilityInfoCache_
+        bool cached = false;
+        bool iconRendered = false;
+    };
+
+    struct CachedAbilityInfo {
+        std::string label;
+        std::string icon;
+        uint64_t lastUsedTime = 0;
+    };
+
+    /**
+     * @brief Get the bundle infos of the elements and resolve the labels and icon paths of the elements
+     *        not in the cache. Each bundle is queried once, and its resource manager is shared by its elements.
+     * @param elementNames Indicates the elementNames.
+     * @param localeInfo Indicates the localeInfo.
+     * @param bundleInfos Indicates the obtained bundle infos, the tasks point to them.
+     * @param tasks Indicates the tasks of the elements.
+     * @return Returns OHOS::NO_ERROR if all the elements are resolved; returns the error of the first failed
+     *         element otherwise.
+     */
+    int32_t PrepareAbilityInfoTasks(const std::vector<ElementName> &elementNames, const std::string &localeInfo,
+        std::map<std::string, BundleInfo> &bundleInfos, std::vector<AbilityInfoTask> &tasks);
+    int32_t ResolveAbilityInfo(const sptr<IBundleMgr> &iBundleMgr, int32_t userId,
+        Global::Resource::ResourceManager &resourceManager, AbilityInfoTask &task);
+    /**
+     * @brief Find the ability of the element in the bundle info of the responding user.
+     * @param bundleInfo Indicates the bundle info, which is queried with its abilities.
+     * @param elementName Indicates the elementName.
+     * @param abilityInfo Indicates the obtained ability info.
+     * @return Returns true if both the application and the ability are enabled; returns false otherwise.
+     */
+    static bool FindAbilityInfo(const BundleInfo &bundleInfo, const ElementName &elementName,
+        AbilityInfo &abilityInfo);
+    /**
+     * @brief Render the icons of the tasks not in the cache, the calling thread renders one of them while
+     *        iconPool_ renders the others.
+     * @param tasks Indicates the tasks of the elements.
+     */
+    void RenderIcons(std::vector<AbilityInfoTask> &tasks);
+    static std::string GetAbilityInfoCacheKey(const ElementName &elementName, int32_t userId,
+        const BundleInfo &bundleInfo, const std::string &localeInfo);
+    bool GetCachedAbilityInfo(const std::string &key, RemoteAbilityInfo &remoteAbilityInfo);
+    void CacheAbilityInfo(const std::string &key, const RemoteAbilityInfo &remoteAbilityInfo);
     std::shared_ptr<Global::Resource::ResourceManager> GetResourceManager(
         const AppExecFwk::BundleInfo &bundleInfo, const std::string &localeInfo);
+    /**
+     * @brief Get the icon sent to the remote device, it is rendered only if it is not in the icon store.
+     * @param bundleInfo Indicates the bundle info of the icon.
+     * @param iconPath Indicates the path of the icon file.
+     * @param icon Indicates the obtained icon, which is a base64 data uri.
+     * @return Returns true if the icon is obtained; returns false otherwise.
+     */
+    bool GetRenderedIcon(const BundleInfo &bundleInfo, std::string &iconPath, std::string &icon);
     bool GetMediaBase64(std::string &path, std::string &value);
     bool GetMediaBae64FromImageBuffer(std::shared_ptr<ImageBuffer>& imageBuffer, std::string& value);
     std::unique_ptr<unsigned char[]> LoadResourceFile(std::string &path, int &len);
-    std::unique_ptr<char[]> EncodeBase64(std::unique_ptr<unsigned char[]> &data, int srcLen);
+    void EncodeDataUri(const std::string &imgType, const unsigned char *data, size_t len, std::string &value);
     bool GetCurrentUserId(int &userId);
 
+    std::shared_ptr<IconStore> iconStore_;
+    std::shared_ptr<IconStoreMonitor> iconStoreMonitor_;
+    OHOS::ThreadPool iconPool_;
+    std::mutex abilityInfoCacheMutex_;
+    uint64_t abilityInfoCacheClock_ = 0;
+    // key:bundleName, moduleName, abilityName, userId, versionCode, updateTime and localeInfo
+    std::unordered_map<std::string, CachedAbilityInfo> abilityInfoCache_;
     static OHOS::sptr<OHOS::AppExecFwk::IBundleMgr> bundleMgr_;
     static std::mutex bundleMgrMutex_;
 };
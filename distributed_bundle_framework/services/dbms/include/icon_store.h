@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_ICON_STORE_H
+#define FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_ICON_STORE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Keeps the rendered icons of the remote ability infos, so an icon is decoded, resized and
+ * encoded once per bundle version instead of once per remote request. The icons of a bundle
+ * version are kept in one file, which is mapped into memory when it is read. The file of the
+ * old version is removed when an icon of the new version is stored. Only the renditions for
+ * remote devices are kept, the local GetAbilityPixelMapIcon of BMS decodes the full icon and
+ * keeps it in the resource cache of BundleDataMgr.
+ */
+class IconStore {
+public:
+    explicit IconStore(const std::string &storeDir);
+    ~IconStore() = default;
+    /**
+     * @brief Get a rendered icon.
+     * @param bundleName Indicates the bundle name of the icon.
+     * @param versionCode Indicates the version code of the bundle.
+     * @param iconPath Indicates the path of the icon file.
+     * @param icon Indicates the obtained rendered icon.
+     * @return Returns true if the icon is found and the icon file is not changed; returns false otherwise.
+     */
+    bool GetIcon(const std::string &bundleName, uint32_t versionCode, const std::string &iconPath,
+        std::string &icon) const;
+    /**
+     * @brief Store a rendered icon.
+     * @param bundleName Indicates the bundle name of the icon.
+     * @param versionCode Indicates the version code of the bundle.
+     * @param iconPath Indicates the path of the icon file.
+     * @param icon Indicates the rendered icon.
+     * @return Returns true if the icon is stored; returns false otherwise.
+     */
+    bool SetIcon(const std::string &bundleName, uint32_t versionCode, const std::string &iconPath,
+        const std::string &icon);
+    /**
+     * @brief Remove the rendered icons of all versions of a bundle.
+     * @param bundleName Indicates the bundle name.
+     */
+    void RemoveBundle(const std::string &bundleName);
+
+private:
+    struct IconItem {
+        std::string key;
+        std::string icon;
+    };
+
+    std::string GetBundleDir(const std::string &bundleName) const;
+    std::string GetStorePath(const std::string &bundleName, uint32_t versionCode) const;
+    static bool GetIconKey(const std::string &iconPath, std::string &key);
+    static bool ReadIcons(const std::string &storePath, const std::string *key, std::vector<IconItem> &items);
+    static bool WriteIcons(const std::string &storePath, const std::vector<IconItem> &items);
+    // removes the files in the dir of a bundle except keepPath, which may be empty
+    void RemoveOtherVersions(const std::string &bundleName, const std::string &keepPath) const;
+
+    std::string storeDir_;
+    // serializes the writers, the readers see either the old file or the new one
+    std::mutex mutex_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_ICON_STORE_H
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_ICON_STORE_MONITOR_H
+#define FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_ICON_STORE_MONITOR_H
+
+#include <memory>
+
+#include "app_log_wrapper.h"
+#include "common_event_manager.h"
+#include "common_event_subscribe_info.h"
+#include "common_event_subscriber.h"
+#include "common_event_support.h"
+#include "icon_store.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+// Removes the rendered icons of a bundle once a bundle or a module of it is uninstalled.
+class IconStoreMonitor : public EventFwk::CommonEventSubscriber {
+public:
+    IconStoreMonitor(const std::shared_ptr<IconStore> &iconStore, const EventFwk::CommonEventSubscribeInfo &sp)
+        : CommonEventSubscriber(sp), iconStore_(iconStore)
+    {}
+    ~IconStoreMonitor() = default;
+
+    void OnReceiveEvent(const EventFwk::CommonEventData &eventData) override
+    {
+        auto want = eventData.GetWant();
+        if (want.GetAction() != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED) {
+            return;
+        }
+        std::string bundleName = want.GetElement().GetBundleName();
+        APP_LOGD("remove icon store of %{public}s", bundleName.c_str());
+        iconStore_->RemoveBundle(bundleName);
+    }
+
+private:
+    std::shared_ptr<IconStore> iconStore_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_ICON_STORE_MONITOR_H
@@ -40,6 +40,8 @@ public:
     int32_t DecodeJPGFile(std::string fileName, std::shared_ptr<ImageBuffer>& imageBuffer);
     int32_t EncodeJPGFile(std::shared_ptr<ImageBuffer>& imageBuffer);
     int32_t ResizeRGBImage(std::shared_ptr<ImageBuffer>& imageBufferIn, std::shared_ptr<ImageBuffer>& imageBufferOut);
+    int32_t ResizeImage(std::shared_ptr<ImageBuffer>& imageBufferIn, std::shared_ptr<ImageBuffer>& imageBufferOut,
+        double ratio);
     std::shared_ptr<ImageBuffer> CompressImage(std::string inFileName);
     void ReleasePngPointer(png_bytepp& rowPointers, uint32_t height);
     bool MallocPngPointer(png_bytepp& rowPointers, uint32_t height, uint32_t strides);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_IMAGE_RESIZE_H
+#define FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_IMAGE_RESIZE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Resizes 8 bit interleaved images with a separable fixed-point filter. Each output pixel is the
+ * area average of the input pixels it covers when shrinking, and the bilinear interpolation of
+ * the nearest input pixels when enlarging. The vertical pass runs first over the whole input, using
+ * SSE2 or NEON when available, so the horizontal pass only works on the rows of the output.
+ * Images of 4 components are RGBA with straight alpha; they are filtered premultiplied, so the
+ * colors of transparent pixels do not bleed into their neighbours. An image of the same size is
+ * copied without filtering.
+ */
+class ImageResize {
+public:
+    /**
+     * @brief Resize an image, the rows of both images are packed without padding.
+     * @param in Indicates the input pixels.
+     * @param inWidth Indicates the width of the input image.
+     * @param inHeight Indicates the height of the input image.
+     * @param out Indicates the output pixels, which holds outWidth * outHeight * components bytes.
+     * @param outWidth Indicates the width of the output image.
+     * @param outHeight Indicates the height of the output image.
+     * @param components Indicates the number of bytes of each pixel, 4 means RGBA with straight alpha.
+     * @return Returns true if the image is resized; returns false otherwise.
+     */
+    static bool Resize(const uint8_t *in, uint32_t inWidth, uint32_t inHeight,
+        uint8_t *out, uint32_t outWidth, uint32_t outHeight, uint32_t components);
+
+private:
+    struct FilterTaps {
+        uint32_t start = 0;
+        // fixed-point weights of the input pixels from start, which sum to 1 << WEIGHT_BITS
+        std::vector<uint16_t> weights;
+    };
+
+    static void CalculateTaps(uint32_t inSize, uint32_t outSize, std::vector<FilterTaps> &taps);
+    static void AccumulateRow(const uint8_t *in, uint16_t weight, uint32_t *acc, uint32_t size);
+    static void ResizeRow(const uint16_t *in, uint8_t *out, const std::vector<FilterTaps> &taps,
+        uint32_t components);
+    static void PremultiplyRow(const uint8_t *in, uint8_t *out, uint32_t width);
+    static void UnpremultiplyRow(uint8_t *row, uint32_t width);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_IMAGE_RESIZE_H
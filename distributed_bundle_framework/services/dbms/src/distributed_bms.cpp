@@ -15,11 +15,14 @@
 
 #include "distributed_bms.h"
 
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <vector>
 
 #include "app_log_wrapper.h"
 #include "appexecfwk_errors.h"
+#include "base64_util.h"
 #include "bundle_mgr_interface.h"
 #include "bundle_mgr_proxy.h"
 #include "iservice_registry.h"
@@ -33,29 +36,23 @@
 namespace OHOS {
 namespace AppExecFwk {
 namespace {
-    const uint8_t DECODE_VALUE_ONE = 1;
-    const uint8_t DECODE_VALUE_TWO = 2;
-    const uint8_t DECODE_VALUE_THREE = 3;
-    const unsigned char DECODE_VALUE_CHAR_THREE = 3;
-    const uint8_t DECODE_VALUE_FOUR = 4;
-    const uint8_t DECODE_VALUE_SIX = 6;
-    const unsigned char DECODE_VALUE_CHAR_FIFTEEN = 15;
-    const unsigned char DECODE_VALUE_CHAR_SIXTY_THREE = 63;
-    const std::vector<char> DECODE_TABLE = {
-        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
-        'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
-        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
-        'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
-        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
-    };
+    const std::string DATA_URI_PREFIX = "data:image/";
+    const std::string DATA_URI_BASE64 = ";base64,";
     const std::string POSTFIX = "_Compress.";
+    const std::string ICON_STORE_DIR = "/data/service/el1/public/dbms/icons";
+    const std::string ICON_POOL_NAME = "DbmsIcon";
+    const std::string CACHE_KEY_SEPARATOR = "|";
+    constexpr int32_t ICON_THREAD_NUMBER = 3;
+    constexpr size_t MAX_ABILITY_INFO_CACHE_SIZE = 64;
 }
 REGISTER_SYSTEM_ABILITY_BY_ID(DistributedBms, DISTRIBUTED_BUNDLE_MGR_SERVICE_SYS_ABILITY_ID, true);
 
 OHOS::sptr<OHOS::AppExecFwk::IBundleMgr> bundleMgr_ = nullptr;
 std::mutex bundleMgrMutex_;
 
-DistributedBms::DistributedBms(int32_t saId, bool runOnCreate) : SystemAbility(saId, runOnCreate)
+DistributedBms::DistributedBms(int32_t saId, bool runOnCreate)
+    : SystemAbility(saId, runOnCreate), iconStore_(std::make_shared<IconStore>(ICON_STORE_DIR)),
+      iconPool_(ICON_POOL_NAME)
 {
     APP_LOGI("DistributedBms :%{public}s call", __func__);
 }
@@ -68,6 +65,8 @@ DistributedBms::~DistributedBms()
 void DistributedBms::OnStart()
 {
     APP_LOGI("DistributedBms: OnStart");
+    iconPool_.Start(ICON_THREAD_NUMBER);
+    AddSystemAbilityListener(COMMON_EVENT_SERVICE_ID);
     bool res = Publish(this);
     if (!res) {
         APP_LOGE("DistributedBms: OnStart failed");
@@ -78,6 +77,25 @@ void DistributedBms::OnStart()
 void DistributedBms::OnStop()
 {
     APP_LOGI("DistributedBms: OnStop");
+    iconPool_.Stop();
+    if (iconStoreMonitor_ != nullptr) {
+        EventFwk::CommonEventManager::UnSubscribeCommonEvent(iconStoreMonitor_);
+    }
+}
+
+void DistributedBms::OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId)
+{
+    if (systemAbilityId != COMMON_EVENT_SERVICE_ID || iconStoreMonitor_ != nullptr) {
+        return;
+    }
+    EventFwk::MatchingSkills matchingSkills;
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED);
+    EventFwk::CommonEventSubscribeInfo subscribeInfo(matchingSkills);
+    iconStoreMonitor_ = std::make_shared<IconStoreMonitor>(iconStore_, subscribeInfo);
+    if (!EventFwk::CommonEventManager::SubscribeCommonEvent(iconStoreMonitor_)) {
+        APP_LOGE("DistributedBms: subscribe uninstall event failed");
+        iconStoreMonitor_ = nullptr;
+    }
 }
 
 static OHOS::sptr<OHOS::AppExecFwk::IBundleMgr> GetBundleMgr()
@@ -168,6 +186,59 @@ int32_t DistributedBms::GetAbilityInfo(const OHOS::AppExecFwk::ElementName &elem
 {
     APP_LOGI("DistributedBms GetAbilityInfo bundleName:%{public}s , abilityName:%{public}s, localeInfo:%{public}s",
         elementName.GetBundleName().c_str(), elementName.GetAbilityName().c_str(), localeInfo.c_str());
+    std::vector<RemoteAbilityInfo> remoteAbilityInfos;
+    int32_t result = GetAbilityInfos({ elementName }, localeInfo, remoteAbilityInfos);
+    if (result != OHOS::NO_ERROR) {
+        return result;
+    }
+    remoteAbilityInfo = remoteAbilityInfos[0];
+    APP_LOGD("DistributedBms GetAbilityInfo label:%{public}s", remoteAbilityInfo.label.c_str());
+    return OHOS::NO_ERROR;
+}
+
+int32_t DistributedBms::GetAbilityInfos(
+    const std::vector<ElementName> &elementNames, std::vector<RemoteAbilityInfo> &remoteAbilityInfos)
+{
+    APP_LOGD("DistributedBms GetAbilityInfos");
+    return GetAbilityInfos(elementNames, "", remoteAbilityInfos);
+}
+
+int32_t DistributedBms::GetAbilityInfos(const std::vector<ElementName> &elementNames,
+    const std::string &localeInfo, std::vector<RemoteAbilityInfo> &remoteAbilityInfos)
+{
+    APP_LOGD("DistributedBms GetAbilityInfos");
+    std::map<std::string, BundleInfo> bundleInfos;
+    std::vector<AbilityInfoTask> tasks;
+    int32_t result = PrepareAbilityInfoTasks(elementNames, localeInfo, bundleInfos, tasks);
+    if (result != OHOS::NO_ERROR) {
+        return result;
+    }
+    RenderIcons(tasks);
+    for (const auto &task : tasks) {
+        if (task.cached) {
+            continue;
+        }
+        if (!task.iconRendered) {
+            const ElementName &elementName = task.remoteAbilityInfo.elementName;
+            APP_LOGE("get AbilityInfo:%{public}s, %{public}s, %{public}s icon failed",
+                elementName.GetBundleName().c_str(), elementName.GetModuleName().c_str(),
+                elementName.GetAbilityName().c_str());
+            return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
+        }
+        if (task.cacheable) {
+            CacheAbilityInfo(task.cacheKey, task.remoteAbilityInfo);
+        }
+    }
+    for (const auto &task : tasks) {
+        remoteAbilityInfos.push_back(task.remoteAbilityInfo);
+    }
+    return OHOS::NO_ERROR;
+}
+
+int32_t DistributedBms::PrepareAbilityInfoTasks(const std::vector<ElementName> &elementNames,
+    const std::string &localeInfo, std::map<std::string, BundleInfo> &bundleInfos,
+    std::vector<AbilityInfoTask> &tasks)
+{
     auto iBundleMgr = GetBundleMgr();
     if (!iBundleMgr) {
         APP_LOGE("DistributedBms GetBundleMgr failed");
@@ -178,86 +249,163 @@ int32_t DistributedBms::GetAbilityInfo(const OHOS::AppExecFwk::ElementName &elem
         APP_LOGE("GetCurrentUserId failed");
         return ERR_APPEXECFWK_USER_NOT_EXIST;
     }
-    BundleInfo bundleInfo;
-    if (!iBundleMgr->GetBundleInfo(elementName.GetBundleName(), 1, bundleInfo, userId)) {
-        APP_LOGE("DistributedBms GetBundleInfo failed");
-        return ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO;
-    }
-    std::shared_ptr<Global::Resource::ResourceManager> resourceManager = nullptr;
-    resourceManager = GetResourceManager(bundleInfo, localeInfo);
-    if (resourceManager == nullptr) {
-        APP_LOGE("DistributedBms InitResourceManager failed");
-        return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
+    std::map<std::string, std::shared_ptr<Global::Resource::ResourceManager>> resourceManagers;
+    tasks.resize(elementNames.size());
+    for (size_t i = 0; i < elementNames.size(); ++i) {
+        const ElementName &elementName = elementNames[i];
+        const std::string &bundleName = elementName.GetBundleName();
+        auto bundleItem = bundleInfos.find(bundleName);
+        if (bundleItem == bundleInfos.end()) {
+            BundleInfo bundleInfo;
+            if (!iBundleMgr->GetBundleInfo(bundleName, BundleFlag::GET_BUNDLE_WITH_ABILITIES, bundleInfo, userId)) {
+                APP_LOGE("DistributedBms GetBundleInfo %{public}s failed", bundleName.c_str());
+                return ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO;
+            }
+            bundleItem = bundleInfos.emplace(bundleName, std::move(bundleInfo)).first;
+        }
+        // the application info is filled for the responding user, a disabled one is never answered from the cache
+        if (!bundleItem->second.applicationInfo.enabled) {
+            APP_LOGE("DistributedBms %{public}s is disabled", bundleName.c_str());
+            return ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO;
+        }
+        AbilityInfoTask &task = tasks[i];
+        task.bundleInfo = &bundleItem->second;
+        task.remoteAbilityInfo.elementName = elementName;
+        task.cacheKey = GetAbilityInfoCacheKey(elementName, userId, bundleItem->second, localeInfo);
+        task.cacheable = FindAbilityInfo(bundleItem->second, elementName, task.abilityInfo);
+        if (task.cacheable && GetCachedAbilityInfo(task.cacheKey, task.remoteAbilityInfo)) {
+            task.cached = true;
+            continue;
+        }
+        auto &resourceManager = resourceManagers[bundleName];
+        if (resourceManager == nullptr) {
+            resourceManager = GetResourceManager(bundleItem->second, localeInfo);
+            if (resourceManager == nullptr) {
+                APP_LOGE("DistributedBms InitResourceManager failed");
+                return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
+            }
+        }
+        int32_t result = ResolveAbilityInfo(iBundleMgr, userId, *resourceManager, task);
+        if (result != OHOS::NO_ERROR) {
+            APP_LOGE("get AbilityInfo:%{public}s, %{public}s, %{public}s failed", bundleName.c_str(),
+                elementName.GetModuleName().c_str(), elementName.GetAbilityName().c_str());
+            return result;
+        }
     }
-    AbilityInfo abilityInfo;
-    OHOS::AAFwk::Want want;
-    want.SetElement(elementName);
-    if (!iBundleMgr->QueryAbilityInfo(want, GET_ABILITY_INFO_WITH_APPLICATION, userId, abilityInfo)) {
-        APP_LOGE("DistributedBms QueryAbilityInfo failed");
-        return ERR_APPEXECFWK_FAILED_GET_ABILITY_INFO;
+    return OHOS::NO_ERROR;
+}
+
+int32_t DistributedBms::ResolveAbilityInfo(const sptr<IBundleMgr> &iBundleMgr, int32_t userId,
+    Global::Resource::ResourceManager &resourceManager, AbilityInfoTask &task)
+{
+    AbilityInfo &abilityInfo = task.abilityInfo;
+    if (!task.cacheable) {
+        OHOS::AAFwk::Want want;
+        want.SetElement(task.remoteAbilityInfo.elementName);
+        if (!iBundleMgr->QueryAbilityInfo(want, GET_ABILITY_INFO_WITH_APPLICATION, userId, abilityInfo)) {
+            APP_LOGE("DistributedBms QueryAbilityInfo failed");
+            return ERR_APPEXECFWK_FAILED_GET_ABILITY_INFO;
+        }
     }
-    remoteAbilityInfo.elementName = elementName;
     OHOS::Global::Resource::RState errval =
-        resourceManager->GetStringById(static_cast<uint32_t>(abilityInfo.labelId), remoteAbilityInfo.label);
+        resourceManager.GetStringById(static_cast<uint32_t>(abilityInfo.labelId), task.remoteAbilityInfo.label);
     if (errval != OHOS::Global::Resource::RState::SUCCESS) {
         APP_LOGE("DistributedBms GetStringById failed");
         return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
     }
-    std::string iconPath;
     OHOS::Global::Resource::RState iconPathErrval =
-        resourceManager->GetMediaById(static_cast<uint32_t>(abilityInfo.iconId), iconPath);
+        resourceManager.GetMediaById(static_cast<uint32_t>(abilityInfo.iconId), task.iconPath);
     if (iconPathErrval != OHOS::Global::Resource::RState::SUCCESS) {
         APP_LOGE("DistributedBms GetStringById  iconPath failed");
         return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
     }
+    return OHOS::NO_ERROR;
+}
 
-    std::shared_ptr<ImageCompress> imageCompress;
-    if (imageCompress->NeedCompress(iconPath)) {
-        std::shared_ptr<ImageBuffer> imageBuffer = imageCompress->CompressImage(iconPath.c_str());
-        if (imageBuffer != nullptr) {
-            if (!GetMediaBae64FromImageBuffer(imageBuffer, remoteAbilityInfo.icon)) {
-                APP_LOGE("DistributedBms GetMediaBase64 failed");
-                return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
-            }
-        } else {
-            if (!GetMediaBase64(iconPath, remoteAbilityInfo.icon)) {
-                APP_LOGE("DistributedBms GetMediaBase64 failed");
-                return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
-            }
-        }
-    } else {
-        if (!GetMediaBase64(iconPath, remoteAbilityInfo.icon)) {
-            APP_LOGE("DistributedBms GetMediaBase64 failed");
-            return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
+bool DistributedBms::FindAbilityInfo(const BundleInfo &bundleInfo, const ElementName &elementName,
+    AbilityInfo &abilityInfo)
+{
+    // a disabled or missing ability is left to QueryAbilityInfo, which reports it as before
+    if (!bundleInfo.applicationInfo.enabled) {
+        return false;
+    }
+    const std::string &moduleName = elementName.GetModuleName();
+    auto item = std::find_if(bundleInfo.abilityInfos.begin(), bundleInfo.abilityInfos.end(),
+        [&elementName, &moduleName](const AbilityInfo &info) {
+            return info.name == elementName.GetAbilityName() && (moduleName.empty() || info.moduleName == moduleName);
+        });
+    if (item == bundleInfo.abilityInfos.end() || !item->enabled) {
+        return false;
+    }
+    abilityInfo = *item;
+    return true;
+}
+
+void DistributedBms::RenderIcons(std::vector<AbilityInfoTask> &tasks)
+{
+    std::vector<AbilityInfoTask *> renderTasks;
+    for (auto &task : tasks) {
+        if (!task.cached) {
+            renderTasks.push_back(&task);
         }
     }
+    if (renderTasks.empty()) {
+        return;
+    }
+    auto render = [this](AbilityInfoTask *task) {
+        task->iconRendered = GetRenderedIcon(*task->bundleInfo, task->iconPath, task->remoteAbilityInfo.icon);
+    };
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i + 1 < renderTasks.size(); ++i) {
+        AbilityInfoTask *task = renderTasks[i];
+        auto renderTask = std::make_shared<std::packaged_task<void()>>([&render, task] { render(task); });
+        futures.push_back(renderTask->get_future());
+        iconPool_.AddTask([renderTask] { (*renderTask)(); });
+    }
+    render(renderTasks.back());
+    for (auto &future : futures) {
+        future.wait();
+    }
+}
 
-    APP_LOGD("DistributedBms GetAbilityInfo label:%{public}s", remoteAbilityInfo.label.c_str());
-    return OHOS::NO_ERROR;
+std::string DistributedBms::GetAbilityInfoCacheKey(const ElementName &elementName, int32_t userId,
+    const BundleInfo &bundleInfo, const std::string &localeInfo)
+{
+    // the update time changes when the bundle is reinstalled without a new version code
+    return elementName.GetBundleName() + CACHE_KEY_SEPARATOR + elementName.GetModuleName() + CACHE_KEY_SEPARATOR +
+        elementName.GetAbilityName() + CACHE_KEY_SEPARATOR + std::to_string(userId) + CACHE_KEY_SEPARATOR +
+        std::to_string(bundleInfo.versionCode) + CACHE_KEY_SEPARATOR + std::to_string(bundleInfo.updateTime) +
+        CACHE_KEY_SEPARATOR + localeInfo;
 }
 
-int32_t DistributedBms::GetAbilityInfos(
-    const std::vector<ElementName> &elementNames, std::vector<RemoteAbilityInfo> &remoteAbilityInfos)
+bool DistributedBms::GetCachedAbilityInfo(const std::string &key, RemoteAbilityInfo &remoteAbilityInfo)
 {
-    APP_LOGD("DistributedBms GetAbilityInfos");
-    return GetAbilityInfos(elementNames, "", remoteAbilityInfos);
+    std::lock_guard<std::mutex> lock(abilityInfoCacheMutex_);
+    auto item = abilityInfoCache_.find(key);
+    if (item == abilityInfoCache_.end()) {
+        return false;
+    }
+    item->second.lastUsedTime = ++abilityInfoCacheClock_;
+    remoteAbilityInfo.label = item->second.label;
+    remoteAbilityInfo.icon = item->second.icon;
+    return true;
 }
 
-int32_t DistributedBms::GetAbilityInfos(const std::vector<ElementName> &elementNames,
-    const std::string &localeInfo, std::vector<RemoteAbilityInfo> &remoteAbilityInfos)
+void DistributedBms::CacheAbilityInfo(const std::string &key, const RemoteAbilityInfo &remoteAbilityInfo)
 {
-    APP_LOGD("DistributedBms GetAbilityInfos");
-    for (auto elementName : elementNames) {
-        RemoteAbilityInfo remoteAbilityInfo;
-        int32_t result = GetAbilityInfo(elementName, localeInfo, remoteAbilityInfo);
-        if (result) {
-            APP_LOGE("get AbilityInfo:%{public}s, %{public}s, %{public}s failed", elementName.GetBundleName().c_str(),
-                elementName.GetModuleName().c_str(), elementName.GetAbilityName().c_str());
-            return result;
-        }
-        remoteAbilityInfos.push_back(remoteAbilityInfo);
+    std::lock_guard<std::mutex> lock(abilityInfoCacheMutex_);
+    if (abilityInfoCache_.find(key) == abilityInfoCache_.end() &&
+        abilityInfoCache_.size() >= MAX_ABILITY_INFO_CACHE_SIZE) {
+        auto leastUsed = std::min_element(abilityInfoCache_.begin(), abilityInfoCache_.end(),
+            [](const auto &lhs, const auto &rhs) {
+                return lhs.second.lastUsedTime < rhs.second.lastUsedTime;
+            });
+        abilityInfoCache_.erase(leastUsed);
     }
-    return OHOS::NO_ERROR;
+    CachedAbilityInfo &cachedInfo = abilityInfoCache_[key];
+    cachedInfo.label = remoteAbilityInfo.label;
+    cachedInfo.icon = remoteAbilityInfo.icon;
+    cachedInfo.lastUsedTime = ++abilityInfoCacheClock_;
 }
 
 std::shared_ptr<Global::Resource::ResourceManager> DistributedBms::GetResourceManager(
@@ -289,6 +437,30 @@ std::shared_ptr<Global::Resource::ResourceManager> DistributedBms::GetResourceMa
     return resourceManager;
 }
 
+bool DistributedBms::GetRenderedIcon(const BundleInfo &bundleInfo, std::string &iconPath, std::string &icon)
+{
+    if (iconStore_->GetIcon(bundleInfo.name, bundleInfo.versionCode, iconPath, icon)) {
+        APP_LOGD("DistributedBms get icon from the store");
+        return true;
+    }
+    auto imageCompress = std::make_shared<ImageCompress>();
+    bool ret = false;
+    if (imageCompress->NeedCompress(iconPath)) {
+        std::shared_ptr<ImageBuffer> imageBuffer = imageCompress->CompressImage(iconPath.c_str());
+        if (imageBuffer != nullptr) {
+            ret = GetMediaBae64FromImageBuffer(imageBuffer, icon);
+        } else {
+            ret = GetMediaBase64(iconPath, icon);
+        }
+    } else {
+        ret = GetMediaBase64(iconPath, icon);
+    }
+    if (ret && !iconStore_->SetIcon(bundleInfo.name, bundleInfo.versionCode, iconPath, icon)) {
+        APP_LOGW("DistributedBms store icon failed");
+    }
+    return ret;
+}
+
 bool DistributedBms::GetMediaBase64(std::string &path, std::string &value)
 {
     int len = 0;
@@ -301,20 +473,29 @@ bool DistributedBms::GetMediaBase64(std::string &path, std::string &value)
     if (pos != std::string::npos) {
         imgType = path.substr(pos + 1);
     }
-    std::unique_ptr<char[]> base64Data = EncodeBase64(tempData, len);
-    value = "data:image/" + imgType + ";base64," + base64Data.get();
+    EncodeDataUri(imgType, tempData.get(), static_cast<size_t>(len), value);
     return true;
 }
 
 bool DistributedBms::GetMediaBae64FromImageBuffer(std::shared_ptr<ImageBuffer>& imageBuffer, std::string& value)
 {
     std::unique_ptr<unsigned char[]>& imageData = imageBuffer->GetCompressDataBuffer();
-    uint32_t length = static_cast<uint32_t>(imageBuffer->GetCompressSize());
-    std::unique_ptr<char[]> base64Data = EncodeBase64(imageData, length);
-    value = "data:image/" + imageBuffer->GetImageType() + ";base64," + base64Data.get();
+    size_t length = static_cast<size_t>(imageBuffer->GetCompressSize());
+    EncodeDataUri(imageBuffer->GetImageType(), imageData.get(), length, value);
     return true;
 }
 
+void DistributedBms::EncodeDataUri(const std::string &imgType, const unsigned char *data, size_t len,
+    std::string &value)
+{
+    // the uri is built in place, its size is known before the data is encoded
+    value.clear();
+    value.reserve(DATA_URI_PREFIX.size() + imgType.size() + DATA_URI_BASE64.size() +
+        Base64Util::GetEncodedSize(len));
+    value.append(DATA_URI_PREFIX).append(imgType).append(DATA_URI_BASE64);
+    Base64Util::Encode(data, len, value);
+}
+
 std::unique_ptr<unsigned char[]> DistributedBms::LoadResourceFile(std::string &path, int &len)
 {
     std::ifstream mediaStream(path, std::ios::binary);
@@ -332,50 +513,6 @@ std::unique_ptr<unsigned char[]> DistributedBms::LoadResourceFile(std::string &p
     return tempData;
 }
 
-std::unique_ptr<char[]> DistributedBms::EncodeBase64(std::unique_ptr<unsigned char[]> &data, int srcLen)
-{
-    int len = (srcLen / DECODE_VALUE_THREE) * DECODE_VALUE_FOUR; // Split 3 bytes to 4 parts, each containing 6 bits.
-    int outLen = ((srcLen % DECODE_VALUE_THREE) != 0) ? (len + DECODE_VALUE_FOUR) : len;
-    const unsigned char *srcData = data.get();
-    std::unique_ptr<char[]>  result = std::make_unique<char[]>(outLen + DECODE_VALUE_ONE);
-    char *dstData = result.get();
-    int j = 0;
-    int i = 0;
-    for (; i < srcLen - DECODE_VALUE_THREE; i += DECODE_VALUE_THREE) {
-        unsigned char byte1 = srcData[i];
-        unsigned char byte2 = srcData[i + DECODE_VALUE_ONE];
-        unsigned char byte3 = srcData[i + DECODE_VALUE_TWO];
-        dstData[j++] = DECODE_TABLE[byte1 >> DECODE_VALUE_TWO];
-        dstData[j++] =
-            DECODE_TABLE[(static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR)
-             | (byte2 >> DECODE_VALUE_FOUR)];
-        dstData[j++] =
-            DECODE_TABLE[(static_cast<uint8_t>(byte2 & DECODE_VALUE_CHAR_FIFTEEN)
-                << DECODE_VALUE_TWO) | (byte3 >> DECODE_VALUE_SIX)];
-        dstData[j++] = DECODE_TABLE[byte3 & DECODE_VALUE_CHAR_SIXTY_THREE];
-    }
-    if (srcLen % DECODE_VALUE_THREE == DECODE_VALUE_ONE) {
-        unsigned char byte1 = srcData[i];
-        dstData[j++] = DECODE_TABLE[byte1 >> DECODE_VALUE_TWO];
-        dstData[j++] = DECODE_TABLE[static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR];
-        dstData[j++] = '=';
-        dstData[j++] = '=';
-    } else {
-        unsigned char byte1 = srcData[i];
-        unsigned char byte2 = srcData[i + DECODE_VALUE_ONE];
-        dstData[j++] = DECODE_TABLE[byte1 >> DECODE_VALUE_TWO];
-        dstData[j++] =
-            DECODE_TABLE[(static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR)
-             | (byte2 >> DECODE_VALUE_FOUR)];
-        dstData[j++] = DECODE_TABLE[static_cast<uint8_t>(byte2 & DECODE_VALUE_CHAR_FIFTEEN)
-                                    << DECODE_VALUE_TWO];
-        dstData[j++] = '=';
-    }
-    dstData[outLen] = '\0';
-
-    return result;
-}
-
 bool DistributedBms::GetCurrentUserId(int &userId)
 {
     std::vector<int> activeIds;
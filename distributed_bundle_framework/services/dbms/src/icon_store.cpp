@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "icon_store.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "app_log_wrapper.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+constexpr uint32_t ICON_STORE_MAGIC = 0x4E4F4349;
+// increase it when the format of the store file or of the rendered icon is changed
+constexpr uint32_t ICON_STORE_VERSION = 1;
+constexpr uint32_t MAX_ICON_COUNT = 64;
+constexpr int64_t NS_PER_SECOND = 1000000000;
+const std::string PATH_SEPARATOR = "/";
+const std::string TMP_SUFFIX = ".tmp";
+
+struct IconStoreHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+};
+
+struct IconItemHeader {
+    uint32_t keyLen;
+    uint32_t iconLen;
+};
+
+bool IsValidBundleName(const std::string &bundleName)
+{
+    // the bundle name comes from the remote device, it must not leave the store dir
+    return !bundleName.empty() && bundleName[0] != '.' && bundleName.find('/') == std::string::npos;
+}
+}  // namespace
+
+IconStore::IconStore(const std::string &storeDir) : storeDir_(storeDir)
+{}
+
+bool IconStore::GetIcon(const std::string &bundleName, uint32_t versionCode, const std::string &iconPath,
+    std::string &icon) const
+{
+    if (!IsValidBundleName(bundleName)) {
+        return false;
+    }
+    std::string key;
+    if (!GetIconKey(iconPath, key)) {
+        return false;
+    }
+    std::vector<IconItem> items;
+    if (!ReadIcons(GetStorePath(bundleName, versionCode), &key, items) || items.empty()) {
+        return false;
+    }
+    icon = std::move(items[0].icon);
+    return true;
+}
+
+bool IconStore::SetIcon(const std::string &bundleName, uint32_t versionCode, const std::string &iconPath,
+    const std::string &icon)
+{
+    if (!IsValidBundleName(bundleName)) {
+        return false;
+    }
+    std::string key;
+    if (!GetIconKey(iconPath, key)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string bundleDir = GetBundleDir(bundleName);
+    if (mkdir(storeDir_.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+        APP_LOGE("create icon store failed, errno:%{public}d", errno);
+        return false;
+    }
+    if (mkdir(bundleDir.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+        APP_LOGE("create icon store of %{public}s failed, errno:%{public}d", bundleName.c_str(), errno);
+        return false;
+    }
+    std::string storePath = GetStorePath(bundleName, versionCode);
+    std::vector<IconItem> items;
+    ReadIcons(storePath, nullptr, items);
+    for (auto iter = items.begin(); iter != items.end();) {
+        // the icon rendered from an older file of the same path is never read again
+        if (iter->key.compare(0, iconPath.size() + 1, iconPath + "|") == 0) {
+            iter = items.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    if (items.size() >= MAX_ICON_COUNT) {
+        items.erase(items.begin());
+    }
+    items.push_back({ key, icon });
+    if (!WriteIcons(storePath, items)) {
+        return false;
+    }
+    RemoveOtherVersions(bundleName, storePath);
+    return true;
+}
+
+void IconStore::RemoveBundle(const std::string &bundleName)
+{
+    if (!IsValidBundleName(bundleName)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveOtherVersions(bundleName, "");
+    std::string bundleDir = GetBundleDir(bundleName);
+    if (rmdir(bundleDir.c_str()) != 0 && errno != ENOENT) {
+        APP_LOGW("remove icon store of %{public}s failed, errno:%{public}d", bundleName.c_str(), errno);
+    }
+}
+
+std::string IconStore::GetBundleDir(const std::string &bundleName) const
+{
+    return storeDir_ + PATH_SEPARATOR + bundleName;
+}
+
+std::string IconStore::GetStorePath(const std::string &bundleName, uint32_t versionCode) const
+{
+    return GetBundleDir(bundleName) + PATH_SEPARATOR + std::to_string(versionCode);
+}
+
+bool IconStore::GetIconKey(const std::string &iconPath, std::string &key)
+{
+    // the icon file may be replaced without a new version code, e.g. by a debug install
+    struct stat buf = {};
+    if (stat(iconPath.c_str(), &buf) != 0 || !S_ISREG(buf.st_mode)) {
+        return false;
+    }
+    int64_t mtimeNs = static_cast<int64_t>(buf.st_mtim.tv_sec) * NS_PER_SECOND + buf.st_mtim.tv_nsec;
+    key = iconPath + "|" + std::to_string(buf.st_size) + "|" + std::to_string(mtimeNs);
+    return true;
+}
+
+bool IconStore::ReadIcons(const std::string &storePath, const std::string *key, std::vector<IconItem> &items)
+{
+    int fd = open(storePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat buf = {};
+    if (fstat(fd, &buf) != 0 || buf.st_size < static_cast<off_t>(sizeof(IconStoreHeader))) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(buf.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        APP_LOGE("map icon store failed, errno:%{public}d", errno);
+        return false;
+    }
+    const char *data = static_cast<const char *>(addr);
+    IconStoreHeader header;
+    (void)memcpy_s(&header, sizeof(header), data, sizeof(header));
+    bool ret = header.magic == ICON_STORE_MAGIC && header.version == ICON_STORE_VERSION;
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; ret && i < header.count; ++i) {
+        IconItemHeader itemHeader;
+        if (size - offset < sizeof(itemHeader)) {
+            ret = false;
+            break;
+        }
+        (void)memcpy_s(&itemHeader, sizeof(itemHeader), data + offset, sizeof(itemHeader));
+        offset += sizeof(itemHeader);
+        if (size - offset < static_cast<size_t>(itemHeader.keyLen) + itemHeader.iconLen) {
+            ret = false;
+            break;
+        }
+        const char *itemKey = data + offset;
+        const char *itemIcon = itemKey + itemHeader.keyLen;
+        offset += static_cast<size_t>(itemHeader.keyLen) + itemHeader.iconLen;
+        if (key == nullptr) {
+            items.push_back({ std::string(itemKey, itemHeader.keyLen), std::string(itemIcon, itemHeader.iconLen) });
+        } else if (key->size() == itemHeader.keyLen && key->compare(0, key->size(), itemKey, itemHeader.keyLen) == 0) {
+            items.push_back({ *key, std::string(itemIcon, itemHeader.iconLen) });
+            break;
+        }
+    }
+    munmap(addr, size);
+    if (!ret) {
+        APP_LOGW("bad icon store %{private}s", storePath.c_str());
+        items.clear();
+    }
+    return ret;
+}
+
+bool IconStore::WriteIcons(const std::string &storePath, const std::vector<IconItem> &items)
+{
+    std::string data;
+    size_t size = sizeof(IconStoreHeader);
+    for (const auto &item : items) {
+        size += sizeof(IconItemHeader) + item.key.size() + item.icon.size();
+    }
+    data.reserve(size);
+    IconStoreHeader header = { ICON_STORE_MAGIC, ICON_STORE_VERSION, static_cast<uint32_t>(items.size()) };
+    data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (const auto &item : items) {
+        IconItemHeader itemHeader = { static_cast<uint32_t>(item.key.size()), static_cast<uint32_t>(item.icon.size()) };
+        data.append(reinterpret_cast<const char *>(&itemHeader), sizeof(itemHeader));
+        data.append(item.key);
+        data.append(item.icon);
+    }
+
+    // the readers keep using the old file until the new one is renamed over it
+    std::string tmpPath = storePath + TMP_SUFFIX;
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        APP_LOGE("open icon store failed, errno:%{public}d", errno);
+        return false;
+    }
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t ret = write(fd, data.data() + written, data.size() - written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    close(fd);
+    if (written != data.size() || rename(tmpPath.c_str(), storePath.c_str()) != 0) {
+        APP_LOGE("write icon store failed, errno:%{public}d", errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void IconStore::RemoveOtherVersions(const std::string &bundleName, const std::string &keepPath) const
+{
+    std::string bundleDir = GetBundleDir(bundleName);
+    DIR *dir = opendir(bundleDir.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_type != DT_REG) {
+            continue;
+        }
+        std::string path = bundleDir + PATH_SEPARATOR + entry->d_name;
+        if (path != keepPath) {
+            APP_LOGD("remove icon store %{private}s", path.c_str());
+            unlink(path.c_str());
+        }
+    }
+    closedir(dir);
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -12,11 +12,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <unistd.h>
 
 #include "image_compress.h"
+#include "image_resize.h"
 
 #include "png.h"
 #include "jpeglib.h"
@@ -32,9 +34,7 @@ namespace {
     constexpr int32_t FILE_COMPRESS_SIZE = 4196;
     constexpr int32_t BITDEPTH_SIXTHEN = 16;
     constexpr int32_t BITDEPTH_EIGHT = 8;
-    constexpr int32_t COLOR_CHANNEL_GREEN = 1;
-    constexpr int32_t COLOR_CHANNEL_BLUE = 2; 
-    constexpr int32_t COLOR_CHANNEL_ALPHA = 3;
+    constexpr uint32_t MIN_IMAGE_SIZE = 1;
     constexpr int32_t NUMBER_ONE = 1;
     constexpr int32_t QUALITY = 30;
     constexpr double EPSILON = 1e-5;
@@ -367,38 +367,7 @@ int32_t ImageCompress::ResizeRGBAImage(std::shared_ptr<ImageBuffer>& imageBuffer
     if (DoubleEqual(ratio, 0.0)) {
         return -1;
     }
-    imageBufferOut->SetWidth(imageBufferIn->GetWidth() * ratio);
-    imageBufferOut->SetHeight(imageBufferIn->GetHeight() * ratio);
-    imageBufferOut->SetComponents(imageBufferIn->GetComponents());
-    imageBufferOut->SetColorType(imageBufferIn->GetColorType());
-    imageBufferOut->SetBitDepth(imageBufferIn->GetBitDepth());
-    imageBufferOut->MallocImageMap(imageBufferOut->GetComponents());
-    ImageRow imageRowIn = imageBufferIn->GetImageDataPointer().get();
-    ImageRow imageRowOut = imageBufferOut->GetImageDataPointer().get();
-    uint32_t outRowStride = imageBufferOut->GetWidth() * imageBufferOut->GetComponents();
-    uint32_t inRowStride = imageBufferIn->GetWidth() * imageBufferIn->GetComponents();
-    uint32_t components = imageBufferIn->GetComponents();
-    for (uint32_t h = 0; h < imageBufferOut->GetHeight(); ++h) {
-        for (uint32_t w = 0; w < imageBufferOut->GetWidth(); ++w) {
-            uint64_t heightIndex = std::round(h / ratio);
-            uint64_t widthIndex = std::round(w / ratio);
-            if (heightIndex > imageBufferIn->GetHeight()) {
-                heightIndex = imageBufferIn->GetHeight() == 0 ? 0 : imageBufferIn->GetHeight() - 1;
-            }
-            if (widthIndex > imageBufferIn->GetWidth()) {
-                widthIndex = imageBufferIn->GetWidth() == 0 ? 0 : imageBufferIn->GetWidth() - 1;
-            }
-            imageRowOut[h * outRowStride +  w * components] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_GREEN] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_GREEN];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_BLUE] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_BLUE];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_ALPHA] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_ALPHA];
-        }
-    }
-    return 0;
+    return ResizeImage(imageBufferIn, imageBufferOut, ratio);
 }
 
 int32_t ImageCompress::DecodeJPGFile(std::string fileName, std::shared_ptr<ImageBuffer>& imageBuffer)
@@ -505,34 +474,27 @@ int32_t ImageCompress::ResizeRGBImage(std::shared_ptr<ImageBuffer>& imageBufferI
     if (DoubleEqual(ratio, 0.0)) {
         return -1;
     }
-    imageBufferOut->SetWidth(imageBufferIn->GetWidth() * ratio);
-    imageBufferOut->SetHeight(imageBufferIn->GetHeight() * ratio);
+    return ResizeImage(imageBufferIn, imageBufferOut, ratio);
+}
+
+int32_t ImageCompress::ResizeImage(std::shared_ptr<ImageBuffer>& imageBufferIn,
+    std::shared_ptr<ImageBuffer>& imageBufferOut, double ratio)
+{
+    if (!imageBufferIn->GetImageDataPointer()) {
+        APP_LOGE("ImageCompress: ResizeImage should decode image first");
+        return -1;
+    }
+    imageBufferOut->SetWidth(std::max(static_cast<uint32_t>(imageBufferIn->GetWidth() * ratio), MIN_IMAGE_SIZE));
+    imageBufferOut->SetHeight(std::max(static_cast<uint32_t>(imageBufferIn->GetHeight() * ratio), MIN_IMAGE_SIZE));
     imageBufferOut->SetComponents(imageBufferIn->GetComponents());
     imageBufferOut->SetColorType(imageBufferIn->GetColorType());
     imageBufferOut->SetBitDepth(imageBufferIn->GetBitDepth());
     imageBufferOut->MallocImageMap(imageBufferOut->GetComponents());
-    ImageRow imageRowIn = imageBufferIn->GetImageDataPointer().get();
-    ImageRow imageRowOut = imageBufferOut->GetImageDataPointer().get();
-    uint32_t outRowStride = imageBufferOut->GetWidth() * imageBufferOut->GetComponents();
-    uint32_t inRowStride = imageBufferIn->GetWidth() * imageBufferIn->GetComponents();
-    uint32_t components = imageBufferIn->GetComponents();
-    for (uint32_t h = 0; h < imageBufferOut->GetHeight(); ++h) {
-        for (uint32_t w = 0; w < imageBufferOut->GetWidth(); ++w) {
-            uint64_t heightIndex = std::round(h / ratio);
-            uint64_t widthIndex = std::round(w / ratio);
-            if (heightIndex > imageBufferIn->GetHeight()) {
-                heightIndex = imageBufferIn->GetHeight() == 0 ? 0 : imageBufferIn->GetHeight() - 1;
-            }
-            if (widthIndex > imageBufferIn->GetWidth()) {
-                widthIndex = imageBufferIn->GetWidth() == 0 ? 0 : imageBufferIn->GetWidth() - 1;
-            }
-            imageRowOut[h * outRowStride +  w * components] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_GREEN] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_GREEN];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_BLUE] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_BLUE];
-        }
+    if (!ImageResize::Resize(imageBufferIn->GetImageDataPointer().get(), imageBufferIn->GetWidth(),
+        imageBufferIn->GetHeight(), imageBufferOut->GetImageDataPointer().get(), imageBufferOut->GetWidth(),
+        imageBufferOut->GetHeight(), imageBufferOut->GetComponents())) {
+        APP_LOGE("ImageCompress: ResizeImage failed");
+        return -1;
     }
     return 0;
 }
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "image_resize.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+constexpr uint32_t WEIGHT_BITS = 14;
+constexpr uint32_t WEIGHT_ONE = 1 << WEIGHT_BITS;
+// the rows resized vertically keep 8 fractional bits, so the horizontal pass fits in 32 bits
+constexpr uint32_t ROW_FRACTION_BITS = 8;
+constexpr uint32_t ROW_SHIFT = WEIGHT_BITS - ROW_FRACTION_BITS;
+constexpr uint32_t OUT_SHIFT = WEIGHT_BITS + ROW_FRACTION_BITS;
+constexpr uint32_t MAX_PIXEL_VALUE = 255;
+constexpr uint32_t RGBA_COMPONENTS = 4;
+constexpr uint32_t ALPHA_INDEX = 3;
+constexpr uint32_t HALF_PIXEL_VALUE = 128;
+constexpr uint32_t BYTE_BITS = 8;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+constexpr uint32_t SIMD_LANES = 16;
+constexpr uint32_t SIMD_QUARTER = SIMD_LANES / 4;
+#endif
+}  // namespace
+
+bool ImageResize::Resize(const uint8_t *in, uint32_t inWidth, uint32_t inHeight,
+    uint8_t *out, uint32_t outWidth, uint32_t outHeight, uint32_t components)
+{
+    if (in == nullptr || out == nullptr || inWidth == 0 || inHeight == 0 ||
+        outWidth == 0 || outHeight == 0 || components == 0) {
+        return false;
+    }
+    if (inWidth == outWidth && inHeight == outHeight) {
+        std::copy_n(in, static_cast<size_t>(inWidth) * inHeight * components, out);
+        return true;
+    }
+    std::vector<FilterTaps> horizontalTaps;
+    std::vector<FilterTaps> verticalTaps;
+    CalculateTaps(inWidth, outWidth, horizontalTaps);
+    CalculateTaps(inHeight, outHeight, verticalTaps);
+
+    // each output row is the weighted sum of its input rows, which is then resized horizontally
+    uint32_t inRowSize = inWidth * components;
+    size_t outRowSize = static_cast<size_t>(outWidth) * components;
+    std::vector<uint32_t> acc(inRowSize);
+    std::vector<uint16_t> row(inRowSize);
+    // the input rows are premultiplied one at a time, so no copy of the whole image is made
+    bool premultiply = components == RGBA_COMPONENTS;
+    std::vector<uint8_t> premultipliedRow(premultiply ? inRowSize : 0);
+    for (uint32_t y = 0; y < outHeight; ++y) {
+        std::fill(acc.begin(), acc.end(), 0);
+        const FilterTaps &taps = verticalTaps[y];
+        for (size_t i = 0; i < taps.weights.size(); ++i) {
+            const uint8_t *inRow = in + static_cast<size_t>(taps.start + i) * inRowSize;
+            if (premultiply) {
+                PremultiplyRow(inRow, premultipliedRow.data(), inWidth);
+                inRow = premultipliedRow.data();
+            }
+            AccumulateRow(inRow, taps.weights[i], acc.data(), inRowSize);
+        }
+        for (uint32_t i = 0; i < inRowSize; ++i) {
+            row[i] = static_cast<uint16_t>((acc[i] + (1u << (ROW_SHIFT - 1))) >> ROW_SHIFT);
+        }
+        uint8_t *outRow = out + y * outRowSize;
+        ResizeRow(row.data(), outRow, horizontalTaps, components);
+        if (premultiply) {
+            UnpremultiplyRow(outRow, outWidth);
+        }
+    }
+    return true;
+}
+
+void ImageResize::CalculateTaps(uint32_t inSize, uint32_t outSize, std::vector<FilterTaps> &taps)
+{
+    taps.resize(outSize);
+    double scale = static_cast<double>(inSize) / outSize;
+    std::vector<double> weights;
+    for (uint32_t x = 0; x < outSize; ++x) {
+        weights.clear();
+        uint32_t start = 0;
+        if (scale > 1.0) {
+            // the output pixel covers [begin, end) of the input
+            double begin = x * scale;
+            double end = std::min(begin + scale, static_cast<double>(inSize));
+            start = static_cast<uint32_t>(begin);
+            for (uint32_t i = start; i < end; ++i) {
+                double overlap = std::min(end, i + 1.0) - std::max(begin, static_cast<double>(i));
+                weights.push_back(overlap / scale);
+            }
+        } else {
+            double center = std::max((x + 0.5) * scale - 0.5, 0.0);
+            start = std::min(static_cast<uint32_t>(center), inSize - 1);
+            double fraction = center - start;
+            weights.push_back(1.0 - fraction);
+            if (start + 1 < inSize) {
+                weights.push_back(fraction);
+            }
+        }
+
+        // quantize the weights, the rounding error goes to the largest one so they still sum to one
+        FilterTaps &tap = taps[x];
+        tap.start = start;
+        tap.weights.resize(weights.size());
+        uint32_t sum = 0;
+        size_t largest = 0;
+        for (size_t i = 0; i < weights.size(); ++i) {
+            tap.weights[i] = static_cast<uint16_t>(std::lround(weights[i] * WEIGHT_ONE));
+            sum += tap.weights[i];
+            if (tap.weights[i] > tap.weights[largest]) {
+                largest = i;
+            }
+        }
+        tap.weights[largest] = static_cast<uint16_t>(tap.weights[largest] + WEIGHT_ONE - sum);
+        while (tap.weights.size() > 1 && tap.weights.back() == 0) {
+            tap.weights.pop_back();
+        }
+    }
+}
+
+void ImageResize::AccumulateRow(const uint8_t *in, uint16_t weight, uint32_t *acc, uint32_t size)
+{
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    // the 16 bit products are split into the low and high halves, then interleaved into 32 bit lanes
+    __m128i zero = _mm_setzero_si128();
+    __m128i weights = _mm_set1_epi16(static_cast<int16_t>(weight));
+    for (; i + SIMD_LANES <= size; i += SIMD_LANES) {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128i halves[] = { _mm_unpacklo_epi8(values, zero), _mm_unpackhi_epi8(values, zero) };
+        __m128i *accs = reinterpret_cast<__m128i *>(acc + i);
+        for (uint32_t j = 0; j < 2; ++j) {
+            __m128i low = _mm_mullo_epi16(halves[j], weights);
+            __m128i high = _mm_mulhi_epu16(halves[j], weights);
+            __m128i *accLow = accs + j * 2;
+            __m128i *accHigh = accLow + 1;
+            _mm_storeu_si128(accLow, _mm_add_epi32(_mm_loadu_si128(accLow), _mm_unpacklo_epi16(low, high)));
+            _mm_storeu_si128(accHigh, _mm_add_epi32(_mm_loadu_si128(accHigh), _mm_unpackhi_epi16(low, high)));
+        }
+    }
+#elif defined(__ARM_NEON)
+    uint16x4_t weights = vdup_n_u16(weight);
+    for (; i + SIMD_LANES <= size; i += SIMD_LANES) {
+        uint8x16_t values = vld1q_u8(in + i);
+        uint16x8_t halves[] = { vmovl_u8(vget_low_u8(values)), vmovl_u8(vget_high_u8(values)) };
+        for (uint32_t j = 0; j < 2; ++j) {
+            uint32_t *accLow = acc + i + j * SIMD_QUARTER * 2;
+            uint32_t *accHigh = accLow + SIMD_QUARTER;
+            vst1q_u32(accLow, vmlal_u16(vld1q_u32(accLow), vget_low_u16(halves[j]), weights));
+            vst1q_u32(accHigh, vmlal_u16(vld1q_u32(accHigh), vget_high_u16(halves[j]), weights));
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        acc[i] += static_cast<uint32_t>(in[i]) * weight;
+    }
+}
+
+void ImageResize::ResizeRow(const uint16_t *in, uint8_t *out, const std::vector<FilterTaps> &taps,
+    uint32_t components)
+{
+    for (const auto &tap : taps) {
+        const uint16_t *pixel = in + static_cast<size_t>(tap.start) * components;
+        for (uint32_t c = 0; c < components; ++c) {
+            uint32_t sum = 0;
+            for (size_t i = 0; i < tap.weights.size(); ++i) {
+                sum += static_cast<uint32_t>(tap.weights[i]) * pixel[i * components + c];
+            }
+            uint32_t value = (sum + (1u << (OUT_SHIFT - 1))) >> OUT_SHIFT;
+            *out++ = static_cast<uint8_t>(std::min(value, MAX_PIXEL_VALUE));
+        }
+    }
+}
+
+void ImageResize::PremultiplyRow(const uint8_t *in, uint8_t *out, uint32_t width)
+{
+    // round(v / 255) is (v + 128 + ((v + 128) >> 8)) >> 8 for every product of two bytes
+    uint32_t size = width * RGBA_COMPONENTS;
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    // the alpha lanes are multiplied by 255, so they are kept after the division
+    __m128i zero = _mm_setzero_si128();
+    __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    __m128i alphaMask = _mm_set_epi16(MAX_PIXEL_VALUE, 0, 0, 0, MAX_PIXEL_VALUE, 0, 0, 0);
+    __m128i half = _mm_set1_epi16(HALF_PIXEL_VALUE);
+    for (; i + SIMD_LANES <= size; i += SIMD_LANES) {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128i halves[] = { _mm_unpacklo_epi8(values, zero), _mm_unpackhi_epi8(values, zero) };
+        for (auto &value : halves) {
+            __m128i alphas = _mm_shufflelo_epi16(value, _MM_SHUFFLE(3, 3, 3, 3));
+            alphas = _mm_shufflehi_epi16(alphas, _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i colors = _mm_or_si128(_mm_and_si128(value, colorMask), alphaMask);
+            __m128i products = _mm_add_epi16(_mm_mullo_epi16(colors, alphas), half);
+            value = _mm_srli_epi16(_mm_add_epi16(products, _mm_srli_epi16(products, BYTE_BITS)), BYTE_BITS);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(halves[0], halves[1]));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + SIMD_LANES * RGBA_COMPONENTS <= size; i += SIMD_LANES * RGBA_COMPONENTS) {
+        uint8x16x4_t pixels = vld4q_u8(in + i);
+        uint8x16_t alphas = pixels.val[ALPHA_INDEX];
+        for (uint32_t c = 0; c < ALPHA_INDEX; ++c) {
+            uint16x8_t low = vmull_u8(vget_low_u8(pixels.val[c]), vget_low_u8(alphas));
+            uint16x8_t high = vmull_u8(vget_high_u8(pixels.val[c]), vget_high_u8(alphas));
+            pixels.val[c] = vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(low, low, BYTE_BITS), BYTE_BITS),
+                vrshrn_n_u16(vrsraq_n_u16(high, high, BYTE_BITS), BYTE_BITS));
+        }
+        vst4q_u8(out + i, pixels);
+    }
+#endif
+    for (; i < size; i += RGBA_COMPONENTS) {
+        uint32_t alpha = in[i + ALPHA_INDEX];
+        for (uint32_t c = 0; c < ALPHA_INDEX; ++c) {
+            uint32_t value = in[i + c] * alpha + HALF_PIXEL_VALUE;
+            out[i + c] = static_cast<uint8_t>((value + (value >> BYTE_BITS)) >> BYTE_BITS);
+        }
+        out[i + ALPHA_INDEX] = static_cast<uint8_t>(alpha);
+    }
+}
+
+void ImageResize::UnpremultiplyRow(uint8_t *row, uint32_t width)
+{
+    for (uint32_t x = 0; x < width; ++x, row += RGBA_COMPONENTS) {
+        uint32_t alpha = row[ALPHA_INDEX];
+        if (alpha == MAX_PIXEL_VALUE) {
+            continue;
+        }
+        for (uint32_t c = 0; c < ALPHA_INDEX; ++c) {
+            // the filtered colors never exceed the filtered alpha, the clamp only guards the rounding
+            uint32_t value = alpha == 0 ? 0 : (row[c] * MAX_PIXEL_VALUE + alpha / 2) / alpha;
+            row[c] = static_cast<uint8_t>(std::min(value, MAX_PIXEL_VALUE));
+        }
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
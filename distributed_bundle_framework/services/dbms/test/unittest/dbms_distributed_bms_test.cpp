@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define private public
+#include "distributed_bms.h"
+#undef private
+
+#include <gtest/gtest.h>
+#include <dirent.h>
+#include <fstream>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "appexecfwk_errors.h"
+#include "bundle_mgr_host.h"
+#include "system_ability_definition.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace OHOS {
+namespace AppExecFwk {
+// the bundle manager proxy cached by distributed_bms.cpp, the tests replace it with MockBundleMgr
+extern sptr<IBundleMgr> bundleMgr_;
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+namespace {
+const std::string TEST_DIR = "/data/test/dbms_distributed_bms";
+const std::string STORE_DIR = TEST_DIR + "/icons";
+const std::string BUNDLE_NAME = "com.example.dbms";
+const std::string MODULE_NAME = "entry";
+const std::string ABILITY_NAME = "MainAbility";
+const std::string OTHER_ABILITY_NAME = "OtherAbility";
+const std::string LOCALE_INFO = "zh-Hans-CN";
+const std::string OTHER_LOCALE_INFO = "en-Latn-US";
+const std::string LABEL = "label";
+const std::string ICON = "data:image/png;base64,Y2FjaGVk";
+const std::string ICON_DATA_URI_PREFIX = "data:image/png;base64,";
+constexpr uint32_t VERSION_CODE = 1;
+constexpr int64_t UPDATE_TIME = 100;
+constexpr size_t MAX_ABILITY_INFO_CACHE_SIZE = 64;
+constexpr int32_t ICON_THREAD_NUMBER = 3;
+
+class MockBundleMgr : public BundleMgrHost {
+public:
+    using BundleMgrHost::GetBundleInfo;
+    using BundleMgrHost::QueryAbilityInfo;
+
+    bool GetBundleInfo(const std::string &bundleName, const BundleFlag flag, BundleInfo &bundleInfo,
+        int32_t userId) override
+    {
+        ++getBundleInfoCount;
+        auto item = bundleInfos.find(bundleName);
+        if (item == bundleInfos.end()) {
+            return false;
+        }
+        bundleInfo = item->second;
+        return true;
+    }
+
+    bool QueryAbilityInfo(const Want &want, int32_t flags, int32_t userId, AbilityInfo &abilityInfo) override
+    {
+        // the disabled abilities are not found by BMS
+        ++queryAbilityInfoCount;
+        return false;
+    }
+
+    std::map<std::string, BundleInfo> bundleInfos;
+    int32_t getBundleInfoCount = 0;
+    int32_t queryAbilityInfoCount = 0;
+};
+
+void WriteTestFile(const std::string &path, const std::string &content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+void RemoveDir(const std::string &path)
+{
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string child = path + "/" + name;
+        if (entry->d_type == DT_DIR) {
+            RemoveDir(child);
+        } else {
+            unlink(child.c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(path.c_str());
+}
+
+AbilityInfo MakeAbilityInfo(const std::string &abilityName)
+{
+    AbilityInfo abilityInfo;
+    abilityInfo.name = abilityName;
+    abilityInfo.bundleName = BUNDLE_NAME;
+    abilityInfo.moduleName = MODULE_NAME;
+    abilityInfo.enabled = true;
+    return abilityInfo;
+}
+
+BundleInfo MakeBundleInfo()
+{
+    BundleInfo bundleInfo;
+    bundleInfo.name = BUNDLE_NAME;
+    bundleInfo.versionCode = VERSION_CODE;
+    bundleInfo.updateTime = UPDATE_TIME;
+    bundleInfo.applicationInfo.enabled = true;
+    bundleInfo.abilityInfos.push_back(MakeAbilityInfo(ABILITY_NAME));
+    bundleInfo.abilityInfos.push_back(MakeAbilityInfo(OTHER_ABILITY_NAME));
+    return bundleInfo;
+}
+
+ElementName MakeElementName(const std::string &abilityName)
+{
+    return ElementName("", BUNDLE_NAME, abilityName, MODULE_NAME);
+}
+}  // namespace
+
+class DbmsDistributedBmsTest : public testing::Test {
+public:
+    DbmsDistributedBmsTest()
+    {}
+    ~DbmsDistributedBmsTest()
+    {}
+
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    // caches the label and icon of the element as if it had been resolved with bundleInfo
+    void CacheAbilityInfo(const ElementName &elementName, const BundleInfo &bundleInfo,
+        const std::string &localeInfo);
+
+    std::shared_ptr<DistributedBms> distributedBms_;
+    sptr<MockBundleMgr> mockBundleMgr_;
+    int32_t userId_ = -1;
+};
+
+void DbmsDistributedBmsTest::SetUpTestCase(void)
+{}
+
+void DbmsDistributedBmsTest::TearDownTestCase(void)
+{}
+
+void DbmsDistributedBmsTest::SetUp()
+{
+    RemoveDir(TEST_DIR);
+    mkdir(TEST_DIR.c_str(), S_IRWXU);
+    distributedBms_ = std::make_shared<DistributedBms>(DISTRIBUTED_BUNDLE_MGR_SERVICE_SYS_ABILITY_ID, true);
+    distributedBms_->iconStore_ = std::make_shared<IconStore>(STORE_DIR);
+    mockBundleMgr_ = new (std::nothrow) MockBundleMgr();
+    ASSERT_NE(mockBundleMgr_, nullptr);
+    mockBundleMgr_->bundleInfos[BUNDLE_NAME] = MakeBundleInfo();
+    OHOS::AppExecFwk::bundleMgr_ = mockBundleMgr_;
+    ASSERT_TRUE(distributedBms_->GetCurrentUserId(userId_));
+}
+
+void DbmsDistributedBmsTest::TearDown()
+{
+    OHOS::AppExecFwk::bundleMgr_ = nullptr;
+    distributedBms_->iconPool_.Stop();
+    distributedBms_ = nullptr;
+    RemoveDir(TEST_DIR);
+}
+
+void DbmsDistributedBmsTest::CacheAbilityInfo(const ElementName &elementName, const BundleInfo &bundleInfo,
+    const std::string &localeInfo)
+{
+    RemoteAbilityInfo remoteAbilityInfo;
+    remoteAbilityInfo.label = LABEL;
+    remoteAbilityInfo.icon = ICON;
+    distributedBms_->CacheAbilityInfo(
+        DistributedBms::GetAbilityInfoCacheKey(elementName, userId_, bundleInfo, localeInfo), remoteAbilityInfo);
+}
+
+/**
+ * @tc.number: PrepareAbilityInfoTasks_0100
+ * @tc.name: test the cached ability infos of one bundle
+ * @tc.desc: 1. cache two abilities of a bundle and get them together
+ *           2. the bundle is queried once and the labels and icons come from the cache
+ */
+HWTEST_F(DbmsDistributedBmsTest, PrepareAbilityInfoTasks_0100, Function | SmallTest | Level0)
+{
+    const BundleInfo &bundleInfo = mockBundleMgr_->bundleInfos[BUNDLE_NAME];
+    std::vector<ElementName> elementNames = { MakeElementName(ABILITY_NAME), MakeElementName(OTHER_ABILITY_NAME) };
+    for (const auto &elementName : elementNames) {
+        CacheAbilityInfo(elementName, bundleInfo, LOCALE_INFO);
+    }
+
+    std::map<std::string, BundleInfo> bundleInfos;
+    std::vector<DistributedBms::AbilityInfoTask> tasks;
+    EXPECT_EQ(distributedBms_->PrepareAbilityInfoTasks(elementNames, LOCALE_INFO, bundleInfos, tasks),
+        OHOS::NO_ERROR);
+    EXPECT_EQ(mockBundleMgr_->getBundleInfoCount, 1);
+    EXPECT_EQ(mockBundleMgr_->queryAbilityInfoCount, 0);
+    ASSERT_EQ(tasks.size(), elementNames.size());
+    for (const auto &task : tasks) {
+        EXPECT_TRUE(task.cacheable);
+        EXPECT_TRUE(task.cached);
+        EXPECT_EQ(task.remoteAbilityInfo.label, LABEL);
+        EXPECT_EQ(task.remoteAbilityInfo.icon, ICON);
+    }
+
+    std::vector<RemoteAbilityInfo> remoteAbilityInfos;
+    EXPECT_EQ(distributedBms_->GetAbilityInfos(elementNames, LOCALE_INFO, remoteAbilityInfos), OHOS::NO_ERROR);
+    ASSERT_EQ(remoteAbilityInfos.size(), elementNames.size());
+    for (size_t i = 0; i < elementNames.size(); ++i) {
+        EXPECT_EQ(remoteAbilityInfos[i].elementName.GetAbilityName(), elementNames[i].GetAbilityName());
+        EXPECT_EQ(remoteAbilityInfos[i].label, LABEL);
+        EXPECT_EQ(remoteAbilityInfos[i].icon, ICON);
+    }
+}
+
+/**
+ * @tc.number: PrepareAbilityInfoTasks_0200
+ * @tc.name: test the cached ability info of a disabled application
+ * @tc.desc: 1. cache an ability, then disable its application for the responding user
+ *           2. the cached ability info is not returned
+ */
+HWTEST_F(DbmsDistributedBmsTest, PrepareAbilityInfoTasks_0200, Function | SmallTest | Level0)
+{
+    ElementName elementName = MakeElementName(ABILITY_NAME);
+    CacheAbilityInfo(elementName, mockBundleMgr_->bundleInfos[BUNDLE_NAME], LOCALE_INFO);
+    mockBundleMgr_->bundleInfos[BUNDLE_NAME].applicationInfo.enabled = false;
+
+    std::map<std::string, BundleInfo> bundleInfos;
+    std::vector<DistributedBms::AbilityInfoTask> tasks;
+    EXPECT_EQ(distributedBms_->PrepareAbilityInfoTasks({ elementName }, LOCALE_INFO, bundleInfos, tasks),
+        ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO);
+    EXPECT_FALSE(tasks[0].cached);
+
+    RemoteAbilityInfo remoteAbilityInfo;
+    EXPECT_EQ(distributedBms_->GetAbilityInfo(elementName, LOCALE_INFO, remoteAbilityInfo),
+        ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO);
+    EXPECT_TRUE(remoteAbilityInfo.label.empty());
+    EXPECT_TRUE(remoteAbilityInfo.icon.empty());
+
+    AbilityInfo abilityInfo;
+    EXPECT_FALSE(DistributedBms::FindAbilityInfo(mockBundleMgr_->bundleInfos[BUNDLE_NAME], elementName, abilityInfo));
+}
+
+/**
+ * @tc.number: PrepareAbilityInfoTasks_0300
+ * @tc.name: test the cached ability info of a disabled ability
+ * @tc.desc: 1. cache an ability, then disable it
+ *           2. the cache is skipped and BMS reports the ability as not found
+ */
+HWTEST_F(DbmsDistributedBmsTest, PrepareAbilityInfoTasks_0300, Function | SmallTest | Level0)
+{
+    ElementName elementName = MakeElementName(ABILITY_NAME);
+    CacheAbilityInfo(elementName, mockBundleMgr_->bundleInfos[BUNDLE_NAME], LOCALE_INFO);
+    mockBundleMgr_->bundleInfos[BUNDLE_NAME].abilityInfos[0].enabled = false;
+
+    std::map<std::string, BundleInfo> bundleInfos;
+    std::vector<DistributedBms::AbilityInfoTask> tasks;
+    EXPECT_EQ(distributedBms_->PrepareAbilityInfoTasks({ elementName }, LOCALE_INFO, bundleInfos, tasks),
+        ERR_APPEXECFWK_FAILED_GET_ABILITY_INFO);
+    ASSERT_EQ(tasks.size(), 1);
+    EXPECT_FALSE(tasks[0].cacheable);
+    EXPECT_FALSE(tasks[0].cached);
+    EXPECT_EQ(mockBundleMgr_->queryAbilityInfoCount, 1);
+}
+
+/**
+ * @tc.number: PrepareAbilityInfoTasks_0400
+ * @tc.name: test the unknown bundle
+ * @tc.desc: 1. get the ability info of a bundle unknown to BMS
+ *           2. the error of GetBundleInfo is returned
+ */
+HWTEST_F(DbmsDistributedBmsTest, PrepareAbilityInfoTasks_0400, Function | SmallTest | Level0)
+{
+    std::map<std::string, BundleInfo> bundleInfos;
+    std::vector<DistributedBms::AbilityInfoTask> tasks;
+    ElementName elementName("", "com.example.unknown", ABILITY_NAME, MODULE_NAME);
+    EXPECT_EQ(distributedBms_->PrepareAbilityInfoTasks({ elementName }, LOCALE_INFO, bundleInfos, tasks),
+        ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO);
+    EXPECT_TRUE(bundleInfos.empty());
+}
+
+/**
+ * @tc.number: AbilityInfoCache_0100
+ * @tc.name: test the invalidation of the cached ability infos
+ * @tc.desc: 1. cache an ability, then update its bundle, change its version or ask for another locale
+ *           2. the cached ability info is no longer found
+ */
+HWTEST_F(DbmsDistributedBmsTest, AbilityInfoCache_0100, Function | SmallTest | Level0)
+{
+    ElementName elementName = MakeElementName(ABILITY_NAME);
+    BundleInfo bundleInfo = mockBundleMgr_->bundleInfos[BUNDLE_NAME];
+    CacheAbilityInfo(elementName, bundleInfo, LOCALE_INFO);
+    RemoteAbilityInfo remoteAbilityInfo;
+    EXPECT_TRUE(distributedBms_->GetCachedAbilityInfo(
+        DistributedBms::GetAbilityInfoCacheKey(elementName, userId_, bundleInfo, LOCALE_INFO), remoteAbilityInfo));
+    EXPECT_FALSE(distributedBms_->GetCachedAbilityInfo(
+        DistributedBms::GetAbilityInfoCacheKey(elementName, userId_, bundleInfo, OTHER_LOCALE_INFO),
+        remoteAbilityInfo));
+    EXPECT_FALSE(distributedBms_->GetCachedAbilityInfo(
+        DistributedBms::GetAbilityInfoCacheKey(elementName, userId_ + 1, bundleInfo, LOCALE_INFO),
+        remoteAbilityInfo));
+
+    BundleInfo updatedBundleInfo = bundleInfo;
+    updatedBundleInfo.versionCode = VERSION_CODE + 1;
+    EXPECT_FALSE(distributedBms_->GetCachedAbilityInfo(
+        DistributedBms::GetAbilityInfoCacheKey(elementName, userId_, updatedBundleInfo, LOCALE_INFO),
+        remoteAbilityInfo));
+
+    // reinstalled with the same version code
+    mockBundleMgr_->bundleInfos[BUNDLE_NAME].updateTime = UPDATE_TIME + 1;
+    std::map<std::string, BundleInfo> bundleInfos;
+    std::vector<DistributedBms::AbilityInfoTask> tasks;
+    distributedBms_->PrepareAbilityInfoTasks({ elementName }, LOCALE_INFO, bundleInfos, tasks);
+    ASSERT_EQ(tasks.size(), 1);
+    EXPECT_TRUE(tasks[0].cacheable);
+    EXPECT_FALSE(tasks[0].cached);
+    EXPECT_NE(tasks[0].remoteAbilityInfo.icon, ICON);
+}
+
+/**
+ * @tc.number: AbilityInfoCache_0200
+ * @tc.name: test the size of the ability info cache
+ * @tc.desc: 1. cache more abilities than the cache holds, reading the first one in between
+ *           2. the least recently used one is dropped and the read one is kept
+ */
+HWTEST_F(DbmsDistributedBmsTest, AbilityInfoCache_0200, Function | SmallTest | Level0)
+{
+    const BundleInfo &bundleInfo = mockBundleMgr_->bundleInfos[BUNDLE_NAME];
+    std::vector<std::string> keys;
+    for (size_t i = 0; i <= MAX_ABILITY_INFO_CACHE_SIZE; ++i) {
+        ElementName elementName = MakeElementName(ABILITY_NAME + std::to_string(i));
+        keys.push_back(DistributedBms::GetAbilityInfoCacheKey(elementName, userId_, bundleInfo, LOCALE_INFO));
+    }
+    RemoteAbilityInfo remoteAbilityInfo;
+    remoteAbilityInfo.label = LABEL;
+    for (size_t i = 0; i < MAX_ABILITY_INFO_CACHE_SIZE; ++i) {
+        distributedBms_->CacheAbilityInfo(keys[i], remoteAbilityInfo);
+    }
+    EXPECT_TRUE(distributedBms_->GetCachedAbilityInfo(keys[0], remoteAbilityInfo));
+    distributedBms_->CacheAbilityInfo(keys.back(), remoteAbilityInfo);
+
+    EXPECT_EQ(distributedBms_->abilityInfoCache_.size(), MAX_ABILITY_INFO_CACHE_SIZE);
+    EXPECT_TRUE(distributedBms_->GetCachedAbilityInfo(keys[0], remoteAbilityInfo));
+    EXPECT_FALSE(distributedBms_->GetCachedAbilityInfo(keys[1], remoteAbilityInfo));
+    EXPECT_TRUE(distributedBms_->GetCachedAbilityInfo(keys.back(), remoteAbilityInfo));
+}
+
+/**
+ * @tc.number: RenderIcons_0100
+ * @tc.name: test the icons rendered on the icon pool
+ * @tc.desc: 1. render the icons of several tasks, one of them cached and one of them missing
+ *           2. each icon is the data uri of its own file, the cached one is kept and the missing one fails
+ */
+HWTEST_F(DbmsDistributedBmsTest, RenderIcons_0100, Function | SmallTest | Level0)
+{
+    distributedBms_->iconPool_.Start(ICON_THREAD_NUMBER);
+    const BundleInfo &bundleInfo = mockBundleMgr_->bundleInfos[BUNDLE_NAME];
+    // the base64 of icon0, icon1 and icon2
+    const std::vector<std::string> encodedIcons = { "aWNvbjA=", "aWNvbjE=", "aWNvbjI=" };
+    std::vector<DistributedBms::AbilityInfoTask> tasks(encodedIcons.size() + 2);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i].bundleInfo = &bundleInfo;
+        tasks[i].iconPath = TEST_DIR + "/icon" + std::to_string(i) + ".png";
+        if (i < encodedIcons.size()) {
+            WriteTestFile(tasks[i].iconPath, "icon" + std::to_string(i));
+        }
+    }
+    DistributedBms::AbilityInfoTask &cachedTask = tasks[encodedIcons.size()];
+    cachedTask.cached = true;
+    cachedTask.remoteAbilityInfo.icon = ICON;
+
+    distributedBms_->RenderIcons(tasks);
+    for (size_t i = 0; i < encodedIcons.size(); ++i) {
+        EXPECT_TRUE(tasks[i].iconRendered);
+        EXPECT_EQ(tasks[i].remoteAbilityInfo.icon, ICON_DATA_URI_PREFIX + encodedIcons[i]);
+    }
+    EXPECT_FALSE(cachedTask.iconRendered);
+    EXPECT_EQ(cachedTask.remoteAbilityInfo.icon, ICON);
+    EXPECT_FALSE(tasks.back().iconRendered);
+}
+
+/**
+ * @tc.number: RenderIcons_0200
+ * @tc.name: test the icons rendered on the calling thread only
+ * @tc.desc: 1. render the icons when all the tasks are cached, and when a single task is not
+ *           2. nothing is rendered for the cached tasks and the single icon is rendered
+ */
+HWTEST_F(DbmsDistributedBmsTest, RenderIcons_0200, Function | SmallTest | Level0)
+{
+    std::vector<DistributedBms::AbilityInfoTask> tasks(1);
+    tasks[0].cached = true;
+    distributedBms_->RenderIcons(tasks);
+    EXPECT_FALSE(tasks[0].iconRendered);
+
+    tasks[0].cached = false;
+    tasks[0].bundleInfo = &mockBundleMgr_->bundleInfos[BUNDLE_NAME];
+    tasks[0].iconPath = TEST_DIR + "/icon.png";
+    WriteTestFile(tasks[0].iconPath, "icon0");
+    distributedBms_->RenderIcons(tasks);
+    EXPECT_TRUE(tasks[0].iconRendered);
+    EXPECT_EQ(tasks[0].remoteAbilityInfo.icon, ICON_DATA_URI_PREFIX + "aWNvbjA=");
+}
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "icon_store.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+const std::string TEST_DIR = "/data/test/dbms_icon_store";
+const std::string STORE_DIR = TEST_DIR + "/icons";
+const std::string ICON_PATH = TEST_DIR + "/icon.png";
+const std::string BUNDLE_NAME = "com.example.iconstore";
+const std::string BUNDLE_DIR = STORE_DIR + "/" + BUNDLE_NAME;
+const std::string ICON = "data:image/jpeg;base64,aWNvbg==";
+const std::string OTHER_ICON = "data:image/jpeg;base64,b3RoZXI=";
+constexpr uint32_t VERSION_CODE = 1;
+constexpr uint32_t NEW_VERSION_CODE = 2;
+// magic, version and count of the store header
+constexpr size_t STORE_HEADER_SIZE = 12;
+
+void WriteTestFile(const std::string &path, const std::string &content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+std::string ReadTestFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool IsExist(const std::string &path)
+{
+    return access(path.c_str(), F_OK) == 0;
+}
+
+std::string GetStorePath(uint32_t versionCode)
+{
+    return BUNDLE_DIR + "/" + std::to_string(versionCode);
+}
+
+void RemoveDir(const std::string &path)
+{
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string child = path + "/" + name;
+        if (entry->d_type == DT_DIR) {
+            RemoveDir(child);
+        } else {
+            unlink(child.c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(path.c_str());
+}
+}  // namespace
+
+class DbmsIconStoreTest : public testing::Test {
+public:
+    DbmsIconStoreTest()
+    {}
+    ~DbmsIconStoreTest()
+    {}
+
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void DbmsIconStoreTest::SetUpTestCase(void)
+{}
+
+void DbmsIconStoreTest::TearDownTestCase(void)
+{}
+
+void DbmsIconStoreTest::SetUp()
+{
+    RemoveDir(TEST_DIR);
+    mkdir(TEST_DIR.c_str(), S_IRWXU);
+    WriteTestFile(ICON_PATH, "icon file");
+}
+
+void DbmsIconStoreTest::TearDown()
+{
+    RemoveDir(TEST_DIR);
+}
+
+/**
+ * @tc.number: IconStore_0100
+ * @tc.name: test the stored icon is read back from the mapped store file
+ * @tc.desc: 1. store an icon
+ *           2. the icon is got by a new store of the same dir
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0100, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    std::string icon;
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+
+    IconStore otherStore(STORE_DIR);
+    EXPECT_TRUE(otherStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_EQ(icon, ICON);
+}
+
+/**
+ * @tc.number: IconStore_0200
+ * @tc.name: test the store file is replaced by rename
+ * @tc.desc: 1. store an icon and keep the inode of the store file
+ *           2. store another icon, the file is a new inode and no tmp file is left
+ *           3. both icons are got
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0200, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+    struct stat oldBuf = {};
+    ASSERT_EQ(stat(GetStorePath(VERSION_CODE).c_str(), &oldBuf), 0);
+
+    std::string otherIconPath = TEST_DIR + "/other.png";
+    WriteTestFile(otherIconPath, "other icon file");
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, otherIconPath, OTHER_ICON));
+    struct stat newBuf = {};
+    ASSERT_EQ(stat(GetStorePath(VERSION_CODE).c_str(), &newBuf), 0);
+    EXPECT_NE(oldBuf.st_ino, newBuf.st_ino);
+    EXPECT_FALSE(IsExist(GetStorePath(VERSION_CODE) + ".tmp"));
+
+    std::string icon;
+    EXPECT_TRUE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_EQ(icon, ICON);
+    EXPECT_TRUE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, otherIconPath, icon));
+    EXPECT_EQ(icon, OTHER_ICON);
+}
+
+/**
+ * @tc.number: IconStore_0300
+ * @tc.name: test the store file of the old version is removed
+ * @tc.desc: 1. store an icon of the old version and of the new version
+ *           2. only the store file of the new version is left
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0300, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, NEW_VERSION_CODE, ICON_PATH, OTHER_ICON));
+    EXPECT_FALSE(IsExist(GetStorePath(VERSION_CODE)));
+    EXPECT_TRUE(IsExist(GetStorePath(NEW_VERSION_CODE)));
+
+    std::string icon;
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_TRUE(iconStore.GetIcon(BUNDLE_NAME, NEW_VERSION_CODE, ICON_PATH, icon));
+    EXPECT_EQ(icon, OTHER_ICON);
+}
+
+/**
+ * @tc.number: IconStore_0400
+ * @tc.name: test the icon is not got after the icon file is changed
+ * @tc.desc: 1. store an icon
+ *           2. change the icon file without a new version code
+ *           3. the stored icon is not got until it is stored again
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0400, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+    WriteTestFile(ICON_PATH, "changed icon file");
+
+    std::string icon;
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, OTHER_ICON));
+    EXPECT_TRUE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_EQ(icon, OTHER_ICON);
+}
+
+/**
+ * @tc.number: IconStore_0500
+ * @tc.name: test a corrupt store file
+ * @tc.desc: 1. store an icon and overwrite the magic of the store file
+ *           2. the icon is not got
+ *           3. the store file is rewritten by the next store
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0500, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+    std::string data = ReadTestFile(GetStorePath(VERSION_CODE));
+    ASSERT_GT(data.size(), STORE_HEADER_SIZE);
+    data[0] = static_cast<char>(~data[0]);
+    WriteTestFile(GetStorePath(VERSION_CODE), data);
+
+    std::string icon;
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_TRUE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_EQ(icon, ICON);
+}
+
+/**
+ * @tc.number: IconStore_0600
+ * @tc.name: test a truncated store file
+ * @tc.desc: 1. store an icon and truncate the store file inside the icon and inside the header
+ *           2. the icon is not got
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0600, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+    std::string data = ReadTestFile(GetStorePath(VERSION_CODE));
+    ASSERT_GT(data.size(), STORE_HEADER_SIZE);
+
+    std::string icon;
+    WriteTestFile(GetStorePath(VERSION_CODE), data.substr(0, data.size() - 1));
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    WriteTestFile(GetStorePath(VERSION_CODE), data.substr(0, STORE_HEADER_SIZE - 1));
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    WriteTestFile(GetStorePath(VERSION_CODE), "");
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+}
+
+/**
+ * @tc.number: IconStore_0700
+ * @tc.name: test the bundle names out of the store dir are rejected
+ * @tc.desc: 1. store icons with invalid bundle names
+ *           2. nothing is stored
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0700, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    EXPECT_FALSE(iconStore.SetIcon("", VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_FALSE(iconStore.SetIcon(".", VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_FALSE(iconStore.SetIcon("..", VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_FALSE(iconStore.SetIcon("../x", VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_FALSE(iconStore.SetIcon("a/b", VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_FALSE(IsExist(STORE_DIR));
+
+    std::string icon;
+    EXPECT_FALSE(iconStore.GetIcon("../x", VERSION_CODE, ICON_PATH, icon));
+    EXPECT_FALSE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, TEST_DIR + "/none.png", ICON));
+}
+
+/**
+ * @tc.number: IconStore_0800
+ * @tc.name: test the store of an uninstalled bundle is removed
+ * @tc.desc: 1. store icons of two bundles and remove one bundle
+ *           2. the dir of the removed bundle is deleted and the other bundle is kept
+ */
+HWTEST_F(DbmsIconStoreTest, IconStore_0800, Function | SmallTest | Level0)
+{
+    IconStore iconStore(STORE_DIR);
+    std::string otherBundleName = "com.example.other";
+    EXPECT_TRUE(iconStore.SetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, ICON));
+    EXPECT_TRUE(iconStore.SetIcon(otherBundleName, VERSION_CODE, ICON_PATH, OTHER_ICON));
+
+    iconStore.RemoveBundle(BUNDLE_NAME);
+    EXPECT_FALSE(IsExist(BUNDLE_DIR));
+    std::string icon;
+    EXPECT_FALSE(iconStore.GetIcon(BUNDLE_NAME, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_TRUE(iconStore.GetIcon(otherBundleName, VERSION_CODE, ICON_PATH, icon));
+    EXPECT_EQ(icon, OTHER_ICON);
+
+    // removing a bundle without a store does nothing
+    iconStore.RemoveBundle(BUNDLE_NAME);
+    iconStore.RemoveBundle("../icons");
+    EXPECT_TRUE(IsExist(STORE_DIR));
+}
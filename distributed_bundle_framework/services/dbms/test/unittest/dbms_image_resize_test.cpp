@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define private public
+#include "image_resize.h"
+#undef private
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+constexpr uint32_t GRAY = 1;
+constexpr uint32_t RGB = 3;
+constexpr uint32_t RGBA = 4;
+constexpr uint32_t WEIGHT_ONE = 1 << 14;
+constexpr int32_t MAX_ERROR = 1;
+constexpr uint32_t RANDOM_SEED = 20220601;
+// covers the SIMD loop of 16 bytes and the scalar tail of every length
+constexpr uint32_t MAX_ROW_SIZE = 100;
+
+std::vector<uint8_t> RandomImage(uint32_t width, uint32_t height, uint32_t components, std::mt19937 &engine)
+{
+    std::uniform_int_distribution<uint32_t> distribution(0, UINT8_MAX);
+    std::vector<uint8_t> image(static_cast<size_t>(width) * height * components);
+    for (auto &value : image) {
+        value = static_cast<uint8_t>(distribution(engine));
+    }
+    return image;
+}
+
+// the filter of ImageResize in double precision, without the fixed-point rounding
+std::vector<std::vector<std::pair<uint32_t, double>>> ReferenceTaps(uint32_t inSize, uint32_t outSize)
+{
+    std::vector<std::vector<std::pair<uint32_t, double>>> taps(outSize);
+    double scale = static_cast<double>(inSize) / outSize;
+    for (uint32_t x = 0; x < outSize; ++x) {
+        if (scale > 1.0) {
+            double begin = x * scale;
+            double end = std::min(begin + scale, static_cast<double>(inSize));
+            for (uint32_t i = static_cast<uint32_t>(begin); i < end; ++i) {
+                double overlap = std::min(end, i + 1.0) - std::max(begin, static_cast<double>(i));
+                taps[x].emplace_back(i, overlap / scale);
+            }
+        } else {
+            double center = std::max((x + 0.5) * scale - 0.5, 0.0);
+            uint32_t start = std::min(static_cast<uint32_t>(center), inSize - 1);
+            double fraction = center - start;
+            if (start + 1 < inSize) {
+                taps[x].emplace_back(start, 1.0 - fraction);
+                taps[x].emplace_back(start + 1, fraction);
+            } else {
+                taps[x].emplace_back(start, 1.0);
+            }
+        }
+    }
+    return taps;
+}
+
+// premultiplies the colors of a RGBA image by its alpha with the rounding of ImageResize
+std::vector<uint8_t> Premultiply(std::vector<uint8_t> image)
+{
+    for (size_t i = 0; i + RGBA <= image.size(); i += RGBA) {
+        uint32_t alpha = image[i + RGBA - 1];
+        for (size_t c = 0; c < RGBA - 1; ++c) {
+            image[i + c] = static_cast<uint8_t>((image[i + c] * alpha + UINT8_MAX / 2) / UINT8_MAX);
+        }
+    }
+    return image;
+}
+
+// the RGBA images are filtered premultiplied, and so is the result of them
+std::vector<uint8_t> ReferenceResize(const std::vector<uint8_t> &in, uint32_t inWidth, uint32_t inHeight,
+    uint32_t outWidth, uint32_t outHeight, uint32_t components)
+{
+    const std::vector<uint8_t> &pixels = components == RGBA ? Premultiply(in) : in;
+    auto horizontalTaps = ReferenceTaps(inWidth, outWidth);
+    auto verticalTaps = ReferenceTaps(inHeight, outHeight);
+    std::vector<uint8_t> out(static_cast<size_t>(outWidth) * outHeight * components);
+    for (uint32_t y = 0; y < outHeight; ++y) {
+        for (uint32_t x = 0; x < outWidth; ++x) {
+            for (uint32_t c = 0; c < components; ++c) {
+                double sum = 0.0;
+                for (const auto &vertical : verticalTaps[y]) {
+                    for (const auto &horizontal : horizontalTaps[x]) {
+                        size_t index = (static_cast<size_t>(vertical.first) * inWidth + horizontal.first) *
+                            components + c;
+                        sum += pixels[index] * vertical.second * horizontal.second;
+                    }
+                }
+                out[(static_cast<size_t>(y) * outWidth + x) * components + c] =
+                    static_cast<uint8_t>(std::min(std::lround(sum), static_cast<long>(UINT8_MAX)));
+            }
+        }
+    }
+    return out;
+}
+
+int32_t MaxDifference(const std::vector<uint8_t> &left, const std::vector<uint8_t> &right)
+{
+    int32_t difference = 0;
+    for (size_t i = 0; i < left.size() && i < right.size(); ++i) {
+        difference = std::max(difference, std::abs(static_cast<int32_t>(left[i]) - right[i]));
+    }
+    return difference;
+}
+
+// checks the resized random image against the reference filter
+void ExpectCloseToReference(uint32_t inWidth, uint32_t inHeight, uint32_t outWidth, uint32_t outHeight,
+    uint32_t components)
+{
+    std::mt19937 engine(RANDOM_SEED);
+    std::vector<uint8_t> in = RandomImage(inWidth, inHeight, components, engine);
+    std::vector<uint8_t> out(static_cast<size_t>(outWidth) * outHeight * components);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), inWidth, inHeight, out.data(), outWidth, outHeight, components));
+    std::vector<uint8_t> expected = ReferenceResize(in, inWidth, inHeight, outWidth, outHeight, components);
+    if (components == RGBA) {
+        // premultiplying the straight colors again restores the filtered ones exactly
+        out = Premultiply(out);
+    }
+    EXPECT_LE(MaxDifference(out, expected), MAX_ERROR) << inWidth << "x" << inHeight << " to " <<
+        outWidth << "x" << outHeight << " with " << components << " components";
+}
+}  // namespace
+
+class DbmsImageResizeTest : public testing::Test {
+public:
+    DbmsImageResizeTest()
+    {}
+    ~DbmsImageResizeTest()
+    {}
+
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void DbmsImageResizeTest::SetUpTestCase(void)
+{}
+
+void DbmsImageResizeTest::TearDownTestCase(void)
+{}
+
+void DbmsImageResizeTest::SetUp()
+{}
+
+void DbmsImageResizeTest::TearDown()
+{}
+
+/**
+ * @tc.number: ImageResize_0100
+ * @tc.name: test the invalid parameters
+ * @tc.desc: 1. resize with a null buffer or a zero size
+ *           2. false is returned
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0100, Function | SmallTest | Level0)
+{
+    uint8_t in[RGBA] = { 0 };
+    uint8_t out[RGBA] = { 0 };
+    EXPECT_FALSE(ImageResize::Resize(nullptr, 1, 1, out, 1, 1, RGBA));
+    EXPECT_FALSE(ImageResize::Resize(in, 1, 1, nullptr, 1, 1, RGBA));
+    EXPECT_FALSE(ImageResize::Resize(in, 0, 1, out, 1, 1, RGBA));
+    EXPECT_FALSE(ImageResize::Resize(in, 1, 0, out, 1, 1, RGBA));
+    EXPECT_FALSE(ImageResize::Resize(in, 1, 1, out, 0, 1, RGBA));
+    EXPECT_FALSE(ImageResize::Resize(in, 1, 1, out, 1, 0, RGBA));
+    EXPECT_FALSE(ImageResize::Resize(in, 1, 1, out, 1, 1, 0));
+}
+
+/**
+ * @tc.number: ImageResize_0200
+ * @tc.name: test the golden values of a downscale
+ * @tc.desc: 1. shrink a 2x2 image and a 4x1 image
+ *           2. each output pixel is the rounded average of the pixels it covers
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0200, Function | SmallTest | Level0)
+{
+    const std::vector<uint8_t> in = { 0, 100, 200, 255 };
+    std::vector<uint8_t> out(1);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), 2, 2, out.data(), 1, 1, GRAY));
+    // (0 + 100 + 200 + 255) / 4 = 138.75
+    EXPECT_EQ(out, std::vector<uint8_t>({ 139 }));
+
+    out.resize(2);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), 4, 1, out.data(), 2, 1, GRAY));
+    EXPECT_EQ(out, std::vector<uint8_t>({ 50, 228 }));
+
+    // 3 to 2 covers one and a half input pixels per output pixel
+    const std::vector<uint8_t> three = { 0, 90, 180 };
+    ASSERT_TRUE(ImageResize::Resize(three.data(), 3, 1, out.data(), 2, 1, GRAY));
+    EXPECT_EQ(out, std::vector<uint8_t>({ 30, 150 }));
+}
+
+/**
+ * @tc.number: ImageResize_0300
+ * @tc.name: test the golden values of an upscale
+ * @tc.desc: 1. enlarge a 2x1 image and a 1x2 image
+ *           2. the output pixels are interpolated between the nearest input pixels
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0300, Function | SmallTest | Level0)
+{
+    const std::vector<uint8_t> in = { 0, 255 };
+    const std::vector<uint8_t> expected = { 0, 64, 191, 255 };
+    std::vector<uint8_t> out(4);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), 2, 1, out.data(), 4, 1, GRAY));
+    EXPECT_EQ(out, expected);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), 1, 2, out.data(), 1, 4, GRAY));
+    EXPECT_EQ(out, expected);
+
+    // a single pixel is repeated
+    const std::vector<uint8_t> pixel = { 10, 20, 30 };
+    std::vector<uint8_t> block(3 * 3 * RGB);
+    ASSERT_TRUE(ImageResize::Resize(pixel.data(), 1, 1, block.data(), 3, 3, RGB));
+    for (size_t i = 0; i < block.size(); ++i) {
+        EXPECT_EQ(block[i], pixel[i % RGB]);
+    }
+}
+
+/**
+ * @tc.number: ImageResize_0400
+ * @tc.name: test the identity and the constant images
+ * @tc.desc: 1. resize to the same size, and resize constant images to several sizes
+ *           2. the pixels are kept exactly, the RGBA image of the same size is copied without premultiplying
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0400, Function | SmallTest | Level0)
+{
+    std::mt19937 engine(RANDOM_SEED);
+    std::vector<uint8_t> in = RandomImage(37, 11, RGBA, engine);
+    std::vector<uint8_t> out(in.size());
+    ASSERT_TRUE(ImageResize::Resize(in.data(), 37, 11, out.data(), 37, 11, RGBA));
+    EXPECT_EQ(out, in);
+
+    const uint32_t sizes[] = { 1, 2, 3, 7, 16, 33 };
+    for (uint8_t value : { 0, 1, 128, 254, 255 }) {
+        std::vector<uint8_t> constant(33 * 7, value);
+        for (uint32_t width : sizes) {
+            for (uint32_t height : sizes) {
+                std::vector<uint8_t> resized(static_cast<size_t>(width) * height);
+                ASSERT_TRUE(ImageResize::Resize(constant.data(), 33, 7, resized.data(), width, height, GRAY));
+                EXPECT_TRUE(std::all_of(resized.begin(), resized.end(),
+                    [value](uint8_t pixel) { return pixel == value; }));
+            }
+        }
+    }
+}
+
+/**
+ * @tc.number: ImageResize_0500
+ * @tc.name: test the downscale and the upscale of odd sizes against the reference filter
+ * @tc.desc: 1. resize random images of odd sizes
+ *           2. the pixels differ from the double precision filter by at most one
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0500, Function | SmallTest | Level0)
+{
+    ExpectCloseToReference(7, 5, 3, 3, RGB);
+    ExpectCloseToReference(101, 67, 17, 13, RGB);
+    ExpectCloseToReference(512, 384, 123, 77, RGB);
+    ExpectCloseToReference(3, 5, 7, 9, RGB);
+    ExpectCloseToReference(13, 7, 128, 129, RGB);
+    ExpectCloseToReference(17, 31, 31, 17, RGB);
+}
+
+/**
+ * @tc.number: ImageResize_0600
+ * @tc.name: test the images of a single row or column
+ * @tc.desc: 1. resize 1xN and Nx1 images
+ *           2. the pixels differ from the double precision filter by at most one
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0600, Function | SmallTest | Level0)
+{
+    ExpectCloseToReference(1, 97, 1, 13, GRAY);
+    ExpectCloseToReference(97, 1, 13, 1, GRAY);
+    ExpectCloseToReference(1, 5, 1, 17, RGB);
+    ExpectCloseToReference(5, 1, 17, 1, RGB);
+    ExpectCloseToReference(1, 64, 3, 3, RGBA);
+    ExpectCloseToReference(64, 1, 1, 1, RGBA);
+}
+
+/**
+ * @tc.number: ImageResize_0700
+ * @tc.name: test the alpha channel
+ * @tc.desc: 1. resize RGBA images
+ *           2. the colors are filtered premultiplied by the alpha, which is resized on its own
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0700, Function | SmallTest | Level0)
+{
+    ExpectCloseToReference(64, 48, 24, 18, RGBA);
+    ExpectCloseToReference(9, 7, 40, 30, RGBA);
+
+    // transparent black with a random alpha keeps its colors black and its opaque areas opaque
+    std::mt19937 engine(RANDOM_SEED);
+    std::uniform_int_distribution<uint32_t> distribution(0, UINT8_MAX);
+    const uint32_t width = 45;
+    const uint32_t height = 21;
+    std::vector<uint8_t> in(width * height * RGBA, 0);
+    for (size_t i = RGBA - 1; i < in.size(); i += RGBA) {
+        in[i] = i < in.size() / 2 ? UINT8_MAX : static_cast<uint8_t>(distribution(engine));
+    }
+    const uint32_t outWidth = 15;
+    const uint32_t outHeight = 7;
+    std::vector<uint8_t> out(outWidth * outHeight * RGBA);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), width, height, out.data(), outWidth, outHeight, RGBA));
+    for (size_t i = 0; i < out.size(); ++i) {
+        if (i % RGBA != RGBA - 1) {
+            EXPECT_EQ(out[i], 0);
+        }
+    }
+    // the top three input rows are opaque, so is the top output row
+    for (uint32_t x = 0; x < outWidth; ++x) {
+        EXPECT_EQ(out[x * RGBA + RGBA - 1], UINT8_MAX);
+    }
+}
+
+/**
+ * @tc.number: ImageResize_0800
+ * @tc.name: test the SIMD accumulation against the scalar one
+ * @tc.desc: 1. accumulate random rows of every length up to MAX_ROW_SIZE with several weights
+ *           2. the sums equal the ones of a scalar loop
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0800, Function | SmallTest | Level0)
+{
+    std::mt19937 engine(RANDOM_SEED);
+    std::uniform_int_distribution<uint32_t> distribution(0, UINT8_MAX);
+    const uint16_t weights[] = { 0, 1, 255, 4096, WEIGHT_ONE - 1, WEIGHT_ONE };
+    for (uint32_t size = 0; size <= MAX_ROW_SIZE; ++size) {
+        std::vector<uint8_t> row(size);
+        std::vector<uint32_t> acc(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            acc[i] = distribution(engine) << 8;
+        }
+        std::vector<uint32_t> expected = acc;
+        for (uint16_t weight : weights) {
+            for (auto &value : row) {
+                value = static_cast<uint8_t>(distribution(engine));
+            }
+            ImageResize::AccumulateRow(row.data(), weight, acc.data(), size);
+            for (uint32_t i = 0; i < size; ++i) {
+                expected[i] += static_cast<uint32_t>(row[i]) * weight;
+            }
+        }
+        EXPECT_EQ(acc, expected) << "size " << size;
+    }
+}
+
+/**
+ * @tc.number: ImageResize_0900
+ * @tc.name: test the fixed-point taps
+ * @tc.desc: 1. calculate the taps of several scales
+ *           2. the weights of each output pixel sum to one and stay inside the input
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_0900, Function | SmallTest | Level0)
+{
+    const uint32_t sizes[] = { 1, 2, 3, 5, 16, 17, 100, 333 };
+    for (uint32_t inSize : sizes) {
+        for (uint32_t outSize : sizes) {
+            std::vector<ImageResize::FilterTaps> taps;
+            ImageResize::CalculateTaps(inSize, outSize, taps);
+            ASSERT_EQ(taps.size(), outSize);
+            for (const auto &tap : taps) {
+                uint32_t sum = 0;
+                for (uint16_t weight : tap.weights) {
+                    sum += weight;
+                }
+                EXPECT_EQ(sum, WEIGHT_ONE);
+                EXPECT_FALSE(tap.weights.empty());
+                EXPECT_LE(tap.start + tap.weights.size(), inSize);
+            }
+        }
+    }
+}
+
+/**
+ * @tc.number: ImageResize_1000
+ * @tc.name: test the colors of the transparent pixels
+ * @tc.desc: 1. resize RGBA images next to transparent pixels of another color
+ *           2. the hidden colors do not bleed into the visible ones
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_1000, Function | SmallTest | Level0)
+{
+    // opaque red next to transparent green gives half transparent red, not brown
+    const std::vector<uint8_t> in = { 255, 0, 0, 255, 0, 255, 0, 0 };
+    std::vector<uint8_t> out(RGBA);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), 2, 1, out.data(), 1, 1, RGBA));
+    EXPECT_EQ(out, std::vector<uint8_t>({ 255, 0, 0, 128 }));
+
+    // enlarging interpolates the alpha only, the visible color is kept
+    std::vector<uint8_t> enlarged(4 * RGBA);
+    ASSERT_TRUE(ImageResize::Resize(in.data(), 2, 1, enlarged.data(), 4, 1, RGBA));
+    EXPECT_EQ(enlarged, std::vector<uint8_t>({ 255, 0, 0, 255, 255, 0, 0, 191, 255, 0, 0, 64, 0, 0, 0, 0 }));
+
+    // a fully transparent output pixel has no color
+    const std::vector<uint8_t> hidden = { 10, 20, 30, 0, 40, 50, 60, 0 };
+    ASSERT_TRUE(ImageResize::Resize(hidden.data(), 2, 1, out.data(), 1, 1, RGBA));
+    EXPECT_EQ(out, std::vector<uint8_t>({ 0, 0, 0, 0 }));
+}
+
+/**
+ * @tc.number: ImageResize_1100
+ * @tc.name: test the premultiplication of every color and alpha
+ * @tc.desc: 1. premultiply rows holding every pair of a color and an alpha, then unpremultiply them
+ *           2. the colors are rounded like the scalar division, the alpha is kept
+ *           3. premultiplying the straight colors again restores the premultiplied ones
+ */
+HWTEST_F(DbmsImageResizeTest, ImageResize_1100, Function | SmallTest | Level0)
+{
+    const uint32_t width = UINT8_MAX + 1;
+    for (uint32_t alpha = 0; alpha <= UINT8_MAX; ++alpha) {
+        std::vector<uint8_t> in(width * RGBA);
+        for (uint32_t x = 0; x < width; ++x) {
+            in[x * RGBA] = static_cast<uint8_t>(x);
+            in[x * RGBA + 1] = static_cast<uint8_t>(UINT8_MAX - x);
+            in[x * RGBA + 2] = static_cast<uint8_t>(x * 7);
+            in[x * RGBA + RGBA - 1] = static_cast<uint8_t>(alpha);
+        }
+        std::vector<uint8_t> premultiplied(in.size());
+        ImageResize::PremultiplyRow(in.data(), premultiplied.data(), width);
+        ASSERT_EQ(premultiplied, Premultiply(in)) << "alpha " << alpha;
+
+        std::vector<uint8_t> straight = premultiplied;
+        ImageResize::UnpremultiplyRow(straight.data(), width);
+        EXPECT_EQ(Premultiply(straight), premultiplied) << "alpha " << alpha;
+    }
+}
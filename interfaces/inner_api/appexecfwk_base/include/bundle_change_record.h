@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_INTERFACES_INNERKITS_APPEXECFWK_BASE_INCLUDE_BUNDLE_CHANGE_RECORD_H
+#define FOUNDATION_APPEXECFWK_INTERFACES_INNERKITS_APPEXECFWK_BASE_INCLUDE_BUNDLE_CHANGE_RECORD_H
+
+#include <string>
+
+#include "bundle_constants.h"
+#include "parcel.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+enum class BundleChangeType : int32_t {
+    ADD = 0,
+    UPDATE,
+    REMOVE,
+    MODULE_REMOVE,
+    ABILITY_STATE_CHANGE,
+    APPLICATION_STATE_CHANGE,
+};
+
+struct BundleChangeRecord : public Parcelable {
+    // monotonically increasing sequence number assigned by bms
+    int64_t generation = 0;
+    BundleChangeType changeType = BundleChangeType::ADD;
+    int32_t userId = Constants::INVALID_USERID;
+    std::string bundleName;
+    std::string moduleName;
+    std::string abilityName;
+
+    bool ReadFromParcel(Parcel &parcel);
+    virtual bool Marshalling(Parcel &parcel) const override;
+    static BundleChangeRecord *Unmarshalling(Parcel &parcel);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_INTERFACES_INNERKITS_APPEXECFWK_BASE_INCLUDE_BUNDLE_CHANGE_RECORD_H
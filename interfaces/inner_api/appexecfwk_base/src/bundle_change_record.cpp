@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_change_record.h"
+
+#include "string_ex.h"
+
+#include "app_log_wrapper.h"
+#include "parcel_macro.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+bool BundleChangeRecord::ReadFromParcel(Parcel &parcel)
+{
+    generation = parcel.ReadInt64();
+    changeType = static_cast<BundleChangeType>(parcel.ReadInt32());
+    userId = parcel.ReadInt32();
+    bundleName = Str16ToStr8(parcel.ReadString16());
+    moduleName = Str16ToStr8(parcel.ReadString16());
+    abilityName = Str16ToStr8(parcel.ReadString16());
+    return true;
+}
+
+bool BundleChangeRecord::Marshalling(Parcel &parcel) const
+{
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int64, parcel, generation);
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, parcel, static_cast<int32_t>(changeType));
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, parcel, userId);
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(String16, parcel, Str8ToStr16(bundleName));
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(String16, parcel, Str8ToStr16(moduleName));
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(String16, parcel, Str8ToStr16(abilityName));
+    return true;
+}
+
+BundleChangeRecord *BundleChangeRecord::Unmarshalling(Parcel &parcel)
+{
+    BundleChangeRecord *record = new (std::nothrow) BundleChangeRecord();
+    if (record && !record->ReadFromParcel(parcel)) {
+        APP_LOGW("read BundleChangeRecord from parcel failed");
+        delete record;
+        record = nullptr;
+    }
+    return record;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
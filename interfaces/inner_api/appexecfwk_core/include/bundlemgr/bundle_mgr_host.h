@@ -549,6 +549,13 @@ private:
     ErrCode HandleGetAllDependentModuleNames(Parcel &data, Parcel &reply);
 
     ErrCode HandleGetSandboxBundleInfo(Parcel &data, Parcel &reply);
+    /**
+     * @brief Handles the GetBundleChanges function called from a IBundleMgr proxy object.
+     * @param data Indicates the data to be read.
+     * @param reply Indicates the reply to be sent;
+     * @return Returns ERR_OK if called successfully; returns error code otherwise.
+     */
+    ErrCode HandleGetBundleChanges(Parcel &data, Parcel &reply);
 
 private:
     /**
@@ -19,6 +19,7 @@
 #include "ability_info.h"
 #include "appexecfwk_errors.h"
 #include "application_info.h"
+#include "bundle_change_record.h"
 #include "bundle_constants.h"
 #include "bundle_info.h"
 #include "bundle_pack_info.h"
@@ -957,6 +958,21 @@ public:
     {
         return false;
     }
+    /**
+     * @brief Obtains the bundle changes recorded after a given generation.
+     * @param generation Indicates the latest generation already observed by the caller.
+     * @param userId Indicates the user ID.
+     * @param changeRecords Indicates the obtained BundleChangeRecord objects, ordered by generation.
+     * @param currentGeneration Indicates the latest generation recorded by the service.
+     * @param needFullSync Indicates whether the requested changes are no longer retained,
+     *                     in which case the caller should re-query all infos instead.
+     * @return Returns true if this function is successfully called; returns false otherwise.
+     */
+    virtual bool GetBundleChanges(int64_t generation, int32_t userId,
+        std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync)
+    {
+        return false;
+    }
 
     enum Message : uint32_t {
         GET_APPLICATION_INFO = 0,
@@ -1042,6 +1058,7 @@ public:
         IMPLICIT_QUERY_INFO_BY_PRIORITY,
         GET_ALL_DEPENDENT_MODULE_NAMES,
         GET_SANDBOX_APP_BUNDLE_INFO,
+        GET_BUNDLE_CHANGES,
     };
 };
 }  // namespace AppExecFwk
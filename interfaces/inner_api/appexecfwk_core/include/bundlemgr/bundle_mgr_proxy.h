@@ -677,6 +677,17 @@ public:
      */
     virtual bool SetModuleUpgradeFlag(
         const std::string &bundleName, const std::string &moduleName, int32_t upgradeFlag) override;
+    /**
+     * @brief Obtains the bundle changes recorded after a given generation through the proxy object.
+     * @param generation Indicates the latest generation already observed by the caller.
+     * @param userId Indicates the user ID.
+     * @param changeRecords Indicates the obtained BundleChangeRecord objects, ordered by generation.
+     * @param currentGeneration Indicates the latest generation recorded by the service.
+     * @param needFullSync Indicates whether the caller should re-query all infos instead.
+     * @return Returns true if this function is successfully called; returns false otherwise.
+     */
+    virtual bool GetBundleChanges(int64_t generation, int32_t userId,
+        std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync) override;
 
 private:
     /**
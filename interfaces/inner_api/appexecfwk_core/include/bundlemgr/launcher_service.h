@@ -24,6 +24,7 @@
 #include "system_ability_definition.h"
 #include "if_system_ability_manager.h"
 #include "iservice_registry.h"
+#include "bundle_change_record.h"
 #include "bundle_monitor.h"
 #include "bundle_status_callback_interface.h"
 #include "launcher_ability_info.h"
@@ -107,6 +108,17 @@ public:
      * @return Returns true if the function is successfully called; returns false otherwise.
      */
     virtual bool GetAllLauncherAbilityInfos(int32_t userId, std::vector<LauncherAbilityInfo> &launcherAbilityInfos);
+    /**
+     * @brief Obtains the bundle changes after a given generation, so that the launcher refreshes incrementally.
+     * @param generation Indicates the latest generation already observed by the launcher.
+     * @param userId Indicates the id for the user.
+     * @param changeRecords List of BundleChangeRecord objects if obtained.
+     * @param currentGeneration Indicates the latest generation recorded by the service.
+     * @param needFullSync Indicates whether the launcher should call GetAllLauncherAbilityInfos instead.
+     * @return Returns true if the function is successfully called; returns false otherwise.
+     */
+    virtual bool GetBundleChanges(int64_t generation, int32_t userId,
+        std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync);
 
 private:
     void init();
@@ -174,6 +174,7 @@ void BundleMgrHost::init()
     funcMap_.emplace(IBundleMgr::Message::GET_ALL_DEPENDENT_MODULE_NAMES,
         &BundleMgrHost::HandleGetAllDependentModuleNames);
     funcMap_.emplace(IBundleMgr::Message::GET_SANDBOX_APP_BUNDLE_INFO, &BundleMgrHost::HandleGetSandboxBundleInfo);
+    funcMap_.emplace(IBundleMgr::Message::GET_BUNDLE_CHANGES, &BundleMgrHost::HandleGetBundleChanges);
 }
 
 int BundleMgrHost::OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
@@ -1738,6 +1739,33 @@ ErrCode BundleMgrHost::HandleGetSandboxBundleInfo(Parcel &data, Parcel &reply)
     return ERR_OK;
 }
 
+ErrCode BundleMgrHost::HandleGetBundleChanges(Parcel &data, Parcel &reply)
+{
+    HITRACE_METER_NAME(HITRACE_TAG_APP, __PRETTY_FUNCTION__);
+    int64_t generation = data.ReadInt64();
+    int32_t userId = data.ReadInt32();
+    std::vector<BundleChangeRecord> changeRecords;
+    int64_t currentGeneration = 0;
+    bool needFullSync = false;
+    bool ret = GetBundleChanges(generation, userId, changeRecords, currentGeneration, needFullSync);
+    if (!reply.WriteBool(ret)) {
+        APP_LOGE("write result failed");
+        return ERR_APPEXECFWK_PARCEL_ERROR;
+    }
+    if (!ret) {
+        return ERR_OK;
+    }
+    if (!reply.WriteInt64(currentGeneration) || !reply.WriteBool(needFullSync)) {
+        APP_LOGE("write generation failed");
+        return ERR_APPEXECFWK_PARCEL_ERROR;
+    }
+    if (!WriteParcelableVector(changeRecords, reply)) {
+        APP_LOGE("write change records failed");
+        return ERR_APPEXECFWK_PARCEL_ERROR;
+    }
+    return ERR_OK;
+}
+
 template<typename T>
 bool BundleMgrHost::WriteParcelableVector(std::vector<T> &parcelableVector, Parcel &reply)
 {
@@ -15,6 +15,8 @@
 
 #include "bundle_mgr_proxy.h"
 
+#include <cinttypes>
+
 #include "ipc_types.h"
 #include "parcel.h"
 #include "string_ex.h"
@@ -2499,6 +2501,48 @@ bool BundleMgrProxy::GetAllDependentModuleNames(const std::string &bundleName, c
     return true;
 }
 
+bool BundleMgrProxy::GetBundleChanges(int64_t generation, int32_t userId,
+    std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync)
+{
+    HITRACE_METER_NAME(HITRACE_TAG_APP, __PRETTY_FUNCTION__);
+    APP_LOGD("begin to GetBundleChanges since %{public}" PRId64, generation);
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        APP_LOGE("fail to GetBundleChanges due to write InterfaceToken fail");
+        return false;
+    }
+    if (!data.WriteInt64(generation)) {
+        APP_LOGE("fail to GetBundleChanges due to write generation fail");
+        return false;
+    }
+    if (!data.WriteInt32(userId)) {
+        APP_LOGE("fail to GetBundleChanges due to write userId fail");
+        return false;
+    }
+
+    MessageParcel reply;
+    if (!SendTransactCmd(IBundleMgr::Message::GET_BUNDLE_CHANGES, data, reply)) {
+        APP_LOGE("fail to GetBundleChanges from server");
+        return false;
+    }
+    if (!reply.ReadBool()) {
+        APP_LOGE("reply result false");
+        return false;
+    }
+    currentGeneration = reply.ReadInt64();
+    needFullSync = reply.ReadBool();
+    int32_t recordSize = reply.ReadInt32();
+    for (int32_t i = 0; i < recordSize; i++) {
+        std::unique_ptr<BundleChangeRecord> record(reply.ReadParcelable<BundleChangeRecord>());
+        if (record == nullptr) {
+            APP_LOGE("Read change records failed");
+            return false;
+        }
+        changeRecords.emplace_back(*record);
+    }
+    return true;
+}
+
 template<typename T>
 bool BundleMgrProxy::GetParcelableInfo(IBundleMgr::Message code, MessageParcel &data, T &parcelableInfo)
 {
@@ -345,5 +345,21 @@ bool LauncherService::GetShortcutInfos(
     }
     return true;
 }
+
+bool LauncherService::GetBundleChanges(int64_t generation, int32_t userId,
+    std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync)
+{
+    APP_LOGD("GetBundleChanges called");
+    auto iBundleMgr = GetBundleMgr();
+    if (iBundleMgr == nullptr) {
+        APP_LOGE("can not get iBundleMgr");
+        return false;
+    }
+    if (!iBundleMgr->GetBundleChanges(generation, userId, changeRecords, currentGeneration, needFullSync)) {
+        APP_LOGE("Get bundle changes failed");
+        return false;
+    }
+    return true;
+}
 }  // namespace AppExecFwk
 }  // namespace OHOS
\ No newline at end of file
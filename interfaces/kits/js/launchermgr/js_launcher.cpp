@@ -48,6 +48,10 @@ struct AsyncHandleBundleContext {
     OHOS::sptr<BundleStatusCallback> bundleStatusCallback = nullptr;
     std::vector<OHOS::AppExecFwk::LauncherAbilityInfo> launcherAbilityInfos;
     std::vector<OHOS::AppExecFwk::ShortcutInfo> shortcutInfos;
+    std::vector<OHOS::AppExecFwk::BundleChangeRecord> changeRecords;
+    int64_t generation = 0;
+    int64_t currentGeneration = 0;
+    bool needFullSync = false;
     std::string bundleName;
     std::string className;
     int32_t userId = 0;
@@ -961,6 +965,147 @@ static napi_value JSGetShortcutInfos(napi_env env, napi_callback_info info)
     return promise;
 }
 
+static void ConvertBundleChanges(napi_env env, napi_value result, const AsyncHandleBundleContext &context)
+{
+    napi_value nGeneration;
+    NAPI_CALL_RETURN_VOID(env, napi_create_int64(env, context.currentGeneration, &nGeneration));
+    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, result, "generation", nGeneration));
+
+    napi_value nNeedFullSync;
+    NAPI_CALL_RETURN_VOID(env, napi_get_boolean(env, context.needFullSync, &nNeedFullSync));
+    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, result, "needFullSync", nNeedFullSync));
+
+    napi_value nChanges;
+    NAPI_CALL_RETURN_VOID(env, napi_create_array(env, &nChanges));
+    size_t index = 0;
+    for (const auto &record : context.changeRecords) {
+        napi_value nRecord;
+        NAPI_CALL_RETURN_VOID(env, napi_create_object(env, &nRecord));
+        napi_value nValue;
+        NAPI_CALL_RETURN_VOID(env, napi_create_int64(env, record.generation, &nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, nRecord, "generation", nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, static_cast<int32_t>(record.changeType), &nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, nRecord, "changeType", nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, record.userId, &nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, nRecord, "userId", nValue));
+        NAPI_CALL_RETURN_VOID(env,
+            napi_create_string_utf8(env, record.bundleName.c_str(), NAPI_AUTO_LENGTH, &nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, nRecord, "bundleName", nValue));
+        NAPI_CALL_RETURN_VOID(env,
+            napi_create_string_utf8(env, record.moduleName.c_str(), NAPI_AUTO_LENGTH, &nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, nRecord, "moduleName", nValue));
+        NAPI_CALL_RETURN_VOID(env,
+            napi_create_string_utf8(env, record.abilityName.c_str(), NAPI_AUTO_LENGTH, &nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, nRecord, "abilityName", nValue));
+        NAPI_CALL_RETURN_VOID(env, napi_set_element(env, nChanges, index, nRecord));
+        index++;
+    }
+    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, result, "changes", nChanges));
+}
+
+static bool InnerJSGetBundleChanges(AsyncHandleBundleContext &context)
+{
+    auto launcher = GetLauncherService();
+    if (launcher == nullptr) {
+        APP_LOGE("can not get launcher");
+        return false;
+    }
+    auto result = launcher->GetBundleChanges(context.generation, context.userId,
+        context.changeRecords, context.currentGeneration, context.needFullSync);
+    if (!result) {
+        APP_LOGE("GetBundleChanges call error");
+        return false;
+    }
+    return true;
+}
+
+static napi_value JSGetBundleChanges(napi_env env, napi_callback_info info)
+{
+    size_t argc = INDEX_THREE;
+    napi_value argv[INDEX_THREE] = { 0 };
+    size_t requireArgc = INDEX_TWO;
+    napi_value thisArg = nullptr;
+    void *data = nullptr;
+
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisArg, &data));
+    NAPI_ASSERT(env, argc >= requireArgc, "requires 2 parameter");
+    AsyncHandleBundleContext *asyncCallbackInfo = new AsyncHandleBundleContext();
+    asyncCallbackInfo->env = env;
+
+    for (size_t i = 0; i < argc; ++i) {
+        napi_valuetype valueType = napi_undefined;
+        napi_typeof(env, argv[i], &valueType);
+        if ((i == 0) && (valueType == napi_number)) {
+            napi_get_value_int64(env, argv[i], &asyncCallbackInfo->generation);
+        } else if ((i == INDEX_ONE) && (valueType == napi_number)) {
+            napi_get_value_int32(env, argv[i], &asyncCallbackInfo->userId);
+        } else if ((i == INDEX_TWO) && (valueType == napi_function)) {
+            napi_create_reference(env, argv[i], NAPI_RETURN_ONE, &asyncCallbackInfo->callbackRef);
+            break;
+        } else {
+            asyncCallbackInfo->err = OPERATION_TYPE_MIAMATCH;
+            asyncCallbackInfo->message = "type mismatch";
+        }
+    }
+    napi_value promise = nullptr;
+    if (asyncCallbackInfo->callbackRef == nullptr) {
+        napi_create_promise(env, &asyncCallbackInfo->deferred, &promise);
+    } else {
+        napi_get_undefined(env,  &promise);
+    }
+    napi_value resource = nullptr;
+    napi_create_string_utf8(env, "JSGetBundleChanges", NAPI_AUTO_LENGTH, &resource);
+
+    napi_create_async_work(
+        env, nullptr, resource,
+        [](napi_env env, void* data) {
+            AsyncHandleBundleContext* asyncCallbackInfo = (AsyncHandleBundleContext*)data;
+            if (!asyncCallbackInfo->err) {
+                asyncCallbackInfo->ret = InnerJSGetBundleChanges(*asyncCallbackInfo);
+            }
+        },
+        [](napi_env env, napi_status status, void* data) {
+            AsyncHandleBundleContext* asyncCallbackInfo = (AsyncHandleBundleContext*)data;
+            napi_value result[INDEX_TWO] = { 0 };
+            // wrap result
+            if (asyncCallbackInfo->err) {
+                napi_create_int32(env, asyncCallbackInfo->err, &result[0]);
+                napi_get_undefined(env, &result[INDEX_ONE]);
+            } else {
+                if (asyncCallbackInfo->ret) {
+                    napi_create_uint32(env, OPERATION_SUCESS, &result[0]);
+                    napi_create_object(env, &result[INDEX_ONE]);
+                    ConvertBundleChanges(env, result[INDEX_ONE], *asyncCallbackInfo);
+                } else {
+                    napi_create_uint32(env, OPERATION_FAILED, &result[0]);
+                    napi_get_undefined(env, &result[INDEX_ONE]);
+                }
+            }
+            // return callback or promise
+            if (asyncCallbackInfo->deferred) {
+                if (asyncCallbackInfo->ret) {
+                    napi_resolve_deferred(env, asyncCallbackInfo->deferred, result[INDEX_ONE]);
+                } else {
+                    napi_reject_deferred(env, asyncCallbackInfo->deferred, result[0]);
+                }
+            } else {
+                napi_value callback = nullptr;
+                napi_value callResult = 0;
+                napi_value undefined = 0;
+                napi_get_reference_value(env, asyncCallbackInfo->callbackRef, &callback);
+                napi_call_function(env, undefined, callback, sizeof(result) / sizeof(result[0]), result, &callResult);
+                napi_delete_reference(env, asyncCallbackInfo->callbackRef);
+            }
+            napi_delete_async_work(env, asyncCallbackInfo->asyncWork);
+            delete asyncCallbackInfo;
+            asyncCallbackInfo = nullptr;
+        },
+        (void*)asyncCallbackInfo, &asyncCallbackInfo->asyncWork);
+    napi_queue_async_work(env, asyncCallbackInfo->asyncWork);
+
+    return promise;
+}
+
 static napi_value LauncherServiceExport(napi_env env, napi_value exports)
 {
     static napi_property_descriptor launcherDesc[] = {
@@ -969,6 +1114,7 @@ static napi_value LauncherServiceExport(napi_env env, napi_value exports)
         DECLARE_NAPI_FUNCTION("getAllLauncherAbilityInfos", JSGetAllLauncherAbilityInfos),
         DECLARE_NAPI_FUNCTION("getLauncherAbilityInfos", JSGetLauncherAbilityInfos),
         DECLARE_NAPI_FUNCTION("getShortcutInfos", JSGetShortcutInfos),
+        DECLARE_NAPI_FUNCTION("getBundleChanges", JSGetBundleChanges),
     };
 
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(launcherDesc) / sizeof(launcherDesc[0]), launcherDesc));
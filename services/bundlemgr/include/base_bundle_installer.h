@@ -29,6 +29,7 @@
 #include "event_report.h"
 #include "inner_bundle_info.h"
 #include "install_param.h"
+#include "ipc/installd_interface.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -36,6 +37,16 @@ class BaseBundleInstaller {
 public:
     BaseBundleInstaller();
     virtual ~BaseBundleInstaller();
+    /**
+     * @brief Add the installed preinstall bundles to a new user in bulk. The access tokens and data
+     *        directories are created concurrently and the bundle infos are saved in one batch.
+     * @param bundleNames Indicates the bundle names of the preinstall applications.
+     * @param userId Indicates the new user.
+     * @param uninstalledBundleNames Indicates the bundles which are not installed yet and need a normal install.
+     * @return Returns ERR_OK if every installed bundle is added to the user; returns the first error otherwise.
+     */
+    ErrCode ProvisionInstalledBundles(const std::vector<std::string> &bundleNames, int32_t userId,
+        std::vector<std::string> &uninstalledBundleNames);
 
 protected:
     enum class InstallerState {
@@ -241,13 +252,6 @@ private:
      */
     ErrCode RemoveModuleAndDataDir(const InnerBundleInfo &info,
         const std::string &modulePackage, int32_t userId, bool isKeepData) const;
-    /**
-     * @brief Parse the bundle config.json file.
-     * @param bundleFilePath Indicates the HAP file path.
-     * @param InnerBundleInfo Indicates the InnerBundleInfo object of a bundle.
-     * @return Returns ERR_OK if the bundle parsed successfully; returns error code otherwise.
-     */
-    ErrCode ParseBundleInfo(const std::string &bundleFilePath, InnerBundleInfo &info, BundlePackInfo &packInfo) const;
     /**
      * @brief Remove the current installing module directory.
      * @param info Indicates the InnerBundleInfo object of a bundle under installing.
@@ -337,7 +341,7 @@ private:
     ErrCode CheckMultipleHapsSignInfo(const std::vector<std::string> &bundlePaths, const InstallParam &installParam,
         std::vector<Security::Verify::HapVerifyResult> &hapVerifyRes) const;
     /**
-     * @brief To parse hap files and to obtain innerBundleInfo of each hap.
+     * @brief To parse hap files and to obtain innerBundleInfo of each hap, the haps are parsed concurrently.
      * @param bundlePaths Indicates the file paths of all HAP packages.
      * @param installParam Indicates the install parameters.
      * @param appType Indicates the app type of the hap.
@@ -460,6 +464,9 @@ private:
 private:
     ErrCode CreateBundleCodeDir(InnerBundleInfo &info) const;
     ErrCode CreateBundleDataDir(InnerBundleInfo &info) const;
+    ErrCode GetCreateDirParam(const InnerBundleInfo &info, InnerBundleUserInfo &newInnerBundleUserInfo,
+        CreateDirParam &createDirParam) const;
+    void UpdateBundleDataDirInfo(InnerBundleInfo &info, const InnerBundleUserInfo &newInnerBundleUserInfo) const;
     ErrCode RemoveModuleDataDir(const InnerBundleInfo &info, const std::string &modulePackage,
         int32_t userId) const;
     ErrCode RemoveBundleCodeDir(const InnerBundleInfo &info) const;
@@ -17,22 +17,27 @@
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_DATA_MGR_H
 
 #include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
-#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 #include "want.h"
 
 #include "ability_info.h"
 #include "application_info.h"
+#include "bundle_change_record.h"
 #include "bundle_data_storage_interface.h"
+#include "bundle_info_index.h"
+#include "bundle_mutex_registry.h"
 #include "bundle_promise.h"
 #include "bundle_sandbox_data_mgr.h"
 #include "bundle_state_storage.h"
 #include "bundle_status_callback_interface.h"
+#include "bundle_status_notifier.h"
 #include "common_event_manager.h"
 #include "distributed_data_storage.h"
 #include "inner_bundle_info.h"
@@ -45,6 +50,7 @@
 #ifdef GLOBAL_RESMGR_ENABLE
 #include "resource_manager.h"
 #endif
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -314,6 +320,11 @@ public:
      */
     std::string GetAbilityLabel(const std::string &bundleName, const std::string &moduleName,
         const std::string &abilityName) const;
+    /**
+     * @brief Drop the labels and icons resolved for the previous system locale and resolve them again
+     *        in background for the bundles which were cached.
+     */
+    void OnLocaleChanged();
     /**
      * @brief Obtains the Want for starting the main ability of an application based on the given bundle name.
      * @param bundleName Indicates the bundle name.
@@ -404,6 +415,14 @@ public:
      * @return Returns true if this function is successfully called; returns false otherwise.
      */
     bool UnregisterBundleStatusCallback();
+    /**
+     * @brief Get the delivery statistics of a bundle status callback.
+     * @param bundleStatusCallback Indicates the registered callback.
+     * @param stats Indicates the obtained statistics.
+     * @return Returns true if the callback is registered; returns false otherwise.
+     */
+    bool GetBundleStatusDeliveryStats(
+        const sptr<IBundleStatusCallback> &bundleStatusCallback, BundleStatusDeliveryStats &stats) const;
     /**
      * @brief Notify when the installation, update, or uninstall state of an application changes.
      * @param bundleName Indicates the name of the bundle whose state has changed.
@@ -416,12 +435,32 @@ public:
      */
     bool NotifyBundleStatus(const std::string &bundleName, const std::string &modulePackage,
         const std::string &mainAbility, const ErrCode resultCode, const NotifyType type, const int32_t &uid);
+    /**
+     * @brief Append a successful bundle change to the bounded change record ring.
+     * @param bundleName Indicates the name of the bundle whose state has changed.
+     * @param moduleName Indicates the module name of the bundle whose state has changed.
+     * @param abilityName Indicates the ability name of the bundle whose state has changed.
+     * @param type Indicates the NotifyType object.
+     * @param userId Indicates the user ID the change belongs to.
+     */
+    void RecordBundleChange(const std::string &bundleName, const std::string &moduleName,
+        const std::string &abilityName, const NotifyType type, int32_t userId);
+    /**
+     * @brief Obtains the bundle changes recorded after a given generation.
+     * @param generation Indicates the latest generation already observed by the caller.
+     * @param userId Indicates the user ID.
+     * @param changeRecords Indicates the obtained BundleChangeRecord objects, ordered by generation.
+     * @param currentGeneration Indicates the latest generation recorded.
+     * @param needFullSync Indicates whether the requested changes have been dropped from the ring.
+     */
+    void GetBundleChanges(int64_t generation, int32_t userId, std::vector<BundleChangeRecord> &changeRecords,
+        int64_t &currentGeneration, bool &needFullSync) const;
     /**
      * @brief Get a mutex for locking by bundle name.
      * @param bundleName Indicates the bundle name.
-     * @return Returns a reference of mutex that for locing by bundle name.
+     * @return Returns the mutex for locking by bundle name, keep it while it is locked.
      */
-    std::mutex &GetBundleMutex(const std::string &bundleName);
+    std::shared_ptr<std::mutex> GetBundleMutex(const std::string &bundleName);
     /**
      * @brief Obtains the provision Id based on a given bundle name.
      * @param bundleName Indicates the application bundle name to be queried.
@@ -659,6 +698,16 @@ public:
 
     bool AddInnerBundleUserInfo(const std::string &bundleName, const InnerBundleUserInfo& newUserInfo);
 
+    /**
+     * @brief Add user infos to several bundles, the bundles are saved to the storage in one batch.
+     *        If the batch can not be saved, none of the bundles is changed.
+     * @param newUserInfos Indicates the user info to add, keyed by bundle name.
+     * @param failedBundleNames Indicates the bundles the user info is not added to.
+     * @return Returns true if all of them are added and saved; returns false otherwise.
+     */
+    bool AddInnerBundleUserInfos(const std::map<std::string, InnerBundleUserInfo> &newUserInfos,
+        std::vector<std::string> &failedBundleNames);
+
     bool RemoveInnerBundleUserInfo(const std::string &bundleName, int32_t userId);
 
 #ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
@@ -699,6 +748,11 @@ public:
      * @return Returns the space size of all free install bundles.
      */
     int64_t GetAllFreeInstallBundleSpaceSize() const;
+    /**
+     * @brief Forget the space size of a bundle, it is measured again when it is queried next time.
+     * @param bundleName Indicates the application bundle name whose files are changed.
+     */
+    void DeleteBundleSpaceSize(const std::string &bundleName) const;
 #endif
     bool GetAllDependentModuleNames(const std::string &bundleName, const std::string &moduleName,
         std::vector<std::string> &dependentModuleNames);
@@ -783,9 +837,85 @@ private:
         std::vector<ExtensionAbilityInfo> &extensionInfos) const;
     void GetMatchExtensionInfos(const Want &want, int32_t flags, const int32_t &userId, const InnerBundleInfo &info,
         std::vector<ExtensionAbilityInfo> &einfos) const;
+    /**
+     * @brief Index the abilities and extensions of a bundle again, bundleInfoMutex_ must be held by the caller.
+     * @param bundleName Indicates the key of the bundle in bundleInfos_, the bundle is removed from
+     *                   the indexes if it is not installed.
+     */
+    void UpdateInfoIndexes(const std::string &bundleName);
+    /**
+     * @brief Find the InnerBundleInfo which can be queried with the flags, bundleInfoMutex_ must be held by the caller.
+     * @param bundleName Indicates the application bundle name to be queried.
+     * @param flags Indicates the information contained in the AbilityInfo object to be returned.
+     * @param userId Indicates the user ID.
+     * @return Returns the InnerBundleInfo in bundleInfos_ if it can be queried; returns nullptr otherwise.
+     */
+    const InnerBundleInfo *FindInnerBundleInfoWithFlags(
+        const std::string &bundleName, const int32_t flags, int32_t userId) const;
+    static bool GetDataAbilityUriAuthority(const std::string &abilityUri, std::string &authority);
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+    // measured space of a bundle, dropped whenever the files of the bundle are changed by BMS
+    struct BundleSpaceSize {
+        int32_t userId = Constants::INVALID_USERID;
+        std::string dataDir;
+        // the code only changes with the install, the data grows while the bundle runs
+        int64_t codeSize = 0;
+        int64_t dataSize = 0;
+        int64_t dataSizeTime = 0;
+    };
+#endif
 #ifdef GLOBAL_RESMGR_ENABLE
+    // resolved resources of a bundle, dropped whenever the install state of the bundle changes
+    struct BundleResourceCache {
+        // serializes the use of the members, resolving resources is done without bundleInfoMutex_
+        std::mutex mutex;
+        std::vector<std::string> moduleResPaths;
+        // the system locale when the cache is created
+        std::string locale;
+        std::shared_ptr<Global::Resource::ResourceManager> resourceManager;
+        // key:labelId
+        std::unordered_map<uint32_t, std::string> labels;
+#ifdef BUNDLE_FRAMEWORK_GRAPHICS
+        // key:iconId
+        std::unordered_map<uint32_t, std::shared_ptr<Media::PixelMap>> icons;
+#endif
+        uint64_t lastUsedTime = 0;
+    };
+
     std::shared_ptr<Global::Resource::ResourceManager> GetResourceManager(
-        const AppExecFwk::BundleInfo &bundleInfo) const;
+        const std::vector<std::string> &moduleResPaths, const std::string &locale) const;
+    /**
+     * @brief Get the resource cache of a bundle, bundleInfoMutex_ must be held by the caller.
+     * @param innerBundleInfo Indicates the InnerBundleInfo object of the bundle.
+     * @return Returns the resource cache of the bundle.
+     */
+    std::shared_ptr<BundleResourceCache> GetBundleResourceCache(const InnerBundleInfo &innerBundleInfo) const;
+    std::shared_ptr<Global::Resource::ResourceManager> GetCachedResourceManager(
+        BundleResourceCache &resourceCache) const;
+    /**
+     * @brief Get a label from the resource cache, resolve and add it if it is not cached.
+     * @param resourceCache Indicates the resource cache of the bundle, its mutex must be held by the caller.
+     * @param labelId Indicates the resource id of the label.
+     * @return Returns the label if it is resolved; returns empty string otherwise.
+     */
+    std::string GetCachedLabel(BundleResourceCache &resourceCache, uint32_t labelId) const;
+#ifdef BUNDLE_FRAMEWORK_GRAPHICS
+    /**
+     * @brief Get an icon from the resource cache, decode and add it if it is not cached.
+     * @param resourceCache Indicates the resource cache of the bundle, its mutex must be held by the caller.
+     * @param iconId Indicates the resource id of the icon.
+     * @return Returns the icon if it is decoded; returns nullptr otherwise.
+     */
+    std::shared_ptr<Media::PixelMap> GetCachedIcon(BundleResourceCache &resourceCache, uint32_t iconId) const;
+#endif
+    void DeleteBundleResourceCache(const std::string &bundleName) const;
+    /**
+     * @brief Queue bundles whose labels and icons are resolved in background, bundleInfoMutex_ may be held.
+     * @param bundleNames Indicates the names of the bundles.
+     */
+    void PostResourceCacheWarmUp(const std::vector<std::string> &bundleNames);
+    void RunResourceCacheWarmUp();
+    void WarmUpBundleResourceCache(const std::string &bundleName);
 #endif
 #ifdef BUNDLE_FRAMEWORK_GRAPHICS
     std::shared_ptr<Media::PixelMap> LoadImageFile(const std::string &path) const;
@@ -803,25 +933,54 @@ private:
     mutable std::mutex bundleInfoMutex_;
     mutable std::mutex stateMutex_;
     mutable std::mutex bundleIdMapMutex_;
-    mutable std::mutex callbackMutex_;
-    mutable std::shared_mutex bundleMutex_;
     mutable std::mutex multiUserIdSetMutex_;
     mutable std::mutex preInstallInfoMutex_;
+    mutable std::mutex changeRecordMutex_;
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+    // always lock bundleInfoMutex_ before spaceSizeMutex_
+    mutable std::mutex spaceSizeMutex_;
+    // increased when a size is deleted, a size measured across the deletion is not saved
+    mutable uint64_t spaceSizeGeneration_ = 0;
+    // key:bundleName
+    mutable std::unordered_map<std::string, BundleSpaceSize> spaceSizes_;
+#endif
+#ifdef GLOBAL_RESMGR_ENABLE
+    // always lock bundleInfoMutex_ before resourceCacheMutex_
+    mutable std::mutex resourceCacheMutex_;
+    mutable uint64_t resourceCacheClock_ = 0;
+    // key:bundleName
+    mutable std::unordered_map<std::string, std::shared_ptr<BundleResourceCache>> resourceCaches_;
+    // the system locale the new caches are resolved for
+    std::string resourceLocale_;
+    // bundles waiting for the warm-up, at most as many as the caches
+    std::deque<std::string> warmUpBundleNames_;
+    bool warmUpRunning_ = false;
+    // resolves the resources of newly installed bundles before they are queried
+    ThreadPool resourceWarmUpPool_;
+#endif
     bool initialUserFlag_ = false;
     // using for locking by bundleName
-    std::unordered_map<std::string, std::mutex> bundleMutexMap_;
+    BundleMutexRegistry bundleMutexRegistry_;
     // using for generating bundleId
     // key:bundleId
     // value:bundleName
     std::map<int32_t, std::string> bundleIdMap_;
     // save all created users.
     std::set<int32_t> multiUserIdsSet_;
-    // use vector because these functions using for IPC, the bundleName may duplicate
-    std::vector<sptr<IBundleStatusCallback>> callbackList_;
+    // delivers the bundle status callbacks, the bundleName of the callbacks may duplicate
+    std::shared_ptr<BundleStatusNotifier> statusNotifier_;
+    // bounded ring of the latest bundle changes, ordered by generation
+    std::deque<BundleChangeRecord> changeRecords_;
+    // generation of the latest change, seeded from the clock so that it never repeats across restarts
+    int64_t changeGeneration_ = 0;
     // all installed bundles
     // key:bundleName
     // value:innerbundleInfo
     std::map<std::string, InnerBundleInfo> bundleInfos_;
+    // updated with bundleInfos_, the data abilities are keyed by their uri without the prefix
+    BundleInfoIndex<std::string> abilityUriIndex_;
+    BundleInfoIndex<std::string> extensionUriIndex_;
+    BundleInfoIndex<ExtensionAbilityType> extensionTypeIndex_;
     // key:bundle name
     std::map<std::string, InstallState> installStates_;
     // current-status:previous-statue pair
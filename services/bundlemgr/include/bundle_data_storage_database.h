@@ -43,6 +43,12 @@ public:
      * @return Returns true if the data is successfully saved; returns false otherwise.
      */
     virtual bool SaveStorageBundleInfo(const InnerBundleInfo &innerBundleInfo);
+    /**
+     * @brief Save the data of several bundles to KvStore in one batch.
+     * @param innerBundleInfos Indicates the InnerBundleInfo objects to be save.
+     * @return Returns true if the data is successfully saved; returns false otherwise.
+     */
+    virtual bool SaveStorageBundleInfos(const std::vector<InnerBundleInfo> &innerBundleInfos) override;
     /**
      * @brief Delete the bundle data corresponding to the device Id of the bundle name to KvStore.
      * @param innerBundleInfo Indicates the InnerBundleInfo object to be Delete.
@@ -17,6 +17,7 @@
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_IBUNDLE_DATA_STORAGE_H
 
 #include <map>
+#include <vector>
 
 #include "inner_bundle_info.h"
 
@@ -38,6 +39,19 @@ public:
      * @return Returns true if this function is successfully called; returns false otherwise.
      */
     virtual bool SaveStorageBundleInfo(const InnerBundleInfo &innerBundleInfo) = 0;
+    /**
+     * @brief Save the data of several bundles, storages supporting batches write them at once.
+     * @param innerBundleInfos Indicates the InnerBundleInfo objects to be save.
+     * @return Returns true if all of them are saved; returns false otherwise.
+     */
+    virtual bool SaveStorageBundleInfos(const std::vector<InnerBundleInfo> &innerBundleInfos)
+    {
+        bool ret = true;
+        for (const auto &innerBundleInfo : innerBundleInfos) {
+            ret = SaveStorageBundleInfo(innerBundleInfo) && ret;
+        }
+        return ret;
+    }
     /**
      * @brief Delete the bundle data corresponding to the device Id of the bundle name to KvStore.
      * @param innerBundleInfo Indicates the InnerBundleInfo object to be Delete.
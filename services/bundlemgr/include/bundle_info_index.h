@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_INFO_INDEX_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_INFO_INDEX_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Indexes the abilities or extensions of all bundles by one of their attributes, e.g. the uri or
+ * the type, so a query by the attribute only visits the matched ones. The entries of a key are
+ * ordered by bundle name and then by the key of the ability or extension in its InnerBundleInfo,
+ * which is the order of a scan over all bundles. It is not thread safe, the owner updates it with
+ * the bundle infos under the same lock.
+ */
+template<typename Key>
+class BundleInfoIndex {
+public:
+    // bundleName and key of the ability or extension in the InnerBundleInfo
+    using Entries = std::set<std::pair<std::string, std::string>>;
+
+    /**
+     * @brief Add an ability or extension of a bundle.
+     * @param key Indicates the indexed attribute of the ability or extension.
+     * @param bundleName Indicates the bundle name.
+     * @param infoKey Indicates the key of the ability or extension in the InnerBundleInfo.
+     */
+    void Add(const Key &key, const std::string &bundleName, const std::string &infoKey)
+    {
+        if (entries_[key].emplace(bundleName, infoKey).second) {
+            bundleKeys_[bundleName].emplace_back(key);
+        }
+    }
+    /**
+     * @brief Remove all abilities or extensions of a bundle.
+     * @param bundleName Indicates the bundle name.
+     */
+    void Remove(const std::string &bundleName)
+    {
+        auto bundleItem = bundleKeys_.find(bundleName);
+        if (bundleItem == bundleKeys_.end()) {
+            return;
+        }
+        for (const auto &key : bundleItem->second) {
+            auto item = entries_.find(key);
+            if (item == entries_.end()) {
+                continue;
+            }
+            auto iter = item->second.lower_bound(std::make_pair(bundleName, std::string()));
+            while (iter != item->second.end() && iter->first == bundleName) {
+                iter = item->second.erase(iter);
+            }
+            if (item->second.empty()) {
+                entries_.erase(item);
+            }
+        }
+        bundleKeys_.erase(bundleItem);
+    }
+    /**
+     * @brief Find the abilities or extensions by the indexed attribute.
+     * @param key Indicates the indexed attribute.
+     * @return Returns the entries of the attribute; returns nullptr if there is none.
+     */
+    const Entries *Find(const Key &key) const
+    {
+        auto item = entries_.find(key);
+        return item == entries_.end() ? nullptr : &item->second;
+    }
+
+private:
+    std::unordered_map<Key, Entries> entries_;
+    // key:bundleName
+    // value:keys of the bundle in entries_
+    std::unordered_map<std::string, std::vector<Key>> bundleKeys_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_INFO_INDEX_H
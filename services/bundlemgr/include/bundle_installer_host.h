@@ -119,6 +119,11 @@ public:
     virtual bool DestoryBundleStreamInstaller(uint32_t streamInstallerId) override;
     virtual ErrCode StreamInstall(const std::vector<std::string> &bundleFilePaths, const InstallParam &installParam,
         const sptr<IStatusReceiver> &statusReceiver) override;
+    /**
+     * @brief Get the manager which runs the installer tasks.
+     * @return Returns the installer manager, nullptr if Init() has not succeeded.
+     */
+    std::shared_ptr<BundleInstallerManager> GetInstallerManager() const;
 
 private:
     /**
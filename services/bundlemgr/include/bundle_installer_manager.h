@@ -16,6 +16,8 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_INSTALLER_MANAGER_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_INSTALLER_MANAGER_H
 
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -30,6 +32,19 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+struct InstallerQueueStats {
+    // tasks added but not started yet
+    size_t pendingTaskCount = 0;
+    // most tasks ever waiting for one bundle
+    size_t maxBundleQueueDepth = 0;
+    // bundles with a queued or running task
+    size_t runningBundleCount = 0;
+    uint64_t startedTaskCount = 0;
+    // time between adding a task and starting it
+    int64_t totalWaitTimeMs = 0;
+    int64_t maxWaitTimeMs = 0;
+};
+
 class BundleInstallerManager : public EventHandler {
 public:
     explicit BundleInstallerManager(const std::shared_ptr<EventRunner> &runner);
@@ -95,6 +110,11 @@ public:
      */
     void CreateUninstallTask(const std::string &bundleName, const std::string &modulePackage,
         const InstallParam &installParam, const sptr<IStatusReceiver> &statusReceiver);
+    /**
+     * @brief Get the queue depth and wait time statistics of the installer tasks.
+     * @return Returns the statistics collected since the manager is created.
+     */
+    InstallerQueueStats GetQueueStats() const;
     enum {
         REMOVE_BUNDLE_INSTALLER = 1,
     };
@@ -112,8 +132,26 @@ private:
      * @return
      */
     void RemoveInstaller(const int64_t installerId);
+    /**
+     * @brief Add a task to the queue of a bundle, the tasks of one bundle run one by one in order.
+     * @param bundleName Indicates the bundle name of the task, empty if it is unknown before the task runs.
+     * @param task Indicates the task to be added.
+     * @return
+     */
+    void AddTask(const std::string &bundleName, const std::function<void()> &task);
+    /**
+     * @brief Run the queued tasks of a bundle until its queue is empty.
+     * @param bundleName Indicates the bundle name of the queue.
+     * @return
+     */
+    void RunBundleTasks(const std::string &bundleName);
+    void RecordWaitTime(int64_t enqueueTime);
 
 private:
+    struct QueuedTask {
+        std::function<void()> task;
+        int64_t enqueueTime = 0;
+    };
     const int MAX_TASK_NUMBER = 10;
     const int THREAD_NUMBER = std::thread::hardware_concurrency();
     // Thread pool used to start multipule installer in parallel.
@@ -121,6 +159,11 @@ private:
     std::mutex mutex_;
     // map key will use timestamp.
     std::unordered_map<int64_t, std::shared_ptr<BundleInstaller>> installers_;
+    // guards bundleTasks_ and stats_
+    mutable std::mutex taskMutex_;
+    // a bundle has an entry while one of its tasks is running, only that task occupies a pool thread
+    std::unordered_map<std::string, std::deque<QueuedTask>> bundleTasks_;
+    InstallerQueueStats stats_;
 
     DISALLOW_COPY_AND_MOVE(BundleInstallerManager);
 };
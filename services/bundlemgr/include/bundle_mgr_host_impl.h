@@ -674,6 +674,17 @@ public:
         const std::string &bundleName, const std::string &moduleName, int32_t upgradeFlag) override;
     virtual ErrCode GetSandboxBundleInfo(
         const std::string &bundleName, int32_t appIndex, int32_t userId, BundleInfo &info) override;
+    /**
+     * @brief Obtains the bundle changes recorded after a given generation.
+     * @param generation Indicates the latest generation already observed by the caller.
+     * @param userId Indicates the user ID.
+     * @param changeRecords Indicates the obtained BundleChangeRecord objects, ordered by generation.
+     * @param currentGeneration Indicates the latest generation recorded by the service.
+     * @param needFullSync Indicates whether the caller should re-query all infos instead.
+     * @return Returns true if this function is successfully called; returns false otherwise.
+     */
+    virtual bool GetBundleChanges(int64_t generation, int32_t userId,
+        std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync) override;
 
 private:
     const std::shared_ptr<BundleCloneMgr> GetCloneMgrFromService();
@@ -18,6 +18,7 @@
 
 #include "bundle_constants.h"
 #include "bundle_data_mgr.h"
+#include "bundle_parse_cache.h"
 #include "event_handler.h"
 #include "pre_scan_info.h"
 
@@ -236,11 +237,24 @@ private:
      */
     void AddParseInfosToMap(const std::string &bundleName,
         const std::unordered_map<std::string, InnerBundleInfo> &infos);
+    /**
+     * @brief Check whether all the haps are processed by the last reboot scan and not changed since then.
+     * @param infos Indicates the parse results of the haps.
+     * @return Returns true if the haps need not be processed again; returns false otherwise.
+     */
+    bool IsHapsProcessed(const std::unordered_map<std::string, InnerBundleInfo> &infos) const;
+    /**
+     * @brief Record that the haps are processed by this reboot scan.
+     * @param infos Indicates the parse results of the haps.
+     */
+    void SetHapsProcessed(const std::unordered_map<std::string, InnerBundleInfo> &infos);
 
     // Used to save the information parsed by Hap in the scanned directory.
     std::map<std::string, std::unordered_map<std::string, InnerBundleInfo>> hapParseInfoMap_;
     // used to save application information that already exists in the Db.
     std::map<std::string, PreInstallBundleInfo> loadExistData_;
+    // parse results of the haps kept between boots, only valid while scanning after reboot.
+    std::shared_ptr<BundleParseCache> parseCache_;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
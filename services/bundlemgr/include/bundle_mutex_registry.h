@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MUTEX_REGISTRY_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MUTEX_REGISTRY_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Hands out one mutex per bundle name. A mutex is kept only while a caller holds it, the unused ones are
+ * removed once the registry reaches PRUNE_THRESHOLD entries, so the registry stays small however many
+ * bundles are installed over time.
+ *
+ * Each name has its own mutex, so two bundles never wait for each other and a thread may hold the mutexes
+ * of several bundles, which a striped table could not allow. The registry lock is only held for the hash
+ * lookup and the reference count, never while a bundle mutex is locked.
+ */
+class BundleMutexRegistry {
+public:
+    BundleMutexRegistry() = default;
+    ~BundleMutexRegistry() = default;
+    /**
+     * @brief Get the mutex of a bundle.
+     * @param bundleName Indicates the bundle name.
+     * @return Returns the mutex of the bundle, it must be held while the mutex is locked.
+     */
+    std::shared_ptr<std::mutex> GetMutex(const std::string &bundleName);
+    /**
+     * @brief Get the number of the mutexes kept by the registry.
+     * @return Returns the number of the mutexes, including the unused ones not removed yet.
+     */
+    size_t GetSize() const;
+
+    static constexpr size_t PRUNE_THRESHOLD = 64;
+
+private:
+    void PruneUnusedMutexes();
+
+    mutable std::mutex mutex_;
+    // the registry holds one reference, a mutex with no other reference is unused
+    std::unordered_map<std::string, std::shared_ptr<std::mutex>> bundleMutexes_;
+
+    DISALLOW_COPY_AND_MOVE(BundleMutexRegistry);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MUTEX_REGISTRY_H
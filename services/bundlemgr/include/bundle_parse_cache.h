@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_PARSE_CACHE_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_PARSE_CACHE_H
+
+#include <string>
+#include <unordered_map>
+
+#include "inner_bundle_info.h"
+#include "nlohmann/json.hpp"
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Keeps the parse results of hap files between two boots, so the unchanged preinstalled haps are
+ * not extracted and parsed again by the reboot scan. A result is used only if the file has the same
+ * identity as when it was parsed, the whole cache is dropped when the system version changes.
+ * It also records which haps have been processed by a scan, so the next scan can skip them.
+ */
+class BundleParseCache {
+public:
+    explicit BundleParseCache(const std::string &cachePath);
+    ~BundleParseCache() = default;
+    /**
+     * @brief Load the cache file.
+     * @return Returns true if the cache is loaded; returns false otherwise.
+     */
+    bool Load();
+    /**
+     * @brief Save the cache file, the results not used since Load are dropped.
+     * @return Returns true if the cache is saved or not changed; returns false otherwise.
+     */
+    bool Save();
+    /**
+     * @brief Get the cached parse result of a hap file.
+     * @param hapPath Indicates the real path of the hap file.
+     * @param info Indicates the obtained InnerBundleInfo object.
+     * @return Returns true if the file is not changed since it was parsed; returns false otherwise.
+     */
+    bool GetInnerBundleInfo(const std::string &hapPath, InnerBundleInfo &info);
+    /**
+     * @brief Set the parse result of a hap file.
+     * @param hapPath Indicates the real path of the hap file.
+     * @param info Indicates the InnerBundleInfo object parsed from the file.
+     */
+    void SetInnerBundleInfo(const std::string &hapPath, const InnerBundleInfo &info);
+    /**
+     * @brief Check whether a hap file is processed by the last scan and not changed since then.
+     * @param hapPath Indicates the real path of the hap file, whose parse result has been got.
+     * @return Returns true if the hap file is processed by the last scan; returns false otherwise.
+     */
+    bool IsProcessed(const std::string &hapPath) const;
+    /**
+     * @brief Mark a hap file as processed by the current scan.
+     * @param hapPath Indicates the real path of the hap file, whose parse result has been got or set.
+     */
+    void SetProcessed(const std::string &hapPath);
+
+private:
+    struct FileIdentity {
+        uint64_t dev = 0;
+        uint64_t ino = 0;
+        int64_t size = 0;
+        int64_t mtimeNs = 0;
+        int64_t ctimeNs = 0;
+
+        bool operator==(const FileIdentity &other) const
+        {
+            return dev == other.dev && ino == other.ino && size == other.size &&
+                mtimeNs == other.mtimeNs && ctimeNs == other.ctimeNs;
+        }
+    };
+
+    struct CacheItem {
+        FileIdentity identity;
+        nlohmann::json info;
+        bool isUsed = false;
+        // processed by the last scan, or by the current one after SetProcessed
+        bool isProcessed = false;
+    };
+
+    static bool GetFileIdentity(const std::string &path, FileIdentity &identity);
+    static std::string GetSystemVersion();
+
+    bool isChanged_ = false;
+    std::string cachePath_;
+    std::unordered_map<std::string, CacheItem> items_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_PARSE_CACHE_H
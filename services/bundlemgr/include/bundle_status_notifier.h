@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_STATUS_NOTIFIER_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_STATUS_NOTIFIER_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bundle_status_callback_interface.h"
+#include "nocopyable.h"
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+struct BundleStatusDeliveryStats {
+    // notifications waiting for the subscriber
+    size_t pendingCount = 0;
+    uint64_t deliveredCount = 0;
+    // notifications merged into an identical one which was still waiting
+    uint64_t coalescedCount = 0;
+    // notifications dropped because the subscriber fell too far behind or its callback was overdue
+    uint64_t droppedCount = 0;
+    // time between queuing a notification and the callback returning
+    int64_t totalLatencyMs = 0;
+    int64_t maxLatencyMs = 0;
+};
+
+/**
+ * Delivers the bundle status callbacks out of the installer threads. Each subscriber has its own queue,
+ * which is delivered in order, one notification per pool task, so a slow subscriber takes its turn with
+ * the others instead of keeping a thread for its whole queue. A callback is a synchronous binder call
+ * without a timeout: a hung subscriber holds its thread until the call returns and gets no new
+ * notifications meanwhile, and as many hung subscribers as pool threads stall the delivery to all.
+ */
+class BundleStatusNotifier {
+public:
+    BundleStatusNotifier();
+    ~BundleStatusNotifier();
+    /**
+     * @brief Add a subscriber.
+     * @param callback Indicates the callback of the subscriber.
+     */
+    void AddCallback(const sptr<IBundleStatusCallback> &callback);
+    /**
+     * @brief Remove the subscribers with the same remote object as the callback.
+     * @param callback Indicates the callback to be removed.
+     */
+    void RemoveCallback(const sptr<IBundleStatusCallback> &callback);
+    /**
+     * @brief Remove all the subscribers, the notifications not delivered yet are dropped.
+     */
+    void ClearCallbacks();
+    /**
+     * @brief Queue a notification for the subscribers of the bundle, it returns without waiting for them.
+     * @param installType Indicates the install type passed to OnBundleStateChanged.
+     * @param resultCode Indicates the result code passed to OnBundleStateChanged.
+     * @param bundleName Indicates the name of the bundle whose state has changed.
+     */
+    void Notify(uint8_t installType, int32_t resultCode, const std::string &bundleName);
+    /**
+     * @brief Get the delivery statistics of a subscriber.
+     * @param callback Indicates the callback of the subscriber.
+     * @param stats Indicates the obtained statistics.
+     * @return Returns true if the subscriber is found; returns false otherwise.
+     */
+    bool GetDeliveryStats(const sptr<IBundleStatusCallback> &callback, BundleStatusDeliveryStats &stats) const;
+
+private:
+    struct Notification {
+        uint8_t installType = 0;
+        int32_t resultCode = 0;
+        std::string bundleName;
+        int64_t enqueueTime = 0;
+    };
+
+    struct Subscriber {
+        sptr<IBundleStatusCallback> callback;
+        std::string bundleName;
+        std::deque<Notification> notifications;
+        // a pool thread is draining the queue
+        bool running = false;
+        // the subscriber is removed, its remaining notifications are not delivered
+        bool removed = false;
+        // when the callback in flight was called, 0 if there is none
+        int64_t callbackStartTime = 0;
+        BundleStatusDeliveryStats stats;
+    };
+
+    void ScheduleSubscriber(const std::shared_ptr<Subscriber> &subscriber);
+    void RunSubscriber(const std::shared_ptr<Subscriber> &subscriber);
+
+    // guards subscribers_ and the members of each subscriber except the callback
+    mutable std::mutex mutex_;
+    // in the order of registering, the same bundle may be subscribed more than once
+    std::vector<std::shared_ptr<Subscriber>> subscribers_;
+    ThreadPool notifyPool_;
+
+    DISALLOW_COPY_AND_MOVE(BundleStatusNotifier);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_STATUS_NOTIFIER_H
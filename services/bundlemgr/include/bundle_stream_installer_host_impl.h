@@ -16,7 +16,11 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_STREAM_INSTALLER_HOST_IMPL_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_STREAM_INSTALLER_HOST_IMPL_H
 
-#include<vector>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "bundle_stream_installer_host.h"
 #include "install_param.h"
@@ -38,12 +42,45 @@ public:
     virtual void SetInstallerId(uint32_t installerId) override;
 
 private:
+    // A hap written by the client through the stream fd.
+    struct StreamHap {
+        std::string path;
+        int32_t fd = -1;
+        // the fd of the service is closed once the hap is complete, it is then verified once
+        bool sealed = false;
+    };
+    /**
+     * @brief Verify the haps whose content is complete while the client is still writing other haps,
+     *        so that Install can reuse the results. It waits until CreateStream opens a new stream.
+     */
+    void PreVerifyStreams();
+    /**
+     * @brief Check whether a hap not sealed yet ends with a complete zip central directory.
+     * @param hap Indicates the stream hap.
+     * @return Returns true if the hap should be sealed and verified now.
+     */
+    bool IsStreamHapReady(const StreamHap &hap) const;
+    /**
+     * @brief Close the fd of the service for a complete hap, so that only the client can still write it.
+     *        A later write changes the stamp of the file and the pre verify result is not used.
+     * @param hap Indicates the stream hap to seal.
+     */
+    void SealStreamHap(StreamHap &hap);
+    void StopPreVerify();
+
     std::string tempDir_;
     uint32_t installerId_ = -1;
     std::vector<int32_t> streamFdVec_;
     InstallParam installParam_;
     int32_t installedUid_;
-    bool isInstallStarted_ = false;
+    std::atomic<bool> isInstallStarted_{false};
+    std::mutex streamMutex_;
+    std::condition_variable streamCondition_;
+    std::vector<StreamHap> streamHaps_;
+    std::thread preVerifyThread_;
+    // set by CreateStream, the haps before the new stream are checked
+    bool preVerifyPending_ = false;
+    bool stopPreVerify_ = false;
 };
 } // AppExecFwk
 } // OHOS
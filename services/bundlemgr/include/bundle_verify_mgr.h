@@ -16,6 +16,11 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_VERIFY_MGR_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_VERIFY_MGR_H
 
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+
 #include "appexecfwk_errors.h"
 #include "interfaces/hap_verify.h"
 
@@ -23,7 +28,48 @@ namespace OHOS {
 namespace AppExecFwk {
 class BundleVerifyMgr {
 public:
+    /**
+     * @brief Verify the signature of a hap, a result saved by PreVerify for the unchanged file is used once.
+     * @param filePath Indicates the hap file path.
+     * @param hapVerifyResult Indicates the signature info of the hap.
+     * @return Returns ERR_OK if the hap is verified successfully; returns error code otherwise.
+     */
     static ErrCode HapVerify(const std::string &filePath, Security::Verify::HapVerifyResult &hapVerifyResult);
+    /**
+     * @brief Verify a hap ahead of its install, while the other haps of the bundle are still being written.
+     *        The result is only kept if the file did not change while it was verified.
+     * @param filePath Indicates the hap file path.
+     * @return Returns the verify result, which is kept until the next HapVerify of the file.
+     */
+    static ErrCode PreVerify(const std::string &filePath);
+    /**
+     * @brief Drop the result saved by PreVerify for a hap, even if the hap no longer exists.
+     * @param filePath Indicates the hap file path.
+     */
+    static void ClearPreVerifyResult(const std::string &filePath);
+
+private:
+    // Identifies the content of a file, any write or replacement of the file changes it.
+    struct FileStamp {
+        dev_t dev = 0;
+        ino_t ino = 0;
+        off_t size = 0;
+        struct timespec ctime = {};
+    };
+    // A verify result is only valid for the file content it was computed from.
+    struct PreVerifyRecord {
+        std::string filePath;
+        FileStamp stamp;
+        ErrCode result = ERR_OK;
+        Security::Verify::HapVerifyResult hapVerifyResult;
+    };
+
+    static bool GetFileStamp(const std::string &filePath, std::string &realPath, FileStamp &stamp);
+    static bool IsSameStamp(const FileStamp &left, const FileStamp &right);
+
+    static std::mutex preVerifyMutex_;
+    // the records by the real path of the haps
+    static std::map<std::string, PreVerifyRecord> preVerifyRecords_;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
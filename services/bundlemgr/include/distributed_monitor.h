@@ -53,6 +53,9 @@ public:
             } else {
                 APP_LOGW("OnReceiveEvent GetBundleInfos failed");
             }
+        } else if (action == EventFwk::CommonEventSupport::COMMON_EVENT_LOCALE_CHANGED) {
+            APP_LOGI("OnReceiveEvent locale changed");
+            bundleDataMgr_->OnLocaleChanged();
         } else {
             APP_LOGI("OnReceiveEvent action = %{public}s not support", action.c_str());
         }
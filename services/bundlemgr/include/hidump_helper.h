@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "bundle_data_mgr.h"
+#include "bundle_installer_manager.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -33,6 +34,7 @@ enum class HidumpFlag {
     GET_BUNDLE_LIST,
     GET_BUNDLE_BY_NAME,
     GET_DEVICEID,
+    GET_INSTALLER_QUEUE,
 };
 
 struct HidumpParam {
@@ -42,7 +44,8 @@ struct HidumpParam {
 
 class HidumpHelper {
 public:
-    explicit HidumpHelper(const std::weak_ptr<BundleDataMgr> &dataMgr);
+    explicit HidumpHelper(const std::weak_ptr<BundleDataMgr> &dataMgr,
+        const std::weak_ptr<BundleInstallerManager> &installerManager = {});
     ~HidumpHelper() = default;
     /**
      * @brief Process hidump.
@@ -67,8 +70,10 @@ private:
     ErrCode GetAllBundleNameList(std::string &result);
     ErrCode GetBundleInfoByName(const std::string &name, std::string &result);
     ErrCode GetAllDeviced(std::string &result);
+    ErrCode GetInstallerQueueStats(std::string &result);
 
     std::weak_ptr<BundleDataMgr> dataMgr_;
+    std::weak_ptr<BundleInstallerManager> installerManager_;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
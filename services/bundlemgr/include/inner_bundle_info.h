@@ -531,70 +531,6 @@ public:
     {
         extensionSkillInfos_.emplace(key, skills);
     }
-    /**
-     * @brief Find AbilityInfo object by Uri.
-     * @param abilityUri Indicates the ability uri.
-     * @param userId Indicates the user ID.
-     * @return Returns the AbilityInfo object if find it; returns null otherwise.
-     */
-    std::optional<AbilityInfo> FindAbilityInfoByUri(const std::string &abilityUri) const
-    {
-        APP_LOGI("Uri is %{public}s", abilityUri.c_str());
-        for (const auto &ability : baseAbilityInfos_) {
-            auto abilityInfo = ability.second;
-            if (abilityInfo.uri.size() < Constants::DATA_ABILITY_URI_PREFIX.size()) {
-                continue;
-            }
-
-            auto configUri = abilityInfo.uri.substr(Constants::DATA_ABILITY_URI_PREFIX.size());
-            APP_LOGI("configUri is %{public}s", configUri.c_str());
-            if (configUri == abilityUri) {
-                return abilityInfo;
-            }
-        }
-        return std::nullopt;
-    }
-
-    bool FindExtensionAbilityInfoByUri(const std::string &uri, ExtensionAbilityInfo &extensionAbilityInfo) const
-    {
-        for (const auto &item : baseExtensionInfos_) {
-            if (uri == item.second.uri) {
-                extensionAbilityInfo = item.second;
-                APP_LOGD("find target extension, bundleName : %{public}s, moduleName : %{public}s, name : %{public}s",
-                    extensionAbilityInfo.bundleName.c_str(), extensionAbilityInfo.moduleName.c_str(),
-                    extensionAbilityInfo.name.c_str());
-                return true;
-            }
-        }
-        return false;
-    }
-
-    /**
-     * @brief Find AbilityInfo object by Uri.
-     * @param abilityUri Indicates the ability uri.
-     * @param userId Indicates the user ID.
-     * @return Returns the AbilityInfo object if find it; returns null otherwise.
-     */
-    void FindAbilityInfosByUri(const std::string &abilityUri,
-        std::vector<AbilityInfo> &abilityInfos,  int32_t userId = Constants::UNSPECIFIED_USERID)
-    {
-        APP_LOGI("Uri is %{public}s", abilityUri.c_str());
-        for (auto &ability : baseAbilityInfos_) {
-            auto abilityInfo = ability.second;
-            if (abilityInfo.uri.size() < Constants::DATA_ABILITY_URI_PREFIX.size()) {
-                continue;
-            }
-
-            auto configUri = abilityInfo.uri.substr(Constants::DATA_ABILITY_URI_PREFIX.size());
-            APP_LOGI("configUri is %{public}s", configUri.c_str());
-            if (configUri == abilityUri) {
-                GetApplicationInfo(
-                    ApplicationFlag::GET_APPLICATION_INFO_WITH_PERMISSION, userId, abilityInfo.applicationInfo);
-                abilityInfos.emplace_back(abilityInfo);
-            }
-        }
-        return;
-    }
     /**
      * @brief Get all ability names in application.
      * @return Returns ability names.
@@ -1194,6 +1130,8 @@ public:
     std::optional<InnerModuleInfo> GetInnerModuleInfoByModuleName(const std::string &moduleName) const;
 
     void GetModuleNames(std::vector<std::string> &moduleNames) const;
+
+    void GetModuleResPaths(std::vector<std::string> &moduleResPaths) const;
     /**
      * @brief Fetch all innerModuleInfos, can be modify.
      */
@@ -16,6 +16,9 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_HOST_IMPL_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_HOST_IMPL_H
 
+#include <map>
+#include <mutex>
+
 #include "ipc/installd_host.h"
 #include "installd/installd_operator.h"
 
@@ -59,6 +62,15 @@ public:
      */
     virtual ErrCode CreateBundleDataDir(const std::string &bundleName, const int userid,
         const int uid, const int gid, const std::string &apl) override;
+    /**
+     * @brief Create the data directories of several bundles in one request.
+     * @param createDirParams Indicates the bundleName, userId, uid, gid and apl of each bundle.
+     * @param results Indicates the result of each bundle, in the order of createDirParams.
+     * @return Returns ERR_OK if the request is handled, the result of each bundle is in results;
+     *         returns error code otherwise.
+     */
+    virtual ErrCode CreateBundleDataDirs(
+        const std::vector<CreateDirParam> &createDirParams, std::vector<ErrCode> &results) override;
     /**
      * @brief Remove a bundle data directory.
      * @param bundleName Indicates the bundleName data directory path that to be created.
@@ -87,7 +99,8 @@ public:
      */
     virtual ErrCode CleanBundleDataDir(const std::string &bundleDir) override;
     /**
-     * @brief Get bundle Stats.
+     * @brief Get bundle Stats. The stats are cached until installd changes the dirs of the bundle, data
+     *        the app writes itself is only counted once the cached stats are older than 10 seconds.
      * @param bundleName Indicates the bundle name.
      * @param userId Indicates the user Id.
      * @param bundleStats Indicates the bundle Stats.
@@ -95,6 +108,16 @@ public:
      */
     virtual ErrCode GetBundleStats(
         const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats) override;
+    /**
+     * @brief Get the stats of several bundles in one request.
+     * @param bundleNames Indicates the bundle names.
+     * @param userId Indicates the user Id.
+     * @param bundleStats Indicates the stats of each bundle in the order of bundleNames, every bundle
+     *        takes the same number of items as the result of GetBundleStats.
+     * @return Returns ERR_OK if get stats successfully; returns error code otherwise.
+     */
+    virtual ErrCode BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+        std::vector<int64_t> &bundleStats) override;
     /**
      * @brief Set dir apl.
      * @param dir Indicates the data dir.
@@ -113,7 +136,27 @@ public:
     virtual ErrCode GetBundleCachePath(const std::string &dir, std::vector<std::string> &cachePath) override;
 
 private:
+    struct BundleStatsCache {
+        std::vector<int64_t> stats;
+        int64_t updateTime = 0;
+    };
+
     std::string GetBundleDataDir(const std::string &el, const int userid) const;
+    void GetBundleDataDirs(const CreateDirParam &param, bool isDistributedFileEnabled,
+        std::vector<OwnerDirInfo> &dirs) const;
+    std::vector<int64_t> GetBundleStatsFromDisk(
+        const std::string &bundleName, const int32_t userId, bool isParallel) const;
+    bool GetCachedBundleStats(const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats);
+    uint64_t GetBundleStatsGeneration();
+    void SaveBundleStats(const std::string &bundleName, const int32_t userId,
+        const std::vector<int64_t> &bundleStats, uint64_t generation);
+    void InvalidateBundleStats(const std::string &bundleName);
+    void InvalidateBundleStatsByPath(const std::string &path);
+
+    std::mutex bundleStatsMutex_;
+    // changed by every invalidation, stats walked before an invalidation are not cached
+    uint64_t bundleStatsGeneration_ = 0;
+    std::map<std::string, std::map<int32_t, BundleStatsCache>> bundleStatsCache_;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -26,6 +26,13 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+struct OwnerDirInfo {
+    std::string path;
+    int mode = 0;
+    int uid = -1;
+    int gid = -1;
+};
+
 class InstalldOperator {
 public:
     /**
@@ -134,6 +141,13 @@ public:
      * @return Returns true if directory made successfully; returns false otherwise.
      */
     static bool MkOwnerDir(const std::string &path,  int mode, const int uid, const int gid);
+    /**
+     * @brief Make several directories and change the mode, owner and group ID of them.
+     *        A parent directory must come before its children.
+     * @param dirs Indicates the path, mode, uid and gid of each directory.
+     * @param results Indicates whether each directory is made successfully, in the order of dirs.
+     */
+    static void MkOwnerDirs(const std::vector<OwnerDirInfo> &dirs, std::vector<bool> &results);
     /**
      * @brief Get disk usage for dir.
      * @param dir Indicates the directory.
@@ -154,6 +168,13 @@ public:
      * @return Returns disk size.
      */
     static int64_t GetDiskUsageFromPath(const std::vector<std::string> &path);
+    /**
+     * @brief Get disk usage for dir and for the cache directories in it with one walk.
+     * @param dir Indicates the directory.
+     * @param cacheSize Indicates the disk usage of the cache directories in dir.
+     * @return Returns the disk usage of dir, the cache directories included.
+     */
+    static int64_t GetDiskUsageWithCache(const std::string &dir, int64_t &cacheSize);
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
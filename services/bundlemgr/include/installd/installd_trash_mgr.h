@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_TRASH_MGR_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_TRASH_MGR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "singleton.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Removes directories by renaming them into the trash of their volume, the trash is
+ * deleted later by a low priority worker thread. Anything left in the trash when installd
+ * stops is deleted after the next start.
+ */
+class InstalldTrashMgr : public DelayedSingleton<InstalldTrashMgr> {
+public:
+    InstalldTrashMgr();
+    ~InstalldTrashMgr();
+    /**
+     * @brief Remove a directory or a file, a directory is moved into the trash if possible.
+     * @param path Indicates the path to be removed.
+     * @return Returns true if the path no longer exists; returns false otherwise.
+     */
+    bool RemoveDir(const std::string &path);
+    /**
+     * @brief Remove all the files in a directory, sub directories are moved into the trash if possible.
+     * @param dataPath Indicates the directory path of the files to be removed.
+     * @return Returns true if the files are removed; returns false otherwise.
+     */
+    bool RemoveFiles(const std::string &dataPath);
+    /**
+     * @brief Queue the trash left by the last run of installd to be deleted.
+     */
+    void RecoverTrash();
+
+private:
+    struct TrashItem {
+        std::string trashDir;
+        // empty name means all the entries of trashDir
+        std::string name;
+    };
+
+    std::string GetTrashDir(const std::string &path) const;
+    bool MoveToTrash(const std::string &path);
+    void AddTrashItem(const std::string &trashDir, const std::string &name);
+    void ProcessTrash();
+
+    bool isWorkerStarted_ = false;
+    std::atomic<uint32_t> sequence_ {0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<TrashItem> trashItems_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_TRASH_MGR_H
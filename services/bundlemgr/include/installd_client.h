@@ -64,6 +64,15 @@ public:
      */
     ErrCode CreateBundleDataDir(const std::string &bundleName,
         const int userid, const int uid, const int gid, const std::string &apl);
+    /**
+     * @brief Create the data directories of several bundles in one request.
+     * @param createDirParams Indicates the bundleName, userId, uid, gid and apl of each bundle.
+     * @param results Indicates the result of each bundle, in the order of createDirParams.
+     * @return Returns ERR_OK if the request is handled, the result of each bundle is in results;
+     *         returns error code otherwise.
+     */
+    ErrCode CreateBundleDataDirs(
+        const std::vector<CreateDirParam> &createDirParams, std::vector<ErrCode> &results);
     /**
      * @brief Remove a bundle data directory.
      * @param bundleName Indicates the bundleName data directory path that to be created.
@@ -91,13 +100,23 @@ public:
      */
     ErrCode CleanBundleDataDir(const std::string &bundleDir);
     /**
-     * @brief Get bundle Stats.
+     * @brief Get bundle Stats. Data the app writes itself may show up to 10 seconds late.
      * @param bundleName Indicates the bundle name.
      * @param userId Indicates the user Id.
      * @param bundleStats Indicates the bundle Stats.
      * @return Returns ERR_OK if get stats successfully; returns error code otherwise.
      */
     ErrCode GetBundleStats(const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats);
+    /**
+     * @brief Get the stats of several bundles in as few requests as possible.
+     * @param bundleNames Indicates the bundle names.
+     * @param userId Indicates the user Id.
+     * @param bundleStats Indicates the stats of each bundle in the order of bundleNames, every bundle
+     *        takes the same number of items as the result of GetBundleStats.
+     * @return Returns ERR_OK if get stats successfully; returns error code otherwise.
+     */
+    ErrCode BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+        std::vector<int64_t> &bundleStats);
 
     /**
      * @brief Reset the installd proxy object when installd service died.
@@ -61,6 +61,13 @@ private:
      * @return Returns true if called successfully; returns false otherwise.
      */
     bool HandleCreateBundleDataDir(MessageParcel &data, MessageParcel &reply);
+    /**
+     * @brief Handles the CreateBundleDataDirs function called from a IInstalld proxy object.
+     * @param data Indicates the data to be read.
+     * @param reply Indicates the reply to be sent;
+     * @return Returns true if called successfully; returns false otherwise.
+     */
+    bool HandleCreateBundleDataDirs(MessageParcel &data, MessageParcel &reply);
     /**
      * @brief Handles the RemoveBundleDataDir function called from a IInstalld proxy object.
      * @param data Indicates the data to be read.
@@ -96,6 +103,13 @@ private:
      * @return Returns true if called successfully; returns false otherwise.
      */
     bool HandleGetBundleStats(MessageParcel &data, MessageParcel &reply);
+    /**
+     * @brief Handles the BatchGetBundleStats function called from a IInstalld proxy object.
+     * @param data Indicates the data to be read.
+     * @param reply Indicates the reply to be sent.
+     * @return Returns true if called successfully; returns false otherwise.
+     */
+    bool HandleBatchGetBundleStats(MessageParcel &data, MessageParcel &reply);
 
     /**
      * @brief Init private hash map funcMap_.
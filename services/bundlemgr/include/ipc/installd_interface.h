@@ -25,6 +25,19 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+// Upper bound of the bundles whose data directories are created in one request.
+constexpr size_t MAX_CREATE_DIR_PARAMS_SIZE = 256;
+// Upper bound of the bundles whose stats are got in one request.
+constexpr size_t MAX_BATCH_BUNDLE_STATS_SIZE = 256;
+
+struct CreateDirParam {
+    std::string bundleName;
+    int32_t userId = 0;
+    int32_t uid = 0;
+    int32_t gid = 0;
+    std::string apl;
+};
+
 class IInstalld : public IRemoteBroker {
 public:
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.appexecfwk.Installd");
@@ -62,6 +75,15 @@ public:
      */
     virtual ErrCode CreateBundleDataDir(const std::string &bundleName,
         const int userid, const int uid, const int gid, const std::string &apl) = 0;
+    /**
+     * @brief Create the data directories of several bundles in one request.
+     * @param createDirParams Indicates the bundleName, userId, uid, gid and apl of each bundle.
+     * @param results Indicates the result of each bundle, in the order of createDirParams.
+     * @return Returns ERR_OK if the request is handled, the result of each bundle is in results;
+     *         returns error code otherwise.
+     */
+    virtual ErrCode CreateBundleDataDirs(
+        const std::vector<CreateDirParam> &createDirParams, std::vector<ErrCode> &results) = 0;
     /**
      * @brief Remove a bundle data directory.
      * @param bundleDir Indicates the bundle data directory path that to be created.
@@ -89,7 +111,7 @@ public:
      */
     virtual ErrCode CleanBundleDataDir(const std::string &bundleDir) = 0;
     /**
-     * @brief Get bundle Stats.
+     * @brief Get bundle Stats. Data the app writes itself may show up to 10 seconds late.
      * @param bundleName Indicates the bundle name.
      * @param userId Indicates the user Id.
      * @param bundleStats Indicates the bundle Stats.
@@ -97,6 +119,16 @@ public:
      */
     virtual ErrCode GetBundleStats(
         const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats) = 0;
+    /**
+     * @brief Get the stats of several bundles in one request. Data the apps write themselves may show up to 10 seconds late.
+     * @param bundleNames Indicates the bundle names.
+     * @param userId Indicates the user Id.
+     * @param bundleStats Indicates the stats of each bundle in the order of bundleNames, every bundle
+     *        takes the same number of items as the result of GetBundleStats.
+     * @return Returns ERR_OK if get stats successfully; returns error code otherwise.
+     */
+    virtual ErrCode BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+        std::vector<int64_t> &bundleStats) = 0;
     /**
      * @brief Set dir apl.
      * @param dir Indicates the data dir.
@@ -124,7 +156,9 @@ protected:
         REMOVE_DIR,
         GET_BUNDLE_STATS,
         SET_DIR_APL,
-        GET_BUNDLE_CACHE_PATH
+        GET_BUNDLE_CACHE_PATH,
+        CREATE_BUNDLE_DATA_DIRS,
+        BATCH_GET_BUNDLE_STATS
     };
 };
 
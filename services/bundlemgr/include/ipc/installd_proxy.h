@@ -62,6 +62,15 @@ public:
      */
     virtual ErrCode CreateBundleDataDir(const std::string &bundleName, const int userid,
         const int uid, const int gid, const std::string &apl) override;
+    /**
+     * @brief Create the data directories of several bundles in one request.
+     * @param createDirParams Indicates the bundleName, userId, uid, gid and apl of each bundle.
+     * @param results Indicates the result of each bundle, in the order of createDirParams.
+     * @return Returns ERR_OK if the request is handled, the result of each bundle is in results;
+     *         returns error code otherwise.
+     */
+    virtual ErrCode CreateBundleDataDirs(
+        const std::vector<CreateDirParam> &createDirParams, std::vector<ErrCode> &results) override;
     /**
      * @brief Remove a bundle data directory through a proxy object.
      * @param bundleDir Indicates the bundle data directory path that to be created.
@@ -97,6 +106,16 @@ public:
      */
     virtual ErrCode GetBundleStats(
         const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats) override;
+    /**
+     * @brief Get the stats of several bundles in one request.
+     * @param bundleNames Indicates the bundle names.
+     * @param userId Indicates the user Id.
+     * @param bundleStats Indicates the stats of each bundle in the order of bundleNames, every bundle
+     *        takes the same number of items as the result of GetBundleStats.
+     * @return Returns ERR_OK if get stats successfully; returns error code otherwise.
+     */
+    virtual ErrCode BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+        std::vector<int64_t> &bundleStats) override;
     /**
      * @brief Set dir apl.
      * @param dir Indicates the data dir.
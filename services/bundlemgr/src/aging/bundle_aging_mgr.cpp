@@ -14,6 +14,9 @@
  */
 #include "aging/bundle_aging_mgr.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "account_helper.h"
 #include "battery_srv_client.h"
 #include "bundle_active_period_stats.h"
@@ -123,23 +126,23 @@ bool BundleAgingMgr::ReInitAgingRequest(const std::shared_ptr<BundleDataMgr> &da
         APP_LOGE("ReInitAgingRequest: can not get bundle active module record");
         return false;
     }
-    int64_t lastBundleUsedTime = 0;
+    // the latest use of each bundle, the records are per module
+    std::unordered_map<std::string, int64_t> lastBundleUsedTimes;
+    lastBundleUsedTimes.reserve(activeModuleRecord.size());
+    for (const auto &moduleRecord : activeModuleRecord) {
+        APP_LOGD("%{public}s: %{public}" PRId64, moduleRecord.bundleName_.c_str(), moduleRecord.lastModuleUsedTime_);
+        int64_t &lastBundleUsedTime = lastBundleUsedTimes[moduleRecord.bundleName_];
+        lastBundleUsedTime = std::max(lastBundleUsedTime, moduleRecord.lastModuleUsedTime_);
+    }
     int64_t lastLaunchTimesMs = AgingUtil::GetNowSysTimeMs();
     APP_LOGD("now: %{public}" PRId64, lastLaunchTimesMs);
-    for (auto iter : bundleNamesAndUid) {
+    for (const auto &iter : bundleNamesAndUid) {
         int64_t dataBytes = dataMgr->GetBundleSpaceSize(iter.first);
         // the value of lastLaunchTimesMs get from lastLaunchTimesMs interface
-        lastBundleUsedTime = 0;
-        for (const auto &moduleRecord : activeModuleRecord) {
-            APP_LOGD("%{public}s: %{public}" PRId64, moduleRecord.bundleName_.c_str(),
-                moduleRecord.lastModuleUsedTime_);
-            if (moduleRecord.bundleName_ == iter.first && lastBundleUsedTime < moduleRecord.lastModuleUsedTime_) {
-                lastBundleUsedTime = moduleRecord.lastModuleUsedTime_;
-            }
-        }
-        if (lastBundleUsedTime) {
-            APP_LOGD("%{public}s: %{public}" PRId64, iter.first.c_str(), lastBundleUsedTime);
-            AgingBundleInfo agingBundleInfo(iter.first, lastBundleUsedTime, dataBytes, iter.second);
+        auto usedTime = lastBundleUsedTimes.find(iter.first);
+        if (usedTime != lastBundleUsedTimes.end() && usedTime->second) {
+            APP_LOGD("%{public}s: %{public}" PRId64, iter.first.c_str(), usedTime->second);
+            AgingBundleInfo agingBundleInfo(iter.first, usedTime->second, dataBytes, iter.second);
             request.AddAgingBundle(agingBundleInfo);
         } else {
             APP_LOGD("%{public}s: %{public}" PRId64, iter.first.c_str(), lastLaunchTimesMs);
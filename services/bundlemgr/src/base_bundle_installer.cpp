@@ -15,6 +15,8 @@
 
 #include "base_bundle_installer.h"
 
+#include <set>
+
 #include "nlohmann/json.hpp"
 
 #ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
@@ -34,6 +36,7 @@
 #include "hitrace_meter.h"
 #include "datetime_ex.h"
 #include "installd_client.h"
+#include "parallel_task_util.h"
 #include "perf_profile.h"
 #include "scope_guard.h"
 #include "string_ex.h"
@@ -43,6 +46,19 @@ namespace OHOS {
 namespace AppExecFwk {
 using namespace OHOS::Security;
 namespace {
+// Upper bound of the threads verifying or parsing the haps of one install.
+constexpr size_t MAX_HAP_PROCESS_THREADS = 4;
+// Upper bound of the threads adding installed bundles to a new user.
+constexpr size_t MAX_USER_PROVISION_THREADS = 8;
+
+struct UserProvisionResult {
+    ErrCode result = ERR_OK;
+    bool isInstalled = false;
+    InnerBundleInfo info;
+    InnerBundleUserInfo newInnerBundleUserInfo;
+    CreateDirParam createDirParam;
+};
+
 std::string GetHapPath(const InnerBundleInfo &info, const std::string &moduleName)
 {
     return info.GetAppCodePath() + Constants::PATH_SEPARATOR
@@ -664,8 +680,8 @@ ErrCode BaseBundleInstaller::ProcessBundleUninstall(
         return ERR_APPEXECFWK_USER_NOT_EXIST;
     }
 
-    auto &mtx = dataMgr_->GetBundleMutex(bundleName);
-    std::lock_guard lock {mtx};
+    auto mtx = dataMgr_->GetBundleMutex(bundleName);
+    std::lock_guard lock {*mtx};
     InnerBundleInfo oldInfo;
     if (!dataMgr_->GetInnerBundleInfo(bundleName, oldInfo)) {
         APP_LOGE("uninstall bundle info missing");
@@ -758,8 +774,8 @@ ErrCode BaseBundleInstaller::ProcessBundleUninstall(
         return ERR_APPEXECFWK_USER_NOT_EXIST;
     }
 
-    auto &mtx = dataMgr_->GetBundleMutex(bundleName);
-    std::lock_guard lock {mtx};
+    auto mtx = dataMgr_->GetBundleMutex(bundleName);
+    std::lock_guard lock {*mtx};
     InnerBundleInfo oldInfo;
     if (!dataMgr_->GetInnerBundleInfo(bundleName, oldInfo)) {
         APP_LOGE("uninstall bundle info missing");
@@ -889,8 +905,8 @@ ErrCode BaseBundleInstaller::InnerProcessInstallByPreInstallInfo(
     }
 
     {
-        auto &mtx = dataMgr_->GetBundleMutex(bundleName);
-        std::lock_guard lock {mtx};
+        auto mtx = dataMgr_->GetBundleMutex(bundleName);
+        std::lock_guard lock {*mtx};
         InnerBundleInfo oldInfo;
         bool isAppExist = dataMgr_->GetInnerBundleInfo(bundleName, oldInfo);
         if (isAppExist) {
@@ -952,6 +968,145 @@ ErrCode BaseBundleInstaller::InnerProcessInstallByPreInstallInfo(
     return ProcessBundleInstall(pathVec, innerInstallParam, preInstallBundleInfo.GetAppType(), uid);
 }
 
+ErrCode BaseBundleInstaller::ProvisionInstalledBundles(const std::vector<std::string> &bundleNames,
+    int32_t userId, std::vector<std::string> &uninstalledBundleNames)
+{
+    HITRACE_METER_NAME(HITRACE_TAG_APP, __PRETTY_FUNCTION__);
+    dataMgr_ = DelayedSingleton<BundleMgrService>::GetInstance()->GetDataMgr();
+    if (dataMgr_ == nullptr) {
+        APP_LOGE("Get dataMgr shared_ptr nullptr.");
+        return ERR_APPEXECFWK_UNINSTALL_BUNDLE_MGR_SERVICE_ERROR;
+    }
+    userId_ = userId;
+    if (!dataMgr_->HasUserId(userId_)) {
+        APP_LOGE("The user %{public}d does not exist.", userId_);
+        return ERR_APPEXECFWK_USER_NOT_EXIST;
+    }
+
+    // the bundles stay locked until their user infos are committed or cleaned up, so no install or
+    // uninstall of them runs in between; they are locked in name order
+    std::map<std::string, std::shared_ptr<std::mutex>> bundleMutexes;
+    for (const auto &bundleName : bundleNames) {
+        bundleMutexes.emplace(bundleName, dataMgr_->GetBundleMutex(bundleName));
+    }
+    std::vector<std::unique_lock<std::mutex>> bundleLocks;
+    bundleLocks.reserve(bundleMutexes.size());
+    for (const auto &item : bundleMutexes) {
+        bundleLocks.emplace_back(*item.second);
+    }
+
+    // the per bundle work only calls thread safe services, members are read only here
+    std::vector<UserProvisionResult> results(bundleNames.size());
+    ParallelTaskUtil::Run(bundleNames.size(), MAX_USER_PROVISION_THREADS, [&](size_t index) {
+        const std::string &bundleName = bundleNames[index];
+        UserProvisionResult &item = results[index];
+        InnerBundleInfo &info = item.info;
+        item.isInstalled = dataMgr_->GetInnerBundleInfo(bundleName, info);
+        if (!item.isInstalled) {
+            return;
+        }
+        dataMgr_->EnableBundle(bundleName);
+        if (info.HasInnerBundleUserInfo(userId_)) {
+            item.result = ERR_APPEXECFWK_INSTALL_ALREADY_EXIST;
+            return;
+        }
+        bool isSingleton = info.IsSingleton();
+        if (isSingleton != (userId_ == Constants::DEFAULT_USERID)) {
+            item.result = ERR_APPEXECFWK_INSTALL_ZERO_USER_WITH_NO_SINGLETON;
+            return;
+        }
+        InnerBundleUserInfo curInnerBundleUserInfo;
+        curInnerBundleUserInfo.bundleUserInfo.userId = userId_;
+        curInnerBundleUserInfo.bundleName = bundleName;
+        info.AddInnerBundleUserInfo(curInnerBundleUserInfo);
+        uint32_t tokenId = CreateAccessTokenId(info);
+        info.SetAccessTokenId(tokenId, userId_);
+        item.result = GrantRequestPermissions(info, tokenId);
+        if (item.result == ERR_OK) {
+            item.result = GetCreateDirParam(info, item.newInnerBundleUserInfo, item.createDirParam);
+        }
+        if (item.result != ERR_OK) {
+            BundlePermissionMgr::DeleteAccessTokenId(tokenId);
+        }
+    });
+
+    // the data dirs of all bundles are created by one installd request
+    std::vector<size_t> createDirIndexes;
+    std::vector<CreateDirParam> createDirParams;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].isInstalled && results[i].result == ERR_OK) {
+            createDirIndexes.emplace_back(i);
+            createDirParams.emplace_back(results[i].createDirParam);
+        }
+    }
+    std::vector<ErrCode> createDirResults;
+    InstalldClient::GetInstance()->CreateBundleDataDirs(createDirParams, createDirResults);
+    for (size_t i = 0; i < createDirIndexes.size(); ++i) {
+        UserProvisionResult &item = results[createDirIndexes[i]];
+        item.result = (i < createDirResults.size()) ? createDirResults[i] : ERR_APPEXECFWK_PARCEL_ERROR;
+        if (item.result != ERR_OK) {
+            APP_LOGE("fail to create bundle data dir, error is %{public}d", item.result);
+            RemoveBundleDataDir(item.info);
+            BundlePermissionMgr::DeleteAccessTokenId(item.info.GetAccessTokenId(userId_));
+            continue;
+        }
+        UpdateBundleDataDirInfo(item.info, item.newInnerBundleUserInfo);
+        item.info.SetBundleInstallTime(BundleUtil::GetCurrentTime(), userId_);
+    }
+
+    std::map<std::string, InnerBundleUserInfo> newUserInfos;
+    for (size_t i = 0; i < bundleNames.size(); ++i) {
+        if (!results[i].isInstalled) {
+            uninstalledBundleNames.emplace_back(bundleNames[i]);
+            continue;
+        }
+        InnerBundleUserInfo innerBundleUserInfo;
+        if (results[i].result == ERR_OK && results[i].info.GetInnerBundleUserInfo(userId_, innerBundleUserInfo)) {
+            newUserInfos.emplace(bundleNames[i], innerBundleUserInfo);
+        }
+    }
+    std::vector<std::string> failedBundleNames;
+    if (!dataMgr_->AddInnerBundleUserInfos(newUserInfos, failedBundleNames)) {
+        APP_LOGE("save user infos of %{public}zu bundles failed when createNewUser", failedBundleNames.size());
+    }
+    // only the bundles whose user info is not saved lose their data dir and access token
+    std::set<std::string> failedBundles(failedBundleNames.begin(), failedBundleNames.end());
+    for (size_t i = 0; i < bundleNames.size(); ++i) {
+        UserProvisionResult &item = results[i];
+        if (item.isInstalled && item.result == ERR_OK && failedBundles.count(bundleNames[i]) > 0) {
+            RemoveBundleDataDir(item.info);
+            BundlePermissionMgr::DeleteAccessTokenId(item.info.GetAccessTokenId(userId_));
+            item.result = ERR_APPEXECFWK_INSTALL_BUNDLE_MGR_SERVICE_ERROR;
+        }
+    }
+    bundleLocks.clear();
+
+    ErrCode firstError = ERR_OK;
+    InstallParam installParam;
+    installParam.userId = userId_;
+    installParam.isPreInstallApp = true;
+    for (size_t i = 0; i < bundleNames.size(); ++i) {
+        UserProvisionResult &item = results[i];
+        if (!item.isInstalled) {
+            continue;
+        }
+        if (item.result != ERR_OK) {
+            APP_LOGE("add bundle %{public}s to user %{public}d failed %{public}d",
+                bundleNames[i].c_str(), userId_, item.result);
+            firstError = (firstError == ERR_OK) ? item.result : firstError;
+        }
+        dataMgr_->NotifyBundleStatus(bundleNames[i], Constants::EMPTY_STRING, Constants::EMPTY_STRING,
+            item.result, NotifyType::INSTALL, item.info.GetUid(userId_));
+        if (item.result == ERR_OK) {
+            DistributedDataStorage::GetInstance()->SaveStorageDistributeInfo(bundleNames[i], userId_);
+        }
+        versionCode_ = item.info.GetVersionCode();
+        SendBundleSystemEvent(bundleNames[i], BundleEventType::INSTALL, installParam,
+            InstallScene::CREATE_USER, item.result);
+    }
+    return firstError;
+}
+
 ErrCode BaseBundleInstaller::RemoveBundle(InnerBundleInfo &info, bool isKeepData)
 {
     ErrCode result = RemoveBundleAndDataDir(info, isKeepData);
@@ -1307,6 +1462,26 @@ ErrCode BaseBundleInstaller::CreateBundleCodeDir(InnerBundleInfo &info) const
 ErrCode BaseBundleInstaller::CreateBundleDataDir(InnerBundleInfo &info) const
 {
     InnerBundleUserInfo newInnerBundleUserInfo;
+    CreateDirParam createDirParam;
+    ErrCode result = GetCreateDirParam(info, newInnerBundleUserInfo, createDirParam);
+    if (result != ERR_OK) {
+        return result;
+    }
+
+    result = InstalldClient::GetInstance()->CreateBundleDataDir(createDirParam.bundleName, createDirParam.userId,
+        createDirParam.uid, createDirParam.gid, createDirParam.apl);
+    if (result != ERR_OK) {
+        APP_LOGE("fail to create bundle data dir, error is %{public}d", result);
+        return result;
+    }
+
+    UpdateBundleDataDirInfo(info, newInnerBundleUserInfo);
+    return ERR_OK;
+}
+
+ErrCode BaseBundleInstaller::GetCreateDirParam(const InnerBundleInfo &info,
+    InnerBundleUserInfo &newInnerBundleUserInfo, CreateDirParam &createDirParam) const
+{
     if (!info.GetInnerBundleUserInfo(userId_, newInnerBundleUserInfo)) {
         APP_LOGE("bundle(%{public}s) get user(%{public}d) failed.",
             info.GetBundleName().c_str(), userId_);
@@ -1318,18 +1493,21 @@ ErrCode BaseBundleInstaller::CreateBundleDataDir(InnerBundleInfo &info) const
         return ERR_APPEXECFWK_INSTALL_GENERATE_UID_ERROR;
     }
 
-    auto result = InstalldClient::GetInstance()->CreateBundleDataDir(info.GetBundleName(), userId_,
-        newInnerBundleUserInfo.uid, newInnerBundleUserInfo.uid, info.GetAppPrivilegeLevel());
-    if (result != ERR_OK) {
-        APP_LOGE("fail to create bundle data dir, error is %{public}d", result);
-        return result;
-    }
+    createDirParam.bundleName = info.GetBundleName();
+    createDirParam.userId = userId_;
+    createDirParam.uid = newInnerBundleUserInfo.uid;
+    createDirParam.gid = newInnerBundleUserInfo.uid;
+    createDirParam.apl = info.GetAppPrivilegeLevel();
+    return ERR_OK;
+}
 
+void BaseBundleInstaller::UpdateBundleDataDirInfo(InnerBundleInfo &info,
+    const InnerBundleUserInfo &newInnerBundleUserInfo) const
+{
     std::string dataBaseDir = Constants::BUNDLE_APP_DATA_BASE_DIR + Constants::BUNDLE_EL[1] +
         Constants::DATABASE + info.GetBundleName();
     info.SetAppDataBaseDir(dataBaseDir);
     info.AddInnerBundleUserInfo(newInnerBundleUserInfo);
-    return ERR_OK;
 }
 
 ErrCode BaseBundleInstaller::ExtractModule(InnerBundleInfo &info, const std::string &modulePath)
@@ -1462,27 +1640,6 @@ ErrCode BaseBundleInstaller::RemoveModuleDataDir(
     return result;
 }
 
-ErrCode BaseBundleInstaller::ParseBundleInfo(const std::string &bundleFilePath, InnerBundleInfo &info,
-    BundlePackInfo &packInfo) const
-{
-    BundleParser bundleParser;
-    ErrCode result = bundleParser.Parse(bundleFilePath, info);
-    if (result != ERR_OK) {
-        APP_LOGE("parse bundle info failed, error: %{public}d", result);
-        return result;
-    }
-    if (!packInfo.GetValid()) {
-        result = bundleParser.ParsePackInfo(bundleFilePath, packInfo);
-        if (result != ERR_OK) {
-            APP_LOGE("parse bundle pack info failed, error: %{public}d", result);
-            return result;
-        }
-        info.SetBundlePackInfo(packInfo);
-        packInfo.SetValid(true);
-    }
-    return ERR_OK;
-}
-
 ErrCode BaseBundleInstaller::ExtractModuleFiles(const InnerBundleInfo &info, const std::string &modulePath,
     const std::string &targetSoPath, const std::string &cpuAbi)
 {
@@ -1550,14 +1707,16 @@ ErrCode BaseBundleInstaller::CheckMultipleHapsSignInfo(const std::vector<std::st
         APP_LOGE("check hap sign info failed due to empty bundlePaths!");
         return ERR_APPEXECFWK_INSTALL_PARAM_ERROR;
     }
-    for (const std::string &bundlePath : bundlePaths) {
-        Security::Verify::HapVerifyResult hapVerifyResult;
-        auto verifyRes = BundleVerifyMgr::HapVerify(bundlePath, hapVerifyResult);
-        if (verifyRes != ERR_OK) {
-            APP_LOGE("hap file verify failed");
-            return verifyRes;
-        }
-        hapVerifyRes.emplace_back(hapVerifyResult);
+    // haps are verified concurrently, the error of the first failed hap in order is reported
+    std::vector<Security::Verify::HapVerifyResult> verifyResults(bundlePaths.size());
+    ErrCode verifyCode = ParallelTaskUtil::RunForFirstError(bundlePaths.size(), MAX_HAP_PROCESS_THREADS,
+        [&](size_t index) { return BundleVerifyMgr::HapVerify(bundlePaths[index], verifyResults[index]); });
+    if (verifyCode != ERR_OK) {
+        APP_LOGE("hap file verify failed");
+        return verifyCode;
+    }
+    for (auto &verifyResult : verifyResults) {
+        hapVerifyRes.emplace_back(std::move(verifyResult));
     }
     if (hapVerifyRes.empty()) {
         APP_LOGE("no sign info in the all haps!");
@@ -1594,12 +1753,18 @@ ErrCode BaseBundleInstaller::ParseHapFiles(const std::vector<std::string> &bundl
 {
     HITRACE_METER_NAME(HITRACE_TAG_APP, __PRETTY_FUNCTION__);
     APP_LOGD("Parse hap file");
-    ErrCode result = ERR_OK;
-    BundlePackInfo packInfo;
-    for (uint32_t i = 0; i < bundlePaths.size(); ++i) {
-        InnerBundleInfo newInfo;
+    if (hapVerifyRes.size() < bundlePaths.size()) {
+        APP_LOGE("hap verify results do not match the hap paths");
+        return ERR_APPEXECFWK_INSTALL_PARAM_ERROR;
+    }
+    // the profiles are parsed concurrently, the results are then checked in hap order so that
+    // the reported error is the same as a serial parse would give
+    std::vector<InnerBundleInfo> parsedInfos(bundlePaths.size());
+    std::vector<ErrCode> parseCodes(bundlePaths.size(), ERR_OK);
+    ParallelTaskUtil::Run(bundlePaths.size(), MAX_HAP_PROCESS_THREADS, [&](size_t index) {
+        InnerBundleInfo &newInfo = parsedInfos[index];
         newInfo.SetAppType(appType);
-        Security::Verify::ProvisionInfo provisionInfo = hapVerifyRes[i].GetProvisionInfo();
+        const Security::Verify::ProvisionInfo &provisionInfo = hapVerifyRes[index].GetProvisionInfo();
         bool isSystemApp = (provisionInfo.bundleInfo.appFeature == Constants::HOS_SYSTEM_APP ||
             provisionInfo.bundleInfo.appFeature == Constants::OHOS_SYSTEM_APP);
         if (isSystemApp) {
@@ -1607,10 +1772,28 @@ ErrCode BaseBundleInstaller::ParseHapFiles(const std::vector<std::string> &bundl
         }
         newInfo.SetUserId(installParam.userId);
         newInfo.SetIsPreInstallApp(installParam.isPreInstallApp);
-        result = ParseBundleInfo(bundlePaths[i], newInfo, packInfo);
-        if (result != ERR_OK) {
-            APP_LOGE("bundle parse failed %{public}d", result);
-            return result;
+        BundleParser bundleParser;
+        parseCodes[index] = bundleParser.Parse(bundlePaths[index], newInfo);
+    });
+
+    ErrCode result = ERR_OK;
+    BundlePackInfo packInfo;
+    for (uint32_t i = 0; i < bundlePaths.size(); ++i) {
+        InnerBundleInfo &newInfo = parsedInfos[i];
+        Security::Verify::ProvisionInfo provisionInfo = hapVerifyRes[i].GetProvisionInfo();
+        if (parseCodes[i] != ERR_OK) {
+            APP_LOGE("bundle parse failed %{public}d", parseCodes[i]);
+            return parseCodes[i];
+        }
+        if (!packInfo.GetValid()) {
+            BundleParser bundleParser;
+            result = bundleParser.ParsePackInfo(bundlePaths[i], packInfo);
+            if (result != ERR_OK) {
+                APP_LOGE("parse bundle pack info failed, error: %{public}d", result);
+                return result;
+            }
+            newInfo.SetBundlePackInfo(packInfo);
+            packInfo.SetValid(true);
         }
         if (newInfo.HasEntry()) {
             if (isContainEntry_) {
@@ -1631,7 +1814,7 @@ ErrCode BaseBundleInstaller::ParseHapFiles(const std::vector<std::string> &bundl
             return result;
         }
 
-        infos.emplace(bundlePaths[i], newInfo);
+        infos.emplace(bundlePaths[i], std::move(newInfo));
     }
     APP_LOGD("finish parse hap file");
     return result;
@@ -1741,8 +1924,8 @@ bool BaseBundleInstaller::GetInnerBundleInfo(InnerBundleInfo &info, bool &isAppE
             return false;
         }
     }
-    auto &mtx = dataMgr_->GetBundleMutex(bundleName_);
-    std::lock_guard lock { mtx };
+    auto mtx = dataMgr_->GetBundleMutex(bundleName_);
+    std::lock_guard lock { *mtx };
     isAppExist = dataMgr_->GetInnerBundleInfo(bundleName_, info);
     return true;
 }
@@ -15,8 +15,10 @@
 
 #include "bundle_data_mgr.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cinttypes>
+#include <functional>
 
 #ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
 #include "installd/installd_operator.h"
@@ -37,25 +39,99 @@
 #include "ipc_skeleton.h"
 #include "json_serializer.h"
 #include "nlohmann/json.hpp"
+#ifdef GLOBAL_RESMGR_ENABLE
+#include "parameters.h"
+#endif
 #include "free_install_params.h"
 #include "singleton.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+constexpr size_t MAX_BUNDLE_CHANGE_RECORD_SIZE = 512;
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+// the data of a bundle is measured again after it, the aging runs far less often
+constexpr int64_t DATA_SIZE_EXPIRE_MS = 60 * 60 * 1000;
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+#ifdef GLOBAL_RESMGR_ENABLE
+constexpr size_t MAX_RESOURCE_CACHE_SIZE = 16;
+#ifdef BUNDLE_FRAMEWORK_GRAPHICS
+constexpr size_t MAX_ICON_CACHE_SIZE = 4;
+#endif
+constexpr int32_t RESOURCE_WARM_UP_THREAD_NUMBER = 1;
+constexpr size_t LOCALE_SCRIPT_LENGTH = 4;
+const std::string LOCALE_PARAMETER = "persist.global.locale";
+const std::string DEFAULT_LOCALE_PARAMETER = "const.global.locale";
+const std::string DEFAULT_LOCALE = "zh-Hans-CN";
+const char LOCALE_SEPARATOR = '-';
+
+std::string GetSystemLocale()
+{
+    std::string locale = system::GetParameter(LOCALE_PARAMETER, "");
+    if (locale.empty()) {
+        locale = system::GetParameter(DEFAULT_LOCALE_PARAMETER, "");
+    }
+    return locale.empty() ? DEFAULT_LOCALE : locale;
+}
+
+// the locale is like zh-Hans-CN or en-US, the script has four letters
+void SetResConfigLocale(Global::Resource::ResConfig &resConfig, const std::string &locale)
+{
+    std::vector<std::string> subtags;
+    size_t start = 0;
+    while (start <= locale.size()) {
+        size_t end = locale.find(LOCALE_SEPARATOR, start);
+        if (end == std::string::npos) {
+            end = locale.size();
+        }
+        subtags.emplace_back(locale.substr(start, end - start));
+        start = end + 1;
+    }
+    std::string script;
+    std::string region;
+    for (size_t i = 1; i < subtags.size(); i++) {
+        if (subtags[i].size() == LOCALE_SCRIPT_LENGTH && script.empty() && region.empty()) {
+            script = subtags[i];
+        } else if (region.empty()) {
+            region = subtags[i];
+        }
+    }
+    resConfig.SetLocaleInfo(subtags[0].c_str(), script.empty() ? nullptr : script.c_str(),
+        region.empty() ? nullptr : region.c_str());
+}
+#endif
+}
+
 BundleDataMgr::BundleDataMgr()
 {
     InitStateTransferMap();
+    changeGeneration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
     dataStorage_ = std::make_shared<BundleDataStorageDatabase>();
     preInstallDataStorage_ = std::make_shared<PreInstallDataStorage>();
     distributedDataStorage_ = DistributedDataStorage::GetInstance();
     sandboxDataMgr_ = std::make_shared<BundleSandboxDataMgr>();
     bundleStateStorage_ = std::make_shared<BundleStateStorage>();
+    statusNotifier_ = std::make_shared<BundleStatusNotifier>();
+#ifdef GLOBAL_RESMGR_ENABLE
+    resourceLocale_ = GetSystemLocale();
+    resourceWarmUpPool_.Start(RESOURCE_WARM_UP_THREAD_NUMBER);
+#endif
     APP_LOGI("BundleDataMgr instance is created");
 }
 
 BundleDataMgr::~BundleDataMgr()
 {
     APP_LOGI("BundleDataMgr instance is destroyed");
+#ifdef GLOBAL_RESMGR_ENABLE
+    resourceWarmUpPool_.Stop();
+#endif
     installStates_.clear();
     transferStates_.clear();
     bundleInfos_.clear();
@@ -80,6 +156,7 @@ bool BundleDataMgr::LoadDataFromPersistentStorage()
     for (const auto &item : bundleInfos_) {
         std::lock_guard<std::mutex> lock(stateMutex_);
         installStates_.emplace(item.first, InstallState::INSTALL_SUCCESS);
+        UpdateInfoIndexes(item.first);
     }
 
     LoadAllPreInstallBundleInfos(preInstallBundleInfos_);
@@ -174,6 +251,17 @@ bool BundleDataMgr::UpdateBundleInstallState(const std::string &bundleName, cons
     for (auto previousState = stateRange.first; previousState != stateRange.second; ++previousState) {
         if (item->second == previousState->second) {
             APP_LOGD("update result:success, current:%{public}d, state:%{public}d", previousState->second, state);
+#ifdef GLOBAL_RESMGR_ENABLE
+            // the resources may be changed by the install, update or uninstall
+            DeleteBundleResourceCache(bundleName);
+            if (state == InstallState::INSTALL_SUCCESS) {
+                // a launcher usually queries the label and icon right after the install or update
+                PostResourceCacheWarmUp({ bundleName });
+            }
+#endif
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+            DeleteBundleSpaceSize(bundleName);
+#endif
             if (IsDeleteDataState(state)) {
                 installStates_.erase(item);
                 DeleteBundleInfo(bundleName, state);
@@ -212,6 +300,7 @@ bool BundleDataMgr::AddInnerBundleInfo(const std::string &bundleName, InnerBundl
         if (dataStorage_->SaveStorageBundleInfo(info)) {
             APP_LOGI("write storage success bundle:%{public}s", bundleName.c_str());
             bundleInfos_.emplace(bundleName, info);
+            UpdateInfoIndexes(bundleName);
             return true;
         }
     }
@@ -241,6 +330,7 @@ bool BundleDataMgr::SaveNewInfoToDB(const std::string &bundleName, InnerBundleIn
     if (dataStorage_->SaveStorageBundleInfo(info)) {
         APP_LOGI("clone newinfo write storage success bundle:%{public}s", Newbundlename.c_str());
         bundleInfos_.emplace(Newbundlename, info);
+        UpdateInfoIndexes(Newbundlename);
         return true;
     }
     APP_LOGD("SaveNewInfoToDB finish");
@@ -277,6 +367,7 @@ bool BundleDataMgr::AddNewModuleInfo(
         if (dataStorage_->SaveStorageBundleInfo(oldInfo)) {
             APP_LOGI("update storage success bundle:%{public}s", bundleName.c_str());
             bundleInfos_.at(bundleName) = oldInfo;
+            UpdateInfoIndexes(bundleName);
             return true;
         }
     }
@@ -306,6 +397,7 @@ bool BundleDataMgr::RemoveModuleInfo(
         if (dataStorage_->SaveStorageBundleInfo(oldInfo)) {
             APP_LOGI("update storage success bundle:%{public}s", bundleName.c_str());
             bundleInfos_.at(bundleName) = oldInfo;
+            UpdateInfoIndexes(bundleName);
             return true;
         }
         APP_LOGD("after delete modulePackage:%{public}s info", modulePackage.c_str());
@@ -335,6 +427,50 @@ bool BundleDataMgr::AddInnerBundleUserInfo(
     return true;
 }
 
+bool BundleDataMgr::AddInnerBundleUserInfos(const std::map<std::string, InnerBundleUserInfo> &newUserInfos,
+    std::vector<std::string> &failedBundleNames)
+{
+    APP_LOGD("AddInnerBundleUserInfos size:%{public}zu", newUserInfos.size());
+    std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    std::lock_guard<std::mutex> stateLock(stateMutex_);
+    std::vector<std::string> changedBundleNames;
+    std::vector<InnerBundleInfo> changedInfos;
+    changedBundleNames.reserve(newUserInfos.size());
+    changedInfos.reserve(newUserInfos.size());
+    for (const auto &item : newUserInfos) {
+        auto infoItem = bundleInfos_.find(item.first);
+        if (infoItem == bundleInfos_.end()) {
+            APP_LOGE("bundle info not exist %{public}s", item.first.c_str());
+            failedBundleNames.emplace_back(item.first);
+            continue;
+        }
+        InnerBundleInfo changedInfo = infoItem->second;
+        changedInfo.AddInnerBundleUserInfo(item.second);
+        changedInfo.SetBundleStatus(InnerBundleInfo::BundleStatus::ENABLED);
+        changedBundleNames.emplace_back(item.first);
+        changedInfos.emplace_back(std::move(changedInfo));
+    }
+    // the cache is only changed once the batch is saved, so a failed batch leaves every bundle as it was
+    if (!dataStorage_->SaveStorageBundleInfos(changedInfos)) {
+        APP_LOGE("update storage failed when add user infos");
+        // a batch larger than one storage write may be partly saved, the saved bundles are written back
+        std::vector<InnerBundleInfo> originalInfos;
+        originalInfos.reserve(changedBundleNames.size());
+        for (const auto &bundleName : changedBundleNames) {
+            originalInfos.emplace_back(bundleInfos_.at(bundleName));
+        }
+        if (!dataStorage_->SaveStorageBundleInfos(originalInfos)) {
+            APP_LOGE("restore storage failed when add user infos");
+        }
+        failedBundleNames.insert(failedBundleNames.end(), changedBundleNames.begin(), changedBundleNames.end());
+        return false;
+    }
+    for (size_t i = 0; i < changedInfos.size(); ++i) {
+        bundleInfos_.at(changedBundleNames[i]) = std::move(changedInfos[i]);
+    }
+    return failedBundleNames.empty();
+}
+
 bool BundleDataMgr::RemoveInnerBundleUserInfo(
     const std::string &bundleName, int32_t userId)
 {
@@ -356,6 +492,9 @@ bool BundleDataMgr::RemoveInnerBundleUserInfo(
     }
 
     bundleStateStorage_->DeleteBundleState(bundleName, userId);
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+    DeleteBundleSpaceSize(bundleName);
+#endif
     return true;
 }
 
@@ -400,6 +539,7 @@ bool BundleDataMgr::UpdateInnerBundleInfo(
         }
         APP_LOGI("update storage success bundle:%{public}s", bundleName.c_str());
         bundleInfos_.at(bundleName) = oldInfo;
+        UpdateInfoIndexes(bundleName);
         return true;
     }
     return false;
@@ -762,6 +902,28 @@ bool BundleDataMgr::QueryLauncherAbilityInfos(
     }
 }
 
+bool BundleDataMgr::GetDataAbilityUriAuthority(const std::string &abilityUri, std::string &authority)
+{
+    if (abilityUri.empty()) {
+        return false;
+    }
+    if (abilityUri.find(Constants::DATA_ABILITY_URI_PREFIX) == std::string::npos) {
+        return false;
+    }
+    std::string noPpefixUri = abilityUri.substr(Constants::DATA_ABILITY_URI_PREFIX.size());
+    auto posFirstSeparator = noPpefixUri.find(Constants::DATA_ABILITY_URI_SEPARATOR);
+    if (posFirstSeparator == std::string::npos) {
+        return false;
+    }
+    auto posSecondSeparator = noPpefixUri.find(Constants::DATA_ABILITY_URI_SEPARATOR, posFirstSeparator + 1);
+    if (posSecondSeparator == std::string::npos) {
+        authority = noPpefixUri.substr(posFirstSeparator + 1, noPpefixUri.size() - posFirstSeparator - 1);
+    } else {
+        authority = noPpefixUri.substr(posFirstSeparator + 1, posSecondSeparator - posFirstSeparator - 1);
+    }
+    return true;
+}
+
 bool BundleDataMgr::QueryAbilityInfoByUri(
     const std::string &abilityUri, int32_t userId, AbilityInfo &abilityInfo) const
 {
@@ -771,10 +933,8 @@ bool BundleDataMgr::QueryAbilityInfoByUri(
         return false;
     }
 
-    if (abilityUri.empty()) {
-        return false;
-    }
-    if (abilityUri.find(Constants::DATA_ABILITY_URI_PREFIX) == std::string::npos) {
+    std::string uri;
+    if (!GetDataAbilityUriAuthority(abilityUri, uri)) {
         return false;
     }
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
@@ -782,21 +942,13 @@ bool BundleDataMgr::QueryAbilityInfoByUri(
         APP_LOGE("bundleInfos_ data is empty");
         return false;
     }
-    std::string noPpefixUri = abilityUri.substr(Constants::DATA_ABILITY_URI_PREFIX.size());
-    auto posFirstSeparator = noPpefixUri.find(Constants::DATA_ABILITY_URI_SEPARATOR);
-    if (posFirstSeparator == std::string::npos) {
+    auto indexItems = abilityUriIndex_.Find(uri);
+    if (indexItems == nullptr) {
+        APP_LOGE("query abilityUri(%{private}s) failed.", abilityUri.c_str());
         return false;
     }
-    auto posSecondSeparator = noPpefixUri.find(Constants::DATA_ABILITY_URI_SEPARATOR, posFirstSeparator + 1);
-    std::string uri;
-    if (posSecondSeparator == std::string::npos) {
-        uri = noPpefixUri.substr(posFirstSeparator + 1, noPpefixUri.size() - posFirstSeparator - 1);
-    } else {
-        uri = noPpefixUri.substr(posFirstSeparator + 1, posSecondSeparator - posFirstSeparator - 1);
-    }
-
-    for (const auto &item : bundleInfos_) {
-        const InnerBundleInfo &info = item.second;
+    for (const auto &[bundleName, abilityKey] : *indexItems) {
+        const InnerBundleInfo &info = bundleInfos_.at(bundleName);
         if (info.IsDisabled()) {
             APP_LOGE("app %{public}s is disabled", info.GetBundleName().c_str());
             continue;
@@ -807,12 +959,7 @@ bool BundleDataMgr::QueryAbilityInfoByUri(
             continue;
         }
 
-        auto ability = info.FindAbilityInfoByUri(uri);
-        if (!ability) {
-            continue;
-        }
-
-        abilityInfo = (*ability);
+        abilityInfo = info.GetInnerAbilityInfos().at(abilityKey);
         info.GetApplicationInfo(
             ApplicationFlag::GET_BASIC_APPLICATION_INFO, responseUserId, abilityInfo.applicationInfo);
         return true;
@@ -825,10 +972,8 @@ bool BundleDataMgr::QueryAbilityInfoByUri(
 bool BundleDataMgr::QueryAbilityInfosByUri(const std::string &abilityUri, std::vector<AbilityInfo> &abilityInfos)
 {
     APP_LOGI("abilityUri is %{private}s", abilityUri.c_str());
-    if (abilityUri.empty()) {
-        return false;
-    }
-    if (abilityUri.find(Constants::DATA_ABILITY_URI_PREFIX) == std::string::npos) {
+    std::string uri;
+    if (!GetDataAbilityUriAuthority(abilityUri, uri)) {
         return false;
     }
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
@@ -836,26 +981,21 @@ bool BundleDataMgr::QueryAbilityInfosByUri(const std::string &abilityUri, std::v
         APP_LOGI("bundleInfos_ data is empty");
         return false;
     }
-    std::string noPpefixUri = abilityUri.substr(Constants::DATA_ABILITY_URI_PREFIX.size());
-    auto posFirstSeparator = noPpefixUri.find(Constants::DATA_ABILITY_URI_SEPARATOR);
-    if (posFirstSeparator == std::string::npos) {
+    auto indexItems = abilityUriIndex_.Find(uri);
+    if (indexItems == nullptr) {
         return false;
     }
-    auto posSecondSeparator = noPpefixUri.find(Constants::DATA_ABILITY_URI_SEPARATOR, posFirstSeparator + 1);
-    std::string uri;
-    if (posSecondSeparator == std::string::npos) {
-        uri = noPpefixUri.substr(posFirstSeparator + 1, noPpefixUri.size() - posFirstSeparator - 1);
-    } else {
-        uri = noPpefixUri.substr(posFirstSeparator + 1, posSecondSeparator - posFirstSeparator - 1);
-    }
-
-    for (auto &item : bundleInfos_) {
-        InnerBundleInfo &info = item.second;
+    int32_t userId = GetUserId();
+    for (const auto &[bundleName, abilityKey] : *indexItems) {
+        const InnerBundleInfo &info = bundleInfos_.at(bundleName);
         if (info.IsDisabled()) {
             APP_LOGI("app %{public}s is disabled", info.GetBundleName().c_str());
             continue;
         }
-        info.FindAbilityInfosByUri(uri, abilityInfos, GetUserId());
+        AbilityInfo abilityInfo = info.GetInnerAbilityInfos().at(abilityKey);
+        info.GetApplicationInfo(
+            ApplicationFlag::GET_APPLICATION_INFO_WITH_PERMISSION, userId, abilityInfo.applicationInfo);
+        abilityInfos.emplace_back(std::move(abilityInfo));
     }
     if (abilityInfos.size() == 0) {
         return false;
@@ -1151,57 +1291,81 @@ bool BundleDataMgr::GetInnerBundleInfoByUid(const int uid, InnerBundleInfo &inne
 int64_t BundleDataMgr::GetBundleSpaceSize(const std::string &bundleName) const
 {
     int32_t userId = AccountHelper::GetCurrentActiveUserId();
-    int64_t curSize = 0;
-    int64_t spaceSize = 0;
-    BundleInfo bundleInfo;
+    if (userId == Constants::INVALID_USERID) {
+        APP_LOGE("%{public}s no active user", bundleName.c_str());
+        return 0;
+    }
+    int64_t now = GetSteadyTimeMs();
+    BundleSpaceSize spaceSize;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(spaceSizeMutex_);
+        generation = spaceSizeGeneration_;
+        auto item = spaceSizes_.find(bundleName);
+        if (item != spaceSizes_.end() && item->second.userId == userId) {
+            if (now - item->second.dataSizeTime < DATA_SIZE_EXPIRE_MS) {
+                return item->second.codeSize + item->second.dataSize;
+            }
+            spaceSize = item->second;
+        }
+    }
 
-    if (userId != Constants::INVALID_USERID
-        && GetBundleInfo(bundleName, GET_ALL_APPLICATION_INFO, bundleInfo, userId) == true) {
-        if (!bundleInfo.applicationInfo.codePath.empty()) {
-            curSize = InstalldOperator::GetDiskUsage(bundleInfo.applicationInfo.codePath);
-            spaceSize += curSize;
-            APP_LOGI("Code %{public}s:%{public}" PRId64, bundleInfo.applicationInfo.codePath.c_str(), curSize);
+    if (spaceSize.userId == Constants::INVALID_USERID) {
+        BundleInfo bundleInfo;
+        if (!GetBundleInfo(bundleName, GET_ALL_APPLICATION_INFO, bundleInfo, userId)) {
+            APP_LOGI("%{public}s spaceSize:0", bundleName.c_str());
+            return 0;
         }
-        if (!bundleInfo.applicationInfo.dataDir.empty()) {
-            curSize = InstalldOperator::GetDiskUsage(bundleInfo.applicationInfo.dataDir);
-            spaceSize += curSize;
-            APP_LOGI("Data %{public}s:%{public}" PRId64, bundleInfo.applicationInfo.dataDir.c_str(), curSize);
+        spaceSize.userId = userId;
+        spaceSize.dataDir = bundleInfo.applicationInfo.dataDir;
+        if (!bundleInfo.applicationInfo.codePath.empty()) {
+            spaceSize.codeSize = InstalldOperator::GetDiskUsage(bundleInfo.applicationInfo.codePath);
+            APP_LOGI("Code %{public}s:%{public}" PRId64, bundleInfo.applicationInfo.codePath.c_str(),
+                spaceSize.codeSize);
         }
     }
+    spaceSize.dataSize = 0;
+    if (!spaceSize.dataDir.empty()) {
+        spaceSize.dataSize = InstalldOperator::GetDiskUsage(spaceSize.dataDir);
+        APP_LOGI("Data %{public}s:%{public}" PRId64, spaceSize.dataDir.c_str(), spaceSize.dataSize);
+    }
+    spaceSize.dataSizeTime = now;
 
-    APP_LOGI("%{public}s spaceSize:%{public}" PRId64, bundleName.c_str(), spaceSize);
-    return spaceSize;
+    std::lock_guard<std::mutex> lock(spaceSizeMutex_);
+    if (generation == spaceSizeGeneration_) {
+        spaceSizes_[bundleName] = spaceSize;
+    }
+    APP_LOGI("%{public}s spaceSize:%{public}" PRId64, bundleName.c_str(), spaceSize.codeSize + spaceSize.dataSize);
+    return spaceSize.codeSize + spaceSize.dataSize;
 }
 
 int64_t BundleDataMgr::GetAllFreeInstallBundleSpaceSize() const
 {
-    int32_t userId = AccountHelper::GetCurrentActiveUserId();
-    int64_t allSize = 0;
-    int64_t curSize = 0;
-    std::vector<BundleInfo> bundleInfos;
-
-    if (userId != Constants::INVALID_USERID
-        && GetBundleInfos(GET_ALL_APPLICATION_INFO, bundleInfos, userId) == true) {
-        for (const auto &item : bundleInfos) {
-            APP_LOGI("%{public}s freeInstall:%{public}d", item.name.c_str(), item.applicationInfo.isFreeInstallApp);
-            if (item.applicationInfo.isFreeInstallApp) {
-                if (!item.applicationInfo.codePath.empty()) {
-                    curSize = InstalldOperator::GetDiskUsage(item.applicationInfo.codePath);
-                    allSize += curSize;
-                    APP_LOGI("Code %{public}s:%{public}" PRId64, item.applicationInfo.codePath.c_str(), curSize);
-                }
-                if (!item.applicationInfo.dataDir.empty()) {
-                    curSize = InstalldOperator::GetDiskUsage(item.applicationInfo.dataDir);
-                    allSize += curSize;
-                    APP_LOGI("Data %{public}s:%{public}" PRId64, item.applicationInfo.dataDir.c_str(), curSize);
-                }
+    std::vector<std::string> bundleNames;
+    {
+        std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+        for (const auto &item : bundleInfos_) {
+            if (item.second.GetIsFreeInstallApp()) {
+                bundleNames.emplace_back(item.first);
             }
         }
     }
 
+    // the bundles not installed for the current user are measured as 0
+    int64_t allSize = 0;
+    for (const auto &bundleName : bundleNames) {
+        allSize += GetBundleSpaceSize(bundleName);
+    }
     APP_LOGI("All sfreeInstall:%{public}" PRId64, allSize);
     return allSize;
 }
+
+void BundleDataMgr::DeleteBundleSpaceSize(const std::string &bundleName) const
+{
+    std::lock_guard<std::mutex> lock(spaceSizeMutex_);
+    spaceSizeGeneration_++;
+    spaceSizes_.erase(bundleName);
+}
 #endif
 
 bool BundleDataMgr::GetBundlesForUid(const int uid, std::vector<std::string> &bundleNames) const
@@ -1279,7 +1443,7 @@ std::string BundleDataMgr::GetAbilityLabel(const std::string &bundleName, const
     const std::string &abilityName) const
 {
 #ifdef GLOBAL_RESMGR_ENABLE
-    std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    std::unique_lock<std::mutex> lock(bundleInfoMutex_);
     if (bundleInfos_.empty()) {
         APP_LOGW("bundleInfos_ data is empty");
         return Constants::EMPTY_STRING;
@@ -1301,24 +1465,46 @@ std::string BundleDataMgr::GetAbilityLabel(const std::string &bundleName, const
     if ((*ability).labelId == 0) {
         return (*ability).label;
     }
-    std::string abilityLabel;
-    BundleInfo bundleInfo;
-    innerBundleInfo.GetBundleInfo(0, bundleInfo, GetUserIdByCallingUid());
-    std::shared_ptr<OHOS::Global::Resource::ResourceManager> resourceManager = GetResourceManager(bundleInfo);
-    if (resourceManager == nullptr) {
-        APP_LOGE("InitResourceManager failed");
-        return Constants::EMPTY_STRING;
+    uint32_t labelId = static_cast<uint32_t>((*ability).labelId);
+    std::shared_ptr<BundleResourceCache> resourceCache = GetBundleResourceCache(innerBundleInfo);
+    lock.unlock();
+
+    // the resource is resolved without bundleInfoMutex_, only the queries of the same bundle wait for it
+    std::lock_guard<std::mutex> cacheLock(resourceCache->mutex);
+    return GetCachedLabel(*resourceCache, labelId);
+#else
+    APP_LOGW("GLOBAL_RESMGR_ENABLE is false");
+    return Constants::EMPTY_STRING;
+#endif
+}
+
+void BundleDataMgr::OnLocaleChanged()
+{
+#ifdef GLOBAL_RESMGR_ENABLE
+    std::string locale = GetSystemLocale();
+    std::vector<std::pair<uint64_t, std::string>> cachedBundles;
+    {
+        std::lock_guard<std::mutex> lock(resourceCacheMutex_);
+        if (locale == resourceLocale_) {
+            return;
+        }
+        APP_LOGI("locale changed to %{public}s, reload %{public}zu resource caches",
+            locale.c_str(), resourceCaches_.size());
+        resourceLocale_ = locale;
+        for (const auto &item : resourceCaches_) {
+            cachedBundles.emplace_back(item.second->lastUsedTime, item.first);
+        }
+        resourceCaches_.clear();
     }
-    OHOS::Global::Resource::RState errval =
-        resourceManager->GetStringById(static_cast<uint32_t>((*ability).labelId), abilityLabel);
-    if (errval != OHOS::Global::Resource::RState::SUCCESS) {
-        return Constants::EMPTY_STRING;
-    } else {
-        return abilityLabel;
+    // the most recently used bundle is resolved first
+    std::sort(cachedBundles.begin(), cachedBundles.end(), std::greater<>());
+    std::vector<std::string> bundleNames;
+    for (const auto &cachedBundle : cachedBundles) {
+        bundleNames.emplace_back(cachedBundle.second);
     }
+    PostResourceCacheWarmUp(bundleNames);
 #else
     APP_LOGW("GLOBAL_RESMGR_ENABLE is false");
-    return Constants::EMPTY_STRING;
 #endif
 }
 
@@ -1456,6 +1642,7 @@ void BundleDataMgr::DeleteBundleInfo(const std::string &bundleName, const Instal
             APP_LOGW("delete storage error name:%{public}s", bundleName.c_str());
         }
         bundleInfos_.erase(bundleName);
+        UpdateInfoIndexes(bundleName);
     }
 }
 
@@ -1483,36 +1670,46 @@ bool BundleDataMgr::IsAppOrAbilityInstalled(const std::string &bundleName) const
 
 bool BundleDataMgr::GetInnerBundleInfoWithFlags(const std::string &bundleName,
     const int32_t flags, InnerBundleInfo &info, int32_t userId) const
+{
+    const InnerBundleInfo *innerBundleInfo = FindInnerBundleInfoWithFlags(bundleName, flags, userId);
+    if (innerBundleInfo == nullptr) {
+        return false;
+    }
+    info = *innerBundleInfo;
+    return true;
+}
+
+const InnerBundleInfo *BundleDataMgr::FindInnerBundleInfoWithFlags(
+    const std::string &bundleName, const int32_t flags, int32_t userId) const
 {
     int32_t requestUserId = GetUserId(userId);
     if (requestUserId == Constants::INVALID_USERID) {
-        return false;
+        return nullptr;
     }
 
     if (bundleInfos_.empty()) {
         APP_LOGE("bundleInfos_ data is empty");
-        return false;
+        return nullptr;
     }
     APP_LOGD("GetInnerBundleInfoWithFlags: %{public}s", bundleName.c_str());
     auto item = bundleInfos_.find(bundleName);
     if (item == bundleInfos_.end()) {
         APP_LOGE("GetInnerBundleInfoWithFlags: bundleName not find");
-        return false;
+        return nullptr;
     }
     const InnerBundleInfo &innerBundleInfo = item->second;
     if (innerBundleInfo.IsDisabled()) {
         APP_LOGE("bundleName: %{public}s status is disabled", innerBundleInfo.GetBundleName().c_str());
-        return false;
+        return nullptr;
     }
 
     int32_t responseUserId = innerBundleInfo.GetResponseUserId(requestUserId);
     if (!(static_cast<uint32_t>(flags) & GET_APPLICATION_INFO_WITH_DISABLE)
         && !innerBundleInfo.GetApplicationEnabled(responseUserId)) {
         APP_LOGE("bundleName: %{public}s is disabled", innerBundleInfo.GetBundleName().c_str());
-        return false;
+        return nullptr;
     }
-    info = innerBundleInfo;
-    return true;
+    return &innerBundleInfo;
 }
 
 bool BundleDataMgr::GetInnerBundleInfo(const std::string &bundleName, InnerBundleInfo &info)
@@ -1747,7 +1944,7 @@ std::shared_ptr<Media::PixelMap> BundleDataMgr::GetAbilityPixelMapIcon(const std
     const std::string &moduleName, const std::string &abilityName) const
 {
 #ifdef GLOBAL_RESMGR_ENABLE
-    std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    std::unique_lock<std::mutex> lock(bundleInfoMutex_);
     if (bundleInfos_.empty()) {
         APP_LOGW("bundleInfos_ data is empty");
         return nullptr;
@@ -1763,28 +1960,13 @@ std::shared_ptr<Media::PixelMap> BundleDataMgr::GetAbilityPixelMapIcon(const std
         APP_LOGE("abilityName:%{public}s not find", abilityName.c_str());
         return nullptr;
     }
-    BundleInfo bundleInfo;
-    int32_t flags = 0;
-    infoItem->second.GetBundleInfo(flags, bundleInfo, GetUserId());
-    std::shared_ptr<Global::Resource::ResourceManager> resourceManager = GetResourceManager(bundleInfo);
-    if (resourceManager == nullptr) {
-        APP_LOGE("InitResourceManager failed");
-        return nullptr;
-    }
-    std::string iconPath;
-    OHOS::Global::Resource::RState iconPathErrval =
-        resourceManager->GetMediaById(static_cast<uint32_t>((*ability).iconId), iconPath);
-    if (iconPathErrval != OHOS::Global::Resource::RState::SUCCESS) {
-        APP_LOGE("GetMediaById iconPath failed");
-        return nullptr;
-    }
-    APP_LOGD("GetMediaById iconPath: %{private}s", iconPath.c_str());
-    auto pixelMapPtr = LoadImageFile(iconPath);
-    if (!pixelMapPtr) {
-        APP_LOGE("LoadImageFile failed");
-        return nullptr;
-    }
-    return pixelMapPtr;
+    uint32_t iconId = static_cast<uint32_t>((*ability).iconId);
+    std::shared_ptr<BundleResourceCache> resourceCache = GetBundleResourceCache(infoItem->second);
+    lock.unlock();
+
+    // the icon is decoded without bundleInfoMutex_, only the queries of the same bundle wait for it
+    std::lock_guard<std::mutex> cacheLock(resourceCache->mutex);
+    return GetCachedIcon(*resourceCache, iconId);
 #else
     APP_LOGW("GLOBAL_RESMGR_ENABLE is false");
     return nullptr;
@@ -1799,8 +1981,7 @@ std::shared_ptr<BundleSandboxDataMgr> BundleDataMgr::GetSandboxDataMgr() const
 bool BundleDataMgr::RegisterBundleStatusCallback(const sptr<IBundleStatusCallback> &bundleStatusCallback)
 {
     APP_LOGD("RegisterBundleStatusCallback %{public}s", bundleStatusCallback->GetBundleName().c_str());
-    std::lock_guard<std::mutex> lock(callbackMutex_);
-    callbackList_.emplace_back(bundleStatusCallback);
+    statusNotifier_->AddCallback(bundleStatusCallback);
     if (bundleStatusCallback->AsObject() != nullptr) {
         sptr<BundleStatusCallbackDeathRecipient> deathRecipient =
             new (std::nothrow) BundleStatusCallbackDeathRecipient();
@@ -1816,23 +1997,22 @@ bool BundleDataMgr::RegisterBundleStatusCallback(const sptr<IBundleStatusCallbac
 bool BundleDataMgr::ClearBundleStatusCallback(const sptr<IBundleStatusCallback> &bundleStatusCallback)
 {
     APP_LOGD("ClearBundleStatusCallback %{public}s", bundleStatusCallback->GetBundleName().c_str());
-    std::lock_guard<std::mutex> lock(callbackMutex_);
-    callbackList_.erase(std::remove_if(callbackList_.begin(),
-        callbackList_.end(),
-        [&](const sptr<IBundleStatusCallback> &callback) {
-            return callback->AsObject() == bundleStatusCallback->AsObject();
-        }),
-        callbackList_.end());
+    statusNotifier_->RemoveCallback(bundleStatusCallback);
     return true;
 }
 
 bool BundleDataMgr::UnregisterBundleStatusCallback()
 {
-    std::lock_guard<std::mutex> lock(callbackMutex_);
-    callbackList_.clear();
+    statusNotifier_->ClearCallbacks();
     return true;
 }
 
+bool BundleDataMgr::GetBundleStatusDeliveryStats(
+    const sptr<IBundleStatusCallback> &bundleStatusCallback, BundleStatusDeliveryStats &stats) const
+{
+    return statusNotifier_->GetDeliveryStats(bundleStatusCallback, stats);
+}
+
 bool BundleDataMgr::GenerateUidAndGid(InnerBundleUserInfo &innerBundleUserInfo)
 {
     if (innerBundleUserInfo.bundleName.empty()) {
@@ -2016,19 +2196,13 @@ bool BundleDataMgr::NotifyBundleStatus(const std::string& bundleName, const std:
         }
         return static_cast<uint8_t>(InstallType::INSTALL_CALLBACK);
     }();
-    {
-        std::lock_guard<std::mutex> lock(callbackMutex_);
-        for (const auto& callback : callbackList_) {
-            if (callback->GetBundleName() == bundleName) {
-                // if the msg needed, it could convert in the proxy node
-                callback->OnBundleStateChanged(installType, resultCode, Constants::EMPTY_STRING, bundleName);
-            }
-        }
-    }
+    // the subscribers are called on the notifier threads, a slow one does not delay the installer
+    statusNotifier_->Notify(installType, resultCode, bundleName);
 
     if (resultCode != ERR_OK) {
         return true;
     }
+    RecordBundleChange(bundleName, modulePackage, abilityName, type, GetUserIdByUid(uid));
     std::string eventData = [type]() -> std::string {
         switch (type) {
             case NotifyType::INSTALL:
@@ -2063,17 +2237,64 @@ bool BundleDataMgr::NotifyBundleStatus(const std::string& bundleName, const std:
     return true;
 }
 
-std::mutex &BundleDataMgr::GetBundleMutex(const std::string &bundleName)
+void BundleDataMgr::RecordBundleChange(const std::string &bundleName, const std::string &moduleName,
+    const std::string &abilityName, const NotifyType type, int32_t userId)
 {
-    bundleMutex_.lock_shared();
-    auto it = bundleMutexMap_.find(bundleName);
-    if (it == bundleMutexMap_.end()) {
-        bundleMutex_.unlock_shared();
-        std::unique_lock lock {bundleMutex_};
-        return bundleMutexMap_[bundleName];
+    BundleChangeRecord record;
+    record.changeType = [type]() -> BundleChangeType {
+        switch (type) {
+            case NotifyType::INSTALL:
+                return BundleChangeType::ADD;
+            case NotifyType::UNINSTALL_BUNDLE:
+                return BundleChangeType::REMOVE;
+            case NotifyType::UNINSTALL_MODULE:
+                return BundleChangeType::MODULE_REMOVE;
+            case NotifyType::ABILITY_ENABLE:
+                return BundleChangeType::ABILITY_STATE_CHANGE;
+            case NotifyType::APPLICATION_ENABLE:
+                return BundleChangeType::APPLICATION_STATE_CHANGE;
+            default:
+                return BundleChangeType::UPDATE;
+        }
+    }();
+    record.userId = userId;
+    record.bundleName = bundleName;
+    record.moduleName = moduleName;
+    record.abilityName = abilityName;
+
+    std::lock_guard<std::mutex> lock(changeRecordMutex_);
+    record.generation = ++changeGeneration_;
+    if (changeRecords_.size() >= MAX_BUNDLE_CHANGE_RECORD_SIZE) {
+        changeRecords_.pop_front();
     }
-    bundleMutex_.unlock_shared();
-    return it->second;
+    changeRecords_.emplace_back(record);
+}
+
+void BundleDataMgr::GetBundleChanges(int64_t generation, int32_t userId,
+    std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync) const
+{
+    std::lock_guard<std::mutex> lock(changeRecordMutex_);
+    currentGeneration = changeGeneration_;
+    // the oldest generation a caller may hold and still be answered incrementally
+    int64_t oldestGeneration = changeRecords_.empty() ? changeGeneration_ : changeRecords_.front().generation - 1;
+    if (generation < oldestGeneration || generation > changeGeneration_) {
+        APP_LOGI("generation %{public}" PRId64 " out of range, full sync needed", generation);
+        needFullSync = true;
+        return;
+    }
+    needFullSync = false;
+    auto iter = std::upper_bound(changeRecords_.begin(), changeRecords_.end(), generation,
+        [](int64_t value, const BundleChangeRecord &record) { return value < record.generation; });
+    for (; iter != changeRecords_.end(); ++iter) {
+        if (userId == Constants::ALL_USERID || iter->userId == userId || iter->userId == Constants::ALL_USERID) {
+            changeRecords.emplace_back(*iter);
+        }
+    }
+}
+
+std::shared_ptr<std::mutex> BundleDataMgr::GetBundleMutex(const std::string &bundleName)
+{
+    return bundleMutexRegistry_.GetMutex(bundleName);
 }
 
 bool BundleDataMgr::GetProvisionId(const std::string &bundleName, std::string &provisionId) const
@@ -2281,6 +2502,7 @@ bool BundleDataMgr::RemoveClonedBundleInfo(const std::string &bundleName)
             return false;
         }
         bundleInfos_.erase(bundleName);
+        UpdateInfoIndexes(bundleName);
     }
     return true;
 }
@@ -2658,13 +2880,13 @@ bool BundleDataMgr::ImplicitQueryExtensionInfos(
     } else {
         // query all
         for (const auto &item : bundleInfos_) {
-            InnerBundleInfo innerBundleInfo;
-            if (!GetInnerBundleInfoWithFlags(item.first, flags, innerBundleInfo, requestUserId)) {
+            const InnerBundleInfo *innerBundleInfo = FindInnerBundleInfoWithFlags(item.first, flags, requestUserId);
+            if (innerBundleInfo == nullptr) {
                 APP_LOGE("ImplicitQueryExtensionAbilityInfos failed");
                 continue;
             }
-            int32_t responseUserId = innerBundleInfo.GetResponseUserId(requestUserId);
-            GetMatchExtensionInfos(want, flags, responseUserId, innerBundleInfo, extensionInfos);
+            int32_t responseUserId = innerBundleInfo->GetResponseUserId(requestUserId);
+            GetMatchExtensionInfos(want, flags, responseUserId, *innerBundleInfo, extensionInfos);
         }
     }
     // sort by priority, descending order.
@@ -2678,18 +2900,19 @@ bool BundleDataMgr::ImplicitQueryExtensionInfos(
 void BundleDataMgr::GetMatchExtensionInfos(const Want &want, int32_t flags, const int32_t &userId,
     const InnerBundleInfo &info, std::vector<ExtensionAbilityInfo> &infos) const
 {
-    auto extensionSkillInfos = info.GetExtensionSkillInfos();
-    auto extensionInfos = info.GetInnerExtensionInfos();
+    const auto &extensionSkillInfos = info.GetExtensionSkillInfos();
+    const auto &extensionInfos = info.GetInnerExtensionInfos();
     for (const auto &skillInfos : extensionSkillInfos) {
         for (const auto &skill : skillInfos.second) {
             if (!skill.Match(want)) {
                 continue;
             }
-            if (extensionInfos.find(skillInfos.first) == extensionInfos.end()) {
+            auto extensionItem = extensionInfos.find(skillInfos.first);
+            if (extensionItem == extensionInfos.end()) {
                 APP_LOGW("cannot find the extension info with %{public}s", skillInfos.first.c_str());
                 break;
             }
-            ExtensionAbilityInfo extensionInfo = extensionInfos[skillInfos.first];
+            ExtensionAbilityInfo extensionInfo = extensionItem->second;
             if ((static_cast<uint32_t>(flags) & GET_ABILITY_INFO_WITH_APPLICATION) ==
                 GET_ABILITY_INFO_WITH_APPLICATION) {
                 info.GetApplicationInfo(
@@ -2716,22 +2939,21 @@ bool BundleDataMgr::QueryExtensionAbilityInfos(const ExtensionAbilityType &exten
         return false;
     }
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
-    for (const auto &item : bundleInfos_) {
-        InnerBundleInfo innerBundleInfo;
-        if (!GetInnerBundleInfoWithFlags(item.first, 0, innerBundleInfo, requestUserId)) {
+    auto indexItems = extensionTypeIndex_.Find(extensionType);
+    if (indexItems == nullptr) {
+        return true;
+    }
+    for (const auto &[bundleName, extensionKey] : *indexItems) {
+        const InnerBundleInfo *innerBundleInfo = FindInnerBundleInfoWithFlags(bundleName, 0, requestUserId);
+        if (innerBundleInfo == nullptr) {
             APP_LOGE("QueryExtensionAbilityInfos failed");
             continue;
         }
-        auto innerExtensionInfos = innerBundleInfo.GetInnerExtensionInfos();
-        int32_t responseUserId = innerBundleInfo.GetResponseUserId(requestUserId);
-        for (const auto &info : innerExtensionInfos) {
-            if (info.second.type == extensionType) {
-                ExtensionAbilityInfo extensionAbilityInfo = info.second;
-                innerBundleInfo.GetApplicationInfo(
-                    ApplicationFlag::GET_BASIC_APPLICATION_INFO, responseUserId, extensionAbilityInfo.applicationInfo);
-                extensionInfos.emplace_back(extensionAbilityInfo);
-            }
-        }
+        int32_t responseUserId = innerBundleInfo->GetResponseUserId(requestUserId);
+        ExtensionAbilityInfo extensionAbilityInfo = innerBundleInfo->GetInnerExtensionInfos().at(extensionKey);
+        innerBundleInfo->GetApplicationInfo(
+            ApplicationFlag::GET_BASIC_APPLICATION_INFO, responseUserId, extensionAbilityInfo.applicationInfo);
+        extensionInfos.emplace_back(std::move(extensionAbilityInfo));
     }
     return true;
 }
@@ -2793,8 +3015,13 @@ bool BundleDataMgr::QueryExtensionAbilityInfoByUri(const std::string &uri, int32
         APP_LOGE("bundleInfos_ data is empty");
         return false;
     }
-    for (const auto &item : bundleInfos_) {
-        const InnerBundleInfo &info = item.second;
+    auto indexItems = extensionUriIndex_.Find(convertUri);
+    if (indexItems == nullptr) {
+        APP_LOGE("QueryExtensionAbilityInfoByUri (%{private}s) failed.", uri.c_str());
+        return false;
+    }
+    for (const auto &[bundleName, extensionKey] : *indexItems) {
+        const InnerBundleInfo &info = bundleInfos_.at(bundleName);
         if (info.IsDisabled()) {
             APP_LOGE("app %{public}s is disabled", info.GetBundleName().c_str());
             continue;
@@ -2805,10 +3032,10 @@ bool BundleDataMgr::QueryExtensionAbilityInfoByUri(const std::string &uri, int32
             continue;
         }
 
-        bool ret = info.FindExtensionAbilityInfoByUri(convertUri, extensionAbilityInfo);
-        if (!ret) {
-            continue;
-        }
+        extensionAbilityInfo = info.GetInnerExtensionInfos().at(extensionKey);
+        APP_LOGD("find target extension, bundleName : %{public}s, moduleName : %{public}s, name : %{public}s",
+            extensionAbilityInfo.bundleName.c_str(), extensionAbilityInfo.moduleName.c_str(),
+            extensionAbilityInfo.name.c_str());
         info.GetApplicationInfo(
             ApplicationFlag::GET_BASIC_APPLICATION_INFO, responseUserId, extensionAbilityInfo.applicationInfo);
         return true;
@@ -2833,12 +3060,38 @@ void BundleDataMgr::GetAllUriPrefix(std::vector<std::string> &uriPrefixList, int
     }
 }
 
+void BundleDataMgr::UpdateInfoIndexes(const std::string &bundleName)
+{
+    abilityUriIndex_.Remove(bundleName);
+    extensionUriIndex_.Remove(bundleName);
+    extensionTypeIndex_.Remove(bundleName);
+    auto infoItem = bundleInfos_.find(bundleName);
+    if (infoItem == bundleInfos_.end()) {
+        return;
+    }
+    for (const auto &[key, abilityInfo] : infoItem->second.GetInnerAbilityInfos()) {
+        if (abilityInfo.uri.size() < Constants::DATA_ABILITY_URI_PREFIX.size()) {
+            continue;
+        }
+        abilityUriIndex_.Add(abilityInfo.uri.substr(Constants::DATA_ABILITY_URI_PREFIX.size()), bundleName, key);
+    }
+    for (const auto &[key, extensionInfo] : infoItem->second.GetInnerExtensionInfos()) {
+        if (!extensionInfo.uri.empty()) {
+            extensionUriIndex_.Add(extensionInfo.uri, bundleName, key);
+        }
+        extensionTypeIndex_.Add(extensionInfo.type, bundleName, key);
+    }
+}
+
 #ifdef GLOBAL_RESMGR_ENABLE
 std::shared_ptr<Global::Resource::ResourceManager> BundleDataMgr::GetResourceManager(
-    const AppExecFwk::BundleInfo &bundleInfo) const
+    const std::vector<std::string> &moduleResPaths, const std::string &locale) const
 {
     std::shared_ptr<Global::Resource::ResourceManager> resourceManager(Global::Resource::CreateResourceManager());
-    for (auto moduleResPath : bundleInfo.moduleResPaths) {
+    if (resourceManager == nullptr) {
+        return nullptr;
+    }
+    for (const auto &moduleResPath : moduleResPaths) {
         if (!moduleResPath.empty()) {
             APP_LOGD("DistributedBms::InitResourceManager, moduleResPath: %{private}s", moduleResPath.c_str());
             if (!resourceManager->AddResource(moduleResPath.c_str())) {
@@ -2848,10 +3101,187 @@ std::shared_ptr<Global::Resource::ResourceManager> BundleDataMgr::GetResourceMan
     }
 
     std::unique_ptr<Global::Resource::ResConfig> resConfig(Global::Resource::CreateResConfig());
-    resConfig->SetLocaleInfo("zh", "Hans", "CN");
+    if (resConfig == nullptr) {
+        return nullptr;
+    }
+    SetResConfigLocale(*resConfig, locale);
     resourceManager->UpdateResConfig(*resConfig);
     return resourceManager;
 }
+
+std::shared_ptr<BundleDataMgr::BundleResourceCache> BundleDataMgr::GetBundleResourceCache(
+    const InnerBundleInfo &innerBundleInfo) const
+{
+    std::lock_guard<std::mutex> lock(resourceCacheMutex_);
+    const std::string &bundleName = innerBundleInfo.GetBundleName();
+    auto item = resourceCaches_.find(bundleName);
+    if (item != resourceCaches_.end()) {
+        item->second->lastUsedTime = ++resourceCacheClock_;
+        return item->second;
+    }
+    if (resourceCaches_.size() >= MAX_RESOURCE_CACHE_SIZE) {
+        auto leastUsed = std::min_element(resourceCaches_.begin(), resourceCaches_.end(),
+            [](const auto &left, const auto &right) {
+                return left.second->lastUsedTime < right.second->lastUsedTime;
+            });
+        resourceCaches_.erase(leastUsed);
+    }
+    auto resourceCache = std::make_shared<BundleResourceCache>();
+    innerBundleInfo.GetModuleResPaths(resourceCache->moduleResPaths);
+    resourceCache->locale = resourceLocale_;
+    resourceCache->lastUsedTime = ++resourceCacheClock_;
+    resourceCaches_.emplace(bundleName, resourceCache);
+    return resourceCache;
+}
+
+std::shared_ptr<Global::Resource::ResourceManager> BundleDataMgr::GetCachedResourceManager(
+    BundleResourceCache &resourceCache) const
+{
+    // resourceCache.mutex must be held by the caller
+    if (resourceCache.resourceManager == nullptr) {
+        resourceCache.resourceManager = GetResourceManager(resourceCache.moduleResPaths, resourceCache.locale);
+    }
+    return resourceCache.resourceManager;
+}
+
+std::string BundleDataMgr::GetCachedLabel(BundleResourceCache &resourceCache, uint32_t labelId) const
+{
+    auto labelItem = resourceCache.labels.find(labelId);
+    if (labelItem != resourceCache.labels.end()) {
+        return labelItem->second;
+    }
+    std::shared_ptr<Global::Resource::ResourceManager> resourceManager = GetCachedResourceManager(resourceCache);
+    if (resourceManager == nullptr) {
+        APP_LOGE("InitResourceManager failed");
+        return Constants::EMPTY_STRING;
+    }
+    std::string label;
+    Global::Resource::RState errval = resourceManager->GetStringById(labelId, label);
+    if (errval != Global::Resource::RState::SUCCESS) {
+        return Constants::EMPTY_STRING;
+    }
+    resourceCache.labels.emplace(labelId, label);
+    return label;
+}
+
+#ifdef BUNDLE_FRAMEWORK_GRAPHICS
+std::shared_ptr<Media::PixelMap> BundleDataMgr::GetCachedIcon(BundleResourceCache &resourceCache,
+    uint32_t iconId) const
+{
+    auto iconItem = resourceCache.icons.find(iconId);
+    if (iconItem != resourceCache.icons.end()) {
+        return iconItem->second;
+    }
+    // the icon store of DBMS only keeps the resized and compressed renditions sent to remote devices,
+    // a local query needs the icon in full size, so it is decoded from the resource of the bundle
+    std::shared_ptr<Global::Resource::ResourceManager> resourceManager = GetCachedResourceManager(resourceCache);
+    if (resourceManager == nullptr) {
+        APP_LOGE("InitResourceManager failed");
+        return nullptr;
+    }
+    std::string iconPath;
+    Global::Resource::RState iconPathErrval = resourceManager->GetMediaById(iconId, iconPath);
+    if (iconPathErrval != Global::Resource::RState::SUCCESS) {
+        APP_LOGE("GetMediaById iconPath failed");
+        return nullptr;
+    }
+    APP_LOGD("GetMediaById iconPath: %{private}s", iconPath.c_str());
+    auto pixelMapPtr = LoadImageFile(iconPath);
+    if (!pixelMapPtr) {
+        APP_LOGE("LoadImageFile failed");
+        return nullptr;
+    }
+    if (resourceCache.icons.size() >= MAX_ICON_CACHE_SIZE) {
+        resourceCache.icons.erase(resourceCache.icons.begin());
+    }
+    resourceCache.icons.emplace(iconId, pixelMapPtr);
+    return pixelMapPtr;
+}
+#endif
+
+void BundleDataMgr::DeleteBundleResourceCache(const std::string &bundleName) const
+{
+    // a query holding the removed cache still finishes with it, the cache is released after that
+    std::lock_guard<std::mutex> lock(resourceCacheMutex_);
+    resourceCaches_.erase(bundleName);
+}
+
+void BundleDataMgr::PostResourceCacheWarmUp(const std::vector<std::string> &bundleNames)
+{
+    {
+        std::lock_guard<std::mutex> lock(resourceCacheMutex_);
+        for (const auto &bundleName : bundleNames) {
+            if (std::find(warmUpBundleNames_.begin(), warmUpBundleNames_.end(), bundleName) !=
+                warmUpBundleNames_.end()) {
+                continue;
+            }
+            warmUpBundleNames_.emplace_back(bundleName);
+            // the caches of the older ones would be dropped by the newer ones anyway
+            if (warmUpBundleNames_.size() > MAX_RESOURCE_CACHE_SIZE) {
+                warmUpBundleNames_.pop_front();
+            }
+        }
+        if (warmUpRunning_ || warmUpBundleNames_.empty()) {
+            return;
+        }
+        warmUpRunning_ = true;
+    }
+    resourceWarmUpPool_.AddTask([this] { RunResourceCacheWarmUp(); });
+}
+
+void BundleDataMgr::RunResourceCacheWarmUp()
+{
+    while (true) {
+        std::string bundleName;
+        {
+            std::lock_guard<std::mutex> lock(resourceCacheMutex_);
+            if (warmUpBundleNames_.empty()) {
+                warmUpRunning_ = false;
+                return;
+            }
+            bundleName = warmUpBundleNames_.front();
+            warmUpBundleNames_.pop_front();
+        }
+        WarmUpBundleResourceCache(bundleName);
+    }
+}
+
+void BundleDataMgr::WarmUpBundleResourceCache(const std::string &bundleName)
+{
+    std::set<uint32_t> labelIds;
+    std::set<uint32_t> iconIds;
+    std::unique_lock<std::mutex> lock(bundleInfoMutex_);
+    auto infoItem = bundleInfos_.find(bundleName);
+    if (infoItem == bundleInfos_.end() || infoItem->second.IsDisabled()) {
+        return;
+    }
+    for (const auto &ability : infoItem->second.GetInnerAbilityInfos()) {
+        if (ability.second.labelId != 0) {
+            labelIds.insert(static_cast<uint32_t>(ability.second.labelId));
+        }
+        if (ability.second.iconId != 0) {
+            iconIds.insert(static_cast<uint32_t>(ability.second.iconId));
+        }
+    }
+    std::shared_ptr<BundleResourceCache> resourceCache = GetBundleResourceCache(infoItem->second);
+    lock.unlock();
+
+    APP_LOGD("warm up resource cache of %{public}s", bundleName.c_str());
+    std::lock_guard<std::mutex> cacheLock(resourceCache->mutex);
+    if (GetCachedResourceManager(*resourceCache) == nullptr) {
+        return;
+    }
+    for (uint32_t labelId : labelIds) {
+        GetCachedLabel(*resourceCache, labelId);
+    }
+#ifdef BUNDLE_FRAMEWORK_GRAPHICS
+    size_t iconCount = 0;
+    for (auto iconId = iconIds.begin(); iconId != iconIds.end() && iconCount < MAX_ICON_CACHE_SIZE;
+        ++iconId, ++iconCount) {
+        GetCachedIcon(*resourceCache, *iconId);
+    }
+#endif
+}
 #endif
 
 #ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
@@ -15,6 +15,7 @@
 
 #include "bundle_data_storage_database.h"
 
+#include <algorithm>
 #include <unistd.h>
 
 #include "app_log_wrapper.h"
@@ -30,6 +31,7 @@ namespace AppExecFwk {
 namespace {
 const int32_t MAX_TIMES = 600;              // 1min
 const int32_t SLEEP_INTERVAL = 100 * 1000;  // 100ms
+const size_t MAX_BATCH_ENTRIES = 128;       // limit of one PutBatch call
 }  // namespace
 
 BundleDataStorageDatabase::BundleDataStorageDatabase()
@@ -155,6 +157,40 @@ bool BundleDataStorageDatabase::SaveStorageBundleInfo(const InnerBundleInfo &inn
     return true;
 }
 
+bool BundleDataStorageDatabase::SaveStorageBundleInfos(const std::vector<InnerBundleInfo> &innerBundleInfos)
+{
+    APP_LOGI("save %{public}zu bundle data", innerBundleInfos.size());
+    if (innerBundleInfos.empty()) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(kvStorePtrMutex_);
+    if (!CheckKvStore()) {
+        APP_LOGE("kvStore is nullptr");
+        return false;
+    }
+    for (size_t begin = 0; begin < innerBundleInfos.size(); begin += MAX_BATCH_ENTRIES) {
+        size_t end = std::min(begin + MAX_BATCH_ENTRIES, innerBundleInfos.size());
+        std::vector<Entry> entries;
+        entries.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            Entry entry;
+            entry.key = Key(innerBundleInfos[i].GetBundleName());
+            entry.value = Value(innerBundleInfos[i].ToString());
+            entries.emplace_back(entry);
+        }
+        Status status = kvStorePtr_->PutBatch(entries);
+        if (status == Status::IPC_ERROR) {
+            status = kvStorePtr_->PutBatch(entries);
+            APP_LOGW("distribute database ipc error and try to call again, result = %{public}d", status);
+        }
+        if (status != Status::SUCCESS) {
+            APP_LOGE("put batch to kvStore error: %{public}d", status);
+            return false;
+        }
+    }
+    return true;
+}
+
 bool BundleDataStorageDatabase::DeleteStorageBundleInfo(const InnerBundleInfo &innerBundleInfo)
 {
     APP_LOGI("delete bundle data");
@@ -473,6 +473,11 @@ bool BundleInstallerHost::DestoryBundleStreamInstaller(uint32_t streamInstallerI
     return true;
 }
 
+std::shared_ptr<BundleInstallerManager> BundleInstallerHost::GetInstallerManager() const
+{
+    return manager_;
+}
+
 bool BundleInstallerHost::CheckBundleInstallerManager(const sptr<IStatusReceiver> &statusReceiver) const
 {
     if (statusReceiver == nullptr) {
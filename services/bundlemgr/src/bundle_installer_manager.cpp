@@ -15,6 +15,7 @@
 
 #include "bundle_installer_manager.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "appexecfwk_errors.h"
@@ -70,7 +71,8 @@ void BundleInstallerManager::CreateInstallTask(
         installer->Install(bundleFilePath, installParam);
         XCollieHelper::CancelTimer(timerId);
     };
-    installersPool_.AddTask(task);
+    // the bundle name is parsed by the installer, the bundle mutex serializes it with other tasks
+    AddTask("", task);
 }
 
 void BundleInstallerManager::CreateRecoverTask(
@@ -86,7 +88,7 @@ void BundleInstallerManager::CreateRecoverTask(
         installer->Recover(bundleName, installParam);
         XCollieHelper::CancelTimer(timerId);
     };
-    installersPool_.AddTask(task);
+    AddTask(bundleName, task);
 }
 
 void BundleInstallerManager::CreateInstallTask(const std::vector<std::string> &bundleFilePaths,
@@ -102,7 +104,7 @@ void BundleInstallerManager::CreateInstallTask(const std::vector<std::string> &b
         installer->Install(bundleFilePaths, installParam);
         XCollieHelper::CancelTimer(timerId);
     };
-    installersPool_.AddTask(task);
+    AddTask("", task);
 }
 
 void BundleInstallerManager::CreateInstallByBundleNameTask(const std::string &bundleName,
@@ -119,7 +121,7 @@ void BundleInstallerManager::CreateInstallByBundleNameTask(const std::string &bu
         installer->InstallByBundleName(bundleName, installParam);
         XCollieHelper::CancelTimer(timerId);
     };
-    installersPool_.AddTask(task);
+    AddTask(bundleName, task);
 }
 
 void BundleInstallerManager::CreateUninstallTask(
@@ -135,7 +137,7 @@ void BundleInstallerManager::CreateUninstallTask(
         installer->Uninstall(bundleName, installParam);
         XCollieHelper::CancelTimer(timerId);
     };
-    installersPool_.AddTask(task);
+    AddTask(bundleName, task);
 }
 
 void BundleInstallerManager::CreateUninstallTask(const std::string &bundleName, const std::string &modulePackage,
@@ -151,7 +153,7 @@ void BundleInstallerManager::CreateUninstallTask(const std::string &bundleName,
         installer->Uninstall(bundleName, modulePackage, installParam);
         XCollieHelper::CancelTimer(timerId);
     };
-    installersPool_.AddTask(task);
+    AddTask(bundleName, task);
 }
 
 std::shared_ptr<BundleInstaller> BundleInstallerManager::CreateInstaller(const sptr<IStatusReceiver> &statusReceiver)
@@ -178,6 +180,80 @@ std::shared_ptr<BundleInstaller> BundleInstallerManager::CreateInstaller(const s
     return installer;
 }
 
+void BundleInstallerManager::AddTask(const std::string &bundleName, const std::function<void()> &task)
+{
+    int64_t enqueueTime = GetTickCount();
+    if (bundleName.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(taskMutex_);
+            stats_.pendingTaskCount++;
+        }
+        installersPool_.AddTask([this, task, enqueueTime] {
+            RecordWaitTime(enqueueTime);
+            task();
+        });
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        stats_.pendingTaskCount++;
+        auto item = bundleTasks_.find(bundleName);
+        if (item != bundleTasks_.end()) {
+            // a task of the bundle is running, this one is started by the same pool thread after it
+            item->second.push_back({ task, enqueueTime });
+            stats_.maxBundleQueueDepth = std::max(stats_.maxBundleQueueDepth, item->second.size());
+            APP_LOGD("queue task of %{public}s, depth %{public}zu", bundleName.c_str(), item->second.size());
+            return;
+        }
+        bundleTasks_[bundleName].push_back({ task, enqueueTime });
+        stats_.maxBundleQueueDepth = std::max(stats_.maxBundleQueueDepth, static_cast<size_t>(1));
+    }
+    installersPool_.AddTask([this, bundleName] { RunBundleTasks(bundleName); });
+}
+
+void BundleInstallerManager::RunBundleTasks(const std::string &bundleName)
+{
+    while (true) {
+        QueuedTask queuedTask;
+        {
+            std::lock_guard<std::mutex> lock(taskMutex_);
+            auto item = bundleTasks_.find(bundleName);
+            if (item == bundleTasks_.end()) {
+                return;
+            }
+            if (item->second.empty()) {
+                bundleTasks_.erase(item);
+                return;
+            }
+            queuedTask = std::move(item->second.front());
+            item->second.pop_front();
+        }
+        RecordWaitTime(queuedTask.enqueueTime);
+        queuedTask.task();
+    }
+}
+
+void BundleInstallerManager::RecordWaitTime(int64_t enqueueTime)
+{
+    int64_t waitTime = GetTickCount() - enqueueTime;
+    APP_LOGD("installer task waits %{public}" PRId64 " ms", waitTime);
+    std::lock_guard<std::mutex> lock(taskMutex_);
+    if (stats_.pendingTaskCount > 0) {
+        stats_.pendingTaskCount--;
+    }
+    stats_.startedTaskCount++;
+    stats_.totalWaitTimeMs += waitTime;
+    stats_.maxWaitTimeMs = std::max(stats_.maxWaitTimeMs, waitTime);
+}
+
+InstallerQueueStats BundleInstallerManager::GetQueueStats() const
+{
+    std::lock_guard<std::mutex> lock(taskMutex_);
+    InstallerQueueStats stats = stats_;
+    stats.runningBundleCount = bundleTasks_.size();
+    return stats;
+}
+
 void BundleInstallerManager::RemoveInstaller(const int64_t installerId)
 {
     APP_LOGD("start to remove installer the specific %{public}" PRId64 " installer", installerId);
@@ -15,6 +15,7 @@
 
 #include "bundle_mgr_host_impl.h"
 
+#include <cinttypes>
 #include <dirent.h>
 #include <future>
 
@@ -574,7 +575,7 @@ void BundleMgrHostImpl::CleanBundleCacheTask(const std::string &bundleName,
         rootDir.emplace_back(dataDir);
     }
 
-    auto cleanCache = [bundleName, userId, rootDir, cleanCacheCallback]() {
+    auto cleanCache = [this, bundleName, userId, rootDir, cleanCacheCallback]() {
         std::vector<std::string> caches;
         for (const auto &st : rootDir) {
             std::vector<std::string> cache;
@@ -596,6 +597,12 @@ void BundleMgrHostImpl::CleanBundleCacheTask(const std::string &bundleName,
             }
         }
 
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+        auto dataMgr = GetDataMgrFromService();
+        if (dataMgr != nullptr) {
+            dataMgr->DeleteBundleSpaceSize(bundleName);
+        }
+#endif
         EventReport::SendCleanCacheSysEvent(bundleName, userId, true, error);
         APP_LOGD("CleanBundleCacheFiles with error %{public}d", error);
         cleanCacheCallback->OnCleanCacheFinished(error);
@@ -651,6 +658,12 @@ bool BundleMgrHostImpl::CleanBundleDataFiles(const std::string &bundleName, cons
         return false;
     }
 
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+    auto dataMgr = GetDataMgrFromService();
+    if (dataMgr != nullptr) {
+        dataMgr->DeleteBundleSpaceSize(bundleName);
+    }
+#endif
     EventReport::SendCleanCacheSysEvent(bundleName, userId, false, false);
     return true;
 }
@@ -1584,5 +1597,22 @@ ErrCode BundleMgrHostImpl::GetSandboxBundleInfo(
     }
     return sandboxDataMgr->GetSandboxAppBundleInfo(bundleName, appIndex, userId, info);
 }
+
+bool BundleMgrHostImpl::GetBundleChanges(int64_t generation, int32_t userId,
+    std::vector<BundleChangeRecord> &changeRecords, int64_t &currentGeneration, bool &needFullSync)
+{
+    APP_LOGD("start GetBundleChanges, generation : %{public}" PRId64 ", userId : %{public}d", generation, userId);
+    if (!BundlePermissionMgr::VerifyCallingPermission(Constants::LISTEN_BUNDLE_CHANGE)) {
+        APP_LOGE("get bundle changes failed due to lack of permission");
+        return false;
+    }
+    auto dataMgr = GetDataMgrFromService();
+    if (dataMgr == nullptr) {
+        APP_LOGE("DataMgr is nullptr");
+        return false;
+    }
+    dataMgr->GetBundleChanges(generation, userId, changeRecords, currentGeneration, needFullSync);
+    return true;
+}
 }  // namespace AppExecFwk
 }  // namespace OHOS
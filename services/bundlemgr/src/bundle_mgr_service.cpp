@@ -91,6 +91,7 @@ void BundleMgrService::AfterRegisterToService()
     if (distributedSub_ == nullptr) {
         EventFwk::MatchingSkills matchingSkills;
         matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_USER_SWITCHED);
+        matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_LOCALE_CHANGED);
         EventFwk::CommonEventSubscribeInfo subscribeInfo(matchingSkills);
         distributedSub_ = std::make_shared<DistributedMonitor>(dataMgr_, subscribeInfo);
         EventFwk::CommonEventManager::SubscribeCommonEvent(distributedSub_);
@@ -197,7 +198,7 @@ bool BundleMgrService::Init()
 
     if (hidumpHelper_ == nullptr) {
         APP_LOGI("Create hidump helper");
-        hidumpHelper_ = std::make_shared<HidumpHelper>(dataMgr_);
+        hidumpHelper_ = std::make_shared<HidumpHelper>(dataMgr_, installer_->GetInstallerManager());
     }
 
 #ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
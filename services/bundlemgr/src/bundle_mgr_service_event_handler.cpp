@@ -15,6 +15,7 @@
 
 #include "bundle_mgr_service_event_handler.h"
 
+#include <algorithm>
 #include <future>
 
 #include "app_log_wrapper.h"
@@ -35,6 +36,7 @@ namespace AppExecFwk {
 namespace {
 const std::string APP_SUFFIX = "/app";
 const std::string PRODUCT_SUFFIX = "/etc/bundle";
+const std::string BUNDLE_PARSE_CACHE_PATH = Constants::BUNDLE_MANAGER_SERVICE_PATH + "/bundle_parse_cache";
 
 std::string GetScanBundleName(const std::string &str)
 {
@@ -292,8 +294,14 @@ void BMSEventHandler::ProcessRebootBundle(int32_t userId)
         return;
     }
 
+    parseCache_ = std::make_shared<BundleParseCache>(BUNDLE_PARSE_CACHE_PATH);
+    parseCache_->Load();
     ProcessRebootBundleInstall();
     ProcessRebootBundleUninstall();
+    if (!parseCache_->Save()) {
+        APP_LOGW("save bundle parse cache failed");
+    }
+    parseCache_.reset();
 }
 
 bool BMSEventHandler::LoadAllPreInstallBundleInfos()
@@ -388,11 +396,18 @@ void BMSEventHandler::InnerProcessRebootBundleInstall(
             std::vector<std::string> filePaths { scanPathIter };
             if (!OTAInstallSystemBundle(filePaths, appType)) {
                 APP_LOGE("OTA Install new bundle(%{public}s) error.", bundleName.c_str());
+            } else {
+                SetHapsProcessed(infos);
             }
 
             continue;
         }
 
+        if (IsHapsProcessed(infos)) {
+            APP_LOGD("haps of bundle(%{public}s) are not changed since last scan.", bundleName.c_str());
+            continue;
+        }
+
         APP_LOGD("OTA process bundle(%{public}s) by path(%{private}s).",
             bundleName.c_str(), scanPathIter.c_str());
         BundleInfo hasInstalledInfo;
@@ -401,11 +416,12 @@ void BMSEventHandler::InnerProcessRebootBundleInstall(
         if (!hasBundleInstalled) {
             APP_LOGW("app(%{public}s) has been uninstalled and do not OTA install.",
                 bundleName.c_str());
+            SetHapsProcessed(infos);
             continue;
         }
 
         std::vector<std::string> filePaths;
-        for (auto item : infos) {
+        for (const auto &item : infos) {
             auto parserModuleNames = item.second.GetModuleNameVec();
             if (parserModuleNames.empty()) {
                 APP_LOGE("module is empty when parser path(%{public}s).", item.first.c_str());
@@ -446,15 +462,38 @@ void BMSEventHandler::InnerProcessRebootBundleInstall(
         }
 
         if (filePaths.empty()) {
+            SetHapsProcessed(infos);
             continue;
         }
 
         if (!OTAInstallSystemBundle(filePaths, appType)) {
             APP_LOGE("OTA bundle(%{public}s) failed", bundleName.c_str());
+        } else {
+            SetHapsProcessed(infos);
         }
     }
 }
 
+bool BMSEventHandler::IsHapsProcessed(const std::unordered_map<std::string, InnerBundleInfo> &infos) const
+{
+    if (parseCache_ == nullptr) {
+        return false;
+    }
+    return std::all_of(infos.begin(), infos.end(), [this](const auto &item) {
+        return parseCache_->IsProcessed(item.first);
+    });
+}
+
+void BMSEventHandler::SetHapsProcessed(const std::unordered_map<std::string, InnerBundleInfo> &infos)
+{
+    if (parseCache_ == nullptr) {
+        return;
+    }
+    for (const auto &item : infos) {
+        parseCache_->SetProcessed(item.first);
+    }
+}
+
 void BMSEventHandler::AddParseInfosToMap(
     const std::string &bundleName, const std::unordered_map<std::string, InnerBundleInfo> &infos)
 {
@@ -464,12 +503,9 @@ void BMSEventHandler::AddParseInfosToMap(
         return;
     }
 
-    auto iterMap = hapParseInfoMapIter->second;
-    for (auto infoIter : infos) {
-        iterMap.emplace(infoIter.first, infoIter.second);
+    for (const auto &infoIter : infos) {
+        hapParseInfoMapIter->second.emplace(infoIter.first, infoIter.second);
     }
-
-    hapParseInfoMap_.at(bundleName) = iterMap;
 }
 
 void BMSEventHandler::ProcessRebootBundleUninstall()
@@ -509,7 +545,7 @@ void BMSEventHandler::ProcessRebootBundleUninstall()
         // If the corresponding Hap does not exist, it should be uninstalled.
         for (auto moduleName : hasInstalledInfo.hapModuleNames) {
             bool hasModuleHapExist = false;
-            for (auto parserInfoIter : listIter->second) {
+            for (const auto &parserInfoIter : listIter->second) {
                 auto parserModuleNames = parserInfoIter.second.GetModuleNameVec();
                 if (!parserModuleNames.empty() && moduleName == parserModuleNames[0]) {
                     hasModuleHapExist = true;
@@ -530,8 +566,8 @@ void BMSEventHandler::ProcessRebootBundleUninstall()
 
         // Check the preInstall path in Db.
         // If the corresponding Hap does not exist, it should be deleted.
-        auto parserInfoMap = listIter->second;
-        for (auto preBundlePath : loadIter.second.GetBundlePaths()) {
+        const auto &parserInfoMap = listIter->second;
+        for (const auto &preBundlePath : loadIter.second.GetBundlePaths()) {
             auto parserInfoIter = parserInfoMap.find(preBundlePath);
             if (parserInfoIter != parserInfoMap.end()) {
                 APP_LOGD("OTA uninstall app(%{public}s) module path(%{private}s) exits.",
@@ -616,11 +652,18 @@ bool BMSEventHandler::ParseHapFiles(
     BundleParser bundleParser;
     for (auto realPath : realPaths) {
         InnerBundleInfo innerBundleInfo;
+        if (parseCache_ != nullptr && parseCache_->GetInnerBundleInfo(realPath, innerBundleInfo)) {
+            infos.emplace(realPath, innerBundleInfo);
+            continue;
+        }
         ret = bundleParser.Parse(realPath, innerBundleInfo);
         if (ret != ERR_OK) {
             APP_LOGE("parse bundle info failed, error: %{public}d", ret);
             continue;
         }
+        if (parseCache_ != nullptr) {
+            parseCache_->SetInnerBundleInfo(realPath, innerBundleInfo);
+        }
 
         infos.emplace(realPath, innerBundleInfo);
     }
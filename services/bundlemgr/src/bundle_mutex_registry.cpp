@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_mutex_registry.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+std::shared_ptr<std::mutex> BundleMutexRegistry::GetMutex(const std::string &bundleName)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto item = bundleMutexes_.find(bundleName);
+    if (item != bundleMutexes_.end()) {
+        return item->second;
+    }
+    if (bundleMutexes_.size() >= PRUNE_THRESHOLD) {
+        PruneUnusedMutexes();
+    }
+    auto bundleMutex = std::make_shared<std::mutex>();
+    bundleMutexes_.emplace(bundleName, bundleMutex);
+    return bundleMutex;
+}
+
+size_t BundleMutexRegistry::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bundleMutexes_.size();
+}
+
+void BundleMutexRegistry::PruneUnusedMutexes()
+{
+    // the references are only added under mutex_, so a mutex seen unused here can not be taken meanwhile
+    for (auto item = bundleMutexes_.begin(); item != bundleMutexes_.end();) {
+        if (item->second.use_count() == 1) {
+            item = bundleMutexes_.erase(item);
+        } else {
+            ++item;
+        }
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_parse_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <vector>
+
+#include "app_log_wrapper.h"
+#include "bundle_constants.h"
+#include "parameter.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+// increase it when the format of the cache file or of InnerBundleInfo json is changed
+constexpr int32_t CACHE_FORMAT_VERSION = 1;
+constexpr int64_t NS_PER_SECOND = 1000000000;
+const std::string CACHE_TMP_SUFFIX = ".tmp";
+const std::string KEY_FORMAT_VERSION = "formatVersion";
+const std::string KEY_SYSTEM_VERSION = "systemVersion";
+const std::string KEY_ITEMS = "items";
+const std::string KEY_PATH = "path";
+const std::string KEY_DEV = "dev";
+const std::string KEY_INO = "ino";
+const std::string KEY_SIZE = "size";
+const std::string KEY_MTIME = "mtime";
+const std::string KEY_CTIME = "ctime";
+const std::string KEY_INFO = "info";
+const std::string KEY_PROCESSED = "processed";
+}  // namespace
+
+BundleParseCache::BundleParseCache(const std::string &cachePath) : cachePath_(cachePath)
+{}
+
+bool BundleParseCache::Load()
+{
+    items_.clear();
+    std::ifstream in(cachePath_, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        APP_LOGD("no bundle parse cache");
+        return false;
+    }
+    std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    nlohmann::json jsonObject = nlohmann::json::from_cbor(buffer, true, false);
+    if (jsonObject.is_discarded() || !jsonObject.is_object()) {
+        APP_LOGW("bad bundle parse cache");
+        isChanged_ = true;
+        return false;
+    }
+    if (jsonObject.value(KEY_FORMAT_VERSION, 0) != CACHE_FORMAT_VERSION ||
+        jsonObject.value(KEY_SYSTEM_VERSION, "") != GetSystemVersion()) {
+        APP_LOGI("bundle parse cache is out of date");
+        isChanged_ = true;
+        return false;
+    }
+    auto itemsIter = jsonObject.find(KEY_ITEMS);
+    if (itemsIter == jsonObject.end() || !itemsIter->is_array()) {
+        isChanged_ = true;
+        return false;
+    }
+    for (auto &itemObject : *itemsIter) {
+        if (!itemObject.is_object() || !itemObject.contains(KEY_PATH) || !itemObject.contains(KEY_INFO)) {
+            continue;
+        }
+        CacheItem item;
+        item.identity.dev = itemObject.value(KEY_DEV, static_cast<uint64_t>(0));
+        item.identity.ino = itemObject.value(KEY_INO, static_cast<uint64_t>(0));
+        item.identity.size = itemObject.value(KEY_SIZE, static_cast<int64_t>(-1));
+        item.identity.mtimeNs = itemObject.value(KEY_MTIME, static_cast<int64_t>(0));
+        item.identity.ctimeNs = itemObject.value(KEY_CTIME, static_cast<int64_t>(0));
+        item.isProcessed = itemObject.value(KEY_PROCESSED, false);
+        item.info = std::move(itemObject[KEY_INFO]);
+        items_[itemObject.value(KEY_PATH, "")] = std::move(item);
+    }
+    APP_LOGI("load %{public}zu bundle parse results", items_.size());
+    return true;
+}
+
+bool BundleParseCache::Save()
+{
+    for (auto iter = items_.begin(); iter != items_.end();) {
+        if (iter->second.isUsed) {
+            ++iter;
+            continue;
+        }
+        // the hap is removed or not scanned any more
+        iter = items_.erase(iter);
+        isChanged_ = true;
+    }
+    if (!isChanged_) {
+        return true;
+    }
+
+    nlohmann::json jsonObject;
+    jsonObject[KEY_FORMAT_VERSION] = CACHE_FORMAT_VERSION;
+    jsonObject[KEY_SYSTEM_VERSION] = GetSystemVersion();
+    nlohmann::json itemsObject = nlohmann::json::array();
+    for (const auto &item : items_) {
+        itemsObject.push_back({
+            { KEY_PATH, item.first },
+            { KEY_DEV, item.second.identity.dev },
+            { KEY_INO, item.second.identity.ino },
+            { KEY_SIZE, item.second.identity.size },
+            { KEY_MTIME, item.second.identity.mtimeNs },
+            { KEY_CTIME, item.second.identity.ctimeNs },
+            { KEY_PROCESSED, item.second.isProcessed },
+            { KEY_INFO, item.second.info },
+        });
+    }
+    jsonObject[KEY_ITEMS] = std::move(itemsObject);
+    std::vector<uint8_t> buffer = nlohmann::json::to_cbor(jsonObject);
+
+    // the old cache is kept until the new one is complete
+    std::string tmpPath = cachePath_ + CACHE_TMP_SUFFIX;
+    std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        APP_LOGE("open bundle parse cache failed");
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    out.close();
+    if (out.fail() || rename(tmpPath.c_str(), cachePath_.c_str()) != 0) {
+        APP_LOGE("write bundle parse cache failed");
+        remove(tmpPath.c_str());
+        return false;
+    }
+    isChanged_ = false;
+    APP_LOGI("save %{public}zu bundle parse results", items_.size());
+    return true;
+}
+
+bool BundleParseCache::GetInnerBundleInfo(const std::string &hapPath, InnerBundleInfo &info)
+{
+    auto iter = items_.find(hapPath);
+    if (iter == items_.end()) {
+        return false;
+    }
+    FileIdentity identity;
+    if (!GetFileIdentity(hapPath, identity) || !(identity == iter->second.identity) ||
+        info.FromJson(iter->second.info) != ERR_OK) {
+        APP_LOGD("parse result of %{private}s is out of date", hapPath.c_str());
+        items_.erase(iter);
+        isChanged_ = true;
+        return false;
+    }
+    iter->second.isUsed = true;
+    return true;
+}
+
+void BundleParseCache::SetInnerBundleInfo(const std::string &hapPath, const InnerBundleInfo &info)
+{
+    CacheItem item;
+    if (!GetFileIdentity(hapPath, item.identity)) {
+        return;
+    }
+    info.ToJson(item.info);
+    item.isUsed = true;
+    item.isProcessed = false;
+    items_[hapPath] = std::move(item);
+    isChanged_ = true;
+}
+
+bool BundleParseCache::IsProcessed(const std::string &hapPath) const
+{
+    auto iter = items_.find(hapPath);
+    return iter != items_.end() && iter->second.isUsed && iter->second.isProcessed;
+}
+
+void BundleParseCache::SetProcessed(const std::string &hapPath)
+{
+    auto iter = items_.find(hapPath);
+    if (iter == items_.end() || !iter->second.isUsed || iter->second.isProcessed) {
+        return;
+    }
+    iter->second.isProcessed = true;
+    isChanged_ = true;
+}
+
+bool BundleParseCache::GetFileIdentity(const std::string &path, FileIdentity &identity)
+{
+    struct stat buf = {};
+    if (stat(path.c_str(), &buf) != 0 || !S_ISREG(buf.st_mode)) {
+        return false;
+    }
+    identity.dev = static_cast<uint64_t>(buf.st_dev);
+    identity.ino = static_cast<uint64_t>(buf.st_ino);
+    identity.size = static_cast<int64_t>(buf.st_size);
+    identity.mtimeNs = static_cast<int64_t>(buf.st_mtim.tv_sec) * NS_PER_SECOND + buf.st_mtim.tv_nsec;
+    identity.ctimeNs = static_cast<int64_t>(buf.st_ctim.tv_sec) * NS_PER_SECOND + buf.st_ctim.tv_nsec;
+    return true;
+}
+
+std::string BundleParseCache::GetSystemVersion()
+{
+    // the parser may change with the system, and the results depend on the device type
+    const char *versionId = GetVersionId();
+    return versionId == nullptr ? "" : versionId;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
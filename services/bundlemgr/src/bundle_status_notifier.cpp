@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_status_notifier.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "app_log_wrapper.h"
+#include "bundle_constants.h"
+#include "datetime_ex.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const std::string NOTIFY_THREAD = "BundleNotify";
+// a callback is a synchronous binder call without a timeout, so a hung subscriber holds a thread
+// until it returns; the rest are still delivered while fewer than this many subscribers hang
+constexpr int32_t NOTIFY_THREAD_NUMBER = 4;
+constexpr size_t MAX_PENDING_NOTIFICATIONS = 128;
+constexpr int64_t SLOW_CALLBACK_MS = 1000;
+// a subscriber whose callback runs longer than this gets no new notifications until it returns
+constexpr int64_t OVERDUE_CALLBACK_MS = 5000;
+}
+
+BundleStatusNotifier::BundleStatusNotifier() : notifyPool_(NOTIFY_THREAD)
+{
+    notifyPool_.Start(NOTIFY_THREAD_NUMBER);
+}
+
+BundleStatusNotifier::~BundleStatusNotifier()
+{
+    notifyPool_.Stop();
+}
+
+void BundleStatusNotifier::AddCallback(const sptr<IBundleStatusCallback> &callback)
+{
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->callback = callback;
+    subscriber->bundleName = callback->GetBundleName();
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.emplace_back(subscriber);
+}
+
+void BundleStatusNotifier::RemoveCallback(const sptr<IBundleStatusCallback> &callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+        [&callback](const std::shared_ptr<Subscriber> &subscriber) {
+            if (subscriber->callback->AsObject() != callback->AsObject()) {
+                return false;
+            }
+            subscriber->removed = true;
+            return true;
+        }),
+        subscribers_.end());
+}
+
+void BundleStatusNotifier::ClearCallbacks()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &subscriber : subscribers_) {
+        subscriber->removed = true;
+    }
+    subscribers_.clear();
+}
+
+void BundleStatusNotifier::Notify(uint8_t installType, int32_t resultCode, const std::string &bundleName)
+{
+    int64_t now = GetTickCount();
+    Notification notification = { installType, resultCode, bundleName, now };
+    std::vector<std::shared_ptr<Subscriber>> idleSubscribers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &subscriber : subscribers_) {
+            if (subscriber->bundleName != bundleName) {
+                continue;
+            }
+            if (subscriber->callbackStartTime != 0 && now - subscriber->callbackStartTime > OVERDUE_CALLBACK_MS) {
+                APP_LOGW("subscriber of %{public}s is overdue, skip the notification", bundleName.c_str());
+                subscriber->stats.droppedCount++;
+                continue;
+            }
+            auto &notifications = subscriber->notifications;
+            // the callback carries no more than these, so a burst of the same change is delivered once
+            if (!notifications.empty() && notifications.back().installType == installType &&
+                notifications.back().resultCode == resultCode) {
+                subscriber->stats.coalescedCount++;
+                continue;
+            }
+            if (notifications.size() >= MAX_PENDING_NOTIFICATIONS) {
+                APP_LOGW("subscriber of %{public}s falls behind, drop the oldest notification", bundleName.c_str());
+                notifications.pop_front();
+                subscriber->stats.droppedCount++;
+            }
+            notifications.push_back(notification);
+            if (!subscriber->running) {
+                subscriber->running = true;
+                idleSubscribers.emplace_back(subscriber);
+            }
+        }
+    }
+    for (const auto &subscriber : idleSubscribers) {
+        ScheduleSubscriber(subscriber);
+    }
+}
+
+void BundleStatusNotifier::ScheduleSubscriber(const std::shared_ptr<Subscriber> &subscriber)
+{
+    notifyPool_.AddTask([this, subscriber] { RunSubscriber(subscriber); });
+}
+
+void BundleStatusNotifier::RunSubscriber(const std::shared_ptr<Subscriber> &subscriber)
+{
+    Notification notification;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriber->removed || subscriber->notifications.empty()) {
+            subscriber->running = false;
+            return;
+        }
+        notification = std::move(subscriber->notifications.front());
+        subscriber->notifications.pop_front();
+        subscriber->callbackStartTime = GetTickCount();
+    }
+    // if the msg needed, it could convert in the proxy node
+    subscriber->callback->OnBundleStateChanged(notification.installType, notification.resultCode,
+        Constants::EMPTY_STRING, notification.bundleName);
+    int64_t latency = GetTickCount() - notification.enqueueTime;
+    if (latency > SLOW_CALLBACK_MS) {
+        APP_LOGW("notify %{public}s takes %{public}" PRId64 " ms", notification.bundleName.c_str(), latency);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscriber->callbackStartTime = 0;
+        subscriber->stats.deliveredCount++;
+        subscriber->stats.totalLatencyMs += latency;
+        subscriber->stats.maxLatencyMs = std::max(subscriber->stats.maxLatencyMs, latency);
+        if (subscriber->removed || subscriber->notifications.empty()) {
+            subscriber->running = false;
+            return;
+        }
+    }
+    // one notification per task, the next one queues behind the other subscribers waiting for a thread
+    ScheduleSubscriber(subscriber);
+}
+
+bool BundleStatusNotifier::GetDeliveryStats(const sptr<IBundleStatusCallback> &callback,
+    BundleStatusDeliveryStats &stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto item = std::find_if(subscribers_.begin(), subscribers_.end(),
+        [&callback](const std::shared_ptr<Subscriber> &subscriber) {
+            return subscriber->callback == callback;
+        });
+    if (item == subscribers_.end()) {
+        return false;
+    }
+    stats = (*item)->stats;
+    stats.pendingCount = (*item)->notifications.size();
+    return true;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -15,13 +15,63 @@
 
 #include "bundle_stream_installer_host_impl.h"
 
+#include <algorithm>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "bundle_mgr_service.h"
 #include "bundle_permission_mgr.h"
 #include "bundle_util.h"
+#include "bundle_verify_mgr.h"
 #include "ipc_skeleton.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+constexpr uint32_t ZIP_EOCD_SIGNATURE = 0x06054b50;
+constexpr size_t ZIP_EOCD_SIZE = 22;
+constexpr size_t ZIP_MAX_COMMENT_SIZE = 0xFFFF;
+constexpr size_t ZIP_EOCD_CD_SIZE_OFFSET = 12;
+constexpr size_t ZIP_EOCD_CD_OFFSET_OFFSET = 16;
+constexpr size_t ZIP_EOCD_COMMENT_SIZE_OFFSET = 20;
+constexpr uint32_t ZIP64_MARKER = 0xFFFFFFFF;
+
+uint32_t ReadLittleEndian32(const uint8_t *data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+        (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Returns true if the file ends with the end of central directory record and the central
+// directory right before it has been written completely.
+bool HasCompleteCentralDirectory(int32_t fd, int64_t fileSize)
+{
+    if (fileSize < static_cast<int64_t>(ZIP_EOCD_SIZE)) {
+        return false;
+    }
+    size_t tailSize = static_cast<size_t>(std::min<int64_t>(fileSize, ZIP_EOCD_SIZE + ZIP_MAX_COMMENT_SIZE));
+    int64_t tailOffset = fileSize - static_cast<int64_t>(tailSize);
+    std::vector<uint8_t> tail(tailSize);
+    if (pread(fd, tail.data(), tailSize, tailOffset) != static_cast<ssize_t>(tailSize)) {
+        return false;
+    }
+    for (size_t pos = tailSize - ZIP_EOCD_SIZE + 1; pos-- > 0;) {
+        if (ReadLittleEndian32(&tail[pos]) != ZIP_EOCD_SIGNATURE) {
+            continue;
+        }
+        uint32_t cdSize = ReadLittleEndian32(&tail[pos + ZIP_EOCD_CD_SIZE_OFFSET]);
+        uint32_t cdOffset = ReadLittleEndian32(&tail[pos + ZIP_EOCD_CD_OFFSET_OFFSET]);
+        size_t commentSize = static_cast<size_t>(tail[pos + ZIP_EOCD_COMMENT_SIZE_OFFSET]) |
+            (static_cast<size_t>(tail[pos + ZIP_EOCD_COMMENT_SIZE_OFFSET + 1]) << 8);
+        if (cdOffset == ZIP64_MARKER || pos + ZIP_EOCD_SIZE + commentSize != tailSize) {
+            return false;
+        }
+        return static_cast<int64_t>(cdOffset) + cdSize == tailOffset + static_cast<int64_t>(pos);
+    }
+    return false;
+}
+}  // namespace
+
 BundleStreamInstallerHostImpl::BundleStreamInstallerHostImpl(uint32_t installerId, int32_t installedUid)
 {
     APP_LOGD("create bundle stream installer host impl instance");
@@ -51,6 +101,11 @@ void BundleStreamInstallerHostImpl::UnInit()
 {
     APP_LOGD("destory stream installer with installerId %{public}d and temp dir %{public}s", installerId_,
         tempDir_.c_str());
+    StopPreVerify();
+    for (const auto &hap : streamHaps_) {
+        BundleVerifyMgr::ClearPreVerifyResult(hap.path);
+    }
+    streamHaps_.clear();
     BundleUtil::CloseFileDescriptor(streamFdVec_);
     BundleUtil::DeleteDir(tempDir_);
 }
@@ -78,11 +133,87 @@ int BundleStreamInstallerHostImpl::CreateStream(const std::string &hapName, long
         APP_LOGE("stream installer create file descriptor failed");
     }
     if (fd > 0) {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        // Install sets the flag before it takes the lock, so a stream racing with it is rejected here
+        if (isInstallStarted_) {
+            APP_LOGE("install has started");
+            close(fd);
+            return -1;
+        }
         streamFdVec_.emplace_back(fd);
+        StreamHap hap;
+        hap.path = bundlePath;
+        hap.fd = fd;
+        streamHaps_.emplace_back(hap);
+        // the client opens the next stream once it has written the previous haps
+        if (streamHaps_.size() > 1 && !stopPreVerify_) {
+            preVerifyPending_ = true;
+            if (!preVerifyThread_.joinable()) {
+                preVerifyThread_ = std::thread(&BundleStreamInstallerHostImpl::PreVerifyStreams, this);
+            }
+            streamCondition_.notify_all();
+        }
     }
     return fd;
 }
 
+bool BundleStreamInstallerHostImpl::IsStreamHapReady(const StreamHap &hap) const
+{
+    struct stat fileStat = {};
+    if (hap.sealed || fstat(hap.fd, &fileStat) != 0) {
+        return false;
+    }
+    return HasCompleteCentralDirectory(hap.fd, static_cast<int64_t>(fileStat.st_size));
+}
+
+void BundleStreamInstallerHostImpl::SealStreamHap(StreamHap &hap)
+{
+    auto iter = std::find(streamFdVec_.begin(), streamFdVec_.end(), hap.fd);
+    if (iter != streamFdVec_.end()) {
+        streamFdVec_.erase(iter);
+    }
+    close(hap.fd);
+    hap.fd = -1;
+    hap.sealed = true;
+}
+
+void BundleStreamInstallerHostImpl::PreVerifyStreams()
+{
+    std::unique_lock<std::mutex> lock(streamMutex_);
+    while (true) {
+        streamCondition_.wait(lock, [this] { return stopPreVerify_ || preVerifyPending_; });
+        if (stopPreVerify_) {
+            break;
+        }
+        preVerifyPending_ = false;
+        // the newest hap is still being written; haps may be added while a verify runs unlocked,
+        // so they are visited by index and a new stream sets preVerifyPending_ again
+        for (size_t i = 0; i + 1 < streamHaps_.size() && !stopPreVerify_; ++i) {
+            if (!IsStreamHapReady(streamHaps_[i])) {
+                continue;
+            }
+            SealStreamHap(streamHaps_[i]);
+            std::string path = streamHaps_[i].path;
+            lock.unlock();
+            ErrCode result = BundleVerifyMgr::PreVerify(path);
+            APP_LOGD("pre verify %{private}s result %{public}d", path.c_str(), result);
+            lock.lock();
+        }
+    }
+}
+
+void BundleStreamInstallerHostImpl::StopPreVerify()
+{
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        stopPreVerify_ = true;
+    }
+    streamCondition_.notify_all();
+    if (preVerifyThread_.joinable()) {
+        preVerifyThread_.join();
+    }
+}
+
 bool BundleStreamInstallerHostImpl::Install(const sptr<IStatusReceiver>& receiver)
 {
     if (receiver == nullptr) {
@@ -95,6 +226,9 @@ bool BundleStreamInstallerHostImpl::Install(const sptr<IStatusReceiver>& receive
         APP_LOGE("get bundle installer failed");
         return false;
     }
+    isInstallStarted_ = true;
+    // a verify in progress finishes here and its result is reused by the installer
+    StopPreVerify();
     std::vector<std::string> pathVec;
     pathVec.emplace_back(tempDir_);
     auto res = installer->Install(pathVec, installParam_, receiver);
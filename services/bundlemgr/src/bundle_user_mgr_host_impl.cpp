@@ -16,6 +16,7 @@
 #include "bundle_user_mgr_host_impl.h"
 
 #include "app_log_wrapper.h"
+#include "base_bundle_installer.h"
 #include "bundle_mgr_service.h"
 #include "bundle_permission_mgr.h"
 #include "bundle_promise.h"
@@ -83,14 +84,26 @@ void BundleUserMgrHostImpl::CreateNewUser(int32_t userId)
     dataMgr->AddUserId(userId);
     // Scan preset applications and parse package information.
     std::vector<PreInstallBundleInfo> preInstallBundleInfos = dataMgr->GetAllPreInstallBundleInfos();
-    g_installedHapNum = 0;
-    std::shared_ptr<BundlePromise> bundlePromise = std::make_shared<BundlePromise>();
-    int32_t totalHapNum = static_cast<int32_t>(preInstallBundleInfos.size());
     if (!BundlePermissionMgr::Init()) {
         APP_LOGW("BundlePermissionMgr::Init failed");
     }
-    // Read apps installed by other users that are visible to all users
+    // Bundles installed for other users only need the user data, which is created in bulk
+    std::vector<std::string> bundleNames;
+    bundleNames.reserve(preInstallBundleInfos.size());
     for (const auto &info : preInstallBundleInfos) {
+        bundleNames.emplace_back(info.GetBundleName());
+    }
+    std::vector<std::string> uninstalledBundleNames;
+    BaseBundleInstaller provisioner;
+    ErrCode result = provisioner.ProvisionInstalledBundles(bundleNames, userId, uninstalledBundleNames);
+    APP_LOGD("provision installed bundles result %{public}d, %{public}zu bundles left to install",
+        result, uninstalledBundleNames.size());
+
+    g_installedHapNum = 0;
+    std::shared_ptr<BundlePromise> bundlePromise = std::make_shared<BundlePromise>();
+    int32_t totalHapNum = static_cast<int32_t>(uninstalledBundleNames.size());
+    // Bundles not installed for any user yet go through the normal install
+    for (const auto &bundleName : uninstalledBundleNames) {
         InstallParam installParam;
         installParam.userId = userId;
         installParam.isPreInstallApp = true;
@@ -98,7 +111,7 @@ void BundleUserMgrHostImpl::CreateNewUser(int32_t userId)
         sptr<UserReceiverImpl> userReceiverImpl(new (std::nothrow) UserReceiverImpl());
         userReceiverImpl->SetBundlePromise(bundlePromise);
         userReceiverImpl->SetTotalHapNum(totalHapNum);
-        installer->InstallByBundleName(info.GetBundleName(), installParam, userReceiverImpl);
+        installer->InstallByBundleName(bundleName, installParam, userReceiverImpl);
     }
 
     if (static_cast<int32_t>(g_installedHapNum) < totalHapNum) {
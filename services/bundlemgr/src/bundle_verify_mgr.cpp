@@ -15,6 +15,8 @@
 
 #include "bundle_verify_mgr.h"
 
+#include <climits>
+#include <cstdlib>
 #include <map>
 
 #include "app_log_wrapper.h"
@@ -44,9 +46,8 @@ const std::map<int32_t, ErrCode> HAP_VERIFY_ERR_MAP = {
     {HapVerifyResultCode::VERIFY_SIGNATURE_FAIL, ERR_APPEXECFWK_INSTALL_FAILED_BUNDLE_SIGNATURE_VERIFICATION_FAILURE},
     {HapVerifyResultCode::VERIFY_SOURCE_INIT_FAIL, ERR_APPEXECFWK_INSTALL_FAILED_VERIFY_SOURCE_INIT_FAIL}
 };
-} // namespace
 
-ErrCode BundleVerifyMgr::HapVerify(const std::string &filePath, HapVerifyResult &hapVerifyResult)
+ErrCode DoHapVerify(const std::string &filePath, HapVerifyResult &hapVerifyResult)
 {
     auto ret = Security::Verify::HapVerify(filePath, hapVerifyResult);
     APP_LOGI("HapVerify result %{public}d", ret);
@@ -55,5 +56,88 @@ ErrCode BundleVerifyMgr::HapVerify(const std::string &filePath, HapVerifyResult
     }
     return HAP_VERIFY_ERR_MAP.at(ret);
 }
+} // namespace
+
+std::mutex BundleVerifyMgr::preVerifyMutex_;
+std::map<std::string, BundleVerifyMgr::PreVerifyRecord> BundleVerifyMgr::preVerifyRecords_;
+
+bool BundleVerifyMgr::GetFileStamp(const std::string &filePath, std::string &realPath, FileStamp &stamp)
+{
+    char buf[PATH_MAX] = {0};
+    struct stat fileStat = {};
+    if (realpath(filePath.c_str(), buf) == nullptr || stat(buf, &fileStat) != 0) {
+        return false;
+    }
+    realPath = buf;
+    stamp.dev = fileStat.st_dev;
+    stamp.ino = fileStat.st_ino;
+    stamp.size = fileStat.st_size;
+    stamp.ctime = fileStat.st_ctim;
+    return true;
+}
+
+bool BundleVerifyMgr::IsSameStamp(const FileStamp &left, const FileStamp &right)
+{
+    return left.dev == right.dev && left.ino == right.ino && left.size == right.size &&
+        left.ctime.tv_sec == right.ctime.tv_sec && left.ctime.tv_nsec == right.ctime.tv_nsec;
+}
+
+ErrCode BundleVerifyMgr::HapVerify(const std::string &filePath, HapVerifyResult &hapVerifyResult)
+{
+    std::string realPath;
+    FileStamp stamp;
+    if (GetFileStamp(filePath, realPath, stamp)) {
+        std::lock_guard<std::mutex> lock(preVerifyMutex_);
+        auto iter = preVerifyRecords_.find(realPath);
+        if (iter != preVerifyRecords_.end()) {
+            PreVerifyRecord record = std::move(iter->second);
+            preVerifyRecords_.erase(iter);
+            if (IsSameStamp(record.stamp, stamp)) {
+                APP_LOGD("use pre verify result of %{private}s", realPath.c_str());
+                hapVerifyResult = std::move(record.hapVerifyResult);
+                return record.result;
+            }
+        }
+    }
+    return DoHapVerify(filePath, hapVerifyResult);
+}
+
+ErrCode BundleVerifyMgr::PreVerify(const std::string &filePath)
+{
+    std::string realPath;
+    PreVerifyRecord record;
+    if (!GetFileStamp(filePath, realPath, record.stamp)) {
+        APP_LOGE("pre verify failed due to invalid path");
+        return ERR_APPEXECFWK_INSTALL_FAILED_INVALID_SIGNATURE_FILE_PATH;
+    }
+    record.filePath = filePath;
+    record.result = DoHapVerify(realPath, record.hapVerifyResult);
+    ErrCode result = record.result;
+    // the result may mix old and new content if the file was written while it was verified
+    std::string checkedPath;
+    FileStamp stamp;
+    if (!GetFileStamp(realPath, checkedPath, stamp) || checkedPath != realPath || !IsSameStamp(record.stamp, stamp)) {
+        APP_LOGW("%{private}s changed during pre verify", realPath.c_str());
+        return result;
+    }
+    std::lock_guard<std::mutex> lock(preVerifyMutex_);
+    preVerifyRecords_[realPath] = std::move(record);
+    return result;
+}
+
+void BundleVerifyMgr::ClearPreVerifyResult(const std::string &filePath)
+{
+    // the hap may have been removed already, so the record is also matched by the path it was saved with
+    char buf[PATH_MAX] = {0};
+    std::string realPath = realpath(filePath.c_str(), buf) != nullptr ? std::string(buf) : filePath;
+    std::lock_guard<std::mutex> lock(preVerifyMutex_);
+    for (auto iter = preVerifyRecords_.begin(); iter != preVerifyRecords_.end();) {
+        if (iter->first == realPath || iter->second.filePath == filePath) {
+            iter = preVerifyRecords_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
 }  // namespace AppExecFwk
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -32,6 +32,7 @@ const std::string ARGS_ABILITY_LIST = "-ability-list";
 const std::string ARGS_BUNDLE = "-bundle";
 const std::string ARGS_BUNDLE_LIST = "-bundle-list";
 const std::string ARGS_DEVICEID = "-device";
+const std::string ARGS_INSTALLER_QUEUE = "-installer-queue";
 const std::string ILLEGAL_INFOMATION = "The arguments are illegal and you can enter '-h' for help.\n";
 const std::string NO_INFOMATION = "no such infomation\n";
 
@@ -42,6 +43,7 @@ const std::unordered_map<std::string, HidumpFlag> ARGS_MAP = {
     { ARGS_BUNDLE, HidumpFlag::GET_BUNDLE },
     { ARGS_BUNDLE_LIST, HidumpFlag::GET_BUNDLE_LIST },
     { ARGS_DEVICEID, HidumpFlag::GET_DEVICEID },
+    { ARGS_INSTALLER_QUEUE, HidumpFlag::GET_INSTALLER_QUEUE },
 };
 
 std::string AnonymizeDeviceId(const std::string &deviceId)
@@ -61,8 +63,9 @@ std::string AnonymizeDeviceId(const std::string &deviceId)
 }
 }
 
-HidumpHelper::HidumpHelper(const std::weak_ptr<BundleDataMgr> &dataMgr)
-    : dataMgr_(dataMgr) {}
+HidumpHelper::HidumpHelper(const std::weak_ptr<BundleDataMgr> &dataMgr,
+    const std::weak_ptr<BundleInstallerManager> &installerManager)
+    : dataMgr_(dataMgr), installerManager_(installerManager) {}
 
 bool HidumpHelper::Dump(const std::vector<std::string>& args, std::string &result)
 {
@@ -188,6 +191,10 @@ ErrCode HidumpHelper::ProcessDump(const HidumpParam& hidumpParam, std::string &r
             errCode = GetAllDeviced(result);
             break;
         }
+        case HidumpFlag::GET_INSTALLER_QUEUE: {
+            errCode = GetInstallerQueueStats(result);
+            break;
+        }
         default: {
             errCode = ERR_APPEXECFWK_HIDUMP_INVALID_ARGS;
             break;
@@ -388,6 +395,23 @@ ErrCode HidumpHelper::GetAllDeviced(std::string &result)
     return ERR_OK;
 }
 
+ErrCode HidumpHelper::GetInstallerQueueStats(std::string &result)
+{
+    auto installerManager = installerManager_.lock();
+    if (installerManager == nullptr) {
+        return ERR_APPEXECFWK_HIDUMP_SERVICE_ERROR;
+    }
+
+    InstallerQueueStats stats = installerManager->GetQueueStats();
+    result.append("pendingTaskCount: ").append(std::to_string(stats.pendingTaskCount)).append("\n")
+          .append("maxBundleQueueDepth: ").append(std::to_string(stats.maxBundleQueueDepth)).append("\n")
+          .append("runningBundleCount: ").append(std::to_string(stats.runningBundleCount)).append("\n")
+          .append("startedTaskCount: ").append(std::to_string(stats.startedTaskCount)).append("\n")
+          .append("totalWaitTimeMs: ").append(std::to_string(stats.totalWaitTimeMs)).append("\n")
+          .append("maxWaitTimeMs: ").append(std::to_string(stats.maxWaitTimeMs)).append("\n");
+    return ERR_OK;
+}
+
 void HidumpHelper::ShowHelp(std::string &result)
 {
     result.append("Usage:dump  <command> [options]\n")
@@ -405,7 +429,9 @@ void HidumpHelper::ShowHelp(std::string &result)
           .append("-bundle-list      ")
           .append("dump list of all bundle names in the system\n")
           .append("-device           ")
-          .append("dump the list of devices involved in the ability infomation in the system\n");
+          .append("dump the list of devices involved in the ability infomation in the system\n")
+          .append("-installer-queue  ")
+          .append("dump the queue depth and wait time of the installer tasks\n");
 }
 
 void HidumpHelper::ShowIllealInfomation(std::string &result)
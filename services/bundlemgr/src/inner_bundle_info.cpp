@@ -1949,6 +1949,13 @@ void InnerBundleInfo::GetModuleNames(std::vector<std::string> &moduleNames) cons
     }
 }
 
+void InnerBundleInfo::GetModuleResPaths(std::vector<std::string> &moduleResPaths) const
+{
+    for (const auto &innerModuleInfo : innerModuleInfos_) {
+        moduleResPaths.emplace_back(innerModuleInfo.second.moduleResPath);
+    }
+}
+
 void InnerBundleInfo::ResetBundleState(int32_t userId)
 {
     if (userId == Constants::ALL_USERID) {
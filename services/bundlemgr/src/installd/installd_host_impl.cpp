@@ -15,6 +15,8 @@
 
 #include "installd/installd_host_impl.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <map>
@@ -33,10 +35,48 @@
 #include "hap_restorecon.h"
 #endif // WITH_SELINUX
 #include "installd/installd_operator.h"
+#include "installd/installd_trash_mgr.h"
+#include "parallel_task_util.h"
 #include "parameters.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+// Upper bound of the threads walking the dirs of bundle stats.
+constexpr size_t MAX_BUNDLE_STATS_THREADS = 4;
+// Cached stats are walked again after this time, the apps change their data without installd.
+// It is short as the stats are shown to the user, yet a screen listing every app walks each one once.
+constexpr int64_t BUNDLE_STATS_CACHE_TIMEOUT_MS = 10 * 1000;
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Returns the bundle name of a code or data path, or empty if the path belongs to no bundle.
+std::string GetBundleNameFromPath(const std::string &path)
+{
+    std::string::size_type begin = std::string::npos;
+    std::string codeDir = Constants::BUNDLE_CODE_DIR + Constants::FILE_SEPARATOR_CHAR;
+    if (path.compare(0, codeDir.size(), codeDir) == 0) {
+        begin = codeDir.size();
+    } else if (path.compare(0, Constants::BUNDLE_APP_DATA_BASE_DIR.size(), Constants::BUNDLE_APP_DATA_BASE_DIR) == 0) {
+        for (const auto &dir : { Constants::BASE, Constants::DATABASE }) {
+            std::string::size_type pos = path.find(dir, Constants::BUNDLE_APP_DATA_BASE_DIR.size());
+            if (pos != std::string::npos) {
+                begin = pos + dir.size();
+                break;
+            }
+        }
+    }
+    if (begin == std::string::npos) {
+        return "";
+    }
+    return path.substr(begin, path.find(Constants::FILE_SEPARATOR_CHAR, begin) - begin);
+}
+}  // namespace
+
 InstalldHostImpl::InstalldHostImpl()
 {
     APP_LOGI("installd service instance is created");
@@ -53,6 +93,7 @@ ErrCode InstalldHostImpl::CreateBundleDir(const std::string &bundleDir)
         APP_LOGE("Calling the function CreateBundleDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
+    InvalidateBundleStatsByPath(bundleDir);
     if (InstalldOperator::IsExistDir(bundleDir)) {
         APP_LOGW("bundleDir %{public}s is exist", bundleDir.c_str());
         OHOS::ForceRemoveDirectory(bundleDir);
@@ -73,6 +114,7 @@ ErrCode InstalldHostImpl::ExtractModuleFiles(const std::string &srcModulePath, c
         APP_LOGE("Calling the function ExtractModuleFiles with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
+    InvalidateBundleStatsByPath(targetPath);
     if (!InstalldOperator::MkRecursiveDir(targetPath, true)) {
         APP_LOGE("create target dir %{private}s failed", targetPath.c_str());
         return ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
@@ -92,6 +134,7 @@ ErrCode InstalldHostImpl::RenameModuleDir(const std::string &oldPath, const std:
         APP_LOGE("Calling the function RenameModuleDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
+    InvalidateBundleStatsByPath(newPath);
     if (!InstalldOperator::RenameDir(oldPath, newPath)) {
         APP_LOGE("rename module dir %{private}s to %{private}s failed", oldPath.c_str(), newPath.c_str());
         return ERR_APPEXECFWK_INSTALLD_RNAME_DIR_FAILED;
@@ -106,54 +149,92 @@ ErrCode InstalldHostImpl::CreateBundleDataDir(const std::string &bundleName,
         APP_LOGE("Calling the function CreateBundleDataDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
-    for (const auto &el : Constants::BUNDLE_EL) {
-        std::string bundleDataDir = GetBundleDataDir(el, userid) + Constants::BASE + bundleName;
-        if (!InstalldOperator::MkOwnerDir(bundleDataDir, S_IRWXU, uid, gid)) {
-            APP_LOGE("CreateBundledatadir MkOwnerDir failed");
-            return ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
+    CreateDirParam createDirParam;
+    createDirParam.bundleName = bundleName;
+    createDirParam.userId = userid;
+    createDirParam.uid = uid;
+    createDirParam.gid = gid;
+    createDirParam.apl = apl;
+    std::vector<ErrCode> results;
+    ErrCode ret = CreateBundleDataDirs({ createDirParam }, results);
+    return (ret == ERR_OK) ? results[0] : ret;
+}
+
+ErrCode InstalldHostImpl::CreateBundleDataDirs(
+    const std::vector<CreateDirParam> &createDirParams, std::vector<ErrCode> &results)
+{
+    APP_LOGD("InstalldHostImpl::CreateBundleDataDirs size:%{public}zu", createDirParams.size());
+    results.assign(createDirParams.size(), ERR_OK);
+    bool isDistributedFileEnabled = system::GetBoolParameter(Constants::DISTRIBUTED_FILE_PROPERTY, false);
+    // the dirs of all bundles are made in one pass, owners maps each dir back to its bundle
+    std::vector<OwnerDirInfo> dirs;
+    std::vector<size_t> owners;
+    for (size_t i = 0; i < createDirParams.size(); ++i) {
+        const CreateDirParam &param = createDirParams[i];
+        if (param.bundleName.empty() || param.userId < 0 || param.uid < 0 || param.gid < 0) {
+            APP_LOGE("Calling the function CreateBundleDataDirs with invalid param");
+            results[i] = ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+            continue;
         }
+        InvalidateBundleStats(param.bundleName);
+        GetBundleDataDirs(param, isDistributedFileEnabled, dirs);
+        owners.resize(dirs.size(), i);
+    }
+    std::vector<bool> dirResults;
+    InstalldOperator::MkOwnerDirs(dirs, dirResults);
+    for (size_t i = 0; i < dirs.size(); ++i) {
+        if (!dirResults[i] && results[owners[i]] == ERR_OK) {
+            APP_LOGE("CreateBundleDataDirs MkOwnerDir %{private}s failed", dirs[i].path.c_str());
+            results[owners[i]] = ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
+        }
+    }
+
+    for (size_t i = 0; i < createDirParams.size(); ++i) {
+        const CreateDirParam &param = createDirParams[i];
+        for (const auto &el : Constants::BUNDLE_EL) {
+            if (results[i] != ERR_OK) {
+                break;
+            }
+            std::string bundleDataDir = GetBundleDataDir(el, param.userId) + Constants::BASE + param.bundleName;
+            results[i] = SetDirApl(bundleDataDir, param.bundleName, param.apl);
+            if (results[i] != ERR_OK) {
+                APP_LOGE("CreateBundleDataDirs SetDirApl failed");
+                break;
+            }
+            std::string databaseDir = GetBundleDataDir(el, param.userId) + Constants::DATABASE + param.bundleName;
+            results[i] = SetDirApl(databaseDir, param.bundleName, param.apl);
+            if (results[i] != ERR_OK) {
+                APP_LOGE("CreateBundleDataDirs SetDirApl failed");
+            }
+        }
+    }
+    return ERR_OK;
+}
+
+void InstalldHostImpl::GetBundleDataDirs(const CreateDirParam &param, bool isDistributedFileEnabled,
+    std::vector<OwnerDirInfo> &dirs) const
+{
+    for (const auto &el : Constants::BUNDLE_EL) {
+        std::string bundleDataDir = GetBundleDataDir(el, param.userId) + Constants::BASE + param.bundleName;
+        dirs.push_back({ bundleDataDir, S_IRWXU, param.uid, param.gid });
         if (el == Constants::BUNDLE_EL[1]) {
             for (const auto &dir : Constants::BUNDLE_DATA_DIR) {
-                if (!InstalldOperator::MkOwnerDir(bundleDataDir + dir, S_IRWXU, uid, gid)) {
-                    APP_LOGE("CreateBundledatadir MkOwnerDir el2 failed");
-                    return ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
-                }
+                dirs.push_back({ bundleDataDir + dir, S_IRWXU, param.uid, param.gid });
             }
         }
-        ErrCode ret = SetDirApl(bundleDataDir, bundleName, apl);
-        if (ret != ERR_OK) {
-            APP_LOGE("CreateBundleDataDir SetDirApl failed");
-            return ret;
-        }
-        std::string databaseDir = GetBundleDataDir(el, userid) + Constants::DATABASE + bundleName;
-        if (!InstalldOperator::MkOwnerDir(
-            databaseDir, S_IRWXU | S_IRWXG | S_ISGID, uid, Constants::DATABASE_DIR_GID)) {
-            APP_LOGE("CreateBundle databaseDir MkOwnerDir failed");
-            return ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
-        }
-        ret = SetDirApl(databaseDir, bundleName, apl);
-        if (ret != ERR_OK) {
-            APP_LOGE("CreateBundleDataDir SetDirApl failed");
-            return ret;
-        }
+        std::string databaseDir = GetBundleDataDir(el, param.userId) + Constants::DATABASE + param.bundleName;
+        dirs.push_back({ databaseDir, S_IRWXU | S_IRWXG | S_ISGID, param.uid, Constants::DATABASE_DIR_GID });
     }
-    if (system::GetBoolParameter(Constants::DISTRIBUTED_FILE_PROPERTY, false)) {
+    if (isDistributedFileEnabled) {
         std::string distributedfile = Constants::DISTRIBUTED_FILE;
-        distributedfile = distributedfile.replace(distributedfile.find("%"), 1, std::to_string(userid));
-        if (!InstalldOperator::MkOwnerDir(distributedfile + bundleName, S_IRWXU | S_IRWXG | S_ISGID, uid, gid)) {
-            APP_LOGE("Failed to mk dir for distributedfile");
-            return ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
-        }
+        distributedfile = distributedfile.replace(distributedfile.find("%"), 1, std::to_string(param.userId));
+        dirs.push_back({ distributedfile + param.bundleName, S_IRWXU | S_IRWXG | S_ISGID, param.uid, param.gid });
 
         distributedfile = Constants::DISTRIBUTED_FILE_NON_ACCOUNT;
-        distributedfile = distributedfile.replace(distributedfile.find("%"), 1, std::to_string(userid));
-        if (!InstalldOperator::MkOwnerDir(distributedfile + bundleName,
-            S_IRWXU | S_IRWXG | S_ISGID, uid, Constants::DFS_GID)) {
-            APP_LOGE("Failed to mk dir for non account distributedfile");
-            return ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
-        }
+        distributedfile = distributedfile.replace(distributedfile.find("%"), 1, std::to_string(param.userId));
+        dirs.push_back({ distributedfile + param.bundleName,
+            S_IRWXU | S_IRWXG | S_ISGID, param.uid, Constants::DFS_GID });
     }
-    return ERR_OK;
 }
 
 ErrCode InstalldHostImpl::RemoveBundleDataDir(const std::string &bundleName, const int userid)
@@ -163,14 +244,15 @@ ErrCode InstalldHostImpl::RemoveBundleDataDir(const std::string &bundleName, con
         APP_LOGE("Calling the function CreateBundleDataDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
+    InvalidateBundleStats(bundleName);
     for (const auto &el : Constants::BUNDLE_EL) {
         std::string bundleDataDir = GetBundleDataDir(el, userid) + Constants::BASE + bundleName;
-        if (!InstalldOperator::DeleteDir(bundleDataDir)) {
+        if (!InstalldTrashMgr::GetInstance()->RemoveDir(bundleDataDir)) {
             APP_LOGE("remove dir %{public}s failed", bundleDataDir.c_str());
             return ERR_APPEXECFWK_INSTALLD_REMOVE_DIR_FAILED;
         }
         std::string databaseDir = GetBundleDataDir(el, userid) + Constants::DATABASE + bundleName;
-        if (!InstalldOperator::DeleteDir(databaseDir)) {
+        if (!InstalldTrashMgr::GetInstance()->RemoveDir(databaseDir)) {
             APP_LOGE("remove dir %{public}s failed", databaseDir.c_str());
             return ERR_APPEXECFWK_INSTALLD_REMOVE_DIR_FAILED;
         }
@@ -185,10 +267,11 @@ ErrCode InstalldHostImpl::RemoveModuleDataDir(const std::string &ModuleDir, cons
         APP_LOGE("Calling the function CreateModuleDataDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
+    InvalidateBundleStats(ModuleDir.substr(0, ModuleDir.find(Constants::FILE_SEPARATOR_CHAR)));
 
     for (const auto &el : Constants::BUNDLE_EL) {
         std::string moduleDataDir = GetBundleDataDir(el, userid) + Constants::BASE + ModuleDir;
-        if (!InstalldOperator::DeleteDir(moduleDataDir)) {
+        if (!InstalldTrashMgr::GetInstance()->RemoveDir(moduleDataDir)) {
             APP_LOGE("remove dir %{public}s failed", moduleDataDir.c_str());
         }
     }
@@ -201,7 +284,8 @@ ErrCode InstalldHostImpl::RemoveDir(const std::string &dir)
         APP_LOGE("Calling the function RemoveDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
-    if (!InstalldOperator::DeleteDir(dir)) {
+    InvalidateBundleStatsByPath(dir);
+    if (!InstalldTrashMgr::GetInstance()->RemoveDir(dir)) {
         APP_LOGE("remove dir %{public}s failed", dir.c_str());
         return ERR_APPEXECFWK_INSTALLD_REMOVE_DIR_FAILED;
     }
@@ -215,8 +299,9 @@ ErrCode InstalldHostImpl::CleanBundleDataDir(const std::string &dataDir)
         APP_LOGE("Calling the function CleanBundleDataDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
+    InvalidateBundleStatsByPath(dataDir);
 
-    if (!InstalldOperator::DeleteFiles(dataDir)) {
+    if (!InstalldTrashMgr::GetInstance()->RemoveFiles(dataDir)) {
         APP_LOGE("CleanBundleDataDir delete files failed");
         return ERR_APPEXECFWK_INSTALLD_CLEAN_DIR_FAILED;
     }
@@ -240,48 +325,148 @@ ErrCode InstalldHostImpl::GetBundleStats(
         APP_LOGE("Calling the function GetBundleStats with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
-    // index 0 : bundle data size
-    std::string path = Constants::BUNDLE_CODE_DIR + Constants::FILE_SEPARATOR_CHAR + bundleName;
-    int64_t fileSize = InstalldOperator::GetDiskUsage(path);
-    bundleStats.push_back(fileSize);
+    std::vector<int64_t> stats;
+    if (!GetCachedBundleStats(bundleName, userId, stats)) {
+        uint64_t generation = GetBundleStatsGeneration();
+        stats = GetBundleStatsFromDisk(bundleName, userId, true);
+        SaveBundleStats(bundleName, userId, stats, generation);
+    }
+    bundleStats.insert(bundleStats.end(), stats.begin(), stats.end());
+    APP_LOGD("InstalldHostImpl::GetBundleStats end");
+    return ERR_OK;
+}
 
-    // index 1 : local bundle data size
-    std::vector<std::string> bundlePath;
-    for (auto &el : Constants::BUNDLE_EL) {
-        std::string filePath = Constants::BUNDLE_APP_DATA_BASE_DIR + el + Constants::FILE_SEPARATOR_CHAR +
-            std::to_string(userId) + Constants::BASE + bundleName;
-        bundlePath.push_back(filePath);
+ErrCode InstalldHostImpl::BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+    std::vector<int64_t> &bundleStats)
+{
+    APP_LOGD("InstalldHostImpl::BatchGetBundleStats size:%{public}zu", bundleNames.size());
+    if (bundleNames.size() > MAX_BATCH_BUNDLE_STATS_SIZE ||
+        std::any_of(bundleNames.begin(), bundleNames.end(), [](const auto &name) { return name.empty(); })) {
+        APP_LOGE("Calling the function BatchGetBundleStats with invalid param");
+        return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+    }
+    std::vector<std::vector<int64_t>> allStats(bundleNames.size());
+    std::vector<size_t> missedIndexes;
+    for (size_t i = 0; i < bundleNames.size(); ++i) {
+        if (!GetCachedBundleStats(bundleNames[i], userId, allStats[i])) {
+            missedIndexes.emplace_back(i);
+        }
+    }
+    // the bundles are walked in parallel, the dirs of one bundle are walked one by one
+    uint64_t generation = GetBundleStatsGeneration();
+    ParallelTaskUtil::Run(missedIndexes.size(), MAX_BUNDLE_STATS_THREADS, [&](size_t index) {
+        size_t i = missedIndexes[index];
+        allStats[i] = GetBundleStatsFromDisk(bundleNames[i], userId, false);
+    });
+    for (size_t i : missedIndexes) {
+        SaveBundleStats(bundleNames[i], userId, allStats[i], generation);
     }
-    std::vector<std::string> cachePath;
-    for (auto &st : bundlePath) {
-        InstalldOperator::TraverseCacheDirectory(st, cachePath);
+    for (const auto &stats : allStats) {
+        bundleStats.insert(bundleStats.end(), stats.begin(), stats.end());
     }
-    int64_t bundleLocalSize = InstalldOperator::GetDiskUsageFromPath(bundlePath);
-    int64_t cacheSize = InstalldOperator::GetDiskUsageFromPath(cachePath);
-    bundleLocalSize -= cacheSize;
-    bundleStats.push_back(bundleLocalSize);
+    return ERR_OK;
+}
 
-    // index 2 : distributed data size
+std::vector<int64_t> InstalldHostImpl::GetBundleStatsFromDisk(
+    const std::string &bundleName, const int32_t userId, bool isParallel) const
+{
+    // every dir is walked once, the cache dirs in the base dirs are sized in the same walk
+    std::vector<std::string> paths;
+    paths.emplace_back(Constants::BUNDLE_CODE_DIR + Constants::FILE_SEPARATOR_CHAR + bundleName);
+    for (const auto &el : Constants::BUNDLE_EL) {
+        paths.emplace_back(GetBundleDataDir(el, userId) + Constants::BASE + bundleName);
+    }
     std::string distributedfilePath = Constants::DISTRIBUTED_FILE;
     distributedfilePath = distributedfilePath.replace(distributedfilePath.find("%"), 1, std::to_string(userId)) +
         bundleName;
-    int64_t distributedFileSize = InstalldOperator::GetDiskUsage(distributedfilePath);
-    bundleStats.push_back(distributedFileSize);
+    paths.emplace_back(distributedfilePath);
+    for (const auto &el : Constants::BUNDLE_EL) {
+        paths.emplace_back(GetBundleDataDir(el, userId) + Constants::DATABASE + bundleName);
+    }
+    std::vector<int64_t> sizes(paths.size(), 0);
+    std::vector<int64_t> cacheSizes(paths.size(), 0);
+    auto walk = [&](size_t index) {
+        sizes[index] = InstalldOperator::GetDiskUsageWithCache(paths[index], cacheSizes[index]);
+    };
+    if (isParallel) {
+        ParallelTaskUtil::Run(paths.size(), MAX_BUNDLE_STATS_THREADS, walk);
+    } else {
+        for (size_t i = 0; i < paths.size(); ++i) {
+            walk(i);
+        }
+    }
 
+    size_t elSize = Constants::BUNDLE_EL.size();
+    size_t distributedIndex = elSize + 1;
+    int64_t bundleLocalSize = 0;
+    int64_t cacheSize = 0;
+    for (size_t i = 1; i < distributedIndex; ++i) {
+        bundleLocalSize += sizes[i];
+        cacheSize += cacheSizes[i];
+    }
+    int64_t databaseFileSize = 0;
+    for (size_t i = distributedIndex + 1; i < paths.size(); ++i) {
+        databaseFileSize += sizes[i];
+    }
+    // index 0 : bundle data size
+    // index 1 : local bundle data size
+    // index 2 : distributed data size
     // index 3 : database size
-    std::vector<std::string> dataBasePath;
-    for (auto &el : Constants::BUNDLE_EL) {
-        std::string filePath = Constants::BUNDLE_APP_DATA_BASE_DIR + el + Constants::FILE_SEPARATOR_CHAR +
-            std::to_string(userId) + Constants::DATABASE + bundleName;
-        dataBasePath.push_back(filePath);
+    // index 4 : cache size
+    return { sizes[0], bundleLocalSize - cacheSize, sizes[distributedIndex], databaseFileSize, cacheSize };
+}
+
+bool InstalldHostImpl::GetCachedBundleStats(
+    const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats)
+{
+    std::lock_guard<std::mutex> lock(bundleStatsMutex_);
+    auto bundleIter = bundleStatsCache_.find(bundleName);
+    if (bundleIter == bundleStatsCache_.end()) {
+        return false;
     }
-    int64_t databaseFileSize = InstalldOperator::GetDiskUsageFromPath(dataBasePath);
-    bundleStats.push_back(databaseFileSize);
+    auto userIter = bundleIter->second.find(userId);
+    if (userIter == bundleIter->second.end()) {
+        return false;
+    }
+    if (GetSteadyTimeMs() - userIter->second.updateTime > BUNDLE_STATS_CACHE_TIMEOUT_MS) {
+        bundleIter->second.erase(userIter);
+        return false;
+    }
+    bundleStats = userIter->second.stats;
+    return true;
+}
 
-    // index 4 : cache size
-    bundleStats.push_back(cacheSize);
-    APP_LOGD("InstalldHostImpl::GetBundleStats end");
-    return ERR_OK;
+uint64_t InstalldHostImpl::GetBundleStatsGeneration()
+{
+    std::lock_guard<std::mutex> lock(bundleStatsMutex_);
+    return bundleStatsGeneration_;
+}
+
+void InstalldHostImpl::SaveBundleStats(const std::string &bundleName, const int32_t userId,
+    const std::vector<int64_t> &bundleStats, uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(bundleStatsMutex_);
+    if (generation != bundleStatsGeneration_) {
+        return;
+    }
+    BundleStatsCache &cache = bundleStatsCache_[bundleName][userId];
+    cache.stats = bundleStats;
+    cache.updateTime = GetSteadyTimeMs();
+}
+
+void InstalldHostImpl::InvalidateBundleStats(const std::string &bundleName)
+{
+    std::lock_guard<std::mutex> lock(bundleStatsMutex_);
+    ++bundleStatsGeneration_;
+    bundleStatsCache_.erase(bundleName);
+}
+
+void InstalldHostImpl::InvalidateBundleStatsByPath(const std::string &path)
+{
+    std::string bundleName = GetBundleNameFromPath(path);
+    if (!bundleName.empty()) {
+        InvalidateBundleStats(bundleName);
+    }
 }
 
 ErrCode InstalldHostImpl::SetDirApl(const std::string &dir, const std::string &bundleName, const std::string &apl)
@@ -15,8 +15,10 @@
 
 #include "installd/installd_operator.h"
 
+#include <cerrno>
 #include <cstdio>
 #include <dirent.h>
+#include <fcntl.h>
 #include <fstream>
 #include <map>
 #include <sstream>
@@ -31,6 +33,71 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+// Upper bound of the parent directory fds kept open by MkOwnerDirs.
+constexpr size_t MAX_CACHED_PARENT_FDS = 64;
+
+// Returns 1 if the dir is made under parentFd, 0 if it already exists and -1 on failure.
+int MkOwnerDirAt(int parentFd, const std::string &name, const OwnerDirInfo &dir)
+{
+    if (mkdirat(parentFd, name.c_str(), dir.mode) != 0) {
+        if (errno == EEXIST) {
+            return 0;
+        }
+        APP_LOGE("mkdirat %{private}s failed, errno:%{public}d", dir.path.c_str(), errno);
+        return -1;
+    }
+    // the mode passed to mkdirat is masked by umask
+    if (fchmodat(parentFd, name.c_str(), dir.mode, 0) != 0) {
+        APP_LOGE("fchmodat %{private}s failed, errno:%{public}d", dir.path.c_str(), errno);
+        return -1;
+    }
+    if (fchownat(parentFd, name.c_str(), dir.uid, dir.gid, AT_SYMLINK_NOFOLLOW) != 0) {
+        APP_LOGE("fchownat %{private}s failed, errno:%{public}d", dir.path.c_str(), errno);
+        return -1;
+    }
+    return 1;
+}
+
+// Returns the disk usage of the entries of the directory, takes the ownership of fd.
+// The first level cache dirs met in the walk are added to cacheSize as well.
+int64_t GetDiskUsageAt(int fd, bool isInCache, int64_t &cacheSize)
+{
+    DIR *dir = fdopendir(fd);
+    if (dir == nullptr) {
+        close(fd);
+        return 0;
+    }
+    int64_t size = 0;
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
+            continue;
+        }
+        struct stat fileInfo = {};
+        if (fstatat(dirfd(dir), entry->d_name, &fileInfo, AT_SYMLINK_NOFOLLOW) != 0) {
+            continue;
+        }
+        size += fileInfo.st_size;
+        if (!S_ISDIR(fileInfo.st_mode)) {
+            continue;
+        }
+        int subFd = openat(dirfd(dir), entry->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (subFd < 0) {
+            continue;
+        }
+        bool isCache = !isInCache && strcmp(entry->d_name, Constants::CACHE_DIR.c_str()) == 0;
+        int64_t subSize = GetDiskUsageAt(subFd, isInCache || isCache, cacheSize);
+        size += subSize;
+        if (isCache) {
+            cacheSize += subSize;
+        }
+    }
+    closedir(dir);
+    return size;
+}
+}  // namespace
+
 bool InstalldOperator::IsExistFile(const std::string &path)
 {
     if (path.empty()) {
@@ -302,6 +369,45 @@ bool InstalldOperator::MkOwnerDir(const std::string &path, int mode, const int u
     return ChangeFileAttr(path, uid, gid);
 }
 
+void InstalldOperator::MkOwnerDirs(const std::vector<OwnerDirInfo> &dirs, std::vector<bool> &results)
+{
+    results.assign(dirs.size(), false);
+    // the dirs of a bundle share a few parents, so each parent is opened once and the dirs
+    // are made relative to it instead of resolving the whole path for every syscall
+    std::map<std::string, int> parentFds;
+    for (size_t i = 0; i < dirs.size(); ++i) {
+        const OwnerDirInfo &dir = dirs[i];
+        std::string::size_type pos = dir.path.rfind(Constants::PATH_SEPARATOR);
+        if (pos == std::string::npos || pos == 0 || pos + 1 == dir.path.size()) {
+            results[i] = MkOwnerDir(dir.path, dir.mode, dir.uid, dir.gid);
+            continue;
+        }
+        std::string parent = dir.path.substr(0, pos);
+        int parentFd = -1;
+        auto iter = parentFds.find(parent);
+        if (iter != parentFds.end()) {
+            parentFd = iter->second;
+        } else {
+            parentFd = open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (parentFd >= 0) {
+                if (parentFds.size() >= MAX_CACHED_PARENT_FDS) {
+                    for (const auto &item : parentFds) {
+                        close(item.second);
+                    }
+                    parentFds.clear();
+                }
+                parentFds.emplace(parent, parentFd);
+            }
+        }
+        int ret = (parentFd >= 0) ? MkOwnerDirAt(parentFd, dir.path.substr(pos + 1), dir) : 0;
+        // missing parents and existing dirs keep the behaviour of MkOwnerDir
+        results[i] = (ret == 0) ? MkOwnerDir(dir.path, dir.mode, dir.uid, dir.gid) : (ret > 0);
+    }
+    for (const auto &item : parentFds) {
+        close(item.second);
+    }
+}
+
 int64_t InstalldOperator::GetDiskUsage(const std::string &dir)
 {
     if (dir.empty() || (dir.size() > Constants::PATH_MAX_SIZE)) {
@@ -391,5 +497,20 @@ int64_t InstalldOperator::GetDiskUsageFromPath(const std::vector<std::string> &p
     }
     return fileSize;
 }
+
+int64_t InstalldOperator::GetDiskUsageWithCache(const std::string &dir, int64_t &cacheSize)
+{
+    cacheSize = 0;
+    if (dir.empty() || (dir.size() > Constants::PATH_MAX_SIZE)) {
+        APP_LOGE("GetDiskUsageWithCache dir path invaild");
+        return 0;
+    }
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        APP_LOGD("GetDiskUsageWithCache open dir:%{private}s failed, errno:%{public}d", dir.c_str(), errno);
+        return 0;
+    }
+    return GetDiskUsageAt(fd, false, cacheSize);
+}
 }  // namespace AppExecFwk
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
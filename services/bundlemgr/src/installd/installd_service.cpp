@@ -23,6 +23,7 @@
 
 #include "app_log_wrapper.h"
 #include "bundle_constants.h"
+#include "installd/installd_trash_mgr.h"
 #include "system_ability_definition.h"
 #include "system_ability_helper.h"
 
@@ -65,6 +66,7 @@ bool InstalldService::Init()
     if (!InitDir(Constants::HAP_COPY_PATH)) {
         APP_LOGI("HAP_COPY_PATH is already exists");
     }
+    InstalldTrashMgr::GetInstance()->RecoverTrash();
     return true;
 }
 
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "installd/installd_trash_mgr.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <deque>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "app_log_wrapper.h"
+#include "bundle_constants.h"
+#include "installd/installd_operator.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const std::string TRASH_DIR = "/.trash";
+constexpr int TRASH_WORKER_NICE = 19;
+// values of linux/ioprio.h, which is not exported to user space on every platform
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_IDLE = 3;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+// Upper bound of the dirs open at once while the trash is deleted, each one holds an fd.
+constexpr size_t MAX_OPEN_DIR_DEPTH = 32;
+
+bool IsUserIdDir(const std::string &name)
+{
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+struct OpenDir {
+    DIR *dir = nullptr;
+    // the name in the parent dir, empty for the trash dir itself
+    std::string name;
+};
+
+// Returns the name a too deep directory is moved to in the trash, it is unique for the trash dir.
+std::string GetDeepDirName()
+{
+    static uint32_t sequence = 0;
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return "deep_" + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(now).count()) +
+        "_" + std::to_string(sequence++);
+}
+
+// Removes the entry of a dir which is not a directory.
+bool RemoveEntryAt(int parentFd, const char *name)
+{
+    if (unlinkat(parentFd, name, 0) == 0 || errno == ENOENT) {
+        return true;
+    }
+    APP_LOGE("remove trash %{private}s failed, errno:%{public}d", name, errno);
+    return false;
+}
+
+// Removes the tree of one entry of the trash, or all the entries of the trash if name is empty.
+// The tree is walked without recursion and at most MAX_OPEN_DIR_DEPTH dirs are open at once, a
+// deeper directory is moved up into the trash and removed after the current tree.
+bool RemoveTrashAt(int trashFd, const std::string &name)
+{
+    bool ret = true;
+    std::deque<std::string> pendingNames { name };
+    std::vector<OpenDir> openDirs;
+    while (!pendingNames.empty()) {
+        std::string rootName = pendingNames.front();
+        pendingNames.pop_front();
+        int fd = openat(trashFd, rootName.empty() ? "." : rootName.c_str(),
+            O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (fd < 0) {
+            // a symlink or a file whose type is not reported by readdir
+            ret = (rootName.empty() || RemoveEntryAt(trashFd, rootName.c_str())) && ret;
+            continue;
+        }
+        DIR *rootDir = fdopendir(fd);
+        if (rootDir == nullptr) {
+            close(fd);
+            ret = false;
+            continue;
+        }
+        openDirs.push_back({ rootDir, rootName });
+        while (!openDirs.empty()) {
+            DIR *dir = openDirs.back().dir;
+            struct dirent *entry = readdir(dir);
+            if (entry == nullptr) {
+                std::string dirName = openDirs.back().name;
+                closedir(dir);
+                openDirs.pop_back();
+                int parentFd = openDirs.empty() ? trashFd : dirfd(openDirs.back().dir);
+                if (!dirName.empty() && unlinkat(parentFd, dirName.c_str(), AT_REMOVEDIR) != 0 && errno != ENOENT) {
+                    APP_LOGE("remove trash %{private}s failed, errno:%{public}d", dirName.c_str(), errno);
+                    ret = false;
+                }
+                continue;
+            }
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                continue;
+            }
+            if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) {
+                ret = RemoveEntryAt(dirfd(dir), entry->d_name) && ret;
+                continue;
+            }
+            if (openDirs.size() >= MAX_OPEN_DIR_DEPTH) {
+                std::string deepName = GetDeepDirName();
+                if (renameat(dirfd(dir), entry->d_name, trashFd, deepName.c_str()) == 0) {
+                    pendingNames.push_back(deepName);
+                } else {
+                    ret = RemoveEntryAt(dirfd(dir), entry->d_name) && ret;
+                }
+                continue;
+            }
+            int childFd = openat(dirfd(dir), entry->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if (childFd < 0) {
+                ret = RemoveEntryAt(dirfd(dir), entry->d_name) && ret;
+                continue;
+            }
+            DIR *childDir = fdopendir(childFd);
+            if (childDir == nullptr) {
+                close(childFd);
+                ret = false;
+                continue;
+            }
+            openDirs.push_back({ childDir, entry->d_name });
+        }
+    }
+    return ret;
+}
+}  // namespace
+
+InstalldTrashMgr::InstalldTrashMgr()
+{
+    APP_LOGI("installd trash mgr instance is created");
+}
+
+InstalldTrashMgr::~InstalldTrashMgr()
+{
+    APP_LOGI("installd trash mgr instance is destroyed");
+}
+
+bool InstalldTrashMgr::RemoveDir(const std::string &path)
+{
+    if (InstalldOperator::IsExistDir(path) && MoveToTrash(path)) {
+        return true;
+    }
+    return InstalldOperator::DeleteDir(path);
+}
+
+bool InstalldTrashMgr::RemoveFiles(const std::string &dataPath)
+{
+    DIR *dir = opendir(dataPath.c_str());
+    if (dir == nullptr) {
+        return false;
+    }
+    bool ret = true;
+    std::vector<std::string> subDirs;
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        std::string subPath = dataPath + Constants::PATH_SEPARATOR + entry->d_name;
+        if (entry->d_type == DT_DIR) {
+            // renamed after the directory is read
+            subDirs.emplace_back(subPath);
+        } else if (unlink(subPath.c_str()) != 0 && errno != ENOENT) {
+            APP_LOGE("remove file %{private}s failed, errno:%{public}d", subPath.c_str(), errno);
+            ret = false;
+        }
+    }
+    closedir(dir);
+    for (const auto &subDir : subDirs) {
+        ret = RemoveDir(subDir) && ret;
+    }
+    return ret;
+}
+
+void InstalldTrashMgr::RecoverTrash()
+{
+    std::vector<std::string> trashDirs { Constants::BUNDLE_BASE_CODE_DIR + TRASH_DIR };
+    for (const auto &el : Constants::BUNDLE_EL) {
+        std::string elDir = Constants::BUNDLE_APP_DATA_BASE_DIR + el;
+        DIR *dir = opendir(elDir.c_str());
+        if (dir == nullptr) {
+            continue;
+        }
+        struct dirent *entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr) {
+            if (entry->d_type == DT_DIR && IsUserIdDir(entry->d_name)) {
+                trashDirs.emplace_back(elDir + Constants::PATH_SEPARATOR + entry->d_name + TRASH_DIR);
+            }
+        }
+        closedir(dir);
+    }
+    for (const auto &trashDir : trashDirs) {
+        if (InstalldOperator::IsExistDir(trashDir)) {
+            APP_LOGI("recover trash %{public}s", trashDir.c_str());
+            AddTrashItem(trashDir, "");
+        }
+    }
+}
+
+std::string InstalldTrashMgr::GetTrashDir(const std::string &path) const
+{
+    // rename only works inside one volume, and the data of each el and user is encrypted
+    // with its own key, so the trash is kept next to the code dir and in each user dir
+    std::string codePrefix = Constants::BUNDLE_BASE_CODE_DIR + Constants::PATH_SEPARATOR;
+    if (path.size() > codePrefix.size() && path.compare(0, codePrefix.size(), codePrefix) == 0) {
+        return Constants::BUNDLE_BASE_CODE_DIR + TRASH_DIR;
+    }
+    for (const auto &el : Constants::BUNDLE_EL) {
+        std::string elPrefix = Constants::BUNDLE_APP_DATA_BASE_DIR + el + Constants::PATH_SEPARATOR;
+        if (path.compare(0, elPrefix.size(), elPrefix) != 0) {
+            continue;
+        }
+        std::string::size_type userEnd = path.find(Constants::PATH_SEPARATOR, elPrefix.size());
+        if (userEnd == std::string::npos || userEnd + 1 >= path.size() ||
+            !IsUserIdDir(path.substr(elPrefix.size(), userEnd - elPrefix.size()))) {
+            return "";
+        }
+        return path.substr(0, userEnd) + TRASH_DIR;
+    }
+    return "";
+}
+
+bool InstalldTrashMgr::MoveToTrash(const std::string &path)
+{
+    std::string trashDir = GetTrashDir(path);
+    if (trashDir.empty()) {
+        return false;
+    }
+    if (mkdir(trashDir.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+        APP_LOGW("create trash %{public}s failed, errno:%{public}d", trashDir.c_str(), errno);
+        return false;
+    }
+    // names stay unique across restarts, the trash of the last run may not be deleted yet
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    std::string name = std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(now).count()) +
+        "_" + std::to_string(sequence_++);
+    if (rename(path.c_str(), (trashDir + Constants::PATH_SEPARATOR + name).c_str()) != 0) {
+        APP_LOGW("move %{private}s to trash failed, errno:%{public}d", path.c_str(), errno);
+        return false;
+    }
+    AddTrashItem(trashDir, name);
+    return true;
+}
+
+void InstalldTrashMgr::AddTrashItem(const std::string &trashDir, const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    trashItems_.push_back({ trashDir, name });
+    if (!isWorkerStarted_) {
+        // the worker keeps the instance alive, it waits for new trash until installd exits
+        std::thread worker([self = DelayedSingleton<InstalldTrashMgr>::GetInstance()] {
+            if (self != nullptr) {
+                self->ProcessTrash();
+            }
+        });
+        worker.detach();
+        isWorkerStarted_ = true;
+    }
+    cv_.notify_one();
+}
+
+void InstalldTrashMgr::ProcessTrash()
+{
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), TRASH_WORKER_NICE) != 0) {
+        APP_LOGW("lower the priority of the trash worker failed, errno:%{public}d", errno);
+    }
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+    while (true) {
+        TrashItem item;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !trashItems_.empty(); });
+            item = trashItems_.front();
+            trashItems_.pop_front();
+        }
+        int fd = open(item.trashDir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            APP_LOGE("open trash %{public}s failed, errno:%{public}d", item.trashDir.c_str(), errno);
+            continue;
+        }
+        bool ret = RemoveTrashAt(fd, item.name);
+        close(fd);
+        if (!ret) {
+            APP_LOGW("trash %{public}s is not fully deleted, it is retried after restart",
+                item.trashDir.c_str());
+        }
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "installd_client.h"
 
+#include <algorithm>
+
 #include "app_log_wrapper.h"
 #include "bundle_constants.h"
 #include "installd_death_recipient.h"
@@ -65,6 +67,25 @@ ErrCode InstalldClient::CreateBundleDataDir(const std::string &bundleName,
     return CallService(&IInstalld::CreateBundleDataDir, bundleName, userid, uid, gid, apl);
 }
 
+ErrCode InstalldClient::CreateBundleDataDirs(
+    const std::vector<CreateDirParam> &createDirParams, std::vector<ErrCode> &results)
+{
+    results.clear();
+    // large batches are sent in several requests to keep each parcel small
+    for (size_t begin = 0; begin < createDirParams.size(); begin += MAX_CREATE_DIR_PARAMS_SIZE) {
+        size_t end = std::min(createDirParams.size(), begin + MAX_CREATE_DIR_PARAMS_SIZE);
+        std::vector<CreateDirParam> batch(createDirParams.begin() + begin, createDirParams.begin() + end);
+        std::vector<ErrCode> batchResults;
+        ErrCode result = CallService(&IInstalld::CreateBundleDataDirs, batch, batchResults);
+        if (result != ERR_OK) {
+            APP_LOGE("fail to create bundle data dirs, error is %{public}d", result);
+            batchResults.assign(batch.size(), result);
+        }
+        results.insert(results.end(), batchResults.begin(), batchResults.end());
+    }
+    return ERR_OK;
+}
+
 ErrCode InstalldClient::RemoveBundleDataDir(
     const std::string &bundleName, const int userid)
 {
@@ -117,6 +138,24 @@ ErrCode InstalldClient::GetBundleStats(
     return CallService(&IInstalld::GetBundleStats, bundleName, userId, bundleStats);
 }
 
+ErrCode InstalldClient::BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+    std::vector<int64_t> &bundleStats)
+{
+    bundleStats.clear();
+    for (size_t begin = 0; begin < bundleNames.size(); begin += MAX_BATCH_BUNDLE_STATS_SIZE) {
+        size_t end = std::min(bundleNames.size(), begin + MAX_BATCH_BUNDLE_STATS_SIZE);
+        std::vector<std::string> batch(bundleNames.begin() + begin, bundleNames.begin() + end);
+        std::vector<int64_t> batchStats;
+        ErrCode result = CallService(&IInstalld::BatchGetBundleStats, batch, userId, batchStats);
+        if (result != ERR_OK) {
+            APP_LOGE("fail to batch get bundle stats, error is %{public}d", result);
+            return result;
+        }
+        bundleStats.insert(bundleStats.end(), batchStats.begin(), batchStats.end());
+    }
+    return ERR_OK;
+}
+
 ErrCode InstalldClient::SetDirApl(const std::string &dir, const std::string &bundleName, const std::string &apl)
 {
     if (dir.empty() || bundleName.empty() || apl.empty()) {
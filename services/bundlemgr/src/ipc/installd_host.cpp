@@ -47,6 +47,8 @@ void InstalldHost::init()
     funcMap_.emplace(IInstalld::Message::REMOVE_DIR, &InstalldHost::HandleRemoveDir);
     funcMap_.emplace(IInstalld::Message::GET_BUNDLE_STATS, &InstalldHost::HandleGetBundleStats);
     funcMap_.emplace(IInstalld::Message::GET_BUNDLE_CACHE_PATH, &InstalldHost::HandleGetBundleCachePath);
+    funcMap_.emplace(IInstalld::Message::CREATE_BUNDLE_DATA_DIRS, &InstalldHost::HandleCreateBundleDataDirs);
+    funcMap_.emplace(IInstalld::Message::BATCH_GET_BUNDLE_STATS, &InstalldHost::HandleBatchGetBundleStats);
 }
 
 int InstalldHost::OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
@@ -114,6 +116,32 @@ bool InstalldHost::HandleCreateBundleDataDir(MessageParcel &data, MessageParcel
     return true;
 }
 
+bool InstalldHost::HandleCreateBundleDataDirs(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t size = data.ReadInt32();
+    if (size < 0 || static_cast<size_t>(size) > MAX_CREATE_DIR_PARAMS_SIZE) {
+        APP_LOGE("invalid size of create dir params %{public}d", size);
+        WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, reply, ERR_APPEXECFWK_INSTALLD_PARAM_ERROR);
+        return true;
+    }
+    std::vector<CreateDirParam> createDirParams(size);
+    for (auto &createDirParam : createDirParams) {
+        createDirParam.bundleName = Str16ToStr8(data.ReadString16());
+        createDirParam.userId = data.ReadInt32();
+        createDirParam.uid = data.ReadInt32();
+        createDirParam.gid = data.ReadInt32();
+        createDirParam.apl = Str16ToStr8(data.ReadString16());
+    }
+    std::vector<ErrCode> results;
+    ErrCode result = CreateBundleDataDirs(createDirParams, results);
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, reply, result);
+    if (result == ERR_OK && !reply.WriteInt32Vector(results)) {
+        APP_LOGE("fail to write CreateBundleDataDirs results into reply");
+        return false;
+    }
+    return true;
+}
+
 bool InstalldHost::HandleRemoveBundleDataDir(MessageParcel &data, MessageParcel &reply)
 {
     std::string bundleName = Str16ToStr8(data.ReadString16());
@@ -162,6 +190,24 @@ bool InstalldHost::HandleGetBundleStats(MessageParcel &data, MessageParcel &repl
     return true;
 }
 
+bool InstalldHost::HandleBatchGetBundleStats(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<std::string> bundleNames;
+    if (!data.ReadStringVector(&bundleNames)) {
+        APP_LOGE("HandleBatchGetBundleStats read bundleNames failed");
+        return false;
+    }
+    int32_t userId = data.ReadInt32();
+    std::vector<int64_t> bundleStats;
+    ErrCode result = BatchGetBundleStats(bundleNames, userId, bundleStats);
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, reply, result);
+    if (result == ERR_OK && !reply.WriteInt64Vector(bundleStats)) {
+        APP_LOGE("HandleBatchGetBundleStats write failed");
+        return false;
+    }
+    return true;
+}
+
 bool InstalldHost::HandleSetDirApl(MessageParcel &data, MessageParcel &reply)
 {
     std::string dataDir = Str16ToStr8(data.ReadString16());
@@ -92,6 +92,33 @@ ErrCode InstalldProxy::CreateBundleDataDir(const std::string &bundleName,
     return TransactInstalldCmd(IInstalld::Message::CREATE_BUNDLE_DATA_DIR, data, reply, option);
 }
 
+ErrCode InstalldProxy::CreateBundleDataDirs(
+    const std::vector<CreateDirParam> &createDirParams, std::vector<ErrCode> &results)
+{
+    MessageParcel data;
+    INSTALLD_PARCEL_WRITE_INTERFACE_TOKEN(data, (GetDescriptor()));
+    INSTALLD_PARCEL_WRITE(data, Int32, static_cast<int32_t>(createDirParams.size()));
+    for (const auto &createDirParam : createDirParams) {
+        INSTALLD_PARCEL_WRITE(data, String16, Str8ToStr16(createDirParam.bundleName));
+        INSTALLD_PARCEL_WRITE(data, Int32, createDirParam.userId);
+        INSTALLD_PARCEL_WRITE(data, Int32, createDirParam.uid);
+        INSTALLD_PARCEL_WRITE(data, Int32, createDirParam.gid);
+        INSTALLD_PARCEL_WRITE(data, String16, Str8ToStr16(createDirParam.apl));
+    }
+
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+    auto ret = TransactInstalldCmd(IInstalld::Message::CREATE_BUNDLE_DATA_DIRS, data, reply, option);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    if (!reply.ReadInt32Vector(&results) || results.size() != createDirParams.size()) {
+        APP_LOGE("fail to read CreateBundleDataDirs results from reply");
+        return ERR_APPEXECFWK_PARCEL_ERROR;
+    }
+    return ERR_OK;
+}
+
 ErrCode InstalldProxy::RemoveBundleDataDir(const std::string &bundleName, const int userid)
 {
     MessageParcel data;
@@ -158,6 +185,25 @@ ErrCode InstalldProxy::GetBundleStats(
     return ret;
 }
 
+ErrCode InstalldProxy::BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+    std::vector<int64_t> &bundleStats)
+{
+    MessageParcel data;
+    INSTALLD_PARCEL_WRITE_INTERFACE_TOKEN(data, (GetDescriptor()));
+    INSTALLD_PARCEL_WRITE(data, StringVector, bundleNames);
+    INSTALLD_PARCEL_WRITE(data, Int32, userId);
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+    auto ret = TransactInstalldCmd(IInstalld::Message::BATCH_GET_BUNDLE_STATS, data, reply, option);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    if (!reply.ReadInt64Vector(&bundleStats)) {
+        return ERR_APPEXECFWK_PARCEL_ERROR;
+    }
+    return ERR_OK;
+}
+
 ErrCode InstalldProxy::SetDirApl(const std::string &dir, const std::string &bundleName, const std::string &apl)
 {
     MessageParcel data;
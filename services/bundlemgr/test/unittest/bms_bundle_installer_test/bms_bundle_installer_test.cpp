@@ -15,20 +15,34 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <climits>
 #include <cstdio>
 #include <dirent.h>
 #include <fcntl.h>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "bundle_info.h"
 #include "bundle_data_storage_database.h"
+#define private public
+#include "bundle_installer_manager.h"
+#undef private
 #include "bundle_installer_host.h"
 #include "bundle_mgr_service.h"
+#define private public
+#include "bundle_verify_mgr.h"
+#undef private
 #include "directory_ex.h"
+#include "hidump_helper.h"
 #include "install_param.h"
 #include "installd/installd_service.h"
 #include "installd_client.h"
@@ -66,6 +80,56 @@ const std::string BUNDLE_BACKUP_NAME = "com.example.backuptest";
 const std::string MODULE_NAME = "entry";
 const std::string EXTENSION_ABILITY_NAME = "extensionAbility_A";
 const size_t NUMBER_ONE = 1;
+const std::string PRE_VERIFY_HAP = "/data/test/pre_verify_test.hap";
+const std::string OTHER_BUNDLE_NAME = "com.example.queuetest";
+const std::string ARGS_INSTALLER_QUEUE = "-installer-queue";
+const size_t QUEUED_TASK_COUNT = 3;
+const auto QUEUE_WAIT_TIME = 5s;
+
+struct QueuedTaskRecord {
+    std::mutex mutex;
+    std::vector<size_t> order;
+    std::atomic<int32_t> runningCount = 0;
+    std::atomic<int32_t> maxRunningCount = 0;
+    std::promise<void> release;
+    std::promise<void> finished;
+};
+const std::string PRE_VERIFY_COPY_HAP = "/data/test/pre_verify_test_copy.hap";
+// set as the saved result to tell a pre verify result from a new verify
+const ErrCode PRE_VERIFY_MARK = ERR_APPEXECFWK_INSTALL_INTERNAL_ERROR;
+
+bool CopyHap(const std::string &srcPath, const std::string &destPath)
+{
+    std::ifstream in(srcPath, std::ios::binary);
+    std::ofstream out(destPath, std::ios::binary | std::ios::trunc);
+    if (!in.is_open() || !out.is_open()) {
+        return false;
+    }
+    out << in.rdbuf();
+    return out.good();
+}
+
+// Marks the result saved for a hap, returns false if there is none.
+bool MarkPreVerifyResult(const std::string &filePath)
+{
+    char buf[PATH_MAX] = {0};
+    if (realpath(filePath.c_str(), buf) == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(BundleVerifyMgr::preVerifyMutex_);
+    auto iter = BundleVerifyMgr::preVerifyRecords_.find(buf);
+    if (iter == BundleVerifyMgr::preVerifyRecords_.end()) {
+        return false;
+    }
+    iter->second.result = PRE_VERIFY_MARK;
+    return true;
+}
+
+size_t GetPreVerifyRecordCount()
+{
+    std::lock_guard<std::mutex> lock(BundleVerifyMgr::preVerifyMutex_);
+    return BundleVerifyMgr::preVerifyRecords_.size();
+}
 }  // namespace
 
 class BmsBundleInstallerTest : public testing::Test {
@@ -540,6 +604,124 @@ HWTEST_F(BmsBundleInstallerTest, CreateUninstallTask_0200, Function | SmallTest
     EXPECT_NE(ERR_OK, result);
 }
 
+/**
+ * @tc.number: InstallerQueueStats_0100
+ * @tc.name: test the tasks of one bundle run one by one in order
+ * @tc.desc: 1.add three tasks of the same bundle while the first one is blocked
+ *           2.the later tasks wait in the bundle queue
+ *           3.the tasks run in the order they are added and never overlap
+ */
+HWTEST_F(BmsBundleInstallerTest, InstallerQueueStats_0100, Function | SmallTest | Level0)
+{
+    CreateInstallerManager();
+    auto manager = GetBundleInstallerManager();
+    ASSERT_NE(manager, nullptr);
+    auto record = std::make_shared<QueuedTaskRecord>();
+    std::shared_future<void> release = record->release.get_future().share();
+    for (size_t i = 0; i < QUEUED_TASK_COUNT; i++) {
+        manager->AddTask(BUNDLE_NAME, [record, release, i] {
+            int32_t running = ++record->runningCount;
+            int32_t maxRunning = record->maxRunningCount.load();
+            while (running > maxRunning && !record->maxRunningCount.compare_exchange_weak(maxRunning, running)) {}
+            if (i == 0) {
+                release.wait_for(QUEUE_WAIT_TIME);
+            }
+            {
+                std::lock_guard<std::mutex> lock(record->mutex);
+                record->order.push_back(i);
+            }
+            record->runningCount--;
+            if (i == QUEUED_TASK_COUNT - 1) {
+                record->finished.set_value();
+            }
+        });
+    }
+    InstallerQueueStats stats = manager->GetQueueStats();
+    EXPECT_EQ(stats.runningBundleCount, NUMBER_ONE);
+    EXPECT_GE(stats.maxBundleQueueDepth, QUEUED_TASK_COUNT - 1);
+    EXPECT_GE(stats.pendingTaskCount, QUEUED_TASK_COUNT - 1);
+
+    record->release.set_value();
+    ASSERT_EQ(record->finished.get_future().wait_for(QUEUE_WAIT_TIME), std::future_status::ready);
+    {
+        std::lock_guard<std::mutex> lock(record->mutex);
+        std::vector<size_t> expectOrder = { 0, 1, 2 };
+        EXPECT_EQ(record->order, expectOrder);
+    }
+    EXPECT_EQ(record->maxRunningCount.load(), 1);
+    stats = manager->GetQueueStats();
+    EXPECT_EQ(stats.pendingTaskCount, 0u);
+    EXPECT_EQ(stats.startedTaskCount, QUEUED_TASK_COUNT);
+}
+
+/**
+ * @tc.number: InstallerQueueStats_0200
+ * @tc.name: test the tasks of different bundles run in parallel
+ * @tc.desc: 1.add one task of each of two bundles
+ *           2.each task waits until the other one has started, so both finish only if they run in parallel
+ */
+HWTEST_F(BmsBundleInstallerTest, InstallerQueueStats_0200, Function | SmallTest | Level0)
+{
+    if (std::thread::hardware_concurrency() < 2) {
+        GTEST_SKIP() << "the installer pool has a single thread";
+    }
+    CreateInstallerManager();
+    auto manager = GetBundleInstallerManager();
+    ASSERT_NE(manager, nullptr);
+    auto firstStarted = std::make_shared<std::promise<void>>();
+    auto secondStarted = std::make_shared<std::promise<void>>();
+    auto firstResult = std::make_shared<std::promise<bool>>();
+    auto secondResult = std::make_shared<std::promise<bool>>();
+    std::shared_future<void> firstFuture = firstStarted->get_future().share();
+    std::shared_future<void> secondFuture = secondStarted->get_future().share();
+    manager->AddTask(BUNDLE_NAME, [firstStarted, secondFuture, firstResult] {
+        firstStarted->set_value();
+        firstResult->set_value(secondFuture.wait_for(QUEUE_WAIT_TIME) == std::future_status::ready);
+    });
+    manager->AddTask(OTHER_BUNDLE_NAME, [secondStarted, firstFuture, secondResult] {
+        secondStarted->set_value();
+        secondResult->set_value(firstFuture.wait_for(QUEUE_WAIT_TIME) == std::future_status::ready);
+    });
+    auto first = firstResult->get_future();
+    auto second = secondResult->get_future();
+    EXPECT_TRUE(first.get());
+    EXPECT_TRUE(second.get());
+}
+
+/**
+ * @tc.number: InstallerQueueStats_0300
+ * @tc.name: test the queue statistics are dumped by hidumper
+ * @tc.desc: 1.run two uninstall tasks of the same bundle
+ *           2.the -installer-queue dump reports both started tasks
+ *           3.the dump fails once the installer manager is released
+ */
+HWTEST_F(BmsBundleInstallerTest, InstallerQueueStats_0300, Function | SmallTest | Level0)
+{
+    CreateInstallerManager();
+    auto manager = GetBundleInstallerManager();
+    ASSERT_NE(manager, nullptr);
+    sptr<MockStatusReceiver> firstReceiver = new (std::nothrow) MockStatusReceiver();
+    sptr<MockStatusReceiver> secondReceiver = new (std::nothrow) MockStatusReceiver();
+    ASSERT_NE(firstReceiver, nullptr);
+    ASSERT_NE(secondReceiver, nullptr);
+    InstallParam installParam;
+    installParam.userId = USERID;
+    manager->CreateUninstallTask(BUNDLE_NAME, installParam, firstReceiver);
+    manager->CreateUninstallTask(BUNDLE_NAME, installParam, secondReceiver);
+    EXPECT_NE(ERR_OK, firstReceiver->GetResultCode());
+    EXPECT_NE(ERR_OK, secondReceiver->GetResultCode());
+
+    std::string result;
+    {
+        HidumpHelper helper(std::weak_ptr<BundleDataMgr>(), manager);
+        EXPECT_TRUE(helper.Dump({ ARGS_INSTALLER_QUEUE }, result));
+    }
+    EXPECT_NE(result.find("pendingTaskCount: 0\n"), std::string::npos);
+    EXPECT_NE(result.find("startedTaskCount: 2\n"), std::string::npos);
+
+    HidumpHelper expiredHelper(std::weak_ptr<BundleDataMgr>(), std::weak_ptr<BundleInstallerManager>());
+    EXPECT_FALSE(expiredHelper.Dump({ ARGS_INSTALLER_QUEUE }, result));
+}
 
 /**
  * @tc.number: ParseModuleJson_0100
@@ -765,4 +947,110 @@ HWTEST_F(BmsBundleInstallerTest, QueryExtensionAbilityInfos_0400, Function | Sma
     }
     UnInstallBundle(BUNDLE_BACKUP_NAME);
 }
+
+/**
+ * @tc.number: QueryExtensionAbilityInfos_0500
+ * @tc.name: test query the extensionAbilityInfos by type
+ * @tc.desc: 1.install the hap
+ *           2.query extensionAbilityInfos of the backup type before and after uninstall
+ */
+HWTEST_F(BmsBundleInstallerTest, QueryExtensionAbilityInfos_0500, Function | SmallTest | Level0)
+{
+    std::string bundlePath = RESOURCE_ROOT_PATH + BUNDLE_BACKUP_TEST;
+    ErrCode installResult = InstallThirdPartyBundle(bundlePath);
+    EXPECT_EQ(installResult, ERR_OK);
+
+    auto dataMgr = GetBundleDataMgr();
+    EXPECT_NE(dataMgr, nullptr);
+    std::vector<ExtensionAbilityInfo> infos;
+    bool result = dataMgr->QueryExtensionAbilityInfos(ExtensionAbilityType::BACKUP, USERID, infos);
+    EXPECT_TRUE(result);
+    auto isBackupBundle = [](const ExtensionAbilityInfo &info) { return info.bundleName == BUNDLE_BACKUP_NAME; };
+    EXPECT_EQ(static_cast<size_t>(std::count_if(infos.begin(), infos.end(), isBackupBundle)), NUMBER_ONE);
+    for (const auto &info : infos) {
+        EXPECT_EQ(info.type, ExtensionAbilityType::BACKUP);
+    }
+    UnInstallBundle(BUNDLE_BACKUP_NAME);
+
+    infos.clear();
+    result = dataMgr->QueryExtensionAbilityInfos(ExtensionAbilityType::BACKUP, USERID, infos);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(std::none_of(infos.begin(), infos.end(), isBackupBundle), true);
+}
+
+/**
+ * @tc.number: PreVerify_0100
+ * @tc.name: test the pre verify result of an unchanged hap is used once
+ * @tc.desc: 1.pre verify a hap and mark the saved result
+ *           2.the next verify returns the marked result and the one after verifies the hap again
+ */
+HWTEST_F(BmsBundleInstallerTest, PreVerify_0100, Function | SmallTest | Level0)
+{
+    ASSERT_TRUE(CopyHap(RESOURCE_ROOT_PATH + RIGHT_BUNDLE, PRE_VERIFY_HAP));
+    size_t recordCount = GetPreVerifyRecordCount();
+    EXPECT_EQ(BundleVerifyMgr::PreVerify(PRE_VERIFY_HAP), ERR_OK);
+    EXPECT_EQ(GetPreVerifyRecordCount(), recordCount + 1);
+    EXPECT_TRUE(MarkPreVerifyResult(PRE_VERIFY_HAP));
+
+    Security::Verify::HapVerifyResult hapVerifyResult;
+    EXPECT_EQ(BundleVerifyMgr::HapVerify(PRE_VERIFY_HAP, hapVerifyResult), PRE_VERIFY_MARK);
+    EXPECT_EQ(GetPreVerifyRecordCount(), recordCount);
+    EXPECT_EQ(BundleVerifyMgr::HapVerify(PRE_VERIFY_HAP, hapVerifyResult), ERR_OK);
+    remove(PRE_VERIFY_HAP.c_str());
+}
+
+/**
+ * @tc.number: PreVerify_0200
+ * @tc.name: test the pre verify result is not used once the hap is written or replaced
+ * @tc.desc: 1.pre verify a hap, mark the saved result and append to the hap
+ *           2.pre verify it again, mark the result and replace the hap by a copy
+ *           3.each verify verifies the hap again and drops the saved result
+ */
+HWTEST_F(BmsBundleInstallerTest, PreVerify_0200, Function | SmallTest | Level0)
+{
+    ASSERT_TRUE(CopyHap(RESOURCE_ROOT_PATH + RIGHT_BUNDLE, PRE_VERIFY_HAP));
+    size_t recordCount = GetPreVerifyRecordCount();
+    Security::Verify::HapVerifyResult hapVerifyResult;
+
+    EXPECT_EQ(BundleVerifyMgr::PreVerify(PRE_VERIFY_HAP), ERR_OK);
+    EXPECT_TRUE(MarkPreVerifyResult(PRE_VERIFY_HAP));
+    {
+        std::ofstream out(PRE_VERIFY_HAP, std::ios::binary | std::ios::app);
+        out << "appended";
+    }
+    EXPECT_NE(BundleVerifyMgr::HapVerify(PRE_VERIFY_HAP, hapVerifyResult), PRE_VERIFY_MARK);
+    EXPECT_EQ(GetPreVerifyRecordCount(), recordCount);
+
+    ASSERT_TRUE(CopyHap(RESOURCE_ROOT_PATH + RIGHT_BUNDLE, PRE_VERIFY_HAP));
+    EXPECT_EQ(BundleVerifyMgr::PreVerify(PRE_VERIFY_HAP), ERR_OK);
+    EXPECT_TRUE(MarkPreVerifyResult(PRE_VERIFY_HAP));
+    ASSERT_TRUE(CopyHap(RESOURCE_ROOT_PATH + RIGHT_BUNDLE, PRE_VERIFY_COPY_HAP));
+    EXPECT_EQ(rename(PRE_VERIFY_COPY_HAP.c_str(), PRE_VERIFY_HAP.c_str()), 0);
+    EXPECT_EQ(BundleVerifyMgr::HapVerify(PRE_VERIFY_HAP, hapVerifyResult), ERR_OK);
+    EXPECT_EQ(GetPreVerifyRecordCount(), recordCount);
+    remove(PRE_VERIFY_HAP.c_str());
+}
+
+/**
+ * @tc.number: PreVerify_0300
+ * @tc.name: test the pre verify result of a removed hap is cleared
+ * @tc.desc: 1.pre verify a hap and remove it
+ *           2.the saved result is dropped by ClearPreVerifyResult
+ */
+HWTEST_F(BmsBundleInstallerTest, PreVerify_0300, Function | SmallTest | Level0)
+{
+    ASSERT_TRUE(CopyHap(RESOURCE_ROOT_PATH + RIGHT_BUNDLE, PRE_VERIFY_HAP));
+    size_t recordCount = GetPreVerifyRecordCount();
+    EXPECT_EQ(BundleVerifyMgr::PreVerify(PRE_VERIFY_HAP), ERR_OK);
+    EXPECT_EQ(GetPreVerifyRecordCount(), recordCount + 1);
+    EXPECT_EQ(remove(PRE_VERIFY_HAP.c_str()), 0);
+    BundleVerifyMgr::ClearPreVerifyResult(PRE_VERIFY_HAP);
+    EXPECT_EQ(GetPreVerifyRecordCount(), recordCount);
+
+    ASSERT_TRUE(CopyHap(RESOURCE_ROOT_PATH + RIGHT_BUNDLE, PRE_VERIFY_HAP));
+    EXPECT_EQ(BundleVerifyMgr::PreVerify(PRE_VERIFY_HAP), ERR_OK);
+    BundleVerifyMgr::ClearPreVerifyResult(PRE_VERIFY_HAP);
+    EXPECT_EQ(GetPreVerifyRecordCount(), recordCount);
+    remove(PRE_VERIFY_HAP.c_str());
+}
 } // OHOS
@@ -13,18 +13,26 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
 
+#define private public
+#include "bundle_data_mgr.h"
+#undef private
 #include "ability_manager_client.h"
 #include "ability_info.h"
 #include "bundle_clone_mgr.h"
-#include "bundle_data_mgr.h"
 #include "bundle_info.h"
 #include "bundle_permission_mgr.h"
 #include "bundle_mgr_service.h"
 #include "bundle_mgr_host.h"
+#include "datetime_ex.h"
 #include "directory_ex.h"
 #include "install_param.h"
 #include "installd/installd_service.h"
@@ -181,6 +189,87 @@ const std::string URI_PATH_REGEX_001 = SCHEME_001 + SCHEME_SEPARATOR + HOST_001
     PORT_SEPARATOR + PORT_001 + PATH_SEPARATOR + PATH_REGEX_001;
 const int32_t DEFAULT_USERID = 100;
 const int32_t WAIT_TIME = 5; // init mocked bms
+const int32_t RESOURCE_LABEL_ID = 16777216;
+const int32_t RESOURCE_ICON_ID = 16777217;
+const std::string CACHED_LABEL = "cached label";
+const std::string STALE_LOCALE = "xx-XX";
+const int32_t WARM_UP_WAIT_COUNT = 500;
+const auto WARM_UP_WAIT_INTERVAL = std::chrono::milliseconds(10);
+const size_t MAX_PENDING_NOTIFICATIONS = 128;
+const int64_t OVERDUE_CALLBACK_MS = 5000;
+const int32_t DELIVERY_WAIT_COUNT = 100;
+const auto DELIVERY_WAIT_INTERVAL = std::chrono::milliseconds(10);
+// a callback blocked by a failed test is released after this, so the notify pool can stop
+const auto MAX_BLOCK_TIME = std::chrono::seconds(10);
+
+// records the notifications and blocks the delivery thread in the callback until it is released
+class BlockingBundleStatus : public IBundleStatusCallback {
+public:
+    void OnBundleStateChanged(const uint8_t installType, const int32_t resultCode, const std::string &resultMsg,
+        const std::string &bundleName) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        installTypes_.push_back(installType);
+        resultCodes_.push_back(resultCode);
+        condition_.notify_all();
+        condition_.wait_for(lock, MAX_BLOCK_TIME, [this] { return released_; });
+    }
+    void OnBundleAdded(const std::string &bundleName, const int userId) override {};
+    void OnBundleUpdated(const std::string &bundleName, const int userId) override {};
+    void OnBundleRemoved(const std::string &bundleName, const int userId) override {};
+    sptr<IRemoteObject> AsObject() override
+    {
+        return nullptr;
+    }
+
+    bool WaitForCalls(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return condition_.wait_for(lock, MAX_BLOCK_TIME, [this, count] { return resultCodes_.size() >= count; });
+    }
+
+    void Release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        condition_.notify_all();
+    }
+
+    std::vector<uint8_t> GetInstallTypes()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return installTypes_;
+    }
+
+    std::vector<int32_t> GetResultCodes()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return resultCodes_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool released_ = false;
+    std::vector<uint8_t> installTypes_;
+    std::vector<int32_t> resultCodes_;
+};
+
+// the statistics are updated after each callback returns
+bool WaitForDelivered(const BundleStatusNotifier &notifier, const sptr<IBundleStatusCallback> &callback,
+    uint64_t count, BundleStatusDeliveryStats &stats)
+{
+    for (int32_t i = 0; i < DELIVERY_WAIT_COUNT; i++) {
+        if (!notifier.GetDeliveryStats(callback, stats)) {
+            return false;
+        }
+        if (stats.deliveredCount >= count) {
+            return true;
+        }
+        std::this_thread::sleep_for(DELIVERY_WAIT_INTERVAL);
+    }
+    return false;
+}
 }  // namespace
 
 class BmsBundleKitServiceTest : public testing::Test {
@@ -246,6 +335,12 @@ public:
         const std::string &abilityName, InnerBundleInfo &innerBundleInfo) const;
     void SaveToDatabase(const std::string &bundleName, InnerBundleInfo &innerBundleInfo,
         bool userDataClearable, bool isSystemApp) const;
+#ifdef GLOBAL_RESMGR_ENABLE
+    void MockInstallBundleWithResourceId(
+        const std::string &bundleName, const std::string &moduleName, const std::string &abilityName) const;
+    bool WaitForResourceWarmUp() const;
+    std::shared_ptr<BundleDataMgr::BundleResourceCache> GetResourceCache(const std::string &bundleName) const;
+#endif
 
 public:
     std::shared_ptr<BundleMgrService> bundleMgrService_ = DelayedSingleton<BundleMgrService>::GetInstance();
@@ -365,6 +460,50 @@ void BmsBundleKitServiceTest::MockInstallBundle(
     SaveToDatabase(bundleName, innerBundleInfo, userDataClearable, isSystemApp);
 }
 
+#ifdef GLOBAL_RESMGR_ENABLE
+void BmsBundleKitServiceTest::MockInstallBundleWithResourceId(
+    const std::string &bundleName, const std::string &moduleName, const std::string &abilityName) const
+{
+    InnerModuleInfo moduleInfo = MockModuleInfo(moduleName);
+    std::string keyName = bundleName + "." + moduleName + "." + abilityName;
+    moduleInfo.entryAbilityKey = keyName;
+    AbilityInfo abilityInfo = MockAbilityInfo(bundleName, moduleName, abilityName);
+    abilityInfo.labelId = RESOURCE_LABEL_ID;
+    abilityInfo.iconId = RESOURCE_ICON_ID;
+    InnerBundleInfo innerBundleInfo;
+    innerBundleInfo.InsertAbilitiesInfo(keyName, abilityInfo);
+    innerBundleInfo.InsertInnerModuleInfo(moduleName, moduleInfo);
+    SaveToDatabase(bundleName, innerBundleInfo, false, false);
+}
+
+bool BmsBundleKitServiceTest::WaitForResourceWarmUp() const
+{
+    auto dataMgr = GetBundleDataMgr();
+    for (int32_t i = 0; i < WARM_UP_WAIT_COUNT; i++) {
+        {
+            std::lock_guard<std::mutex> lock(dataMgr->resourceCacheMutex_);
+            if (!dataMgr->warmUpRunning_ && dataMgr->warmUpBundleNames_.empty()) {
+                return true;
+            }
+        }
+        std::this_thread::sleep_for(WARM_UP_WAIT_INTERVAL);
+    }
+    return false;
+}
+
+std::shared_ptr<BundleDataMgr::BundleResourceCache> BmsBundleKitServiceTest::GetResourceCache(
+    const std::string &bundleName) const
+{
+    auto dataMgr = GetBundleDataMgr();
+    std::lock_guard<std::mutex> lock(dataMgr->resourceCacheMutex_);
+    auto item = dataMgr->resourceCaches_.find(bundleName);
+    if (item == dataMgr->resourceCaches_.end()) {
+        return nullptr;
+    }
+    return item->second;
+}
+#endif
+
 InnerModuleInfo BmsBundleKitServiceTest::MockModuleInfo(const std::string &moduleName) const
 {
     InnerModuleInfo moduleInfo;
@@ -1447,6 +1586,129 @@ HWTEST_F(BmsBundleKitServiceTest, GetAbilityLabel_0500, Function | SmallTest | L
     MockUninstallBundle(BUNDLE_NAME_TEST);
 }
 
+/**
+ * @tc.number: GetModuleResPaths_0100
+ * @tc.name: test can get the resource paths of all the modules, which are used to resolve the label and icon
+ * @tc.desc: 1.system run normally
+ *           2.get the resource path of each module
+ */
+HWTEST_F(BmsBundleKitServiceTest, GetModuleResPaths_0100, Function | SmallTest | Level1)
+{
+    InnerModuleInfo moduleInfo = MockModuleInfo(MODULE_NAME_TEST);
+    moduleInfo.moduleResPath = "/data/app/el1/bundle/public/test/entry/resources.index";
+    InnerModuleInfo moduleInfo1 = MockModuleInfo(MODULE_NAME_TEST_1);
+    InnerBundleInfo innerBundleInfo;
+    innerBundleInfo.InsertInnerModuleInfo(MODULE_NAME_TEST, moduleInfo);
+    innerBundleInfo.InsertInnerModuleInfo(MODULE_NAME_TEST_1, moduleInfo1);
+
+    std::vector<std::string> moduleResPaths;
+    innerBundleInfo.GetModuleResPaths(moduleResPaths);
+    EXPECT_EQ(moduleResPaths.size(), 2);
+    EXPECT_NE(std::find(moduleResPaths.begin(), moduleResPaths.end(), moduleInfo.moduleResPath),
+        moduleResPaths.end());
+}
+
+#ifdef GLOBAL_RESMGR_ENABLE
+/**
+ * @tc.number: ResourceCache_0100
+ * @tc.name: test the ability label is served from the resource cache until the bundle changes
+ * @tc.desc: 1.the cache of a newly installed bundle is created in background
+ *           2.a label in the cache is returned without resolving the resource
+ *           3.the cache is dropped when the bundle starts updating
+ */
+HWTEST_F(BmsBundleKitServiceTest, ResourceCache_0100, Function | SmallTest | Level1)
+{
+    auto dataMgr = GetBundleDataMgr();
+    MockInstallBundleWithResourceId(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    EXPECT_TRUE(WaitForResourceWarmUp());
+    auto resourceCache = GetResourceCache(BUNDLE_NAME_TEST);
+    ASSERT_NE(resourceCache, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(resourceCache->mutex);
+        resourceCache->labels[RESOURCE_LABEL_ID] = CACHED_LABEL;
+    }
+    std::string label = dataMgr->GetAbilityLabel(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    EXPECT_EQ(label, CACHED_LABEL);
+
+    EXPECT_TRUE(dataMgr->UpdateBundleInstallState(BUNDLE_NAME_TEST, InstallState::UPDATING_START));
+    EXPECT_EQ(GetResourceCache(BUNDLE_NAME_TEST), nullptr);
+    label = dataMgr->GetAbilityLabel(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    EXPECT_NE(label, CACHED_LABEL);
+    EXPECT_TRUE(dataMgr->UpdateBundleInstallState(BUNDLE_NAME_TEST, InstallState::UPDATING_SUCCESS));
+    EXPECT_TRUE(dataMgr->UpdateBundleInstallState(BUNDLE_NAME_TEST, InstallState::INSTALL_SUCCESS));
+    EXPECT_TRUE(WaitForResourceWarmUp());
+
+    MockUninstallBundle(BUNDLE_NAME_TEST);
+    EXPECT_EQ(GetResourceCache(BUNDLE_NAME_TEST), nullptr);
+}
+
+#ifdef BUNDLE_FRAMEWORK_GRAPHICS
+/**
+ * @tc.number: ResourceCache_0200
+ * @tc.name: test the ability icon is served from the resource cache until the bundle changes
+ * @tc.desc: 1.an icon in the cache is returned without decoding the resource
+ *           2.the cache is dropped when the bundle starts uninstalling
+ */
+HWTEST_F(BmsBundleKitServiceTest, ResourceCache_0200, Function | SmallTest | Level1)
+{
+    auto dataMgr = GetBundleDataMgr();
+    MockInstallBundleWithResourceId(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    EXPECT_TRUE(WaitForResourceWarmUp());
+    auto resourceCache = GetResourceCache(BUNDLE_NAME_TEST);
+    ASSERT_NE(resourceCache, nullptr);
+    auto cachedIcon = std::make_shared<Media::PixelMap>();
+    {
+        std::lock_guard<std::mutex> lock(resourceCache->mutex);
+        resourceCache->icons[RESOURCE_ICON_ID] = cachedIcon;
+    }
+    auto icon = dataMgr->GetAbilityPixelMapIcon(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    EXPECT_EQ(icon, cachedIcon);
+
+    EXPECT_TRUE(dataMgr->UpdateBundleInstallState(BUNDLE_NAME_TEST, InstallState::UNINSTALL_START));
+    EXPECT_EQ(GetResourceCache(BUNDLE_NAME_TEST), nullptr);
+    EXPECT_TRUE(dataMgr->UpdateBundleInstallState(BUNDLE_NAME_TEST, InstallState::UNINSTALL_SUCCESS));
+}
+#endif
+
+/**
+ * @tc.number: ResourceCache_0300
+ * @tc.name: test the resource caches are resolved again when the locale changes
+ * @tc.desc: 1.the cache of a newly installed bundle is created in background with its resource manager
+ *           2.a locale change replaces the cache with one resolved in background for the new locale
+ *           3.the same locale again keeps the cache
+ */
+HWTEST_F(BmsBundleKitServiceTest, ResourceCache_0300, Function | SmallTest | Level1)
+{
+    auto dataMgr = GetBundleDataMgr();
+    MockInstallBundleWithResourceId(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    EXPECT_TRUE(WaitForResourceWarmUp());
+    auto resourceCache = GetResourceCache(BUNDLE_NAME_TEST);
+    ASSERT_NE(resourceCache, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(resourceCache->mutex);
+        EXPECT_NE(resourceCache->resourceManager, nullptr);
+        resourceCache->labels[RESOURCE_LABEL_ID] = CACHED_LABEL;
+    }
+    {
+        std::lock_guard<std::mutex> lock(dataMgr->resourceCacheMutex_);
+        dataMgr->resourceLocale_ = STALE_LOCALE;
+    }
+    dataMgr->OnLocaleChanged();
+    EXPECT_TRUE(WaitForResourceWarmUp());
+    auto reloadedCache = GetResourceCache(BUNDLE_NAME_TEST);
+    ASSERT_NE(reloadedCache, nullptr);
+    EXPECT_NE(reloadedCache, resourceCache);
+    EXPECT_NE(reloadedCache->locale, STALE_LOCALE);
+    std::string label = dataMgr->GetAbilityLabel(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    EXPECT_NE(label, CACHED_LABEL);
+
+    dataMgr->OnLocaleChanged();
+    EXPECT_EQ(GetResourceCache(BUNDLE_NAME_TEST), reloadedCache);
+
+    MockUninstallBundle(BUNDLE_NAME_TEST);
+}
+#endif
+
 /**
  * @tc.number: GetAbilityLabel_0600
  * @tc.name: test can not get the ability's label if module and ability exist
@@ -2331,6 +2593,30 @@ HWTEST_F(BmsBundleKitServiceTest, QueryAbilityInfoByUri_0500, Function | SmallTe
     MockUninstallBundle(BUNDLE_NAME_TEST);
 }
 
+/**
+ * @tc.number: QueryAbilityInfoByUri_0600
+ * @tc.name: test the ability of an uninstalled bundle is not got by uri
+ * @tc.desc: 1.system run normally
+ *           2.get the ability info of the bundle which is still installed
+ */
+HWTEST_F(BmsBundleKitServiceTest, QueryAbilityInfoByUri_0600, Function | SmallTest | Level1)
+{
+    MockInstallBundle(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    MockInstallBundle(BUNDLE_NAME_DEMO, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    MockUninstallBundle(BUNDLE_NAME_TEST);
+
+    AbilityInfo result;
+    bool testRet = GetBundleDataMgr()->QueryAbilityInfoByUri(
+        ABILITY_URI, DEFAULT_USERID, result);
+    EXPECT_EQ(true, testRet);
+    EXPECT_EQ(BUNDLE_NAME_DEMO, result.bundleName);
+
+    MockUninstallBundle(BUNDLE_NAME_DEMO);
+    testRet = GetBundleDataMgr()->QueryAbilityInfoByUri(
+        ABILITY_URI, DEFAULT_USERID, result);
+    EXPECT_EQ(false, testRet);
+}
+
 /**
  * @tc.number: QueryKeepAliveBundleInfos_0100
  * @tc.name: test can get the keep alive bundle infos
@@ -3067,6 +3353,185 @@ HWTEST_F(BmsBundleKitServiceTest, UnregisterBundleStatus_0100, Function | SmallT
     EXPECT_EQ(callbackResult1, ERR_TIMED_OUT);
 }
 
+/**
+ * @tc.number: NotifyBundleStatus_0100
+ * @tc.name: test the delivery of the bundle status is recorded
+ * @tc.desc: 1.system run normally
+ *           2.the bundle status is delivered once and its latency is recorded
+ */
+HWTEST_F(BmsBundleKitServiceTest, NotifyBundleStatus_0100, Function | SmallTest | Level1)
+{
+    GetBundleDataMgr()->UnregisterBundleStatusCallback();
+    sptr<MockBundleStatus> bundleStatusCallback = new (std::nothrow) MockBundleStatus();
+    bundleStatusCallback->SetBundleName(HAP_FILE_PATH);
+    bool result = GetBundleDataMgr()->RegisterBundleStatusCallback(bundleStatusCallback);
+    EXPECT_TRUE(result);
+
+    bool resultNotify = GetBundleDataMgr()->NotifyBundleStatus(
+        HAP_FILE_PATH, HAP_FILE_PATH, ABILITY_NAME_DEMO, ERR_OK, NotifyType::INSTALL, Constants::INVALID_UID);
+    EXPECT_TRUE(resultNotify);
+    int32_t callbackResult = bundleStatusCallback->GetResultCode();
+    EXPECT_EQ(callbackResult, ERR_OK);
+
+    // the statistics are updated after the callback returns
+    BundleStatusDeliveryStats stats;
+    for (int32_t i = 0; i < 100; i++) {
+        result = GetBundleDataMgr()->GetBundleStatusDeliveryStats(bundleStatusCallback, stats);
+        if (!result || stats.deliveredCount > 0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(result);
+    EXPECT_EQ(stats.deliveredCount, 1u);
+    EXPECT_EQ(stats.pendingCount, 0u);
+    EXPECT_GE(stats.maxLatencyMs, 0);
+    GetBundleDataMgr()->ClearBundleStatusCallback(bundleStatusCallback);
+}
+
+/**
+ * @tc.number: NotifyBundleStatus_0200
+ * @tc.name: test the notifications waiting for a subscriber are coalesced
+ * @tc.desc: 1.block the subscriber in its callback and notify the same change several times
+ *           2.the repeated change is delivered once, in order with the others
+ */
+HWTEST_F(BmsBundleKitServiceTest, NotifyBundleStatus_0200, Function | SmallTest | Level1)
+{
+    BundleStatusNotifier notifier;
+    sptr<BlockingBundleStatus> callback = new (std::nothrow) BlockingBundleStatus();
+    ASSERT_NE(callback, nullptr);
+    callback->SetBundleName(BUNDLE_NAME_TEST);
+    notifier.AddCallback(callback);
+    const uint8_t install = static_cast<uint8_t>(NotifyType::INSTALL);
+    const uint8_t update = static_cast<uint8_t>(NotifyType::UPDATE);
+    const uint8_t uninstall = static_cast<uint8_t>(NotifyType::UNINSTALL_BUNDLE);
+
+    notifier.Notify(install, ERR_OK, BUNDLE_NAME_TEST);
+    EXPECT_TRUE(callback->WaitForCalls(1));
+    for (int32_t i = 0; i < 3; i++) {
+        notifier.Notify(update, ERR_OK, BUNDLE_NAME_TEST);
+    }
+    notifier.Notify(uninstall, ERR_OK, BUNDLE_NAME_TEST);
+    notifier.Notify(uninstall, ERR_OK, BUNDLE_NAME_TEST);
+    // another result code is another change
+    notifier.Notify(uninstall, ERR_APPEXECFWK_UNINSTALL_MISSING_INSTALLED_BUNDLE, BUNDLE_NAME_TEST);
+    notifier.Notify(update, ERR_OK, BUNDLE_NAME_DEMO);
+
+    BundleStatusDeliveryStats stats;
+    EXPECT_TRUE(notifier.GetDeliveryStats(callback, stats));
+    EXPECT_EQ(stats.pendingCount, 3u);
+    EXPECT_EQ(stats.coalescedCount, 3u);
+    EXPECT_EQ(stats.droppedCount, 0u);
+
+    callback->Release();
+    EXPECT_TRUE(WaitForDelivered(notifier, callback, 4, stats));
+    EXPECT_EQ(stats.pendingCount, 0u);
+    EXPECT_EQ(callback->GetInstallTypes(), std::vector<uint8_t>({ install, update, uninstall, uninstall }));
+    EXPECT_EQ(callback->GetResultCodes(),
+        std::vector<int32_t>({ ERR_OK, ERR_OK, ERR_OK, ERR_APPEXECFWK_UNINSTALL_MISSING_INSTALLED_BUNDLE }));
+}
+
+/**
+ * @tc.number: NotifyBundleStatus_0300
+ * @tc.name: test the oldest notifications are dropped when a subscriber falls behind
+ * @tc.desc: 1.block the subscriber in its callback and notify more changes than its queue holds
+ *           2.the oldest waiting ones are dropped and the newest are delivered in order
+ */
+HWTEST_F(BmsBundleKitServiceTest, NotifyBundleStatus_0300, Function | SmallTest | Level1)
+{
+    BundleStatusNotifier notifier;
+    sptr<BlockingBundleStatus> callback = new (std::nothrow) BlockingBundleStatus();
+    ASSERT_NE(callback, nullptr);
+    callback->SetBundleName(BUNDLE_NAME_TEST);
+    notifier.AddCallback(callback);
+    const uint8_t install = static_cast<uint8_t>(NotifyType::INSTALL);
+
+    // the result codes differ, so none of them is coalesced
+    const int32_t notifyCount = static_cast<int32_t>(MAX_PENDING_NOTIFICATIONS) + 2;
+    notifier.Notify(install, 0, BUNDLE_NAME_TEST);
+    EXPECT_TRUE(callback->WaitForCalls(1));
+    for (int32_t i = 1; i <= notifyCount; i++) {
+        notifier.Notify(install, i, BUNDLE_NAME_TEST);
+    }
+
+    BundleStatusDeliveryStats stats;
+    EXPECT_TRUE(notifier.GetDeliveryStats(callback, stats));
+    EXPECT_EQ(stats.pendingCount, MAX_PENDING_NOTIFICATIONS);
+    EXPECT_EQ(stats.droppedCount, 2u);
+    EXPECT_EQ(stats.coalescedCount, 0u);
+
+    callback->Release();
+    EXPECT_TRUE(WaitForDelivered(notifier, callback, MAX_PENDING_NOTIFICATIONS + 1, stats));
+    std::vector<int32_t> expected = { 0 };
+    for (int32_t i = 3; i <= notifyCount; i++) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(callback->GetResultCodes(), expected);
+}
+
+/**
+ * @tc.number: NotifyBundleStatus_0400
+ * @tc.name: test the notifications of an overdue subscriber are dropped
+ * @tc.desc: 1.block the subscriber in its callback past the overdue time and notify a change
+ *           2.the change is dropped, and the subscriber gets the next one once its callback returns
+ */
+HWTEST_F(BmsBundleKitServiceTest, NotifyBundleStatus_0400, Function | SmallTest | Level1)
+{
+    BundleStatusNotifier notifier;
+    sptr<BlockingBundleStatus> callback = new (std::nothrow) BlockingBundleStatus();
+    ASSERT_NE(callback, nullptr);
+    callback->SetBundleName(BUNDLE_NAME_TEST);
+    notifier.AddCallback(callback);
+    const uint8_t install = static_cast<uint8_t>(NotifyType::INSTALL);
+    const uint8_t update = static_cast<uint8_t>(NotifyType::UPDATE);
+
+    notifier.Notify(install, ERR_OK, BUNDLE_NAME_TEST);
+    EXPECT_TRUE(callback->WaitForCalls(1));
+    {
+        // the callback in flight started longer ago than the overdue time
+        std::lock_guard<std::mutex> lock(notifier.mutex_);
+        ASSERT_EQ(notifier.subscribers_.size(), 1u);
+        notifier.subscribers_[0]->callbackStartTime = GetTickCount() - OVERDUE_CALLBACK_MS - 1;
+    }
+    notifier.Notify(update, ERR_OK, BUNDLE_NAME_TEST);
+
+    BundleStatusDeliveryStats stats;
+    EXPECT_TRUE(notifier.GetDeliveryStats(callback, stats));
+    EXPECT_EQ(stats.pendingCount, 0u);
+    EXPECT_EQ(stats.droppedCount, 1u);
+
+    callback->Release();
+    EXPECT_TRUE(WaitForDelivered(notifier, callback, 1, stats));
+    notifier.Notify(update, ERR_OK, BUNDLE_NAME_TEST);
+    EXPECT_TRUE(WaitForDelivered(notifier, callback, 2, stats));
+    EXPECT_EQ(stats.droppedCount, 1u);
+    EXPECT_EQ(callback->GetInstallTypes(), std::vector<uint8_t>({ install, update }));
+}
+
+/**
+ * @tc.number: GetBundleMutex_0100
+ * @tc.name: test the mutex of a bundle is shared while it is held
+ * @tc.desc: 1.system run normally
+ *           2.the same mutex is returned for the same bundle name, the unused ones are removed
+ */
+HWTEST_F(BmsBundleKitServiceTest, GetBundleMutex_0100, Function | SmallTest | Level1)
+{
+    auto mutex1 = GetBundleDataMgr()->GetBundleMutex(BUNDLE_NAME_TEST);
+    auto mutex2 = GetBundleDataMgr()->GetBundleMutex(BUNDLE_NAME_TEST);
+    auto mutex3 = GetBundleDataMgr()->GetBundleMutex(BUNDLE_NAME_DEMO);
+    EXPECT_EQ(mutex1, mutex2);
+    EXPECT_NE(mutex1, mutex3);
+
+    BundleMutexRegistry registry;
+    auto heldMutex = registry.GetMutex(BUNDLE_NAME_TEST);
+    for (size_t i = 0; i < BundleMutexRegistry::PRUNE_THRESHOLD * 2; i++) {
+        auto mtx = registry.GetMutex(BUNDLE_NAME_DEMO + std::to_string(i));
+        std::lock_guard lock {*mtx};
+    }
+    EXPECT_LE(registry.GetSize(), BundleMutexRegistry::PRUNE_THRESHOLD);
+    EXPECT_EQ(registry.GetMutex(BUNDLE_NAME_TEST), heldMutex);
+}
+
 /**
  * @tc.number: GetBundlesForUid_0100
  * @tc.name: test can get the bundle names with bundle installed
@@ -4415,4 +4880,41 @@ HWTEST_F(BmsBundleKitServiceTest, GetAlldependentModuleNames_004, Function | Sma
         EXPECT_EQ(dependentModuleName[MODULE_NAMES_SIZE_TWO], MODULE_NAME_TEST_3);
     }
 }
-}
\ No newline at end of file
+
+#ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
+/**
+ * @tc.number: GetBundleSpaceSize_0100
+ * @tc.name: test the space size of a bundle is kept until it is deleted
+ * @tc.desc: 1.system run normally
+ *           2.the measured size is returned after the data grows
+ *           3.the grown size is measured after the size is deleted
+ */
+HWTEST_F(BmsBundleKitServiceTest, GetBundleSpaceSize_0100, Function | SmallTest | Level1)
+{
+    CreateFileDir();
+    MockInstallBundle(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    GetBundleDataMgr()->DeleteBundleSpaceSize(BUNDLE_NAME_TEST);
+    std::string testFile = FILES_DIR + "/space_size_test";
+    const std::string content(4096, 'a');
+    std::remove(testFile.c_str());
+
+    int64_t spaceSize = GetBundleDataMgr()->GetBundleSpaceSize(BUNDLE_NAME_TEST);
+    EXPECT_GE(spaceSize, 0);
+    {
+        std::ofstream file(testFile, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+    // the files changed out of BMS are not seen until the size expires or is deleted
+    EXPECT_EQ(GetBundleDataMgr()->GetBundleSpaceSize(BUNDLE_NAME_TEST), spaceSize);
+    GetBundleDataMgr()->DeleteBundleSpaceSize(BUNDLE_NAME_TEST);
+    int64_t grownSize = GetBundleDataMgr()->GetBundleSpaceSize(BUNDLE_NAME_TEST);
+    EXPECT_EQ(grownSize, spaceSize + static_cast<int64_t>(content.size()));
+    EXPECT_EQ(GetBundleDataMgr()->GetBundleSpaceSize(BUNDLE_NAME_TEST), grownSize);
+    EXPECT_EQ(GetBundleDataMgr()->GetBundleSpaceSize(BUNDLE_NAME_DEMO), 0);
+
+    std::remove(testFile.c_str());
+    MockUninstallBundle(BUNDLE_NAME_TEST);
+    CleanFileDir();
+}
+#endif
+}
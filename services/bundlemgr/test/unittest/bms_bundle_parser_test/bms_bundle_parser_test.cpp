@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 #include <string>
 #include <gtest/gtest.h>
@@ -20,6 +22,7 @@
 #include "app_log_wrapper.h"
 #include "bundle_constants.h"
 #include "bundle_extractor.h"
+#include "bundle_parse_cache.h"
 #include "bundle_parser.h"
 #include "bundle_profile.h"
 #include "common_profile.h"
@@ -41,6 +44,9 @@ const std::string NOTHING_CONFIG = "nothing_config";
 const std::string FORMAT_ERROR_PROFILE = "format_error_profile";
 const std::string FORMAT_MISSING_PROFILE = "format_missing_profile";
 const std::string UNKOWN_PATH = "unknown_path";
+const std::string PARSE_CACHE_HAP_FILE = "/data/test/bundle_parse_cache_test.hap";
+const std::string PARSE_CACHE_FILE = "/data/test/bundle_parse_cache_test";
+const std::string PARSE_CACHE_BUNDLE_NAME = "com.example.parsecache";
 const size_t ONE = 1;
 const size_t TWO = 2;
 const nlohmann::json CONFIG_JSON = R"(
@@ -1200,4 +1206,73 @@ HWTEST_F(BmsBundleParserTest, TestDefaultPermissionProfile_0500, Function | Smal
     ErrCode result = CheckProfileDefaultPermission(errorProfileJson, defaultPermissions);
     EXPECT_EQ(result, ERR_APPEXECFWK_PARSE_PROFILE_MISSING_PROP);
 }
+
+/**
+ * @tc.number: TestBundleParseCache_0100
+ * @tc.name: test bundle parse cache
+ * @tc.desc: 1. the parse result is got after the cache is saved and loaded
+ *           2. the parse result is dropped after the hap file is changed
+ */
+HWTEST_F(BmsBundleParserTest, TestBundleParseCache_0100, Function | SmallTest | Level1)
+{
+    std::ofstream hapFile(PARSE_CACHE_HAP_FILE, std::ios::out | std::ios::trunc);
+    hapFile << "hap";
+    hapFile.close();
+    InnerBundleInfo innerBundleInfo;
+    ApplicationInfo applicationInfo;
+    applicationInfo.bundleName = PARSE_CACHE_BUNDLE_NAME;
+    innerBundleInfo.SetBaseApplicationInfo(applicationInfo);
+    BundleParseCache cache(PARSE_CACHE_FILE);
+    cache.SetInnerBundleInfo(PARSE_CACHE_HAP_FILE, innerBundleInfo);
+    EXPECT_TRUE(cache.Save());
+
+    BundleParseCache loadedCache(PARSE_CACHE_FILE);
+    EXPECT_TRUE(loadedCache.Load());
+    InnerBundleInfo cachedInfo;
+    EXPECT_TRUE(loadedCache.GetInnerBundleInfo(PARSE_CACHE_HAP_FILE, cachedInfo));
+    EXPECT_EQ(cachedInfo.GetBundleName(), PARSE_CACHE_BUNDLE_NAME);
+
+    hapFile.open(PARSE_CACHE_HAP_FILE, std::ios::out | std::ios::app);
+    hapFile << "changed";
+    hapFile.close();
+    EXPECT_FALSE(loadedCache.GetInnerBundleInfo(PARSE_CACHE_HAP_FILE, cachedInfo));
+    remove(PARSE_CACHE_HAP_FILE.c_str());
+    remove(PARSE_CACHE_FILE.c_str());
+}
+
+/**
+ * @tc.number: TestBundleParseCache_0200
+ * @tc.name: test bundle parse cache
+ * @tc.desc: 1. a hap is processed by the next scan only after it is marked processed
+ *           2. a changed hap is not processed any more
+ */
+HWTEST_F(BmsBundleParserTest, TestBundleParseCache_0200, Function | SmallTest | Level1)
+{
+    std::ofstream hapFile(PARSE_CACHE_HAP_FILE, std::ios::out | std::ios::trunc);
+    hapFile << "hap";
+    hapFile.close();
+    InnerBundleInfo innerBundleInfo;
+    BundleParseCache cache(PARSE_CACHE_FILE);
+    cache.SetInnerBundleInfo(PARSE_CACHE_HAP_FILE, innerBundleInfo);
+    EXPECT_FALSE(cache.IsProcessed(PARSE_CACHE_HAP_FILE));
+    cache.SetProcessed(PARSE_CACHE_HAP_FILE);
+    EXPECT_TRUE(cache.Save());
+
+    BundleParseCache loadedCache(PARSE_CACHE_FILE);
+    EXPECT_TRUE(loadedCache.Load());
+    EXPECT_FALSE(loadedCache.IsProcessed(PARSE_CACHE_HAP_FILE));
+    InnerBundleInfo cachedInfo;
+    EXPECT_TRUE(loadedCache.GetInnerBundleInfo(PARSE_CACHE_HAP_FILE, cachedInfo));
+    EXPECT_TRUE(loadedCache.IsProcessed(PARSE_CACHE_HAP_FILE));
+
+    hapFile.open(PARSE_CACHE_HAP_FILE, std::ios::out | std::ios::app);
+    hapFile << "changed";
+    hapFile.close();
+    BundleParseCache changedCache(PARSE_CACHE_FILE);
+    EXPECT_TRUE(changedCache.Load());
+    EXPECT_FALSE(changedCache.GetInnerBundleInfo(PARSE_CACHE_HAP_FILE, cachedInfo));
+    EXPECT_FALSE(changedCache.IsProcessed(PARSE_CACHE_HAP_FILE));
+    remove(PARSE_CACHE_HAP_FILE.c_str());
+    remove(PARSE_CACHE_FILE.c_str());
+}
 } // OHOS
\ No newline at end of file
@@ -987,4 +987,112 @@ HWTEST_F(BmsDataMgrTest, GetApplicationInfo_0200, Function | SmallTest | Level0)
     EXPECT_NE(appInfo.name, appInfo3.name);
     EXPECT_NE(appInfo.bundleName, appInfo3.bundleName);
     EXPECT_NE(appInfo.deviceId, appInfo3.deviceId);
-}
\ No newline at end of file
+}
+/**
+ * @tc.number: GetBundleChanges_0100
+ * @tc.name: GetBundleChanges
+ * @tc.desc: 1. record bundle changes
+ *           2. query the changes since a known generation then verify
+ */
+HWTEST_F(BmsDataMgrTest, GetBundleChanges_0100, Function | SmallTest | Level0)
+{
+    auto dataMgr = GetDataMgr();
+    EXPECT_NE(dataMgr, nullptr);
+    std::vector<BundleChangeRecord> changeRecords;
+    int64_t generation = 0;
+    bool needFullSync = true;
+    dataMgr->GetBundleChanges(0, USERID, changeRecords, generation, needFullSync);
+    EXPECT_TRUE(needFullSync);
+
+    dataMgr->RecordBundleChange(BUNDLE_NAME, PACKAGE_NAME, ABILITY_NAME, NotifyType::INSTALL, USERID);
+    dataMgr->RecordBundleChange(BUNDLE_NAME, PACKAGE_NAME, ABILITY_NAME, NotifyType::UPDATE, USERID + 1);
+    dataMgr->RecordBundleChange(BUNDLE_NAME, PACKAGE_NAME, ABILITY_NAME, NotifyType::UNINSTALL_BUNDLE, USERID);
+
+    int64_t currentGeneration = 0;
+    dataMgr->GetBundleChanges(generation, USERID, changeRecords, currentGeneration, needFullSync);
+    EXPECT_FALSE(needFullSync);
+    EXPECT_EQ(currentGeneration, generation + 3);
+    ASSERT_EQ(changeRecords.size(), 2);
+    EXPECT_EQ(changeRecords[0].changeType, BundleChangeType::ADD);
+    EXPECT_EQ(changeRecords[0].bundleName, BUNDLE_NAME);
+    EXPECT_EQ(changeRecords[1].changeType, BundleChangeType::REMOVE);
+    EXPECT_EQ(changeRecords[1].generation, currentGeneration);
+
+    changeRecords.clear();
+    dataMgr->GetBundleChanges(currentGeneration, USERID, changeRecords, currentGeneration, needFullSync);
+    EXPECT_FALSE(needFullSync);
+    EXPECT_TRUE(changeRecords.empty());
+}
+
+/**
+ * @tc.number: GetBundleChanges_0200
+ * @tc.name: GetBundleChanges
+ * @tc.desc: 1. record more bundle changes than the ring keeps
+ *           2. verify the outdated generation requires a full sync
+ */
+HWTEST_F(BmsDataMgrTest, GetBundleChanges_0200, Function | SmallTest | Level0)
+{
+    auto dataMgr = GetDataMgr();
+    EXPECT_NE(dataMgr, nullptr);
+    std::vector<BundleChangeRecord> changeRecords;
+    int64_t generation = 0;
+    bool needFullSync = false;
+    dataMgr->GetBundleChanges(0, USERID, changeRecords, generation, needFullSync);
+
+    const int32_t changeCount = 1024;
+    for (int32_t i = 0; i < changeCount; i++) {
+        dataMgr->RecordBundleChange(BUNDLE_NAME, PACKAGE_NAME, ABILITY_NAME, NotifyType::UPDATE, USERID);
+    }
+    int64_t currentGeneration = 0;
+    dataMgr->GetBundleChanges(generation, USERID, changeRecords, currentGeneration, needFullSync);
+    EXPECT_TRUE(needFullSync);
+    EXPECT_TRUE(changeRecords.empty());
+    EXPECT_EQ(currentGeneration, generation + changeCount);
+
+    dataMgr->GetBundleChanges(currentGeneration + 1, USERID, changeRecords, currentGeneration, needFullSync);
+    EXPECT_TRUE(needFullSync);
+}
+
+/**
+ * @tc.number: AddInnerBundleUserInfos_0100
+ * @tc.name: AddInnerBundleUserInfos
+ * @tc.desc: 1. add user infos of several bundles in one batch
+ *           2. verify an unknown bundle fails the batch result
+ */
+HWTEST_F(BmsDataMgrTest, AddInnerBundleUserInfos_0100, Function | SmallTest | Level0)
+{
+    InnerBundleInfo info;
+    BundleInfo bundleInfo;
+    bundleInfo.name = BUNDLE_NAME;
+    bundleInfo.applicationInfo.name = APP_NAME;
+    ApplicationInfo applicationInfo;
+    applicationInfo.name = BUNDLE_NAME;
+    applicationInfo.deviceId = DEVICE_ID;
+    applicationInfo.bundleName = BUNDLE_NAME;
+    info.SetBaseBundleInfo(bundleInfo);
+    info.SetBaseApplicationInfo(applicationInfo);
+    auto dataMgr = GetDataMgr();
+    EXPECT_NE(dataMgr, nullptr);
+    dataMgr->UpdateBundleInstallState(BUNDLE_NAME, InstallState::INSTALL_START);
+    dataMgr->AddInnerBundleInfo(BUNDLE_NAME, info);
+
+    InnerBundleUserInfo innerBundleUserInfo;
+    innerBundleUserInfo.bundleName = BUNDLE_NAME;
+    innerBundleUserInfo.bundleUserInfo.userId = USERID;
+    std::map<std::string, InnerBundleUserInfo> newUserInfos;
+    newUserInfos.emplace(BUNDLE_NAME, innerBundleUserInfo);
+    std::vector<std::string> failedBundleNames;
+    EXPECT_TRUE(dataMgr->AddInnerBundleUserInfos(newUserInfos, failedBundleNames));
+    EXPECT_TRUE(failedBundleNames.empty());
+    InnerBundleInfo result;
+    EXPECT_TRUE(dataMgr->GetInnerBundleInfo(BUNDLE_NAME, result));
+    EXPECT_TRUE(result.HasInnerBundleUserInfo(USERID));
+
+    newUserInfos.emplace("not.exist.bundle", innerBundleUserInfo);
+    EXPECT_FALSE(dataMgr->AddInnerBundleUserInfos(newUserInfos, failedBundleNames));
+    EXPECT_EQ(failedBundleNames, std::vector<std::string> {"not.exist.bundle"});
+    EXPECT_TRUE(dataMgr->GetInnerBundleInfo(BUNDLE_NAME, result));
+    EXPECT_TRUE(result.HasInnerBundleUserInfo(USERID));
+
+    dataMgr->UpdateBundleInstallState(BUNDLE_NAME, InstallState::UNINSTALL_START);
+}
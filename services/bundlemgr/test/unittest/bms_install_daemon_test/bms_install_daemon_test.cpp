@@ -14,12 +14,17 @@
  */
 
 #include <cstdio>
+#include <dirent.h>
 #include <gtest/gtest.h>
 #include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
 
 #include "directory_ex.h"
 #include "installd/installd_service.h"
+#define private public
+#include "installd/installd_trash_mgr.h"
+#undef private
 #include "installd_client.h"
 
 using namespace testing::ext;
@@ -47,6 +52,26 @@ const int32_t UID = 1000;
 const int32_t GID = 1000;
 const std::string APL = "normal";
 const int32_t USERID_2 = 101;
+const std::string BUNDLE_EL2_TRASH_DIR = "/data/app/el2/100/.trash";
+const int32_t TRASH_WAIT_TIMES = 50;
+// deeper than the dirs the trash worker keeps open at once
+const int32_t TRASH_TREE_DEPTH = 100;
+
+// Returns false if the dir does not exist, the trash dir is kept once it is created.
+bool IsDirEmpty(const std::string &path)
+{
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return false;
+    }
+    int32_t count = 0;
+    while (readdir(dir) != nullptr) {
+        ++count;
+    }
+    closedir(dir);
+    // only . and ..
+    return count <= 2;
+}
 }  // namespace
 
 class BmsInstallDaemonTest : public testing::Test {
@@ -70,6 +95,8 @@ public:
     bool CheckBundleDirExist() const;
     bool CheckBundleDataDirExist() const;
     bool GetBundleStats(const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats) const;
+    bool BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+        std::vector<int64_t> &bundleStats) const;
 
 private:
     std::shared_ptr<InstalldService> service_ = std::make_shared<InstalldService>();
@@ -201,6 +228,15 @@ bool BmsInstallDaemonTest::GetBundleStats(const std::string &bundleName, const i
     return false;
 }
 
+bool BmsInstallDaemonTest::BatchGetBundleStats(const std::vector<std::string> &bundleNames, const int32_t userId,
+    std::vector<int64_t> &bundleStats) const
+{
+    if (!service_->IsServiceReady()) {
+        service_->Start();
+    }
+    return InstalldClient::GetInstance()->BatchGetBundleStats(bundleNames, userId, bundleStats) == ERR_OK;
+}
+
 /**
  * @tc.number: Startup_0100
  * @tc.name: test the start function of the installd service when service is not ready
@@ -488,6 +524,91 @@ HWTEST_F(BmsInstallDaemonTest, BundleDataDir_0600, Function | SmallTest | Level0
     EXPECT_FALSE(dirExist);
 }
 
+/**
+ * @tc.number: BundleDataDirs_0100
+ * @tc.name: test the CreateBundleDataDirs function of installd service
+ * @tc.desc: 1. the service is already initialized, one of the two params is illegal
+ *           2. the data dir of the legal param is created and each param gets its own result
+ */
+HWTEST_F(BmsInstallDaemonTest, BundleDataDirs_0100, Function | SmallTest | Level0)
+{
+    CreateBundleDir(BUNDLE_CODE_DIR);
+    CreateDirParam createDirParam;
+    createDirParam.bundleName = BUNDLE_NAME13;
+    createDirParam.userId = USERID;
+    createDirParam.uid = UID;
+    createDirParam.gid = GID;
+    createDirParam.apl = APL;
+    CreateDirParam invalidParam = createDirParam;
+    invalidParam.bundleName = "";
+    std::vector<ErrCode> results;
+    int result = InstalldClient::GetInstance()->CreateBundleDataDirs({ createDirParam, invalidParam }, results);
+    EXPECT_EQ(result, 0);
+    ASSERT_EQ(results.size(), 2U);
+    EXPECT_EQ(results[0], 0);
+    EXPECT_EQ(results[1], ERR_APPEXECFWK_INSTALLD_PARAM_ERROR);
+    bool dirExist = CheckBundleDataDirExist();
+    EXPECT_TRUE(dirExist);
+    int result1 = RemoveBundleDataDir(BUNDLE_DATA_DIR);
+    EXPECT_EQ(result1, 0);
+    RemoveBundleDir(BUNDLE_CODE_DIR);
+}
+
+/**
+ * @tc.number: TrashDir_0100
+ * @tc.name: test the RemoveDir function of installd trash mgr
+ * @tc.desc: 1. the data dir is renamed into the trash of its user and el
+ *           2. the trash is emptied in background
+ *           3. the data dir is gone once RemoveDir returns
+ */
+HWTEST_F(BmsInstallDaemonTest, TrashDir_0100, Function | SmallTest | Level0)
+{
+    auto trashMgr = InstalldTrashMgr::GetInstance();
+    EXPECT_EQ(trashMgr->GetTrashDir(BUNDLE_DATA_DIR), BUNDLE_EL2_TRASH_DIR);
+    OHOS::ForceCreateDirectory(BUNDLE_DATA_DIR + "/files/temp");
+    // RemoveDir deletes the dir in place if it can not be moved, so the move is checked by itself
+    EXPECT_TRUE(trashMgr->MoveToTrash(BUNDLE_DATA_DIR));
+    EXPECT_FALSE(CheckBundleDataDirExist());
+    bool isTrashEmpty = false;
+    for (int32_t i = 0; i < TRASH_WAIT_TIMES && !isTrashEmpty; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        isTrashEmpty = IsDirEmpty(BUNDLE_EL2_TRASH_DIR);
+    }
+    EXPECT_TRUE(isTrashEmpty);
+
+    OHOS::ForceCreateDirectory(BUNDLE_DATA_DIR + "/files/temp");
+    EXPECT_TRUE(trashMgr->RemoveDir(BUNDLE_DATA_DIR));
+    EXPECT_FALSE(CheckBundleDataDirExist());
+}
+
+/**
+ * @tc.number: TrashDir_0200
+ * @tc.name: test the trash worker deletes a tree deeper than the dirs it keeps open
+ * @tc.desc: 1. a data dir with a deep tree is moved into the trash
+ *           2. the whole tree is deleted in background
+ */
+HWTEST_F(BmsInstallDaemonTest, TrashDir_0200, Function | SmallTest | Level0)
+{
+    std::string path = BUNDLE_DATA_DIR;
+    for (int32_t i = 0; i < TRASH_TREE_DEPTH; ++i) {
+        path += "/d";
+    }
+    EXPECT_TRUE(OHOS::ForceCreateDirectory(path));
+    FILE *file = fopen((path + "/file").c_str(), "w");
+    EXPECT_NE(file, nullptr);
+    if (file != nullptr) {
+        fclose(file);
+    }
+    EXPECT_TRUE(InstalldTrashMgr::GetInstance()->MoveToTrash(BUNDLE_DATA_DIR));
+    EXPECT_FALSE(CheckBundleDataDirExist());
+    bool isTrashEmpty = false;
+    for (int32_t i = 0; i < TRASH_WAIT_TIMES && !isTrashEmpty; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        isTrashEmpty = IsDirEmpty(BUNDLE_EL2_TRASH_DIR);
+    }
+    EXPECT_TRUE(isTrashEmpty);
+}
+
 /**
  * @tc.number: ExtractBundleFile_0100
  * @tc.name: test the ExtractBundleFile function of installd service with flag system bundle
@@ -615,7 +736,8 @@ HWTEST_F(BmsInstallDaemonTest, GetBundleStats_0200, Function | SmallTest | Level
 */
 HWTEST_F(BmsInstallDaemonTest, GetBundleStats_0300, Function | SmallTest | Level0)
 {
-    OHOS::ForceCreateDirectory(BUNDLE_APP_DIR);
+    // installd drops the cached stats of a bundle whose dirs it changes
+    CreateBundleDir(BUNDLE_APP_DIR);
     std::vector<int64_t> stats;
     bool result = GetBundleStats(BUNDLE_NAME, USERID_2, stats);
     EXPECT_EQ(result, true);
@@ -631,12 +753,13 @@ HWTEST_F(BmsInstallDaemonTest, GetBundleStats_0300, Function | SmallTest | Level
 */
 HWTEST_F(BmsInstallDaemonTest, GetBundleStats_0400, Function | SmallTest | Level0)
 {
-    OHOS::ForceCreateDirectory(BUNDLE_APP_DIR);
     OHOS::ForceCreateDirectory(BUNDLE_EL1_BASE_DIR);
     OHOS::ForceCreateDirectory(BUNDLE_EL1_DATABASE_DIR);
     OHOS::ForceCreateDirectory(BUNDLE_EL2_BASE_DIR);
     OHOS::ForceCreateDirectory(BUNDLE_EL3_BASE_DIR);
     OHOS::ForceCreateDirectory(BUNDLE_EL4_BASE_DIR);
+    // the data dirs are created without installd, creating the code dir drops the cached stats
+    CreateBundleDir(BUNDLE_APP_DIR);
     std::vector<int64_t> stats;
     bool result = GetBundleStats(BUNDLE_NAME, USERID_2, stats);
     EXPECT_EQ(result, true);
@@ -652,4 +775,84 @@ HWTEST_F(BmsInstallDaemonTest, GetBundleStats_0400, Function | SmallTest | Level
     OHOS::ForceRemoveDirectory(BUNDLE_EL3_BASE_DIR);
     OHOS::ForceRemoveDirectory(BUNDLE_EL4_BASE_DIR);
 }
+
+/**
+ * @tc.number: GetBundleStats_0500
+ * @tc.name: test the GetBundleStats function of installd service
+ * @tc.desc: 1. the stats are cached while the app changes its data without installd
+ *           2. the stats are walked again once installd changes the dirs of the bundle
+ */
+HWTEST_F(BmsInstallDaemonTest, GetBundleStats_0500, Function | SmallTest | Level0)
+{
+    CreateBundleDir(BUNDLE_APP_DIR);
+    std::vector<int64_t> stats;
+    EXPECT_TRUE(GetBundleStats(BUNDLE_NAME, USERID_2, stats));
+    OHOS::ForceCreateDirectory(BUNDLE_EL1_BASE_DIR);
+    std::vector<int64_t> cachedStats;
+    EXPECT_TRUE(GetBundleStats(BUNDLE_NAME, USERID_2, cachedStats));
+    EXPECT_EQ(cachedStats, stats);
+
+    CreateBundleDir(BUNDLE_APP_DIR);
+    std::vector<int64_t> newStats;
+    EXPECT_TRUE(GetBundleStats(BUNDLE_NAME, USERID_2, newStats));
+    ASSERT_EQ(newStats.size(), stats.size());
+    EXPECT_GT(newStats[1], stats[1]);
+    OHOS::ForceRemoveDirectory(BUNDLE_APP_DIR);
+    OHOS::ForceRemoveDirectory(BUNDLE_EL1_BASE_DIR);
+}
+
+/**
+ * @tc.number: BatchGetBundleStats_0100
+ * @tc.name: test the BatchGetBundleStats function of installd service
+ * @tc.desc: 1. the stats of a bundle with data, a bundle without data and the same bundle again are got at once
+ *           2. each bundle takes the same items as GetBundleStats walking it by itself
+ */
+HWTEST_F(BmsInstallDaemonTest, BatchGetBundleStats_0100, Function | SmallTest | Level0)
+{
+    OHOS::ForceCreateDirectory(BUNDLE_EL2_BASE_DIR);
+    FILE *file = fopen((BUNDLE_EL2_BASE_DIR + "/file").c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fputs("batch stats", file);
+    fclose(file);
+    // creating the code dir through installd drops the cached stats, so both queries walk the dirs
+    CreateBundleDir(BUNDLE_APP_DIR);
+    const std::vector<std::string> bundleNames { BUNDLE_NAME, BUNDLE_NAME13, BUNDLE_NAME };
+    std::vector<int64_t> batchStats;
+    EXPECT_TRUE(BatchGetBundleStats(bundleNames, USERID_2, batchStats));
+
+    CreateBundleDir(BUNDLE_APP_DIR);
+    std::vector<int64_t> expectedStats;
+    for (const auto &bundleName : bundleNames) {
+        std::vector<int64_t> stats;
+        EXPECT_TRUE(GetBundleStats(bundleName, USERID_2, stats));
+        expectedStats.insert(expectedStats.end(), stats.begin(), stats.end());
+    }
+    EXPECT_EQ(batchStats, expectedStats);
+    ASSERT_EQ(batchStats.size() % bundleNames.size(), 0u);
+    size_t statsSize = batchStats.size() / bundleNames.size();
+    ASSERT_GT(statsSize, 4u);
+    // index 4 is the cache size, the file is in the cache dir of the base dir
+    EXPECT_GT(batchStats[4], 0);
+    EXPECT_EQ(batchStats[statsSize + 4], 0);
+    OHOS::ForceRemoveDirectory(BUNDLE_APP_DIR);
+    OHOS::ForceRemoveDirectory(BUNDLE_EL2_BASE_DIR);
+}
+
+/**
+ * @tc.number: BatchGetBundleStats_0200
+ * @tc.name: test the BatchGetBundleStats function of installd service
+ * @tc.desc: 1. more bundles than one request takes are split into several requests
+ *           2. an empty bundle name fails the request
+ */
+HWTEST_F(BmsInstallDaemonTest, BatchGetBundleStats_0200, Function | SmallTest | Level0)
+{
+    std::vector<int64_t> stats;
+    EXPECT_TRUE(GetBundleStats(BUNDLE_NAME13, USERID_2, stats));
+    std::vector<std::string> bundleNames(MAX_BATCH_BUNDLE_STATS_SIZE + 1, BUNDLE_NAME13);
+    std::vector<int64_t> batchStats;
+    EXPECT_TRUE(BatchGetBundleStats(bundleNames, USERID_2, batchStats));
+    EXPECT_EQ(batchStats.size(), stats.size() * bundleNames.size());
+
+    EXPECT_FALSE(BatchGetBundleStats({ BUNDLE_NAME13, "" }, USERID_2, batchStats));
+}
 } // OHOS
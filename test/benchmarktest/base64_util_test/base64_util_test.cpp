@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "base64_util.h"
+
+using namespace std;
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+    // about the size of an icon sent by DBMS, the size is not a multiple of 3
+    constexpr int32_t ICON_SIZE = 12289;
+    const std::string ICON_TYPE = "png";
+    const std::vector<char> ENCODE_TABLE = {
+        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+        'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+        'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+    };
+
+    std::unique_ptr<unsigned char[]> GetIconData()
+    {
+        std::unique_ptr<unsigned char[]> data = std::make_unique<unsigned char[]>(ICON_SIZE);
+        for (int32_t i = 0; i < ICON_SIZE; i++) {
+            data[i] = static_cast<unsigned char>(i * 151);
+        }
+        return data;
+    }
+
+    // the encoder used by DBMS before, which is only correct when srcLen % 3 != 0
+    std::unique_ptr<char[]> EncodeBase64ByTriplet(std::unique_ptr<unsigned char[]> &data, int srcLen)
+    {
+        int len = (srcLen / 3) * 4;
+        int outLen = ((srcLen % 3) != 0) ? (len + 4) : len;
+        const unsigned char *srcData = data.get();
+        std::unique_ptr<char[]> result = std::make_unique<char[]>(outLen + 1);
+        char *dstData = result.get();
+        int j = 0;
+        int i = 0;
+        for (; i < srcLen - 3; i += 3) {
+            dstData[j++] = ENCODE_TABLE[srcData[i] >> 2];
+            dstData[j++] = ENCODE_TABLE[((srcData[i] & 3) << 4) | (srcData[i + 1] >> 4)];
+            dstData[j++] = ENCODE_TABLE[((srcData[i + 1] & 15) << 2) | (srcData[i + 2] >> 6)];
+            dstData[j++] = ENCODE_TABLE[srcData[i + 2] & 63];
+        }
+        if (srcLen % 3 == 1) {
+            dstData[j++] = ENCODE_TABLE[srcData[i] >> 2];
+            dstData[j++] = ENCODE_TABLE[(srcData[i] & 3) << 4];
+            dstData[j++] = '=';
+            dstData[j++] = '=';
+        } else {
+            dstData[j++] = ENCODE_TABLE[srcData[i] >> 2];
+            dstData[j++] = ENCODE_TABLE[((srcData[i] & 3) << 4) | (srcData[i + 1] >> 4)];
+            dstData[j++] = ENCODE_TABLE[(srcData[i + 1] & 15) << 2];
+            dstData[j++] = '=';
+        }
+        dstData[outLen] = '\0';
+        return result;
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForEncodeDataUriByTriplet
+     * @tc.desc: Testcase for building the data uri of an icon as DBMS did before.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForEncodeDataUriByTriplet(benchmark::State &state)
+    {
+        std::unique_ptr<unsigned char[]> data = GetIconData();
+        for (auto _ : state) {
+            /* @tc.steps: step1.encode the icon in loop */
+            std::unique_ptr<char[]> base64Data = EncodeBase64ByTriplet(data, ICON_SIZE);
+            std::string value = "data:image/" + ICON_TYPE + ";base64," + base64Data.get();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForEncodeDataUri
+     * @tc.desc: Testcase for building the data uri of an icon by Base64Util.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForEncodeDataUri(benchmark::State &state)
+    {
+        std::unique_ptr<unsigned char[]> data = GetIconData();
+        for (auto _ : state) {
+            /* @tc.steps: step1.encode the icon in loop */
+            std::string value;
+            value.reserve(ICON_TYPE.size() + Base64Util::GetEncodedSize(ICON_SIZE) + 32);
+            value.append("data:image/").append(ICON_TYPE).append(";base64,");
+            Base64Util::Encode(data.get(), ICON_SIZE, value);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForDecode
+     * @tc.desc: Testcase for decoding the base64 text of an icon.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForDecode(benchmark::State &state)
+    {
+        std::unique_ptr<unsigned char[]> data = GetIconData();
+        std::string text;
+        Base64Util::Encode(data.get(), ICON_SIZE, text);
+        for (auto _ : state) {
+            /* @tc.steps: step1.decode the icon in loop */
+            std::vector<uint8_t> decoded;
+            benchmark::DoNotOptimize(Base64Util::Decode(text, decoded));
+        }
+    }
+
+    BENCHMARK(BenchmarkTestForEncodeDataUriByTriplet)->Iterations(1000);
+    BENCHMARK(BenchmarkTestForEncodeDataUri)->Iterations(1000);
+    BENCHMARK(BenchmarkTestForDecode)->Iterations(1000);
+}
+
+BENCHMARK_MAIN();
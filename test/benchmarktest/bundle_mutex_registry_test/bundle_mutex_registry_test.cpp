@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "bundle_mutex_registry.h"
+
+using namespace std;
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+    // a few bundles locked over and over, as the installer threads do
+    constexpr int32_t HOT_BUNDLE_COUNT = 8;
+    // a new bundle name each time, as a device with app churn sees over its lifetime
+    constexpr int32_t CHURN_BUNDLE_COUNT = 100000;
+    const std::string BUNDLE_NAME_PREFIX = "com.example.bundlekit.test";
+
+    std::vector<std::string> GetBundleNames(int32_t count)
+    {
+        std::vector<std::string> bundleNames;
+        for (int32_t i = 0; i < count; i++) {
+            bundleNames.emplace_back(BUNDLE_NAME_PREFIX + std::to_string(i));
+        }
+        return bundleNames;
+    }
+
+    // the mutex table used by BundleDataMgr before, which keeps a mutex for every bundle name ever locked
+    class BundleMutexMap {
+    public:
+        std::mutex &GetMutex(const std::string &bundleName)
+        {
+            mutex_.lock_shared();
+            auto it = bundleMutexMap_.find(bundleName);
+            if (it == bundleMutexMap_.end()) {
+                mutex_.unlock_shared();
+                std::unique_lock lock {mutex_};
+                return bundleMutexMap_[bundleName];
+            }
+            mutex_.unlock_shared();
+            return it->second;
+        }
+
+    private:
+        std::shared_mutex mutex_;
+        std::unordered_map<std::string, std::mutex> bundleMutexMap_;
+    };
+
+    BundleMutexMap g_bundleMutexMap;
+    BundleMutexRegistry g_bundleMutexRegistry;
+    const std::vector<std::string> HOT_BUNDLE_NAMES = GetBundleNames(HOT_BUNDLE_COUNT);
+    const std::vector<std::string> CHURN_BUNDLE_NAMES = GetBundleNames(CHURN_BUNDLE_COUNT);
+
+    /**
+     * @tc.name: BenchmarkTestForBundleMutexMap
+     * @tc.desc: Testcase for locking a few bundles by the mutex map from several threads.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForBundleMutexMap(benchmark::State &state)
+    {
+        size_t index = 0;
+        for (auto _ : state) {
+            /* @tc.steps: step1.lock the bundles in loop */
+            const std::string &bundleName = HOT_BUNDLE_NAMES[index++ % HOT_BUNDLE_NAMES.size()];
+            std::lock_guard lock {g_bundleMutexMap.GetMutex(bundleName)};
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForBundleMutexRegistry
+     * @tc.desc: Testcase for locking a few bundles by the mutex registry from several threads.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForBundleMutexRegistry(benchmark::State &state)
+    {
+        size_t index = 0;
+        for (auto _ : state) {
+            /* @tc.steps: step1.lock the bundles in loop */
+            const std::string &bundleName = HOT_BUNDLE_NAMES[index++ % HOT_BUNDLE_NAMES.size()];
+            auto mtx = g_bundleMutexRegistry.GetMutex(bundleName);
+            std::lock_guard lock {*mtx};
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForBundleMutexRegistryChurn
+     * @tc.desc: Testcase for locking new bundles by the mutex registry, the registry must stay small.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForBundleMutexRegistryChurn(benchmark::State &state)
+    {
+        BundleMutexRegistry registry;
+        size_t index = 0;
+        for (auto _ : state) {
+            /* @tc.steps: step1.lock a new bundle in loop */
+            auto mtx = registry.GetMutex(CHURN_BUNDLE_NAMES[index++ % CHURN_BUNDLE_NAMES.size()]);
+            std::lock_guard lock {*mtx};
+        }
+        state.counters["mutexes"] = static_cast<double>(registry.GetSize());
+    }
+
+    BENCHMARK(BenchmarkTestForBundleMutexMap)->Iterations(100000)->Threads(1)->Threads(4);
+    BENCHMARK(BenchmarkTestForBundleMutexRegistry)->Iterations(100000)->Threads(1)->Threads(4);
+    BENCHMARK(BenchmarkTestForBundleMutexRegistryChurn)->Iterations(100000);
+}
+
+BENCHMARK_MAIN();
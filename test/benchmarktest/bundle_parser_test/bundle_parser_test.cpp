@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "bundle_extractor.h"
+#include "bundle_parser.h"
+#include "bundle_profile.h"
+#include "inner_bundle_info.h"
+
+using namespace std;
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+    const std::string HAP_FILE_PATH = "/data/test/benchmark/test.hap";
+    // a profile of this size is close to the biggest ones of the preinstalled apps
+    constexpr int32_t ABILITY_COUNT = 200;
+
+    std::string GetLargeProfile()
+    {
+        nlohmann::json profile = R"(
+            {
+                "app": {
+                    "bundleName": "com.example.benchmark",
+                    "vendor": "example",
+                    "version": {
+                        "code": 1,
+                        "name": "1.0"
+                    },
+                    "apiVersion": {
+                        "compatible": 8,
+                        "target": 8,
+                        "releaseType": "Release"
+                    }
+                },
+                "deviceConfig": {
+                    "default": {
+                        "keepAlive": false
+                    }
+                },
+                "module": {
+                    "package": "com.example.benchmark.entry",
+                    "name": ".MainApplication",
+                    "distro": {
+                        "moduleType": "entry",
+                        "deliveryWithInstall": true,
+                        "moduleName": "entry"
+                    },
+                    "deviceType": [
+                        "phone"
+                    ],
+                    "abilities": []
+                }
+            }
+        )"_json;
+        for (int32_t i = 0; i < ABILITY_COUNT; i++) {
+            std::string index = std::to_string(i);
+            nlohmann::json ability = {
+                {"name", ".Ability" + index},
+                {"description", "benchmark ability " + index},
+                {"icon", "$media:icon"},
+                {"label", "$string:label"},
+                {"type", "page"},
+                {"launchType", "standard"},
+                {"orientation", "unspecified"},
+                {"visible", true},
+                {"permissions", {"ohos.permission.benchmark" + index}},
+                {"skills", {{{"actions", {"action.benchmark" + index}}, {"entities", {"entity.benchmark"}}}}},
+                {"metaData", {{"customizeData", {{{"name", "name" + index}, {"value", "value" + index}}}}}}
+            };
+            profile["module"]["abilities"].push_back(ability);
+        }
+        return profile.dump();
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForTransformProfileFromStream
+     * @tc.desc: Testcase for transforming a large config.json read from a stream.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForTransformProfileFromStream(benchmark::State &state)
+    {
+        std::string profile = GetLargeProfile();
+        BundleExtractor bundleExtractor("");
+        BundleProfile bundleProfile;
+        for (auto _ : state) {
+            /* @tc.steps: step1.write the profile to a stream and transform it in loop */
+            std::ostringstream profileStream;
+            profileStream << profile;
+            InnerBundleInfo innerBundleInfo;
+            benchmark::DoNotOptimize(bundleProfile.TransformTo(profileStream, bundleExtractor, innerBundleInfo));
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForParseHap
+     * @tc.desc: Testcase for parsing a hap file.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForParseHap(benchmark::State &state)
+    {
+        BundleParser bundleParser;
+        for (auto _ : state) {
+            /* @tc.steps: step1.parse the hap in loop */
+            InnerBundleInfo innerBundleInfo;
+            benchmark::DoNotOptimize(bundleParser.Parse(HAP_FILE_PATH, innerBundleInfo));
+        }
+    }
+
+    BENCHMARK(BenchmarkTestForTransformProfileFromStream)->Iterations(100);
+    BENCHMARK(BenchmarkTestForParseHap)->Iterations(1000);
+}
+
+BENCHMARK_MAIN();
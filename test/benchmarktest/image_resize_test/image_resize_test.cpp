@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "image_resize.h"
+
+using namespace std;
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+    // a 1024 * 1024 icon is shrunk to about 4K bytes by DBMS
+    constexpr uint32_t IN_SIZE = 1024;
+    constexpr uint32_t OUT_SIZE = 200;
+    constexpr uint32_t RGBA_COMPONENTS = 4;
+    constexpr uint32_t RGB_COMPONENTS = 3;
+
+    std::vector<uint8_t> GetImage(uint32_t components)
+    {
+        std::vector<uint8_t> image(IN_SIZE * IN_SIZE * components);
+        for (size_t i = 0; i < image.size(); i++) {
+            image[i] = static_cast<uint8_t>(i * 31 + i / IN_SIZE);
+        }
+        return image;
+    }
+
+    // the nearest neighbour scaling used by ImageCompress before
+    void ResizeByNearest(const uint8_t *in, uint8_t *out, uint32_t components)
+    {
+        double ratio = static_cast<double>(OUT_SIZE) / IN_SIZE;
+        for (uint32_t h = 0; h < OUT_SIZE; ++h) {
+            for (uint32_t w = 0; w < OUT_SIZE; ++w) {
+                uint64_t heightIndex = std::round(h / ratio);
+                uint64_t widthIndex = std::round(w / ratio);
+                for (uint32_t c = 0; c < components; ++c) {
+                    out[(h * OUT_SIZE + w) * components + c] =
+                        in[(heightIndex * IN_SIZE + widthIndex) * components + c];
+                }
+            }
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForResizeRGBAByNearest
+     * @tc.desc: Testcase for shrinking a RGBA icon by the nearest neighbour scaling.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForResizeRGBAByNearest(benchmark::State &state)
+    {
+        std::vector<uint8_t> in = GetImage(RGBA_COMPONENTS);
+        std::vector<uint8_t> out(OUT_SIZE * OUT_SIZE * RGBA_COMPONENTS);
+        for (auto _ : state) {
+            /* @tc.steps: step1.resize the icon in loop */
+            ResizeByNearest(in.data(), out.data(), RGBA_COMPONENTS);
+            benchmark::DoNotOptimize(out.data());
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForResizeRGBA
+     * @tc.desc: Testcase for shrinking a RGBA icon by ImageResize.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForResizeRGBA(benchmark::State &state)
+    {
+        std::vector<uint8_t> in = GetImage(RGBA_COMPONENTS);
+        std::vector<uint8_t> out(OUT_SIZE * OUT_SIZE * RGBA_COMPONENTS);
+        for (auto _ : state) {
+            /* @tc.steps: step1.resize the icon in loop */
+            benchmark::DoNotOptimize(ImageResize::Resize(in.data(), IN_SIZE, IN_SIZE,
+                out.data(), OUT_SIZE, OUT_SIZE, RGBA_COMPONENTS));
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForResizeRGBByNearest
+     * @tc.desc: Testcase for shrinking a RGB icon by the nearest neighbour scaling.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForResizeRGBByNearest(benchmark::State &state)
+    {
+        std::vector<uint8_t> in = GetImage(RGB_COMPONENTS);
+        std::vector<uint8_t> out(OUT_SIZE * OUT_SIZE * RGB_COMPONENTS);
+        for (auto _ : state) {
+            /* @tc.steps: step1.resize the icon in loop */
+            ResizeByNearest(in.data(), out.data(), RGB_COMPONENTS);
+            benchmark::DoNotOptimize(out.data());
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForResizeRGB
+     * @tc.desc: Testcase for shrinking a RGB icon by ImageResize.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForResizeRGB(benchmark::State &state)
+    {
+        std::vector<uint8_t> in = GetImage(RGB_COMPONENTS);
+        std::vector<uint8_t> out(OUT_SIZE * OUT_SIZE * RGB_COMPONENTS);
+        for (auto _ : state) {
+            /* @tc.steps: step1.resize the icon in loop */
+            benchmark::DoNotOptimize(ImageResize::Resize(in.data(), IN_SIZE, IN_SIZE,
+                out.data(), OUT_SIZE, OUT_SIZE, RGB_COMPONENTS));
+        }
+    }
+
+    BENCHMARK(BenchmarkTestForResizeRGBAByNearest)->Iterations(100);
+    BENCHMARK(BenchmarkTestForResizeRGBA)->Iterations(100);
+    BENCHMARK(BenchmarkTestForResizeRGBByNearest)->Iterations(100);
+    BENCHMARK(BenchmarkTestForResizeRGB)->Iterations(100);
+}
+
+BENCHMARK_MAIN();
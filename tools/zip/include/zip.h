@@ -20,6 +20,7 @@
 #include <iostream>
 #include <memory>
 #include <time.h>
+#include "zip_stream.h"
 #include "zip_utils.h"
 #include "file_path.h"
 
@@ -160,6 +161,34 @@ bool Zip(const FilePath &srcDir, const FilePath &destFile, const OPTIONS &option
 // options is default value.
 bool Unzip(const FilePath &zipFile, const FilePath &destDir, const OPTIONS &options, CALLBACK callback);
 
+// Extracts only the entries named in |entryNames| from |srcFile| into |destDir| on the calling
+// thread. The central directory is read once into a name index and every requested entry is
+// located directly, so the rest of the archive is never touched. Entries are extracted on
+// |options.parallel| threads. Returns false if an entry is missing, unsafe or fails to extract.
+// example
+// srcFile = /ziptest/hapresult/hapfourfile.zip
+// destDir = /ziptest/hapunzipdir/01
+// entryNames = {"resources/base/media/icon.png", "module.json"}
+bool ExtractEntries(const FilePath &srcFile, const FilePath &destDir, const std::vector<std::string> &entryNames,
+    const OPTIONS &options);
+
+// Same as ExtractEntries(), but runs as a zip task and reports the result through |callback|.
+bool UnzipEntries(const FilePath &srcFile, const FilePath &destDir, const std::vector<std::string> &entryNames,
+    const OPTIONS &options, CALLBACK callback);
+
+// Compresses |srcLen| bytes at |src| into |dest| using the zlib format, without any file I/O.
+// |dest| is sized once from deflateBound(), so the data is written in place.
+// Use ZlibStream for payloads that arrive in chunks.
+ErrorCode CompressBuffer(const uint8_t *src, size_t srcLen, const OPTIONS &options, std::vector<uint8_t> &dest);
+
+// Upper bound of the data DecompressBuffer() produces by default, a few KB of input may inflate to GBs.
+constexpr size_t kMaxDecompressedSize = 128 * 1024 * 1024;
+
+// Decompresses the zlib or gzip data at |src| into |dest|, growing |dest| as needed.
+// Fails with ERROR_CODE_MEM_ERROR when the data inflates to more than |maxSize| bytes.
+ErrorCode DecompressBuffer(const uint8_t *src, size_t srcLen, std::vector<uint8_t> &dest,
+    size_t maxSize = kMaxDecompressedSize);
+
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
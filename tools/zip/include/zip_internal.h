@@ -63,8 +63,10 @@ zipFile OpenForZipping(const std::string &fileNameUtf8, int appendFlag);
 // passed to zipOpen2().
 zipFile OpenFdForZipping(PlatformFile zipFd, int appendFlag);
 
-bool ZipOpenNewFileInZip(
-    zipFile zipFile, const std::string &strPath, const OPTIONS &options, const struct tm *lastModifiedTime);
+// Opens a new entry |strPath| in |zipFile|. If |raw| is true, the caller writes already deflated data and
+// closes the entry with zipCloseFileInZipRaw().
+bool ZipOpenNewFileInZip(zipFile zipFile, const std::string &strPath, const OPTIONS &options,
+    const struct tm *lastModifiedTime, bool raw = false);
 
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <time.h>
+#include <unordered_map>
 #include <stdio.h>
 #include "file_path.h"
 #include "zip_utils.h"
@@ -152,6 +153,34 @@ public:
     // Advances the next entry. Returns true on success.
     bool AdvanceToNextEntry();
 
+    // Returns the position of the current entry in |position|, which can be passed
+    // to LocateEntry() of another reader opened on the same zip file.
+    bool GetCurrentEntryPos(unz_file_pos &position) const;
+
+    // Moves to the entry at |position| and opens it, so that several readers can
+    // extract different entries of the same zip file concurrently.
+    bool LocateEntry(const unz_file_pos &position);
+
+    // Reads the central directory once and indexes the entries by name, so that
+    // LocateEntryByName() can seek to an entry without walking the ones before it.
+    bool BuildEntryIndex();
+
+    // Returns the sum of the original sizes of all entries, known after BuildEntryIndex().
+    uint64_t GetTotalOriginalSize() const
+    {
+        return totalOriginalSize_;
+    }
+
+    // Reports the extracted bytes to |token| and stops extracting once it is canceled.
+    void SetTaskToken(const std::shared_ptr<ZipTaskToken> &token)
+    {
+        token_ = token;
+    }
+
+    // Moves to the entry named |entryName| and opens it. BuildEntryIndex() must be
+    // called beforehand. Returns false if there is no such entry.
+    bool LocateEntryByName(const std::string &entryName);
+
     // Opens the current entry in the zip file. On success, returns true and
     // updates the the current entry state (i.e. CurrentEntryInfo() is
     // updated). This function should be called before operations over the
@@ -191,6 +220,10 @@ private:
     int numEntries_;
     bool reachedEnd_;
     std::unique_ptr<EntryInfo> currentEntryInfo_;
+    // Entry positions keyed by the file name stored in the central directory.
+    std::unordered_map<std::string, unz_file_pos> entryIndex_;
+    uint64_t totalOriginalSize_ = 0;
+    std::shared_ptr<ZipTaskToken> token_ = nullptr;
 
     DISALLOW_COPY_AND_ASSIGN(ZipReader);
 };
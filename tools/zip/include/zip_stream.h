@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZIP_STREAM_H
+#define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZIP_STREAM_H
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "zlib.h"
+#include "zip_utils.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace LIBZIP {
+// A chunked deflate or inflate stream working on memory only. Data is pushed with Write() and
+// every produced chunk is handed to the |sink|, so callers never need the whole payload at once.
+// Deflate produces the zlib format, inflate accepts both zlib and gzip input.
+class ZlibStream {
+public:
+    // Receives the next chunk of output. Return false to abort the stream.
+    using Sink = std::function<bool(const uint8_t *data, size_t size)>;
+
+    enum class Mode {
+        DEFLATE = 0,
+        INFLATE,
+    };
+
+    ZlibStream(Mode mode, const OPTIONS &options);
+    ~ZlibStream();
+
+    // Prepares the zlib state. Must be called once before Write().
+    ErrorCode Init();
+
+    // Feeds |size| bytes of |data| into the stream. If |finish| is true, all pending output is
+    // flushed and the stream ends; further writes fail with ERROR_CODE_STREAM_ERROR.
+    // Returns ERROR_CODE_OK on success, ERROR_CODE_STREAM_END once an inflated stream is complete.
+    ErrorCode Write(const uint8_t *data, size_t size, bool finish, const Sink &sink);
+
+    // Returns the total number of bytes consumed and produced so far.
+    uint64_t GetTotalIn() const
+    {
+        return stream_.total_in;
+    }
+    uint64_t GetTotalOut() const
+    {
+        return stream_.total_out;
+    }
+
+private:
+    Mode mode_;
+    OPTIONS options_;
+    z_stream stream_;
+    bool initialized_ = false;
+    bool finished_ = false;
+    std::vector<uint8_t> chunk_;
+
+    DISALLOW_COPY_AND_ASSIGN(ZlibStream);
+};
+}  // namespace LIBZIP
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZIP_STREAM_H
@@ -14,6 +14,7 @@
  */
 #ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZIP_UTILS_H
 #define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZIP_UTILS_H
+#include <atomic>
 #include <chrono>
 #include <ctime>
 #include <ratio>
@@ -21,6 +22,7 @@
 #include <errno.h>
 #include <stddef.h>
 #include <functional>
+#include <memory>
 
 #include "event_handler.h"
 
@@ -58,7 +60,8 @@ enum ErrorCode {
     ERROR_CODE_DATA_ERROR = -3,
     ERROR_CODE_MEM_ERROR = -4,
     ERROR_CODE_BUF_ERROR = -5,
-    ERROR_CODE_VERSION_ERROR = -6
+    ERROR_CODE_VERSION_ERROR = -6,
+    ERROR_CODE_CANCELED = -7
 };
 
 // Constant definitions related to zlib Library
@@ -96,6 +99,44 @@ using COMPRESS_STRATEGY = enum CompressStrategy;
 enum MemoryLevel { MEM_LEVEL_MIN_MEMLEVEL = 1, MEM_LEVEL_DEFAULT_MEMLEVEL = 8, MEM_LEVEL_MAX_MEMLEVEL = 9 };
 using MEMORY_LEVEL = enum MemoryLevel;
 
+// Shared between the caller of a zip or unzip job and the job itself, to observe the bytes
+// processed, cancel the job between chunks and read the throughput once it is finished.
+// The progress callback must be set before the job starts; everything else may be used from
+// any thread.
+class ZipTaskToken {
+public:
+    // |processedBytes| and |totalBytes| count uncompressed data, |finished| is true for the last report.
+    using ProgressCallback = std::function<void(uint64_t processedBytes, uint64_t totalBytes, bool finished)>;
+
+    void SetProgressCallback(const ProgressCallback &callback, uint64_t interval);
+    void Cancel();
+    bool IsCanceled() const;
+    void Start();
+    void SetTotalBytes(uint64_t totalBytes);
+    // Returns false if the job has been canceled and should stop.
+    bool AddProcessedBytes(uint64_t bytes);
+    void Finish();
+
+    uint64_t GetProcessedBytes() const;
+    uint64_t GetTotalBytes() const;
+    int64_t GetElapsedMs() const;
+    // Returns the average bytes per second since Start().
+    uint64_t GetThroughput() const;
+
+private:
+    void ReportProgress(bool finished);
+
+    std::atomic<bool> canceled_ {false};
+    std::atomic<bool> finished_ {false};
+    std::atomic<uint64_t> processedBytes_ {0};
+    std::atomic<uint64_t> totalBytes_ {0};
+    std::atomic<uint64_t> nextReportBytes_ {0};
+    std::atomic<int64_t> startTime_ {0};
+    std::atomic<int64_t> endTime_ {0};
+    uint64_t progressInterval_ = 0;
+    ProgressCallback progressCallback_;
+};
+
 // Compression Options
 struct Options {
     FLUSH_TYPE flush;
@@ -106,6 +147,11 @@ struct Options {
                             // compression rate, and 0 does not compress
     MEMORY_LEVEL memLevel;  // Internal compression status, how much memory should be allocated
     COMPRESS_STRATEGY strategy;  // CompressStrategy
+    int parallel;           // Number of worker threads used to deflate or extract the entries of one archive,
+                            // 1 processes entries one by one on the task thread
+    int concurrency;        // Number of task runners this job may share with the other jobs, 0 uses the
+                            // default, it does not change the limit of other jobs
+    std::shared_ptr<ZipTaskToken> token = nullptr;  // Progress and cancellation of the job, optional
 
     // default constructor
     Options()
@@ -122,16 +168,28 @@ struct Options {
         level = COMPRESS_LEVEL_DEFAULT_COMPRESSION;
         memLevel = MEM_LEVEL_DEFAULT_MEMLEVEL;
         strategy = COMPRESS_STRATEGY_DEFAULT_STRATEGY;
+        parallel = 1;
+        concurrency = 0;
     }
 };
 using OPTIONS = struct Options;
 
 constexpr PlatformFile kInvalidPlatformFile = -1;
+// Upper bound of both |Options::parallel| and |Options::concurrency|.
+constexpr int kMaxZipParallel = 8;
 
 struct tm *GetCurrentSystemTime(void);
 bool StartsWith(const std::string &str, const std::string &searchFor);
 bool EndsWith(const std::string &str, const std::string &searchFor);
-void PostTask(const OHOS::AppExecFwk::InnerEvent::Callback &callback);
+// Runs |callback| on the task runner pool. At most |concurrency| runners are shared by the tasks posted
+// with the same limit, 0 uses the default limit. The limit only applies to this task. Returns false if
+// the task could not be queued, |callback| is not run then.
+bool PostTask(const OHOS::AppExecFwk::InnerEvent::Callback &callback, int concurrency = 0);
+// Returns ERROR_CODE_CANCELED if the job owning |token| has been canceled, ERROR_CODE_ERRNO otherwise.
+ErrorCode GetFailedErrorCode(const std::shared_ptr<ZipTaskToken> &token);
+// Runs |task| with indexes [0, count) through ParallelTaskUtil on up to |parallel| threads, clamped to
+// [1, kMaxZipParallel], and waits for all of them.
+void RunParallelTasks(size_t count, int parallel, const std::function<void(size_t)> &task);
 bool FilePathCheckValid(const std::string &str);
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
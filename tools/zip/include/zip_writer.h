@@ -59,7 +59,7 @@ private:
     // to |rootDir| specified in the Create method.
     bool AddEntries(const std::vector<FilePath> &paths, const OPTIONS &options, CALLBACK callback);
 
-    // Closes the ZIP file.
+    // Closes the ZIP file and reports the result through |callback|.
     // Returns true if successful, false otherwise (typically if an entry failed
     // to be written).
     bool Close(const OPTIONS &options, CALLBACK callback);
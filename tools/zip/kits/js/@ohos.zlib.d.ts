@@ -26,7 +26,12 @@ declare namespace zlib {
  */
   export enum ErrorCode {
     ERROR_CODE_OK = 0,
-    ERROR_CODE_ERRNO = -1
+    ERROR_CODE_ERRNO = -1,
+    /**
+     * The job has been stopped through its task token.
+     * @since 9
+     */
+    ERROR_CODE_CANCELED = -7
   }
 
 /**
@@ -86,8 +91,75 @@ declare namespace zlib {
     level?: CompressLevel;
     memLevel?: MemLevel;
     strategy?: CompressStrategy;
+    /**
+     * Number of threads used to compress or decompress the entries of one file, 1 by default.
+     * @since 9
+     */
+    parallel?: number;
+    /**
+     * Number of task threads this zipFile/unzipFile call may share with the other calls, 2 by default.
+     * It only applies to this call.
+     * @since 9
+     */
+    concurrency?: number;
+    /**
+     * Token created by createTaskToken, used to cancel the job and read its statistics.
+     * @since 9
+     */
+    token?: TaskToken;
+    /**
+     * Called on the JS thread with the uncompressed bytes processed so far, and once more when the job ends.
+     * @since 9
+     */
+    onProgress?: (processedBytes: number, totalBytes: number) => void;
+    /**
+     * Minimum number of bytes between two onProgress calls, 1 MB by default.
+     * @since 9
+     */
+    progressInterval?: number;
   }
 
+  /**
+   * Statistics of a zip or unzip job.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   */
+  interface TaskStats {
+    processedBytes: number;
+    totalBytes: number;
+    elapsedMs: number;
+    /** Average bytes per second since the job started. */
+    throughput: number;
+  }
+
+  /**
+   * Controls a running zip or unzip job.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   */
+  interface TaskToken {
+    /**
+     * Stops the job between two chunks, the job then ends with ERROR_CODE_CANCELED.
+     */
+    cancel(): void;
+
+    /**
+     * Returns the statistics of the current or last job.
+     */
+    getStats(): TaskStats;
+  }
+
+  /**
+   * Creates a token to be passed in the options of zipFile, unzipFile or unzipEntries.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @return Returns the task token.
+   */
+  function createTaskToken(): TaskToken;
+
   /**
    * Compress the specified file.
    *
@@ -111,4 +183,79 @@ declare namespace zlib {
    * @return Returns error code.
    */
   function unzipFile(inFile:string, outFile:string, options: Options): Promise<void>;
+
+  /**
+   * Decompress only the listed entries of the specified file.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param inFile Indicates the path of the file to be decompressed.
+   * @param outFile Indicates the path of the decompressed file.
+   * @param entries Indicates the names of the entries to be extracted, as stored in the file.
+   * @param options Indicates the options, parallel sets the number of extracting threads.
+   * @return Returns error code.
+   */
+  function unzipEntries(inFile:string, outFile:string, entries: Array<string>, options: Options,
+    callback: AsyncCallback<void>): void;
+  function unzipEntries(inFile:string, outFile:string, entries: Array<string>, options: Options): Promise<void>;
+
+  /**
+   * A chunked deflate or inflate stream working on memory only.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   */
+  interface ZlibStream {
+    /**
+     * Feeds a chunk into the stream and returns the output produced for it.
+     *
+     * @param chunk Indicates the next part of the input.
+     * @param finish Indicates whether this is the last chunk.
+     * @return Returns the output produced for this chunk, which may be empty.
+     */
+    write(chunk: ArrayBuffer, finish: boolean): ArrayBuffer;
+  }
+
+  /**
+   * Compress the data in memory using the zlib format.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param data Indicates the data to be compressed.
+   * @param options Indicates the compression options.
+   * @return Returns the compressed data.
+   */
+  function compressBuffer(data: ArrayBuffer, options: Options, callback: AsyncCallback<ArrayBuffer>): void;
+  function compressBuffer(data: ArrayBuffer, options: Options): Promise<ArrayBuffer>;
+
+  /**
+   * Decompress zlib or gzip data in memory. The call fails if the data decompresses to more than
+   * 128 MB, use createInflateStream for larger data.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param data Indicates the data to be decompressed.
+   * @return Returns the decompressed data.
+   */
+  function decompressBuffer(data: ArrayBuffer, callback: AsyncCallback<ArrayBuffer>): void;
+  function decompressBuffer(data: ArrayBuffer): Promise<ArrayBuffer>;
+
+  /**
+   * Creates a stream which compresses the chunks written to it.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param options Indicates the compression options.
+   * @return Returns the deflate stream.
+   */
+  function createDeflateStream(options?: Options): ZlibStream;
+
+  /**
+   * Creates a stream which decompresses zlib or gzip chunks written to it.
+   *
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @return Returns the inflate stream.
+   */
+  function createInflateStream(): ZlibStream;
 }
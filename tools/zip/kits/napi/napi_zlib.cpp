@@ -14,6 +14,7 @@
  */
 #include "napi_zlib.h"
 
+#include <atomic>
 #include <cstring>
 #include <uv.h>
 #include <vector>
@@ -37,6 +38,7 @@ constexpr size_t ARGS_TWO = 2;
 constexpr size_t ARGS_MAX_COUNT = 10;
 constexpr int32_t PARAM0 = 0;
 constexpr int32_t PARAM1 = 1;
+constexpr int32_t PARAM2 = 2;
 constexpr int32_t PARAM3 = 3;
 }
 
@@ -61,23 +63,31 @@ constexpr int32_t PARAM3 = 3;
         return ret;                                                                                               \
     }
 
-std::shared_ptr<ZlibCallbackInfo> g_zipAceCallbackInfo = nullptr;
-std::shared_ptr<ZlibCallbackInfo> g_unzipAceCallbackInfo = nullptr;
-void ZipFileAsyncCallBack(int result);
-void ZipFilePromiseCallBack(int result);
-void UnzipFileAsyncCallBack(int result);
-void UnzipFilePromiseCallBack(int result);
+#define COMPRESS_PARALLEL_CHECK(name, value, ret)                                            \
+    if ((value) < 0 || (value) > kMaxZipParallel) {                                          \
+        APP_LOGE("%{public}s parameter =[%{public}d] value is incorrect", name, (int)(value)); \
+        return ret;                                                                          \
+    }
+
+CALLBACK CreateResultCallback(const std::shared_ptr<ZlibCallbackInfo> &aceCallback);
+void ReleaseZipCallbackInfo(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackInfo);
+void ZipFileComplete(napi_env env, napi_status status, void *data);
 napi_value UnwrapZipParam(CallZipUnzipParam &param, napi_env env, napi_value *args, size_t argc);
 napi_value UnwrapUnZipParam(CallZipUnzipParam &param, napi_env env, napi_value *args, size_t argc);
 napi_value ZipFileWrap(napi_env env, napi_callback_info info, AsyncZipCallbackInfo *asyncZipCallbackInfo);
 napi_value UnwrapStringParam(std::string &str, napi_env env, napi_value args);
-bool UnwrapOptionsParams(OPTIONS &options, napi_env env, napi_value arg);
+bool UnwrapOptionsParams(OPTIONS &options, napi_env env, napi_value arg,
+    std::shared_ptr<ZlibProgressContext> *progress = nullptr);
 napi_value ZipFileAsync(napi_env env, napi_value *args, size_t argcAsync, AsyncZipCallbackInfo *asyncZipCallbackInfo);
 napi_value UnzipFileAsync(napi_env env, napi_value *args, size_t argcAsync, AsyncZipCallbackInfo *asyncZipCallbackInfo);
-void ZipAndUnzipFileAsyncCallBack(std::shared_ptr<ZlibCallbackInfo> &zipAceCallbackInfo, int result);
+void ZipAndUnzipFileAsyncCallBack(const std::shared_ptr<ZlibCallbackInfo> &zipAceCallbackInfo, int result);
 napi_value ZipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackInfo);
 napi_value UnzipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackInfo);
 void ZipAndUnzipFileAsyncCallBackInnerJsThread(uv_work_t *work, int status);
+bool UnwrapTaskToken(std::shared_ptr<ZipTaskToken> &token, napi_env env, napi_value arg);
+bool SetProgressCallback(OPTIONS &options, napi_env env, napi_value jsCallback, uint64_t interval,
+    std::shared_ptr<ZlibProgressContext> *progress);
+void ReleaseProgressCallback(napi_env env, OPTIONS &options, std::shared_ptr<ZlibProgressContext> &progress);
 
 /**
  * @brief FlushType data initialization.
@@ -226,6 +236,7 @@ napi_value ErrorCodeInit(napi_env env, napi_value exports)
     const int ERROR_CODE_MEM_ERROR = -4;
     const int ERROR_CODE_BUF_ERROR = -5;
     const int ERROR_CODE_VERSION_ERROR = -6;
+    const int ERROR_CODE_CANCELED = -7;
 
     napi_value errorCode = nullptr;
     napi_create_object(env, &errorCode);
@@ -238,6 +249,7 @@ napi_value ErrorCodeInit(napi_env env, napi_value exports)
     SetNamedProperty(env, errorCode, "ERROR_CODE_MEM_ERROR", ERROR_CODE_MEM_ERROR);
     SetNamedProperty(env, errorCode, "ERROR_CODE_BUF_ERROR", ERROR_CODE_BUF_ERROR);
     SetNamedProperty(env, errorCode, "ERROR_CODE_VERSION_ERROR", ERROR_CODE_VERSION_ERROR);
+    SetNamedProperty(env, errorCode, "ERROR_CODE_CANCELED", ERROR_CODE_CANCELED);
 
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_PROPERTY("ErrorCode", errorCode),
@@ -262,6 +274,12 @@ napi_value ZlibInit(napi_env env, napi_value exports)
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_FUNCTION("zipFile", NAPI_ZipFile),
         DECLARE_NAPI_FUNCTION("unzipFile", NAPI_UnzipFile),
+        DECLARE_NAPI_FUNCTION("unzipEntries", NAPI_UnzipEntries),
+        DECLARE_NAPI_FUNCTION("compressBuffer", NAPI_CompressBuffer),
+        DECLARE_NAPI_FUNCTION("decompressBuffer", NAPI_DecompressBuffer),
+        DECLARE_NAPI_FUNCTION("createDeflateStream", NAPI_CreateDeflateStream),
+        DECLARE_NAPI_FUNCTION("createInflateStream", NAPI_CreateInflateStream),
+        DECLARE_NAPI_FUNCTION("createTaskToken", NAPI_CreateTaskToken),
     };
 
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties));
@@ -325,18 +343,57 @@ napi_value NAPI_ZipFile(napi_env env, napi_callback_info info)
 
     ret = ZipFileWrap(env, info, asyncZipCallbackInfo);
     if (ret == nullptr) {
+        ReleaseZipCallbackInfo(env, asyncZipCallbackInfo);
+    }
 
-        if (g_zipAceCallbackInfo != nullptr) {
-            g_zipAceCallbackInfo.reset();
-            g_zipAceCallbackInfo = nullptr;
-        }
-        if (asyncZipCallbackInfo != nullptr) {
-            delete asyncZipCallbackInfo;
-            asyncZipCallbackInfo = nullptr;
+    return ret;
+}
+
+// Releases a call which failed before its async work was queued.
+void ReleaseZipCallbackInfo(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackInfo)
+{
+    if (asyncZipCallbackInfo == nullptr) {
+        return;
+    }
+    if (asyncZipCallbackInfo->asyncWork != nullptr) {
+        napi_delete_async_work(env, asyncZipCallbackInfo->asyncWork);
+    }
+    auto &aceCallback = asyncZipCallbackInfo->aceCallback;
+    if (aceCallback != nullptr) {
+        ReleaseProgressCallback(env, aceCallback->param.options, aceCallback->param.progress);
+        if (aceCallback->callback != nullptr) {
+            napi_delete_reference(env, aceCallback->callback);
+            aceCallback->callback = nullptr;
         }
     }
+    delete asyncZipCallbackInfo;
+}
 
-    return ret;
+// Completes the async work of zipFile or unzipFile on the JS thread.
+void ZipFileComplete(napi_env env, napi_status status, void *data)
+{
+    AsyncZipCallbackInfo *asyncCallbackInfo = static_cast<AsyncZipCallbackInfo *>(data);
+    if (asyncCallbackInfo == nullptr) {
+        return;
+    }
+    // Zip() and Unzip() fail before posting without finishing the token, so no final report releases it
+    if (!asyncCallbackInfo->posted && asyncCallbackInfo->aceCallback != nullptr) {
+        auto &param = asyncCallbackInfo->aceCallback->param;
+        ReleaseProgressCallback(env, param.options, param.progress);
+    }
+    napi_delete_async_work(env, asyncCallbackInfo->asyncWork);
+    delete asyncCallbackInfo;
+}
+
+// The result is delivered once, to the call which owns |aceCallback|.
+CALLBACK CreateResultCallback(const std::shared_ptr<ZlibCallbackInfo> &aceCallback)
+{
+    auto delivered = std::make_shared<std::atomic<bool>>(false);
+    return [aceCallback, delivered](int result) {
+        if (!delivered->exchange(true)) {
+            ZipAndUnzipFileAsyncCallBack(aceCallback, result);
+        }
+    };
 }
 
 napi_value ZipFileWrap(napi_env env, napi_callback_info info, AsyncZipCallbackInfo *asyncZipCallbackInfo)
@@ -356,14 +413,9 @@ napi_value ZipFileWrap(napi_env env, napi_callback_info info, AsyncZipCallbackIn
         APP_LOGE("%{public}s, call unwrapWant failed.", __func__);
         return nullptr;
     }
-    g_zipAceCallbackInfo = std::make_shared<ZlibCallbackInfo>();
-    if (g_zipAceCallbackInfo == nullptr) {
-        APP_LOGE("%{public}s, call param failed.", __func__);
-        return nullptr;
-    }
-    asyncZipCallbackInfo->aceCallback = g_zipAceCallbackInfo;
-    g_zipAceCallbackInfo->param = param;
-    g_zipAceCallbackInfo->env = env;
+    asyncZipCallbackInfo->aceCallback = std::make_shared<ZlibCallbackInfo>();
+    asyncZipCallbackInfo->aceCallback->param = param;
+    asyncZipCallbackInfo->aceCallback->env = env;
 
     if (argcAsync > PARAM3) {
         ret = ZipFileAsync(env, args, argcAsync, asyncZipCallbackInfo);
@@ -385,7 +437,8 @@ napi_value ZipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackIn
     napi_deferred deferred;
     napi_value promise = 0;
     NAPI_CALL(env, napi_create_promise(env, &deferred, &promise));
-    g_zipAceCallbackInfo->deferred = deferred;
+    asyncZipCallbackInfo->aceCallback->deferred = deferred;
+    asyncZipCallbackInfo->aceCallback->isCallBack = false;
     napi_create_async_work(
         env,
         nullptr,
@@ -394,26 +447,23 @@ napi_value ZipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackIn
             APP_LOGI("NAPI_ZipFile_Promise, worker pool thread execute.");
             AsyncZipCallbackInfo *asyncCallbackInfo = static_cast<AsyncZipCallbackInfo *>(data);
             if (asyncCallbackInfo != nullptr && asyncCallbackInfo->aceCallback != nullptr) {
-                Zip(FilePath(asyncCallbackInfo->aceCallback->param.src),
+                asyncCallbackInfo->posted = Zip(FilePath(asyncCallbackInfo->aceCallback->param.src),
                     FilePath(asyncCallbackInfo->aceCallback->param.dest),
                     asyncCallbackInfo->aceCallback->param.options,
-                    ZipFilePromiseCallBack,
+                    CreateResultCallback(asyncCallbackInfo->aceCallback),
                     false);
             }
             APP_LOGI("NAPI_ZipFile_Promise, worker pool thread execute end.");
         },
-        [](napi_env env, napi_status status, void *data) {
-            APP_LOGI("NAPI_ZipFile_Promise, main event thread complete.");
-            AsyncZipCallbackInfo *asyncCallbackInfo = static_cast<AsyncZipCallbackInfo *>(data);
-            napi_delete_async_work(env, asyncCallbackInfo->asyncWork);
-            delete asyncCallbackInfo;
-            asyncCallbackInfo = nullptr;
-            APP_LOGI("NAPI_ZipFile_Promise, main event thread complete end.");
-        },
+        ZipFileComplete,
         (void *)asyncZipCallbackInfo,
         &asyncZipCallbackInfo->asyncWork);
 
-    napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork);
+    if (asyncZipCallbackInfo->asyncWork == nullptr ||
+        napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork) != napi_ok) {
+        APP_LOGE("%{public}s, queue async work failed.", __func__);
+        return nullptr;
+    }
     APP_LOGI("%{public}s, promise end.", __func__);
     return promise;
 }
@@ -452,7 +502,8 @@ napi_value UnwrapStringParam(std::string &str, napi_env env, napi_value argv)
     return result;
 }
 
-bool UnwrapOptionsParams(OPTIONS &options, napi_env env, napi_value arg)
+bool UnwrapOptionsParams(OPTIONS &options, napi_env env, napi_value arg,
+    std::shared_ptr<ZlibProgressContext> *progress)
 {
     APP_LOGI("%{public}s called.", __func__);
 
@@ -469,6 +520,8 @@ bool UnwrapOptionsParams(OPTIONS &options, napi_env env, napi_value arg)
 
     napi_value jsProName = nullptr;
     napi_value jsProValue = nullptr;
+    napi_value jsProgress = nullptr;
+    uint64_t progressInterval = 0;
 
     for (uint32_t index = 0; index < jsProCount; index++) {
         NAPI_CALL_BASE(env, napi_get_element(env, jsProNameList, index, &jsProName), false);
@@ -499,10 +552,31 @@ bool UnwrapOptionsParams(OPTIONS &options, napi_env env, napi_value arg)
             NAPI_CALL_BASE_BOOL(UnwrapIntValue(env, jsProValue, ret), false);
             COMPRESS_STRATEGY_CHECK(ret, false)
             options.strategy = static_cast<COMPRESS_STRATEGY>(ret);
+        } else if (strProName == std::string("parallel")) {
+            NAPI_CALL_BASE_BOOL(UnwrapIntValue(env, jsProValue, ret), false);
+            COMPRESS_PARALLEL_CHECK("parallel", ret, false)
+            options.parallel = ret;
+        } else if (strProName == std::string("concurrency")) {
+            NAPI_CALL_BASE_BOOL(UnwrapIntValue(env, jsProValue, ret), false);
+            COMPRESS_PARALLEL_CHECK("concurrency", ret, false)
+            options.concurrency = ret;
+        } else if (strProName == std::string("token")) {
+            NAPI_CALL_BASE_BOOL(UnwrapTaskToken(options.token, env, jsProValue), false);
+        } else if (strProName == std::string("onProgress")) {
+            NAPI_CALL_BASE_BOOL(jsValueType == napi_function, false);
+            jsProgress = jsProValue;
+        } else if (strProName == std::string("progressInterval")) {
+            NAPI_CALL_BASE_BOOL(UnwrapIntValue(env, jsProValue, ret), false);
+            NAPI_CALL_BASE_BOOL(ret >= 0, false);
+            progressInterval = static_cast<uint64_t>(ret);
         } else {
             continue;
         }
     }
+    // the token may come after onProgress in the property list, so the callback is bound last
+    if (jsProgress != nullptr) {
+        NAPI_CALL_BASE_BOOL(SetProgressCallback(options, env, jsProgress, progressInterval, progress), false);
+    }
     return true;
 }
 
@@ -528,7 +602,7 @@ napi_value UnwrapZipParam(CallZipUnzipParam &param, napi_env env, napi_value *ar
     }
 
     // unwrap the param[2]
-    if (!UnwrapOptionsParams(param.options, env, args[2])) {
+    if (!UnwrapOptionsParams(param.options, env, args[2], &param.progress)) {
         APP_LOGI("%{public}s called, args[2] error", __func__);
         return nullptr;
     }
@@ -555,6 +629,13 @@ napi_value UnwrapUnZipParam(CallZipUnzipParam &param, napi_env env, napi_value *
         return nullptr;
     }
 
+    // unwrap the param[2], only parallel and concurrency are used by unzip
+    if (IsTypeForNapiValue(env, args[2], napi_object) &&
+        !UnwrapOptionsParams(param.options, env, args[2], &param.progress)) {
+        APP_LOGI("%{public}s called, args[2] error", __func__);
+        return nullptr;
+    }
+
     // create reutrn
     napi_value ret = 0;
     NAPI_CALL_BASE(env, napi_create_int32(env, 0, &ret), nullptr);
@@ -585,7 +666,9 @@ napi_value ZipFileAsync(napi_env env, napi_value *args, size_t argcAsync, AsyncZ
         NAPI_CALL_BASE(env, napi_typeof(env, args[PARAM3], &valuetype), nullptr);
         if (valuetype == napi_function) {
             // resultCallback: AsyncCallback<ZipRestult>
-            napi_create_reference(env, args[PARAM3], 1, &g_zipAceCallbackInfo->callback);
+            NAPI_CALL_BASE(env,
+                napi_create_reference(env, args[PARAM3], 1, &asyncZipCallbackInfo->aceCallback->callback), nullptr);
+            asyncZipCallbackInfo->aceCallback->isCallBack = true;
         } else {
             APP_LOGE("%{public}s, args[3] error. It should be a function type.", __func__);
             return nullptr;
@@ -599,23 +682,22 @@ napi_value ZipFileAsync(napi_env env, napi_value *args, size_t argcAsync, AsyncZ
             APP_LOGI("NAPI_ZipFile_callback, worker pool thread execute.");
             AsyncZipCallbackInfo *asyncCallbackInfo = (AsyncZipCallbackInfo *)data;
             if (asyncCallbackInfo != nullptr && asyncCallbackInfo->aceCallback != nullptr) {
-                Zip(FilePath(asyncCallbackInfo->aceCallback->param.src),
+                asyncCallbackInfo->posted = Zip(FilePath(asyncCallbackInfo->aceCallback->param.src),
                     FilePath(asyncCallbackInfo->aceCallback->param.dest),
                     asyncCallbackInfo->aceCallback->param.options,
-                    ZipFileAsyncCallBack,
+                    CreateResultCallback(asyncCallbackInfo->aceCallback),
                     false);
             }
         },
-        [](napi_env env, napi_status status, void *data) {
-            APP_LOGI("NAPI_ZipFile_callback, main event thread complete.");
-            AsyncZipCallbackInfo *asyncCallbackInfo = (AsyncZipCallbackInfo *)data;
-            napi_delete_async_work(env, asyncCallbackInfo->asyncWork);
-            delete asyncCallbackInfo;
-        },
+        ZipFileComplete,
         (void *)asyncZipCallbackInfo,
         &asyncZipCallbackInfo->asyncWork);
 
-    napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork);
+    if (asyncZipCallbackInfo->asyncWork == nullptr ||
+        napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork) != napi_ok) {
+        APP_LOGE("%{public}s, queue async work failed.", __func__);
+        return nullptr;
+    }
     napi_value result = 0;
     napi_get_null(env, &result);
     return result;
@@ -650,13 +732,13 @@ napi_value NAPI_UnzipFile(napi_env env, napi_callback_info info)
 
     AsyncZipCallbackInfo *asyncZipCallbackInfo = CreateZipAsyncCallbackInfo(env);
     if (asyncZipCallbackInfo == nullptr) {
+        ReleaseProgressCallback(env, param.options, param.progress);
         return nullptr;
     }
 
-    g_unzipAceCallbackInfo = std::make_shared<ZlibCallbackInfo>();
-    asyncZipCallbackInfo->aceCallback = g_unzipAceCallbackInfo;
-    g_unzipAceCallbackInfo->param = param;
-    g_unzipAceCallbackInfo->env = env;
+    asyncZipCallbackInfo->aceCallback = std::make_shared<ZlibCallbackInfo>();
+    asyncZipCallbackInfo->aceCallback->param = param;
+    asyncZipCallbackInfo->aceCallback->env = env;
 
     if (argcAsync > PARAM3) {
         ret = UnzipFileAsync(env, args, argcAsync, asyncZipCallbackInfo);
@@ -665,15 +747,7 @@ napi_value NAPI_UnzipFile(napi_env env, napi_callback_info info)
     }
     if (ret == nullptr) {
         APP_LOGE("%{public}s,ret == nullptr", __func__);
-        if (g_unzipAceCallbackInfo != nullptr) {
-            g_unzipAceCallbackInfo.reset();
-            g_unzipAceCallbackInfo = nullptr;
-        }
-        if (asyncZipCallbackInfo != nullptr) {
-            napi_delete_async_work(env, asyncZipCallbackInfo->asyncWork);
-            delete asyncZipCallbackInfo;
-            asyncZipCallbackInfo = nullptr;
-        }
+        ReleaseZipCallbackInfo(env, asyncZipCallbackInfo);
     }
     APP_LOGI("%{public}s,end", __func__);
     return ret;
@@ -690,7 +764,8 @@ napi_value UnzipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallback
     napi_deferred deferred;
     napi_value promise = 0;
     NAPI_CALL(env, napi_create_promise(env, &deferred, &promise));
-    g_unzipAceCallbackInfo->deferred = deferred;
+    asyncZipCallbackInfo->aceCallback->deferred = deferred;
+    asyncZipCallbackInfo->aceCallback->isCallBack = false;
     napi_create_async_work(
         env,
         nullptr,
@@ -699,24 +774,21 @@ napi_value UnzipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallback
             APP_LOGI("NAPI_UnzipFile_Promise, worker pool thread execute.");
             AsyncZipCallbackInfo *asyncCallbackInfo = static_cast<AsyncZipCallbackInfo *>(data);
             if (asyncCallbackInfo != nullptr && asyncCallbackInfo->aceCallback != nullptr) {
-                Unzip(FilePath(asyncCallbackInfo->aceCallback->param.src),
+                asyncCallbackInfo->posted = Unzip(FilePath(asyncCallbackInfo->aceCallback->param.src),
                     FilePath(asyncCallbackInfo->aceCallback->param.dest),
                     asyncCallbackInfo->aceCallback->param.options,
-                    UnzipFilePromiseCallBack);
+                    CreateResultCallback(asyncCallbackInfo->aceCallback));
             }
             APP_LOGI("NAPI_UnzipFile_Promise, worker pool thread execute end.");
         },
-        [](napi_env env, napi_status status, void *data) {
-            APP_LOGI("NAPI_UnzipFile_Promise, main event thread complete.");
-            AsyncZipCallbackInfo *asyncCallbackInfo = static_cast<AsyncZipCallbackInfo *>(data);
-            napi_delete_async_work(env, asyncCallbackInfo->asyncWork);
-            delete asyncCallbackInfo;
-            asyncCallbackInfo = nullptr;
-            APP_LOGI("NAPI_UnzipFile_Promise, main event thread complete end.");
-        },
+        ZipFileComplete,
         (void *)asyncZipCallbackInfo,
         &asyncZipCallbackInfo->asyncWork);
-    napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork);
+    if (asyncZipCallbackInfo->asyncWork == nullptr ||
+        napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork) != napi_ok) {
+        APP_LOGE("%{public}s, queue async work failed.", __func__);
+        return nullptr;
+    }
     APP_LOGI("%{public}s, promise end.", __func__);
     return promise;
 }
@@ -734,7 +806,9 @@ napi_value UnzipFileAsync(napi_env env, napi_value *args, size_t argcAsync, Asyn
         NAPI_CALL_BASE(env, napi_typeof(env, args[PARAM3], &valuetype), nullptr);
         if (valuetype == napi_function) {
             // resultCallback: AsyncCallback<ZipRestult>
-            napi_create_reference(env, args[PARAM3], 1, &g_unzipAceCallbackInfo->callback);
+            NAPI_CALL_BASE(env,
+                napi_create_reference(env, args[PARAM3], 1, &asyncZipCallbackInfo->aceCallback->callback), nullptr);
+            asyncZipCallbackInfo->aceCallback->isCallBack = true;
         } else {
             APP_LOGE("%{public}s, args[3] error. It should be a function type.", __func__);
             return nullptr;
@@ -749,58 +823,25 @@ napi_value UnzipFileAsync(napi_env env, napi_value *args, size_t argcAsync, Asyn
             AsyncZipCallbackInfo *asyncCallbackInfo = (AsyncZipCallbackInfo *)data;
             // Unzip
             if (asyncCallbackInfo != nullptr && asyncCallbackInfo->aceCallback != nullptr) {
-                Unzip(FilePath(asyncCallbackInfo->aceCallback->param.src),
+                asyncCallbackInfo->posted = Unzip(FilePath(asyncCallbackInfo->aceCallback->param.src),
                     FilePath(asyncCallbackInfo->aceCallback->param.dest),
                     asyncCallbackInfo->aceCallback->param.options,
-                    UnzipFileAsyncCallBack);
+                    CreateResultCallback(asyncCallbackInfo->aceCallback));
             }
         },
-        [](napi_env env, napi_status status, void *data) {
-            APP_LOGI("NAPI_UnzipFile, main event thread complete.");
-            AsyncZipCallbackInfo *asyncCallbackInfo = (AsyncZipCallbackInfo *)data;
-            napi_delete_async_work(env, asyncCallbackInfo->asyncWork);
-            delete asyncCallbackInfo;
-        },
+        ZipFileComplete,
         (void *)asyncZipCallbackInfo,
         &asyncZipCallbackInfo->asyncWork);
 
-    napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork);
+    if (asyncZipCallbackInfo->asyncWork == nullptr ||
+        napi_queue_async_work(env, asyncZipCallbackInfo->asyncWork) != napi_ok) {
+        APP_LOGE("%{public}s, queue async work failed.", __func__);
+        return nullptr;
+    }
     napi_value result = 0;
     napi_get_null(env, &result);
     return result;
 }
-// ZipFile callback
-void ZipFileAsyncCallBack(int result)
-{
-    if (g_zipAceCallbackInfo != nullptr) {
-        g_zipAceCallbackInfo->isCallBack = true;
-    }
-    ZipAndUnzipFileAsyncCallBack(g_zipAceCallbackInfo, result);
-}
-// ZipFile Promise
-void ZipFilePromiseCallBack(int result)
-{
-    if (g_zipAceCallbackInfo != nullptr) {
-        g_zipAceCallbackInfo->isCallBack = false;
-    }
-    ZipAndUnzipFileAsyncCallBack(g_zipAceCallbackInfo, result);
-}
-// UnzipFile callback
-void UnzipFileAsyncCallBack(int result)
-{
-    if (g_unzipAceCallbackInfo != nullptr) {
-        g_unzipAceCallbackInfo->isCallBack = true;
-    }
-    ZipAndUnzipFileAsyncCallBack(g_unzipAceCallbackInfo, result);
-}
-// UnzipFile Promise
-void UnzipFilePromiseCallBack(int result)
-{
-    if (g_unzipAceCallbackInfo != nullptr) {
-        g_unzipAceCallbackInfo->isCallBack = false;
-    }
-    ZipAndUnzipFileAsyncCallBack(g_unzipAceCallbackInfo, result);
-}
 void ZipAndUnzipFileAsyncCallBackInnerJsThread(uv_work_t *work)
 {
     if (work == nullptr) {
@@ -844,7 +885,7 @@ void ZipAndUnzipFileAsyncCallBackInnerJsThread(uv_work_t *work)
         work = nullptr;
     }
 }
-void ZipAndUnzipFileAsyncCallBack(std::shared_ptr<ZlibCallbackInfo> &zipAceCallbackInfo, int result)
+void ZipAndUnzipFileAsyncCallBack(const std::shared_ptr<ZlibCallbackInfo> &zipAceCallbackInfo, int result)
 {
     if (zipAceCallbackInfo == nullptr) {
         return;
@@ -869,8 +910,6 @@ void ZipAndUnzipFileAsyncCallBack(std::shared_ptr<ZlibCallbackInfo> &zipAceCallb
     }
     *asyncCallbackInfo = *zipAceCallbackInfo;
     asyncCallbackInfo->callbackResult = result;
-    zipAceCallbackInfo.reset();
-    zipAceCallbackInfo = nullptr;
     work->data = (void *)asyncCallbackInfo;
     int rev = uv_queue_work(
         loop,
@@ -898,6 +937,555 @@ void ZipAndUnzipFileAsyncCallBack(std::shared_ptr<ZlibCallbackInfo> &zipAceCallb
     }
 }
 
+bool UnwrapStringArrayParam(std::vector<std::string> &strings, napi_env env, napi_value arg)
+{
+    bool isArray = false;
+    NAPI_CALL_BASE(env, napi_is_array(env, arg, &isArray), false);
+    if (!isArray) {
+        return false;
+    }
+    uint32_t length = 0;
+    NAPI_CALL_BASE(env, napi_get_array_length(env, arg, &length), false);
+    for (uint32_t index = 0; index < length; index++) {
+        napi_value element = nullptr;
+        NAPI_CALL_BASE(env, napi_get_element(env, arg, index, &element), false);
+        std::string str;
+        if (UnwrapStringParam(str, env, element) == nullptr) {
+            return false;
+        }
+        strings.push_back(str);
+    }
+    return true;
+}
+
+void UnzipEntriesComplete(napi_env env, napi_status status, void *data)
+{
+    APP_LOGI("NAPI_UnzipEntries, main event thread complete.");
+    ZlibEntriesCallbackInfo *entriesInfo = static_cast<ZlibEntriesCallbackInfo *>(data);
+    if (entriesInfo == nullptr) {
+        return;
+    }
+    int errCode = entriesInfo->result ? ERROR_CODE_OK : GetFailedErrorCode(entriesInfo->options.token);
+    napi_value result[ARGS_TWO] = {0};
+    result[PARAM0] = GetCallbackErrorValue(env, errCode);
+    napi_create_int32(env, errCode, &result[PARAM1]);
+    if (entriesInfo->callback != nullptr) {
+        napi_value callback = nullptr;
+        napi_value undefined = nullptr;
+        napi_value jsResult = nullptr;
+        napi_get_reference_value(env, entriesInfo->callback, &callback);
+        napi_get_undefined(env, &undefined);
+        napi_call_function(env, undefined, callback, ARGS_TWO, &result[PARAM0], &jsResult);
+        napi_delete_reference(env, entriesInfo->callback);
+    } else if (entriesInfo->result) {
+        napi_resolve_deferred(env, entriesInfo->deferred, result[PARAM1]);
+    } else {
+        napi_reject_deferred(env, entriesInfo->deferred, result[PARAM0]);
+    }
+    napi_delete_async_work(env, entriesInfo->asyncWork);
+    delete entriesInfo;
+}
+
+napi_value NAPI_UnzipEntries(napi_env env, napi_callback_info info)
+{
+    APP_LOGI("%{public}s,called", __func__);
+    napi_value args[ARGS_MAX_COUNT] = {nullptr};
+    size_t argc = ARGS_MAX_COUNT;
+    const size_t argcPromise = 4;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+    if (argc < argcPromise || argc > argcPromise + 1) {
+        APP_LOGE("%{public}s, Wrong argument count.", __func__);
+        return nullptr;
+    }
+    std::unique_ptr<ZlibEntriesCallbackInfo> entriesInfo = std::make_unique<ZlibEntriesCallbackInfo>();
+    entriesInfo->env = env;
+    if (UnwrapStringParam(entriesInfo->src, env, args[PARAM0]) == nullptr ||
+        UnwrapStringParam(entriesInfo->dest, env, args[PARAM1]) == nullptr ||
+        !UnwrapStringArrayParam(entriesInfo->entryNames, env, args[PARAM2]) ||
+        !UnwrapOptionsParams(entriesInfo->options, env, args[PARAM3], &entriesInfo->progress)) {
+        APP_LOGE("%{public}s, call unwrap param failed.", __func__);
+        return nullptr;
+    }
+    // the references are released by UnzipEntriesComplete once the work is queued
+    auto releaseReferences = [env, &entriesInfo]() {
+        ReleaseProgressCallback(env, entriesInfo->options, entriesInfo->progress);
+        if (entriesInfo->callback != nullptr) {
+            napi_delete_reference(env, entriesInfo->callback);
+            entriesInfo->callback = nullptr;
+        }
+    };
+    napi_value promise = nullptr;
+    napi_status status = napi_ok;
+    if (argc > argcPromise) {
+        if (!IsTypeForNapiValue(env, args[argcPromise], napi_function)) {
+            APP_LOGE("%{public}s, the last argument should be a function.", __func__);
+            releaseReferences();
+            return nullptr;
+        }
+        status = napi_create_reference(env, args[argcPromise], 1, &entriesInfo->callback);
+        if (status == napi_ok) {
+            status = napi_get_null(env, &promise);
+        }
+    } else {
+        status = napi_create_promise(env, &entriesInfo->deferred, &promise);
+    }
+
+    napi_value resourceName = nullptr;
+    if (status == napi_ok) {
+        status = napi_create_string_latin1(env, __func__, NAPI_AUTO_LENGTH, &resourceName);
+    }
+    if (status == napi_ok) {
+        status = napi_create_async_work(
+            env,
+            nullptr,
+            resourceName,
+            [](napi_env env, void *data) {
+                ZlibEntriesCallbackInfo *entriesInfo = static_cast<ZlibEntriesCallbackInfo *>(data);
+                entriesInfo->result = ExtractEntries(FilePath(entriesInfo->src), FilePath(entriesInfo->dest),
+                    entriesInfo->entryNames, entriesInfo->options);
+            },
+            UnzipEntriesComplete,
+            (void *)entriesInfo.get(),
+            &entriesInfo->asyncWork);
+    }
+    if (status != napi_ok) {
+        APP_LOGE("%{public}s, create async work failed.", __func__);
+        releaseReferences();
+        return nullptr;
+    }
+    if (napi_queue_async_work(env, entriesInfo->asyncWork) != napi_ok) {
+        APP_LOGE("%{public}s, queue async work failed.", __func__);
+        napi_delete_async_work(env, entriesInfo->asyncWork);
+        releaseReferences();
+        return nullptr;
+    }
+    entriesInfo.release();
+    return promise;
+}
+
+// Wraps |data| into an ArrayBuffer which takes over the native memory instead of copying it.
+napi_value CreateExternalArrayBuffer(napi_env env, std::unique_ptr<std::vector<uint8_t>> &data)
+{
+    napi_value result = nullptr;
+    if (data == nullptr || data->empty()) {
+        void *empty = nullptr;
+        NAPI_CALL(env, napi_create_arraybuffer(env, 0, &empty, &result));
+        return result;
+    }
+    std::vector<uint8_t> *buffer = data.get();
+    NAPI_CALL(env, napi_create_external_arraybuffer(env, buffer->data(), buffer->size(),
+        [](napi_env env, void *data, void *hint) {
+            delete static_cast<std::vector<uint8_t> *>(hint);
+        },
+        buffer, &result));
+    data.release();
+    return result;
+}
+
+bool UnwrapArrayBufferParam(napi_env env, napi_value arg, ZlibBufferCallbackInfo &bufferInfo)
+{
+    bool isArrayBuffer = false;
+    NAPI_CALL_BASE(env, napi_is_arraybuffer(env, arg, &isArrayBuffer), false);
+    if (!isArrayBuffer) {
+        APP_LOGE("%{public}s, the data should be an ArrayBuffer.", __func__);
+        return false;
+    }
+    void *data = nullptr;
+    size_t length = 0;
+    NAPI_CALL_BASE(env, napi_get_arraybuffer_info(env, arg, &data, &length), false);
+    bufferInfo.src = static_cast<const uint8_t *>(data);
+    bufferInfo.srcLen = length;
+    NAPI_CALL_BASE(env, napi_create_reference(env, arg, 1, &bufferInfo.srcRef), false);
+    return true;
+}
+
+void ZlibBufferComplete(napi_env env, napi_status status, void *data)
+{
+    APP_LOGI("ZlibBuffer, main event thread complete.");
+    ZlibBufferCallbackInfo *bufferInfo = static_cast<ZlibBufferCallbackInfo *>(data);
+    if (bufferInfo == nullptr) {
+        return;
+    }
+    napi_value result[ARGS_TWO] = {0};
+    if (bufferInfo->result == ERROR_CODE_OK) {
+        napi_get_null(env, &result[PARAM0]);
+        result[PARAM1] = CreateExternalArrayBuffer(env, bufferInfo->dest);
+    } else {
+        result[PARAM0] = GetCallbackErrorValue(env, bufferInfo->result);
+        napi_get_undefined(env, &result[PARAM1]);
+    }
+    if (bufferInfo->callback != nullptr) {
+        napi_value callback = nullptr;
+        napi_value undefined = nullptr;
+        napi_value jsResult = nullptr;
+        napi_get_reference_value(env, bufferInfo->callback, &callback);
+        napi_get_undefined(env, &undefined);
+        napi_call_function(env, undefined, callback, ARGS_TWO, &result[PARAM0], &jsResult);
+        napi_delete_reference(env, bufferInfo->callback);
+    } else if (bufferInfo->result == ERROR_CODE_OK) {
+        napi_resolve_deferred(env, bufferInfo->deferred, result[PARAM1]);
+    } else {
+        napi_reject_deferred(env, bufferInfo->deferred, result[PARAM0]);
+    }
+    if (bufferInfo->srcRef != nullptr) {
+        napi_delete_reference(env, bufferInfo->srcRef);
+    }
+    napi_delete_async_work(env, bufferInfo->asyncWork);
+    delete bufferInfo;
+}
+
+napi_value ZlibBufferWrap(napi_env env, napi_value *args, size_t argc, size_t callbackIndex,
+    std::unique_ptr<ZlibBufferCallbackInfo> &bufferInfo)
+{
+    if (!UnwrapArrayBufferParam(env, args[PARAM0], *bufferInfo)) {
+        return nullptr;
+    }
+    // the references are released by ZlibBufferComplete once the work is queued
+    auto releaseReferences = [env, &bufferInfo]() {
+        napi_delete_reference(env, bufferInfo->srcRef);
+        if (bufferInfo->callback != nullptr) {
+            napi_delete_reference(env, bufferInfo->callback);
+        }
+    };
+    napi_value promise = nullptr;
+    if (argc > callbackIndex) {
+        if (!IsTypeForNapiValue(env, args[callbackIndex], napi_function)) {
+            APP_LOGE("%{public}s, the last argument should be a function.", __func__);
+            releaseReferences();
+            return nullptr;
+        }
+        napi_create_reference(env, args[callbackIndex], 1, &bufferInfo->callback);
+        napi_get_null(env, &promise);
+    } else if (napi_create_promise(env, &bufferInfo->deferred, &promise) != napi_ok) {
+        releaseReferences();
+        return nullptr;
+    }
+
+    napi_value resourceName = nullptr;
+    napi_status status = napi_create_string_latin1(env, __func__, NAPI_AUTO_LENGTH, &resourceName);
+    if (status == napi_ok) {
+        status = napi_create_async_work(
+            env,
+            nullptr,
+            resourceName,
+            [](napi_env env, void *data) {
+                ZlibBufferCallbackInfo *bufferInfo = static_cast<ZlibBufferCallbackInfo *>(data);
+                bufferInfo->dest = std::make_unique<std::vector<uint8_t>>();
+                if (bufferInfo->compress) {
+                    bufferInfo->result =
+                        CompressBuffer(bufferInfo->src, bufferInfo->srcLen, bufferInfo->options, *bufferInfo->dest);
+                } else {
+                    bufferInfo->result = DecompressBuffer(bufferInfo->src, bufferInfo->srcLen, *bufferInfo->dest);
+                }
+            },
+            ZlibBufferComplete,
+            (void *)bufferInfo.get(),
+            &bufferInfo->asyncWork);
+    }
+    if (status != napi_ok) {
+        APP_LOGE("%{public}s, create async work failed.", __func__);
+        releaseReferences();
+        return nullptr;
+    }
+    if (napi_queue_async_work(env, bufferInfo->asyncWork) != napi_ok) {
+        APP_LOGE("%{public}s, queue async work failed.", __func__);
+        napi_delete_async_work(env, bufferInfo->asyncWork);
+        releaseReferences();
+        return nullptr;
+    }
+    bufferInfo.release();
+    return promise;
+}
+
+napi_value NAPI_CompressBuffer(napi_env env, napi_callback_info info)
+{
+    APP_LOGI("%{public}s,called", __func__);
+    napi_value args[ARGS_MAX_COUNT] = {nullptr};
+    size_t argc = ARGS_MAX_COUNT;
+    const size_t argcPromise = 2;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+    if (argc < argcPromise || argc > argcPromise + 1) {
+        APP_LOGE("%{public}s, Wrong argument count.", __func__);
+        return nullptr;
+    }
+    std::unique_ptr<ZlibBufferCallbackInfo> bufferInfo = std::make_unique<ZlibBufferCallbackInfo>();
+    bufferInfo->env = env;
+    bufferInfo->compress = true;
+    if (!UnwrapOptionsParams(bufferInfo->options, env, args[PARAM1])) {
+        APP_LOGE("%{public}s, args[1] error.", __func__);
+        return nullptr;
+    }
+    return ZlibBufferWrap(env, args, argc, PARAM2, bufferInfo);
+}
+
+napi_value NAPI_DecompressBuffer(napi_env env, napi_callback_info info)
+{
+    APP_LOGI("%{public}s,called", __func__);
+    napi_value args[ARGS_MAX_COUNT] = {nullptr};
+    size_t argc = ARGS_MAX_COUNT;
+    const size_t argcPromise = 1;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+    if (argc < argcPromise || argc > argcPromise + 1) {
+        APP_LOGE("%{public}s, Wrong argument count.", __func__);
+        return nullptr;
+    }
+    std::unique_ptr<ZlibBufferCallbackInfo> bufferInfo = std::make_unique<ZlibBufferCallbackInfo>();
+    bufferInfo->env = env;
+    bufferInfo->compress = false;
+    return ZlibBufferWrap(env, args, argc, PARAM1, bufferInfo);
+}
+
+napi_value NAPI_ZlibStreamWrite(napi_env env, napi_callback_info info)
+{
+    napi_value args[ARGS_TWO] = {nullptr};
+    size_t argc = ARGS_TWO;
+    napi_value thisArg = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, nullptr));
+    ZlibStream *stream = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisArg, reinterpret_cast<void **>(&stream)));
+    if (stream == nullptr || argc < ARGS_TWO) {
+        napi_throw_error(env, std::to_string(ERROR_CODE_STREAM_ERROR).c_str(), "invalid zlib stream call");
+        return nullptr;
+    }
+    bool isArrayBuffer = false;
+    NAPI_CALL(env, napi_is_arraybuffer(env, args[PARAM0], &isArrayBuffer));
+    if (!isArrayBuffer || !IsTypeForNapiValue(env, args[PARAM1], napi_boolean)) {
+        napi_throw_type_error(env, nullptr, "write(chunk: ArrayBuffer, finish: boolean) expected");
+        return nullptr;
+    }
+    void *data = nullptr;
+    size_t length = 0;
+    bool finish = false;
+    NAPI_CALL(env, napi_get_arraybuffer_info(env, args[PARAM0], &data, &length));
+    NAPI_CALL(env, napi_get_value_bool(env, args[PARAM1], &finish));
+
+    std::unique_ptr<std::vector<uint8_t>> output = std::make_unique<std::vector<uint8_t>>();
+    ErrorCode ret = stream->Write(static_cast<const uint8_t *>(data), length, finish,
+        [&output](const uint8_t *chunk, size_t size) {
+            output->insert(output->end(), chunk, chunk + size);
+            return true;
+        });
+    if (ret != ERROR_CODE_OK && ret != ERROR_CODE_STREAM_END) {
+        napi_throw_error(env, std::to_string(ret).c_str(), "zlib stream write failed");
+        return nullptr;
+    }
+    return CreateExternalArrayBuffer(env, output);
+}
+
+napi_value CreateZlibStreamObject(napi_env env, ZlibStream::Mode mode, const OPTIONS &options)
+{
+    std::unique_ptr<ZlibStream> stream = std::make_unique<ZlibStream>(mode, options);
+    if (stream->Init() != ERROR_CODE_OK) {
+        APP_LOGE("%{public}s, init zlib stream failed.", __func__);
+        return nullptr;
+    }
+    napi_value jsStream = nullptr;
+    NAPI_CALL(env, napi_create_object(env, &jsStream));
+    napi_property_descriptor properties[] = {
+        DECLARE_NAPI_FUNCTION("write", NAPI_ZlibStreamWrite),
+    };
+    NAPI_CALL(env, napi_define_properties(env, jsStream, sizeof(properties) / sizeof(properties[0]), properties));
+    NAPI_CALL(env, napi_wrap(env, jsStream, stream.get(),
+        [](napi_env env, void *data, void *hint) {
+            delete static_cast<ZlibStream *>(data);
+        },
+        nullptr, nullptr));
+    stream.release();
+    return jsStream;
+}
+
+napi_value NAPI_CreateDeflateStream(napi_env env, napi_callback_info info)
+{
+    APP_LOGI("%{public}s,called", __func__);
+    napi_value args[ARGS_TWO] = {nullptr};
+    size_t argc = ARGS_TWO;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+    OPTIONS options;
+    if (argc > 0 && IsTypeForNapiValue(env, args[PARAM0], napi_object) &&
+        !UnwrapOptionsParams(options, env, args[PARAM0])) {
+        APP_LOGE("%{public}s, args[0] error.", __func__);
+        return nullptr;
+    }
+    return CreateZlibStreamObject(env, ZlibStream::Mode::DEFLATE, options);
+}
+
+napi_value NAPI_CreateInflateStream(napi_env env, napi_callback_info info)
+{
+    APP_LOGI("%{public}s,called", __func__);
+    OPTIONS options;
+    return CreateZlibStreamObject(env, ZlibStream::Mode::INFLATE, options);
+}
+
+napi_value NAPI_TaskTokenCancel(napi_env env, napi_callback_info info)
+{
+    napi_value thisArg = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &thisArg, nullptr));
+    std::shared_ptr<ZipTaskToken> *token = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisArg, reinterpret_cast<void **>(&token)));
+    if (token != nullptr && *token != nullptr) {
+        (*token)->Cancel();
+    }
+    napi_value result = nullptr;
+    NAPI_CALL(env, napi_get_undefined(env, &result));
+    return result;
+}
+
+napi_value NAPI_TaskTokenGetStats(napi_env env, napi_callback_info info)
+{
+    napi_value thisArg = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &thisArg, nullptr));
+    std::shared_ptr<ZipTaskToken> *token = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisArg, reinterpret_cast<void **>(&token)));
+    if (token == nullptr || *token == nullptr) {
+        return nullptr;
+    }
+    napi_value stats = nullptr;
+    NAPI_CALL(env, napi_create_object(env, &stats));
+    const std::pair<const char *, double> values[] = {
+        {"processedBytes", static_cast<double>((*token)->GetProcessedBytes())},
+        {"totalBytes", static_cast<double>((*token)->GetTotalBytes())},
+        {"elapsedMs", static_cast<double>((*token)->GetElapsedMs())},
+        {"throughput", static_cast<double>((*token)->GetThroughput())},
+    };
+    for (const auto &value : values) {
+        napi_value jsValue = nullptr;
+        NAPI_CALL(env, napi_create_double(env, value.second, &jsValue));
+        NAPI_CALL(env, napi_set_named_property(env, stats, value.first, jsValue));
+    }
+    return stats;
+}
+
+napi_value NAPI_CreateTaskToken(napi_env env, napi_callback_info info)
+{
+    APP_LOGI("%{public}s,called", __func__);
+    napi_value jsToken = nullptr;
+    NAPI_CALL(env, napi_create_object(env, &jsToken));
+    napi_property_descriptor properties[] = {
+        DECLARE_NAPI_FUNCTION("cancel", NAPI_TaskTokenCancel),
+        DECLARE_NAPI_FUNCTION("getStats", NAPI_TaskTokenGetStats),
+    };
+    NAPI_CALL(env, napi_define_properties(env, jsToken, sizeof(properties) / sizeof(properties[0]), properties));
+    // the job keeps its own reference, so the token outlives a collected JS object
+    auto token = std::make_unique<std::shared_ptr<ZipTaskToken>>(std::make_shared<ZipTaskToken>());
+    NAPI_CALL(env, napi_wrap(env, jsToken, token.get(),
+        [](napi_env env, void *data, void *hint) {
+            delete static_cast<std::shared_ptr<ZipTaskToken> *>(data);
+        },
+        nullptr, nullptr));
+    token.release();
+    return jsToken;
+}
+
+bool UnwrapTaskToken(std::shared_ptr<ZipTaskToken> &token, napi_env env, napi_value arg)
+{
+    if (!IsTypeForNapiValue(env, arg, napi_object)) {
+        APP_LOGE("%{public}s, token is not an object.", __func__);
+        return false;
+    }
+    std::shared_ptr<ZipTaskToken> *wrapped = nullptr;
+    if (napi_unwrap(env, arg, reinterpret_cast<void **>(&wrapped)) != napi_ok || wrapped == nullptr) {
+        APP_LOGE("%{public}s, token is not created by createTaskToken.", __func__);
+        return false;
+    }
+    token = *wrapped;
+    return true;
+}
+
+void ZlibProgressInnerJsThread(uv_work_t *work)
+{
+    std::unique_ptr<uv_work_t> workPtr(work);
+    std::unique_ptr<ZlibProgressReport> report(static_cast<ZlibProgressReport *>(work->data));
+    if (report == nullptr || report->context == nullptr || report->context->released) {
+        return;
+    }
+    ZlibProgressContext &context = *report->context;
+    napi_handle_scope scope = nullptr;
+    napi_open_handle_scope(context.env, &scope);
+    napi_value args[ARGS_TWO] = {nullptr};
+    napi_create_double(context.env, static_cast<double>(report->processedBytes), &args[PARAM0]);
+    napi_create_double(context.env, static_cast<double>(report->totalBytes), &args[PARAM1]);
+    napi_value callback = nullptr;
+    napi_value undefined = nullptr;
+    napi_value jsResult = nullptr;
+    napi_get_reference_value(context.env, context.callback, &callback);
+    napi_get_undefined(context.env, &undefined);
+    napi_call_function(context.env, undefined, callback, ARGS_TWO, args, &jsResult);
+    napi_close_handle_scope(context.env, scope);
+    if (report->finished) {
+        napi_delete_reference(context.env, context.callback);
+        context.callback = nullptr;
+        context.released = true;
+    }
+}
+
+void PostProgressReport(const std::shared_ptr<ZlibProgressContext> &context, uint64_t processedBytes,
+    uint64_t totalBytes, bool finished)
+{
+    uv_loop_s *loop = nullptr;
+    napi_get_uv_event_loop(context->env, &loop);
+    if (loop == nullptr) {
+        return;
+    }
+    uv_work_t *work = new (std::nothrow) uv_work_t;
+    if (work == nullptr) {
+        return;
+    }
+    ZlibProgressReport *report = new (std::nothrow) ZlibProgressReport {
+        .context = context,
+        .processedBytes = processedBytes,
+        .totalBytes = totalBytes,
+        .finished = finished,
+    };
+    if (report == nullptr) {
+        delete work;
+        return;
+    }
+    work->data = static_cast<void *>(report);
+    int rev = uv_queue_work(
+        loop, work, [](uv_work_t *work) {}, [](uv_work_t *work, int status) { ZlibProgressInnerJsThread(work); });
+    if (rev != 0) {
+        delete report;
+        delete work;
+    }
+}
+
+bool SetProgressCallback(OPTIONS &options, napi_env env, napi_value jsCallback, uint64_t interval,
+    std::shared_ptr<ZlibProgressContext> *progress)
+{
+    if (options.token == nullptr) {
+        options.token = std::make_shared<ZipTaskToken>();
+    }
+    auto context = std::make_shared<ZlibProgressContext>();
+    context->env = env;
+    NAPI_CALL_BASE(env, napi_create_reference(env, jsCallback, 1, &context->callback), false);
+    options.token->SetProgressCallback(
+        [context](uint64_t processedBytes, uint64_t totalBytes, bool finished) {
+            PostProgressReport(context, processedBytes, totalBytes, finished);
+        },
+        interval);
+    if (progress != nullptr) {
+        *progress = context;
+    }
+    return true;
+}
+
+// Drops the progress callback of a call which failed before its work was queued, no report will come to do it.
+void ReleaseProgressCallback(napi_env env, OPTIONS &options, std::shared_ptr<ZlibProgressContext> &progress)
+{
+    if (progress == nullptr) {
+        return;
+    }
+    if (options.token != nullptr) {
+        options.token->SetProgressCallback(nullptr, 0);
+    }
+    if (!progress->released) {
+        napi_delete_reference(env, progress->callback);
+        progress->callback = nullptr;
+        progress->released = true;
+    }
+    progress.reset();
+}
+
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
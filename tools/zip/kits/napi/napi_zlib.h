@@ -155,6 +155,100 @@ napi_value NAPI_ZipFile(napi_env env, napi_callback_info info);
  */
 napi_value NAPI_UnzipFile(napi_env env, napi_callback_info info);
 
+/**
+ * @brief Zlib NAPI method : unzipEntries.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * NAPI_UnzipEntries interface supports promise and callback calls. Only the listed entries are
+ * extracted, located through the central directory instead of walking the archive.
+ *
+ * example
+ * var src ="/ziptest/hapresult/hapfourfile.zip";
+ * var dest ="/ziptest/hapunzipdir/01";
+ * var entries = ["resources/base/media/icon.png"];
+ * var option = {
+ *           parallel:2
+ *       };
+ */
+napi_value NAPI_UnzipEntries(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Zlib NAPI method : compressBuffer.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * NAPI_CompressBuffer interface supports promise and callback calls. The source ArrayBuffer is read
+ * in place and the compressed data is returned in a new ArrayBuffer owning the native buffer.
+ *
+ * example
+ * var data = new ArrayBuffer(1024);
+ * var option = {
+ *           level:-1,
+ *           memLevel:8,
+ *           strategy:0
+ *       };
+ * zlib.compressBuffer(data, option).then((compressed) => {});
+ */
+napi_value NAPI_CompressBuffer(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Zlib NAPI method : decompressBuffer.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * NAPI_DecompressBuffer interface supports promise and callback calls, zlib and gzip data are accepted.
+ * The decompressed data is limited to kMaxDecompressedSize bytes.
+ */
+napi_value NAPI_DecompressBuffer(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Zlib NAPI method : createDeflateStream and createInflateStream.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * The returned object has a write(chunk: ArrayBuffer, finish: boolean): ArrayBuffer method which
+ * returns the output produced for that chunk.
+ *
+ * example
+ * var stream = zlib.createDeflateStream({level:1});
+ * var part1 = stream.write(chunk1, false);
+ * var part2 = stream.write(chunk2, true);
+ */
+napi_value NAPI_CreateDeflateStream(napi_env env, napi_callback_info info);
+napi_value NAPI_CreateInflateStream(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Zlib NAPI method : createTaskToken.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * The returned token is passed in the options of zipFile, unzipFile or unzipEntries. It has a cancel()
+ * method which stops the job between chunks, and a getStats() method which returns
+ * {processedBytes, totalBytes, elapsedMs, throughput}.
+ *
+ * example
+ * var token = zlib.createTaskToken();
+ * zlib.unzipFile(inFile, outFile, {token: token, onProgress: (processed, total) => {}});
+ * token.cancel();
+ */
+napi_value NAPI_CreateTaskToken(napi_env env, napi_callback_info info);
+
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
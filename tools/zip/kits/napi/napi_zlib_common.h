@@ -16,6 +16,7 @@
 #define OHOS_APPEXECFWK_LIBZIP_COMMON_H
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "napi/native_api.h"
 #include "napi/native_common.h"
@@ -32,10 +33,20 @@ namespace LIBZIP {
         }                                    \
     } while (0)
 
+// Forwards the progress of a zip or unzip job to a JS function, reports are delivered on the JS thread.
+struct ZlibProgressContext {
+    napi_env env = nullptr;
+    napi_ref callback = nullptr;
+    // set on the JS thread once the final report has been delivered and the callback released
+    bool released = false;
+};
+
 struct CallZipUnzipParam {
     std::string src;
     std::string dest;
     OPTIONS options;
+    // the progress callback bound by the options, released here if the job is never posted
+    std::shared_ptr<ZlibProgressContext> progress;
 };
 
 struct ZlibCallbackInfo {
@@ -50,7 +61,46 @@ struct ZlibCallbackInfo {
 struct AsyncZipCallbackInfo {
     napi_async_work asyncWork;
     std::shared_ptr<ZlibCallbackInfo> aceCallback;
+    // the job reached the task runner, which releases the progress callback when it finishes
+    bool posted = false;
+};
+struct ZlibBufferCallbackInfo {
+    napi_env env = nullptr;
+    napi_async_work asyncWork = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref callback = nullptr;
+    // keeps the source ArrayBuffer alive while the worker thread reads it in place
+    napi_ref srcRef = nullptr;
+    const uint8_t *src = nullptr;
+    size_t srcLen = 0;
+    bool compress = true;
+    OPTIONS options;
+    // handed over to the result ArrayBuffer without copying
+    std::unique_ptr<std::vector<uint8_t>> dest;
+    int result = 0;
+};
+
+struct ZlibEntriesCallbackInfo {
+    napi_env env = nullptr;
+    napi_async_work asyncWork = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref callback = nullptr;
+    std::string src;
+    std::string dest;
+    std::vector<std::string> entryNames;
+    OPTIONS options;
+    // the progress callback bound by the options, released here if the call fails before the work is queued
+    std::shared_ptr<ZlibProgressContext> progress;
+    bool result = false;
 };
+
+struct ZlibProgressReport {
+    std::shared_ptr<ZlibProgressContext> context;
+    uint64_t processedBytes = 0;
+    uint64_t totalBytes = 0;
+    bool finished = false;
+};
+
 bool UnwrapIntValue(napi_env env, napi_value jsValue, int &result);
 bool IsTypeForNapiValue(napi_env env, napi_value param, napi_valuetype expectType);
 std::string UnwrapStringFromJS(napi_env env, napi_value param, const std::string &defaultValue);
@@ -14,10 +14,14 @@
  */
 #include "zip.h"
 
+#include <algorithm>
+#include <atomic>
 #include <fcntl.h>
+#include <limits>
 #include <list>
 #include <stdio.h>
 #include <string>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <vector>
 
@@ -43,6 +47,8 @@ const std::string SEPARATOR = "/";
 const char HIDDEN_SEPARATOR = '.';
 const std::string ZIP = ".zip";
 const std::int32_t ZIP_SIZE = 4;
+// Initial guess of the inflated size relative to the compressed size.
+const size_t INFLATE_SIZE_RATIO = 4;
 
 #define CALLING_CALL_BACK(callback, result) \
     if (callback != nullptr) {              \
@@ -60,6 +66,15 @@ struct UnzipParam {
     CALLBACK callback = nullptr;
     FilterCallback filterCB = nullptr;
     bool logSkippedFiles = false;
+    // Entries are extracted on |parallel| threads, each reading |srcFile| with its own reader.
+    int parallel = 1;
+    FilePath srcFile;
+    std::shared_ptr<ZipTaskToken> token = nullptr;
+};
+
+struct PendingEntry {
+    unz_file_pos position = {};
+    FilePath entryPath;
 };
 bool IsHiddenFile(const FilePath &filePath)
 {
@@ -120,6 +135,69 @@ std::unique_ptr<WriterDelegate> CreateFilePathWriterDelegate(FilePath &extractDi
         return std::make_unique<FilePathWriterDelegate>(FilePath(extractDir.Value() + "/" + entryPath.Value()));
     }
 }
+
+// Extracts |pendingEntries| on up to |parallel| threads. Every thread opens its own reader on
+// |srcFile| because a minizip handle can not be shared between threads.
+bool ExtractEntriesInParallel(const FilePath &srcFile, FilePath &destDir, WriterFactory writerFactory,
+    std::vector<PendingEntry> &pendingEntries, int parallel, const std::shared_ptr<ZipTaskToken> &token)
+{
+    size_t sliceCount = std::min(pendingEntries.size(), static_cast<size_t>(std::max(parallel, 1)));
+    std::atomic<bool> success(true);
+    RunParallelTasks(sliceCount, parallel, [&](size_t slice) {
+        ZipReader reader;
+        FilePath zipFilePath = srcFile;
+        if (!reader.Open(zipFilePath)) {
+            success = false;
+            return;
+        }
+        reader.SetTaskToken(token);
+        for (size_t i = slice; i < pendingEntries.size() && success; i += sliceCount) {
+            std::unique_ptr<WriterDelegate> writer = writerFactory(destDir, pendingEntries[i].entryPath);
+            if (!reader.LocateEntry(pendingEntries[i].position) ||
+                !reader.ExtractCurrentEntry(writer.get(), std::numeric_limits<uint64_t>::max())) {
+                APP_LOGI("%{public}s called, Failed to extract.", __func__);
+                success = false;
+            }
+        }
+    });
+    return success;
+}
+
+// Finishes the job of |token| when leaving the scope, so a failed or canceled job still sends its
+// final progress report.
+struct TaskTokenFinisher {
+    explicit TaskTokenFinisher(const std::shared_ptr<ZipTaskToken> &token) : token(token)
+    {
+        if (token != nullptr) {
+            token->Start();
+        }
+    }
+    ~TaskTokenFinisher()
+    {
+        if (token != nullptr) {
+            token->Finish();
+        }
+    }
+    std::shared_ptr<ZipTaskToken> token;
+};
+
+// Sums up the sizes of the files which will be added, so that progress can be reported against it.
+uint64_t GetTotalFileSize(const FilePath &rootDir, const std::vector<FilePath> &relativePaths)
+{
+    uint64_t totalSize = 0;
+    bool rootIsDir = FilePath::IsDir(rootDir);
+    for (auto relativePath : relativePaths) {
+        FilePath absolutePath = rootDir;
+        if (rootIsDir) {
+            absolutePath = absolutePath.Append(relativePath);
+        }
+        struct stat fileStat = {};
+        if (stat(absolutePath.Value().c_str(), &fileStat) == 0 && S_ISREG(fileStat.st_mode)) {
+            totalSize += static_cast<uint64_t>(fileStat.st_size);
+        }
+    }
+    return totalSize;
+}
 }  // namespace
 
 ZipParams::ZipParams(const FilePath &srcDir, const FilePath &destFile) : srcDir_(srcDir), destFile_(destFile)
@@ -185,6 +263,9 @@ bool Zip(const ZipParams &params, const OPTIONS &options, CALLBACK callback)
         ZIP_WRITER_IS_NULL(zipWriter, "!!! ZipWriter::Create ReturnValue is Null !!!",
             callback, ERROR_CODE_ERRNO);
     }
+    if (options.token != nullptr) {
+        options.token->SetTotalBytes(GetTotalFileSize(paramPath, *filesToAdd));
+    }
     return zipWriter->WriteEntries(*filesToAdd, options, callback);
 }
 
@@ -198,6 +279,13 @@ bool UnzipWithFilterAndWriters(const PlatformFile &srcFile, FilePath &destDir, W
         APP_LOGI("%{public}s called, Failed to open srcFile.", __func__);
         return false;
     }
+    if (unzipParam.token != nullptr) {
+        reader.SetTaskToken(unzipParam.token);
+        if (reader.BuildEntryIndex()) {
+            unzipParam.token->SetTotalBytes(reader.GetTotalOriginalSize());
+        }
+    }
+    std::vector<PendingEntry> pendingEntries;
     while (reader.HasMore()) {
         if (!reader.OpenCurrentEntryInZip()) {
             CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
@@ -220,10 +308,19 @@ bool UnzipWithFilterAndWriters(const PlatformFile &srcFile, FilePath &destDir, W
                     return false;
                 }
 
+            } else if (unzipParam.parallel > 1) {
+                PendingEntry pendingEntry;
+                pendingEntry.entryPath = entryPath;
+                if (!reader.GetCurrentEntryPos(pendingEntry.position)) {
+                    CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+                    APP_LOGI("%{public}s called, Failed to get the entry position.", __func__);
+                    return false;
+                }
+                pendingEntries.push_back(pendingEntry);
             } else {
                 std::unique_ptr<WriterDelegate> writer = writerFactory(destDir, entryPath);
                 if (!reader.ExtractCurrentEntry(writer.get(), std::numeric_limits<uint64_t>::max())) {
-                    CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+                    CALLING_CALL_BACK(unzipParam.callback, GetFailedErrorCode(unzipParam.token))
                     APP_LOGI("%{public}s called, Failed to extract.", __func__);
                     return false;
                 }
@@ -238,6 +335,14 @@ bool UnzipWithFilterAndWriters(const PlatformFile &srcFile, FilePath &destDir, W
             return false;
         }
     }
+    if (!pendingEntries.empty() && !ExtractEntriesInParallel(unzipParam.srcFile, destDir, writerFactory,
+        pendingEntries, unzipParam.parallel, unzipParam.token)) {
+        CALLING_CALL_BACK(unzipParam.callback, GetFailedErrorCode(unzipParam.token))
+        return false;
+    }
+    if (unzipParam.token != nullptr) {
+        unzipParam.token->Finish();
+    }
     CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_OK)
     return true;
 }
@@ -321,12 +426,19 @@ bool Unzip(const FilePath &srcFile, const FilePath &destDir, const OPTIONS &opti
         UnzipParam unzipParam {
             .callback = callback,
             .filterCB = ExcludeNoFilesFilter,
-            .logSkippedFiles = true
+            .logSkippedFiles = true,
+            .parallel = options.parallel,
+            .srcFile = srcFile,
+            .token = options.token
         };
+        TaskTokenFinisher finisher(options.token);
         UnzipWithFilterCallback(srcFile, destDir, options, unzipParam);
     };
 
-    PostTask(innerTask);
+    if (!PostTask(innerTask, options.concurrency)) {
+        CALLING_CALL_BACK(callback, ERROR_CODE_ERRNO)
+        return false;
+    }
     return true;
 }
 
@@ -380,8 +492,8 @@ bool Zip(const FilePath &srcDir, const FilePath &destFile, const OPTIONS &option
         return false;
     }
     
-    auto innerTask = [srcDir, destFile, includeHiddenFiles, callback]() {
-        OPTIONS options;
+    auto innerTask = [srcDir, destFile, options, includeHiddenFiles, callback]() {
+        TaskTokenFinisher finisher(options.token);
         if (includeHiddenFiles) {
             ZipWithFilterCallback(srcDir, destFile, options, callback, ExcludeNoFilesFilter);
         } else {
@@ -389,9 +501,165 @@ bool Zip(const FilePath &srcDir, const FilePath &destFile, const OPTIONS &option
         }
     };
 
-    PostTask(innerTask);
+    if (!PostTask(innerTask, options.concurrency)) {
+        CALLING_CALL_BACK(callback, ERROR_CODE_ERRNO)
+        return false;
+    }
+    return true;
+}
+bool ExtractEntries(const FilePath &srcFile, const FilePath &destDir, const std::vector<std::string> &entryNames,
+    const OPTIONS &options)
+{
+    TaskTokenFinisher finisher(options.token);
+    FilePath src = srcFile;
+    FilePath dest = destDir;
+    if (!FilePathCheckValid(src.Value()) || !FilePath::PathIsValid(srcFile)) {
+        APP_LOGI("%{public}s called, srcFile is invalid.", __func__);
+        return false;
+    }
+    if (!FilePath::DirectoryExists(destDir)) {
+        APP_LOGI("%{public}s called fail, destDir isn't path.", __func__);
+        return false;
+    }
+    ZipReader reader;
+    if (!reader.Open(src) || !reader.BuildEntryIndex()) {
+        APP_LOGI("%{public}s called, Failed to read the central directory.", __func__);
+        return false;
+    }
+    std::vector<PendingEntry> pendingEntries;
+    uint64_t totalSize = 0;
+    for (const auto &entryName : entryNames) {
+        if (!reader.LocateEntryByName(entryName)) {
+            APP_LOGI("%{public}s called, entry %{private}s not found.", __func__, entryName.c_str());
+            return false;
+        }
+        ZipReader::EntryInfo *entryInfo = reader.CurrentEntryInfo();
+        if (entryInfo == nullptr || entryInfo->IsUnsafe()) {
+            APP_LOGI("%{public}s called, Found an unsafe file in zip.", __func__);
+            return false;
+        }
+        FilePath entryPath = entryInfo->GetFilePath();
+        if (entryInfo->IsDirectory()) {
+            if (!CreateDirectory(dest, entryPath)) {
+                APP_LOGI("!!!directory_creator(%{private}s) Failed!!!.", entryPath.Value().c_str());
+                return false;
+            }
+            continue;
+        }
+        PendingEntry pendingEntry;
+        pendingEntry.entryPath = entryPath;
+        if (!reader.GetCurrentEntryPos(pendingEntry.position)) {
+            return false;
+        }
+        pendingEntries.push_back(pendingEntry);
+        totalSize += static_cast<uint64_t>(entryInfo->GetOriginalSize());
+    }
+    reader.Close();
+    if (options.token != nullptr) {
+        options.token->SetTotalBytes(totalSize);
+    }
+    if (pendingEntries.empty()) {
+        return true;
+    }
+    return ExtractEntriesInParallel(srcFile, dest,
+        std::bind(&CreateFilePathWriterDelegate, std::placeholders::_1, std::placeholders::_2),
+        pendingEntries, options.parallel, options.token);
+}
+
+bool UnzipEntries(const FilePath &srcFile, const FilePath &destDir, const std::vector<std::string> &entryNames,
+    const OPTIONS &options, CALLBACK callback)
+{
+    auto innerTask = [srcFile, destDir, entryNames, options, callback]() {
+        bool ret = ExtractEntries(srcFile, destDir, entryNames, options);
+        CALLING_CALL_BACK(callback, ret ? ERROR_CODE_OK : GetFailedErrorCode(options.token))
+    };
+
+    if (!PostTask(innerTask, options.concurrency)) {
+        CALLING_CALL_BACK(callback, ERROR_CODE_ERRNO)
+        return false;
+    }
     return true;
 }
+
+ErrorCode CompressBuffer(const uint8_t *src, size_t srcLen, const OPTIONS &options, std::vector<uint8_t> &dest)
+{
+    if ((src == nullptr && srcLen > 0) || srcLen > std::numeric_limits<uInt>::max()) {
+        APP_LOGE("%{public}s called, invalid source buffer", __func__);
+        return ERROR_CODE_BUF_ERROR;
+    }
+    z_stream stream = {};
+    int ret = deflateInit2(&stream, static_cast<int>(options.level), Z_DEFLATED, MAX_WBITS,
+        static_cast<int>(options.memLevel), static_cast<int>(options.strategy));
+    if (ret != Z_OK) {
+        APP_LOGE("%{public}s called, deflateInit2 failed, ret = %{public}d", __func__, ret);
+        return static_cast<ErrorCode>(ret);
+    }
+    dest.resize(deflateBound(&stream, srcLen));
+    stream.next_in = const_cast<Bytef *>(src);
+    stream.avail_in = static_cast<uInt>(srcLen);
+    stream.next_out = dest.data();
+    stream.avail_out = static_cast<uInt>(dest.size());
+    ret = deflate(&stream, Z_FINISH);
+    dest.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (ret != Z_STREAM_END) {
+        APP_LOGE("%{public}s called, deflate failed, ret = %{public}d", __func__, ret);
+        dest.clear();
+        return ret == Z_OK ? ERROR_CODE_BUF_ERROR : static_cast<ErrorCode>(ret);
+    }
+    return ERROR_CODE_OK;
+}
+
+ErrorCode DecompressBuffer(const uint8_t *src, size_t srcLen, std::vector<uint8_t> &dest, size_t maxSize)
+{
+    if (src == nullptr || srcLen == 0 || srcLen > std::numeric_limits<uInt>::max() || maxSize == 0) {
+        APP_LOGE("%{public}s called, invalid source buffer", __func__);
+        return ERROR_CODE_BUF_ERROR;
+    }
+    z_stream stream = {};
+    // accept both zlib and gzip headers
+    int ret = inflateInit2(&stream, MAX_WBITS + 32);
+    if (ret != Z_OK) {
+        APP_LOGE("%{public}s called, inflateInit2 failed, ret = %{public}d", __func__, ret);
+        return static_cast<ErrorCode>(ret);
+    }
+    dest.resize(std::min(std::max(srcLen * INFLATE_SIZE_RATIO, static_cast<size_t>(kZipBufSize)), maxSize));
+    stream.next_in = const_cast<Bytef *>(src);
+    stream.avail_in = static_cast<uInt>(srcLen);
+    while (true) {
+        if (stream.total_out == dest.size()) {
+            if (dest.size() >= maxSize) {
+                APP_LOGE("%{public}s called, the data inflates to more than %{public}zu bytes", __func__, maxSize);
+                ret = Z_MEM_ERROR;
+                break;
+            }
+            dest.resize(std::min(dest.size() * 2, maxSize));
+        }
+        stream.next_out = dest.data() + stream.total_out;
+        stream.avail_out = static_cast<uInt>(
+            std::min<size_t>(dest.size() - stream.total_out, std::numeric_limits<uInt>::max()));
+        ret = inflate(&stream, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            break;
+        }
+        if (ret != Z_OK && !(ret == Z_BUF_ERROR && stream.avail_out == 0)) {
+            break;
+        }
+        if (stream.avail_in == 0 && stream.avail_out != 0) {
+            // the input ended before the compressed stream did
+            ret = Z_BUF_ERROR;
+            break;
+        }
+    }
+    dest.resize(stream.total_out);
+    inflateEnd(&stream);
+    if (ret != Z_STREAM_END) {
+        APP_LOGE("%{public}s called, inflate failed, ret = %{public}d", __func__, ret);
+        dest.clear();
+        return static_cast<ErrorCode>(ret == Z_NEED_DICT ? Z_DATA_ERROR : ret);
+    }
+    return ERROR_CODE_OK;
+}
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -154,6 +154,68 @@ bool ZipReader::AdvanceToNextEntry()
     return true;
 }
 
+bool ZipReader::GetCurrentEntryPos(unz_file_pos &position) const
+{
+    if (zipFile_ == nullptr) {
+        return false;
+    }
+    return unzGetFilePos(zipFile_, &position) == UNZ_OK;
+}
+
+bool ZipReader::LocateEntry(const unz_file_pos &position)
+{
+    if (zipFile_ == nullptr) {
+        return false;
+    }
+    unz_file_pos targetPos = position;
+    if (unzGoToFilePos(zipFile_, &targetPos) != UNZ_OK) {
+        return false;
+    }
+    reachedEnd_ = false;
+    currentEntryInfo_.reset();
+    return OpenCurrentEntryInZip();
+}
+
+bool ZipReader::BuildEntryIndex()
+{
+    if (zipFile_ == nullptr) {
+        return false;
+    }
+    entryIndex_.clear();
+    totalOriginalSize_ = 0;
+    if (numEntries_ == 0) {
+        return true;
+    }
+    entryIndex_.reserve(numEntries_);
+    char rawFileNameInZip[kZipMaxPath] = {};
+    int result = unzGoToFirstFile(zipFile_);
+    while (result == UNZ_OK) {
+        unz_file_pos position = {};
+        unz_file_info rawFileInfo = {};
+        if (unzGetCurrentFileInfo(zipFile_, &rawFileInfo, rawFileNameInZip, sizeof(rawFileNameInZip) - 1,
+            NULL, 0, NULL, 0) != UNZ_OK || unzGetFilePos(zipFile_, &position) != UNZ_OK) {
+            entryIndex_.clear();
+            return false;
+        }
+        entryIndex_.emplace(std::string(rawFileNameInZip), position);
+        totalOriginalSize_ += rawFileInfo.uncompressed_size;
+        result = unzGoToNextFile(zipFile_);
+    }
+    // Rewind so that sequential reading keeps working after indexing.
+    reachedEnd_ = false;
+    currentEntryInfo_.reset();
+    return result == UNZ_END_OF_LIST_OF_FILE && unzGoToFirstFile(zipFile_) == UNZ_OK;
+}
+
+bool ZipReader::LocateEntryByName(const std::string &entryName)
+{
+    auto iter = entryIndex_.find(entryName);
+    if (iter == entryIndex_.end()) {
+        return false;
+    }
+    return LocateEntry(iter->second);
+}
+
 bool ZipReader::OpenCurrentEntryInZip()
 {
     if (zipFile_ == nullptr) {
@@ -211,6 +273,10 @@ bool ZipReader::ExtractCurrentEntry(WriterDelegate *delegate, uint64_t numBytesT
             if (!delegate->WriteBytes(buf.get(), numBytesToWrite)) {
                 break;
             }
+            if (token_ != nullptr && !token_->AddProcessedBytes(numBytesToWrite)) {
+                APP_LOGI("%{public}s called, unzip task canceled", __func__);
+                break;
+            }
             if (remainingCapacity == checked_cast<uint64_t>(numBytesRead)) {
                 // Ensures function returns true if the entire file has been read.
                 entirefileextracted = (unzReadCurrentFile(zipFile_, buf.get(), 1) == 0);
@@ -254,6 +320,8 @@ void ZipReader::Reset()
     numEntries_ = 0;
     reachedEnd_ = false;
     currentEntryInfo_.reset();
+    entryIndex_.clear();
+    totalOriginalSize_ = 0;
 }
 
 // FilePathWriterDelegate
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "zip_stream.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "app_log_wrapper.h"
+#include "zip_internal.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace LIBZIP {
+namespace {
+// Accept both zlib and gzip headers when inflating.
+constexpr int AUTO_DETECT_WINDOW_BITS = MAX_WBITS + 32;
+
+bool IsFatalZlibError(int ret)
+{
+    return ret == Z_STREAM_ERROR || ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR;
+}
+}  // namespace
+
+ZlibStream::ZlibStream(Mode mode, const OPTIONS &options) : mode_(mode), options_(options), stream_()
+{}
+
+ZlibStream::~ZlibStream()
+{
+    if (!initialized_) {
+        return;
+    }
+    if (mode_ == Mode::DEFLATE) {
+        deflateEnd(&stream_);
+    } else {
+        inflateEnd(&stream_);
+    }
+}
+
+ErrorCode ZlibStream::Init()
+{
+    if (initialized_) {
+        return ERROR_CODE_STREAM_ERROR;
+    }
+    int ret = Z_OK;
+    if (mode_ == Mode::DEFLATE) {
+        ret = deflateInit2(&stream_, static_cast<int>(options_.level), Z_DEFLATED, MAX_WBITS,
+            static_cast<int>(options_.memLevel), static_cast<int>(options_.strategy));
+    } else {
+        ret = inflateInit2(&stream_, AUTO_DETECT_WINDOW_BITS);
+    }
+    if (ret != Z_OK) {
+        APP_LOGE("%{public}s called, init zlib stream failed, ret = %{public}d", __func__, ret);
+        return static_cast<ErrorCode>(ret);
+    }
+    chunk_.resize(std::max(options_.chunkSize, kZipBufSize));
+    initialized_ = true;
+    return ERROR_CODE_OK;
+}
+
+ErrorCode ZlibStream::Write(const uint8_t *data, size_t size, bool finish, const Sink &sink)
+{
+    if (!initialized_ || finished_ || (data == nullptr && size > 0)) {
+        return ERROR_CODE_STREAM_ERROR;
+    }
+    stream_.next_in = const_cast<Bytef *>(data);
+    size_t remaining = size;
+    int ret = Z_OK;
+    do {
+        // avail_in is only 32 bits wide, so huge inputs are fed in several pieces
+        uInt piece = static_cast<uInt>(std::min<size_t>(remaining, std::numeric_limits<uInt>::max()));
+        stream_.avail_in = piece;
+        remaining -= piece;
+        int flush = (mode_ == Mode::DEFLATE && finish && remaining == 0) ? Z_FINISH : Z_NO_FLUSH;
+        do {
+            stream_.next_out = chunk_.data();
+            stream_.avail_out = chunk_.size();
+            ret = (mode_ == Mode::DEFLATE) ? deflate(&stream_, flush) : inflate(&stream_, flush);
+            if (IsFatalZlibError(ret)) {
+                APP_LOGE("%{public}s called, zlib stream failed, ret = %{public}d", __func__, ret);
+                finished_ = true;
+                return static_cast<ErrorCode>(ret == Z_NEED_DICT ? Z_DATA_ERROR : ret);
+            }
+            size_t produced = chunk_.size() - stream_.avail_out;
+            if (produced > 0 && sink != nullptr && !sink(chunk_.data(), produced)) {
+                finished_ = true;
+                return ERROR_CODE_ERRNO;
+            }
+        } while (ret != Z_STREAM_END && stream_.avail_out == 0);
+    } while (remaining > 0 && ret != Z_STREAM_END);
+
+    if (ret == Z_STREAM_END) {
+        finished_ = true;
+        return mode_ == Mode::DEFLATE ? ERROR_CODE_OK : ERROR_CODE_STREAM_END;
+    }
+    if (finish) {
+        // the input ended before the compressed stream did
+        finished_ = true;
+        return ERROR_CODE_BUF_ERROR;
+    }
+    return ERROR_CODE_OK;
+}
+}  // namespace LIBZIP
+}  // namespace AppExecFwk
+}  // namespace OHOS
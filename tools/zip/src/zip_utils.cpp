@@ -14,9 +14,15 @@
  */
 #include "zip_utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <regex>
+#include <vector>
 
+#include "app_log_wrapper.h"
 #include "event_handler.h"
+#include "parallel_task_util.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -24,20 +30,170 @@ namespace LIBZIP {
 namespace {
 const std::string SEPARATOR = "/";
 const std::regex FILE_PATH_REGEX("([0-9A-Za-z/+_=\\-,.])+");
+constexpr int DEFAULT_TASK_CONCURRENCY = 2;
+constexpr uint64_t DEFAULT_PROGRESS_INTERVAL = 1024 * 1024;
+constexpr int64_t MS_PER_SECOND = 1000;
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct TaskRunner {
+    std::shared_ptr<EventHandler> handler;
+    std::shared_ptr<std::atomic<uint32_t>> pendingCount;
+};
 }  // namespace
 using namespace OHOS::AppExecFwk;
 
-std::shared_ptr<EventHandler> g_handler = nullptr;
-void PostTask(const InnerEvent::Callback &callback)
+std::mutex g_taskRunnersMutex;
+std::vector<TaskRunner> g_taskRunners;
+
+// Only the first |concurrency| runners are used by the task. Picks an idle one first, creates a new
+// one while fewer exist, and otherwise queues the task on the least loaded one.
+bool PostTask(const InnerEvent::Callback &callback, int concurrency)
 {
-    if (g_handler == nullptr) {
+    size_t limit = static_cast<size_t>(
+        concurrency > 0 ? std::clamp(concurrency, 1, kMaxZipParallel) : DEFAULT_TASK_CONCURRENCY);
+    std::lock_guard<std::mutex> lock(g_taskRunnersMutex);
+    size_t usable = std::min(g_taskRunners.size(), limit);
+    TaskRunner *selected = nullptr;
+    for (size_t i = 0; i < usable; ++i) {
+        if (selected == nullptr || g_taskRunners[i].pendingCount->load() < selected->pendingCount->load()) {
+            selected = &g_taskRunners[i];
+        }
+    }
+    if ((selected == nullptr || selected->pendingCount->load() > 0) &&
+        usable == g_taskRunners.size() && usable < limit) {
         auto runner = EventRunner::Create(true);
-        g_handler = std::make_shared<EventHandler>(runner);
+        if (runner != nullptr) {
+            TaskRunner taskRunner;
+            taskRunner.handler = std::make_shared<EventHandler>(runner);
+            taskRunner.pendingCount = std::make_shared<std::atomic<uint32_t>>(0);
+            g_taskRunners.push_back(taskRunner);
+            selected = &g_taskRunners.back();
+        }
+    }
+    if (selected == nullptr || selected->handler == nullptr) {
+        APP_LOGE("%{public}s called, no task runner is available", __func__);
+        return false;
+    }
+
+    auto pendingCount = selected->pendingCount;
+    pendingCount->fetch_add(1);
+    auto task = [callback, pendingCount]() {
+        callback();
+        pendingCount->fetch_sub(1);
+    };
+    if (!selected->handler->PostTask(task)) {
+        APP_LOGE("%{public}s called, post task failed", __func__);
+        pendingCount->fetch_sub(1);
+        return false;
+    }
+    return true;
+}
+
+void RunParallelTasks(size_t count, int parallel, const std::function<void(size_t)> &task)
+{
+    ParallelTaskUtil::Run(count, static_cast<size_t>(std::clamp(parallel, 1, kMaxZipParallel)), task);
+}
+
+void ZipTaskToken::SetProgressCallback(const ProgressCallback &callback, uint64_t interval)
+{
+    progressCallback_ = callback;
+    progressInterval_ = interval > 0 ? interval : DEFAULT_PROGRESS_INTERVAL;
+    nextReportBytes_ = progressInterval_;
+}
+
+void ZipTaskToken::Cancel()
+{
+    canceled_ = true;
+}
+
+bool ZipTaskToken::IsCanceled() const
+{
+    return canceled_;
+}
+
+void ZipTaskToken::Start()
+{
+    processedBytes_ = 0;
+    nextReportBytes_ = progressInterval_;
+    finished_ = false;
+    endTime_ = 0;
+    startTime_ = GetSteadyTimeMs();
+}
+
+void ZipTaskToken::SetTotalBytes(uint64_t totalBytes)
+{
+    totalBytes_ = totalBytes;
+}
+
+bool ZipTaskToken::AddProcessedBytes(uint64_t bytes)
+{
+    uint64_t processed = processedBytes_.fetch_add(bytes) + bytes;
+    if (progressCallback_ != nullptr) {
+        // only the thread which moves the threshold reports, so workers never report twice
+        uint64_t next = nextReportBytes_.load();
+        while (processed >= next) {
+            if (nextReportBytes_.compare_exchange_weak(next, processed + progressInterval_)) {
+                ReportProgress(false);
+                break;
+            }
+        }
+    }
+    return !canceled_;
+}
+
+void ZipTaskToken::Finish()
+{
+    if (finished_.exchange(true)) {
+        return;
+    }
+    endTime_ = GetSteadyTimeMs();
+    if (progressCallback_ != nullptr) {
+        ReportProgress(true);
+    }
+}
+
+void ZipTaskToken::ReportProgress(bool finished)
+{
+    progressCallback_(processedBytes_.load(), totalBytes_.load(), finished);
+}
+
+uint64_t ZipTaskToken::GetProcessedBytes() const
+{
+    return processedBytes_;
+}
+
+uint64_t ZipTaskToken::GetTotalBytes() const
+{
+    return totalBytes_;
+}
+
+int64_t ZipTaskToken::GetElapsedMs() const
+{
+    int64_t startTime = startTime_;
+    if (startTime == 0) {
+        return 0;
     }
+    int64_t endTime = endTime_;
+    return (endTime != 0 ? endTime : GetSteadyTimeMs()) - startTime;
+}
 
-    if (g_handler != nullptr) {
-        g_handler->PostTask(callback);
+uint64_t ZipTaskToken::GetThroughput() const
+{
+    int64_t elapsedMs = GetElapsedMs();
+    if (elapsedMs <= 0) {
+        return 0;
     }
+    return processedBytes_.load() * MS_PER_SECOND / static_cast<uint64_t>(elapsedMs);
+}
+
+ErrorCode GetFailedErrorCode(const std::shared_ptr<ZipTaskToken> &token)
+{
+    return (token != nullptr && token->IsCanceled()) ? ERROR_CODE_CANCELED : ERROR_CODE_ERRNO;
 }
 
 struct tm *GetCurrentSystemTime(void)
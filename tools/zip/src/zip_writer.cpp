@@ -16,6 +16,7 @@
 #include "zip_writer.h"
 
 #include <stdio.h>
+#include <sys/stat.h>
 
 #include "app_log_wrapper.h"
 #include "contrib/minizip/zip.h"
@@ -31,17 +32,31 @@ namespace {
 // Numbers of pending entries that trigger writting them to the ZIP file.
 constexpr size_t g_MaxPendingEntriesCount = 50;
 const std::string SEPARATOR = "/";
+// Files larger than this are streamed through minizip instead of being deflated in memory.
+constexpr off_t MAX_PARALLEL_DEFLATE_FILE_SIZE = 4 * 1024 * 1024;
+// Upper bound of the source bytes held in memory for one batch of parallel deflated entries.
+constexpr off_t MAX_PARALLEL_DEFLATE_BATCH_SIZE = 32 * 1024 * 1024;
+
+// An entry which has been deflated in memory by a worker thread and is waiting to be
+// stitched into the zip stream in its original order.
+struct DeflatedEntry {
+    bool prepared = false;
+    bool success = false;
+    uLong crc = 0;
+    uLong uncompressedSize = 0;
+    std::string data;
+};
 
 #define CALLING_CALL_BACK(callback, result) \
     if (callback != nullptr) {              \
         callback(result);                   \
     }
 
-bool AddFileContentToZip(zipFile zip_file, FilePath &file_path)
+bool AddFileContentToZip(zipFile zip_file, FilePath &file_path, const std::shared_ptr<ZipTaskToken> &token)
 {
     APP_LOGI("%{public}s called", __func__);
     uint32_t num_bytes;
-    char buf[kZipBufSize];
+    auto buf = std::make_unique<char[]>(kZipBufSize);
     if (!FilePathCheckValid(file_path.Value())) {
         APP_LOGI(
             "%{public}s called, filePath is invalid!!! file_path=%{public}s", __func__, file_path.Value().c_str());
@@ -61,15 +76,21 @@ bool AddFileContentToZip(zipFile zip_file, FilePath &file_path)
     }
 
     while (!feof(fp)) {
-        num_bytes = fread(buf, 1, kZipBufSize, fp);
+        num_bytes = fread(buf.get(), 1, kZipBufSize, fp);
         if (num_bytes > 0) {
-            if (zipWriteInFileInZip(zip_file, buf, num_bytes) != ZIP_OK) {
+            if (zipWriteInFileInZip(zip_file, buf.get(), num_bytes) != ZIP_OK) {
                 APP_LOGI("%{public}s called, Could not write data to zip for path:%{private}s ",
                     __func__, file_path.Value().c_str());
                 fclose(fp);
                 fp = nullptr;
                 return false;
             }
+            if (token != nullptr && !token->AddProcessedBytes(num_bytes)) {
+                APP_LOGI("%{public}s called, zip task canceled", __func__);
+                fclose(fp);
+                fp = nullptr;
+                return false;
+            }
         } else {
             break;
         }
@@ -109,7 +130,7 @@ bool AddFileEntryToZip(zipFile zip_file, FilePath &relativePath, FilePath &absol
     if (!OpenNewFileEntry(zip_file, relativePath, false, lastModified, options)) {
         return false;
     }
-    bool success = AddFileContentToZip(zip_file, absolutePath);
+    bool success = AddFileContentToZip(zip_file, absolutePath, options.token);
     if (!CloseNewFileEntry(zip_file)) {
         APP_LOGI("!!! CloseNewFileEntry returnValule is false !!!");
         return false;
@@ -117,6 +138,107 @@ bool AddFileEntryToZip(zipFile zip_file, FilePath &relativePath, FilePath &absol
     return success;
 }
 
+bool ReadFileContent(FilePath &filePath, off_t size, std::string &content)
+{
+    if (!FilePathCheckValid(filePath.Value()) || !FilePath::PathIsValid(filePath)) {
+        APP_LOGI("%{public}s called, filePath is invalid", __func__);
+        return false;
+    }
+    FILE *fp = fopen(filePath.Value().c_str(), "rb");
+    if (fp == nullptr) {
+        APP_LOGI("%{public}s called, open file failed", __func__);
+        return false;
+    }
+    content.resize(size);
+    size_t readBytes = size > 0 ? fread(&content[0], 1, size, fp) : 0;
+    fclose(fp);
+    fp = nullptr;
+    content.resize(readBytes);
+    return true;
+}
+
+// Deflates the whole file into |entry|, producing the raw deflate stream minizip expects for
+// an entry opened in raw mode.
+void DeflateFileContent(FilePath &filePath, off_t size, const OPTIONS &options, DeflatedEntry &entry)
+{
+    std::string content;
+    if ((options.token != nullptr && options.token->IsCanceled()) || !ReadFileContent(filePath, size, content)) {
+        return;
+    }
+    entry.uncompressedSize = content.size();
+    entry.crc = crc32(0L, reinterpret_cast<const Bytef *>(content.data()), content.size());
+
+    z_stream stream = {};
+    if (deflateInit2(&stream, static_cast<int>(options.level), Z_DEFLATED, -MAX_WBITS,
+        static_cast<int>(options.memLevel), static_cast<int>(options.strategy)) != Z_OK) {
+        APP_LOGI("%{public}s called, deflateInit2 failed", __func__);
+        return;
+    }
+    entry.data.resize(deflateBound(&stream, content.size()));
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(content.data()));
+    stream.avail_in = content.size();
+    stream.next_out = reinterpret_cast<Bytef *>(&entry.data[0]);
+    stream.avail_out = entry.data.size();
+    int ret = deflate(&stream, Z_FINISH);
+    entry.data.resize(stream.total_out);
+    deflateEnd(&stream);
+    entry.success = (ret == Z_STREAM_END);
+}
+
+// Deflates the small regular files of one batch on |options.parallel| threads. Entries which are
+// not prepared here are written through the streaming path.
+std::vector<DeflatedEntry> DeflateEntriesInParallel(std::vector<FilePath> &absolutePaths, const OPTIONS &options)
+{
+    std::vector<DeflatedEntry> entries(absolutePaths.size());
+    if (options.parallel <= 1) {
+        return entries;
+    }
+    std::vector<off_t> sizes(absolutePaths.size(), 0);
+    std::vector<size_t> indexes;
+    off_t batchSize = 0;
+    for (size_t i = 0; i < absolutePaths.size(); i++) {
+        struct stat st = {};
+        if (stat(absolutePaths[i].Value().c_str(), &st) != 0 || !S_ISREG(st.st_mode) ||
+            st.st_size > MAX_PARALLEL_DEFLATE_FILE_SIZE || batchSize + st.st_size > MAX_PARALLEL_DEFLATE_BATCH_SIZE) {
+            continue;
+        }
+        batchSize += st.st_size;
+        sizes[i] = st.st_size;
+        entries[i].prepared = true;
+        indexes.push_back(i);
+    }
+    RunParallelTasks(indexes.size(), options.parallel, [&](size_t index) {
+        size_t entryIndex = indexes[index];
+        DeflateFileContent(absolutePaths[entryIndex], sizes[entryIndex], options, entries[entryIndex]);
+    });
+    return entries;
+}
+
+bool AddDeflatedEntryToZip(zipFile zip_file, FilePath &relativePath, const DeflatedEntry &entry, const OPTIONS &options)
+{
+    if (!entry.success) {
+        return false;
+    }
+    struct tm *lastModified = GetCurrentSystemTime();
+    if (lastModified == nullptr) {
+        return false;
+    }
+    if (!ZipOpenNewFileInZip(zip_file, relativePath.Value(), options, lastModified, true)) {
+        return false;
+    }
+    bool success = entry.data.empty() ||
+        zipWriteInFileInZip(zip_file, entry.data.data(), entry.data.size()) == ZIP_OK;
+    if (zipCloseFileInZipRaw(zip_file, entry.uncompressedSize, entry.crc) != ZIP_OK) {
+        APP_LOGI("!!! zipCloseFileInZipRaw returnValule is false !!!");
+        return false;
+    }
+    if (success && options.token != nullptr && !options.token->AddProcessedBytes(entry.uncompressedSize)) {
+        APP_LOGI("%{public}s called, zip task canceled", __func__);
+        return false;
+    }
+    return success;
+}
+
 bool AddDirectoryEntryToZip(zipFile zip_file, FilePath &path, struct tm *lastModified, const OPTIONS &options)
 {
     APP_LOGI("%{public}s called", __func__);
@@ -164,6 +286,11 @@ ZipWriter::ZipWriter(zipFile zip_file, const FilePath &rootDir) : zipFile_(zip_f
 ZipWriter::~ZipWriter()
 {
     pendingEntries_.clear();
+    // A failed or canceled job never reaches Close(), release the handle here.
+    if (zipFile_ != nullptr) {
+        zipClose(zipFile_, nullptr);
+        zipFile_ = nullptr;
+    }
 }
 
 bool ZipWriter::WriteEntries(const std::vector<FilePath> &paths, const OPTIONS &options, CALLBACK callback)
@@ -183,8 +310,15 @@ bool ZipWriter::AddEntries(const std::vector<FilePath> &paths, const OPTIONS &op
 
 bool ZipWriter::Close(const OPTIONS &options, CALLBACK callback)
 {
-    bool success = FlushEntriesIfNeeded(true, options, callback) && zipClose(zipFile_, nullptr) == ZIP_OK;
+    if (!FlushEntriesIfNeeded(true, options, callback)) {
+        return false;
+    }
+    bool success = zipClose(zipFile_, nullptr) == ZIP_OK;
     zipFile_ = nullptr;
+    if (options.token != nullptr) {
+        options.token->Finish();
+    }
+    CALLING_CALL_BACK(callback, success ? ERROR_CODE_OK : ERROR_CODE_ERRNO)
     return success;
 }
 
@@ -213,14 +347,26 @@ bool ZipWriter::FlushEntriesIfNeeded(bool force, const OPTIONS &options, CALLBAC
             }
         }
         pendingEntries_.erase(pendingEntries_.begin(), pendingEntries_.begin() + entry_count);
+        std::vector<DeflatedEntry> deflatedEntries = DeflateEntriesInParallel(absolutePaths, options);
         for (size_t i = 0; i < absolutePaths.size(); i++) {
             FilePath &relativePath = relativePaths[i];
             FilePath &absolutePath = absolutePaths[i];
             bool isValid = FilePath::PathIsValid(absolutePath);
             bool isDir = FilePath::IsDir(absolutePath);
-            if (isValid && !isDir) {
+            if (options.token != nullptr && options.token->IsCanceled()) {
+                CALLING_CALL_BACK(callback, ERROR_CODE_CANCELED)
+                APP_LOGI("%{public}s called, zip task canceled", __func__);
+                return false;
+            }
+            if (deflatedEntries[i].prepared) {
+                if (!AddDeflatedEntryToZip(zipFile_, relativePath, deflatedEntries[i], options)) {
+                    CALLING_CALL_BACK(callback, GetFailedErrorCode(options.token))
+                    APP_LOGI("%{public}s called, Failed to write deflated file", __func__);
+                    return false;
+                }
+            } else if (isValid && !isDir) {
                 if (!AddFileEntryToZip(zipFile_, relativePath, absolutePath, options)) {
-                    CALLING_CALL_BACK(callback, ERROR_CODE_ERRNO)
+                    CALLING_CALL_BACK(callback, GetFailedErrorCode(options.token))
                     APP_LOGI("%{public}s called, Failed to write file", __func__);
                     return false;
                 }
@@ -235,7 +381,6 @@ bool ZipWriter::FlushEntriesIfNeeded(bool force, const OPTIONS &options, CALLBAC
             }
         }
     }
-    CALLING_CALL_BACK(callback, ERROR_CODE_OK)
     return true;
 }
 
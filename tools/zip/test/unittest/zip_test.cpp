@@ -13,8 +13,13 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iterator>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "zip.h"
 
@@ -61,6 +66,18 @@ void UnzipCallBack(int result)
     printf("--UnZip--callback--result=%d--\n", result);
 }
 
+void WriteTestFile(const std::string &path, const std::string &content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+std::string ReadTestFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
 /**
  * @tc.number: APPEXECFWK_LIBZIP_zip_0100_8file
  * @tc.name: zip_0100_8file
@@ -299,6 +316,182 @@ HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_Checkzip_0800, Function | MediumTest | Level
     Unzip(srcFile, destFile, options, UnzipCallBack);
     std::this_thread::sleep_for(std::chrono::milliseconds(5000));
 }
+
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_zip_0300_parallel
+ * @tc.name: zip_0300_parallel
+ * @tc.desc: zip and unzip the entries of one file on several threads, with two jobs running at once.
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_zip_0300_parallel, Function | MediumTest | Level1)
+{
+    std::string srcDir = BASE_PATH + APP_PATH + "test/parallel";
+    std::string resultDir = BASE_PATH + APP_PATH + "result";
+    FilePath::CreateDirectory(FilePath(srcDir));
+    FilePath::CreateDirectory(FilePath(resultDir));
+    // small files are deflated in batches on the workers, the large one is streamed
+    const int fileCount = 12;
+    std::vector<std::string> contents;
+    for (int i = 0; i < fileCount; i++) {
+        contents.push_back("parallel entry " + std::to_string(i) + std::string(i * 100, 'a' + i));
+    }
+    contents.push_back(std::string(4 * 1024 * 1024, 'z'));
+    for (size_t i = 0; i < contents.size(); i++) {
+        WriteTestFile(srcDir + "/" + std::to_string(i) + ".txt", contents[i]);
+    }
+
+    OPTIONS options;
+    options.parallel = 4;
+    options.concurrency = 2;
+    std::vector<std::string> archives = { resultDir + "/parallel_0.zip", resultDir + "/parallel_1.zip" };
+    std::vector<std::future<int>> zipResults;
+    for (const auto &archive : archives) {
+        std::remove(archive.c_str());
+        auto zipped = std::make_shared<std::promise<int>>();
+        zipResults.push_back(zipped->get_future());
+        EXPECT_TRUE(Zip(FilePath(srcDir), FilePath(archive), options,
+            [zipped](int result) { zipped->set_value(result); }, false));
+    }
+    for (auto &zipResult : zipResults) {
+        ASSERT_EQ(zipResult.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        ASSERT_EQ(zipResult.get(), ERROR_CODE_OK);
+    }
+
+    for (size_t i = 0; i < archives.size(); i++) {
+        std::string unzipDest = BASE_PATH + APP_PATH + "unzip/parallel_" + std::to_string(i);
+        FilePath::CreateDirectory(FilePath(unzipDest));
+        for (size_t j = 0; j < contents.size(); j++) {
+            std::remove((unzipDest + "/" + std::to_string(j) + ".txt").c_str());
+        }
+        auto unzipped = std::make_shared<std::promise<int>>();
+        EXPECT_TRUE(Unzip(FilePath(archives[i]), FilePath(unzipDest), options,
+            [unzipped](int result) { unzipped->set_value(result); }));
+        auto unzipResult = unzipped->get_future();
+        ASSERT_EQ(unzipResult.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        ASSERT_EQ(unzipResult.get(), ERROR_CODE_OK);
+        // every entry is in the archive, once and with its original content
+        for (size_t j = 0; j < contents.size(); j++) {
+            EXPECT_EQ(ReadTestFile(unzipDest + "/" + std::to_string(j) + ".txt"), contents[j]) << j;
+        }
+    }
+}
+
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_buffer_0100
+ * @tc.name: buffer_0100
+ * @tc.desc: compress and decompress data in memory, whole and in chunks.
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_buffer_0100, Function | MediumTest | Level1)
+{
+    std::string src;
+    for (int i = 0; i < 10000; i++) {
+        src += std::to_string(i);
+    }
+    const uint8_t *srcData = reinterpret_cast<const uint8_t *>(src.data());
+
+    OPTIONS options;
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> decompressed;
+    EXPECT_EQ(CompressBuffer(srcData, src.size(), options, compressed), ERROR_CODE_OK);
+    EXPECT_EQ(DecompressBuffer(compressed.data(), compressed.size(), decompressed), ERROR_CODE_OK);
+    EXPECT_EQ(std::string(decompressed.begin(), decompressed.end()), src);
+    EXPECT_NE(DecompressBuffer(compressed.data(), compressed.size() / 2, decompressed), ERROR_CODE_OK);
+    EXPECT_EQ(DecompressBuffer(compressed.data(), compressed.size(), decompressed, src.size()), ERROR_CODE_OK);
+    EXPECT_EQ(DecompressBuffer(compressed.data(), compressed.size(), decompressed, src.size() - 1),
+        ERROR_CODE_MEM_ERROR);
+
+    std::vector<uint8_t> output;
+    auto sink = [&output](const uint8_t *data, size_t size) {
+        output.insert(output.end(), data, data + size);
+        return true;
+    };
+    ZlibStream inflater(ZlibStream::Mode::INFLATE, options);
+    EXPECT_EQ(inflater.Init(), ERROR_CODE_OK);
+    size_t half = compressed.size() / 2;
+    EXPECT_EQ(inflater.Write(compressed.data(), half, false, sink), ERROR_CODE_OK);
+    EXPECT_EQ(inflater.Write(compressed.data() + half, compressed.size() - half, true, sink), ERROR_CODE_STREAM_END);
+    EXPECT_EQ(std::string(output.begin(), output.end()), src);
+}
+
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_unzip_entries_0100
+ * @tc.name: unzip_entries_0100
+ * @tc.desc: extract selected entries located through the central directory index.
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_unzip_entries_0100, Function | MediumTest | Level1)
+{
+    std::string srcDir = BASE_PATH + APP_PATH + "test/entries";
+    std::string src = BASE_PATH + APP_PATH + "result/entries.zip";
+    std::string dest = BASE_PATH + APP_PATH + "unzip/entries";
+    FilePath::CreateDirectory(FilePath(srcDir));
+    FilePath::CreateDirectory(FilePath(BASE_PATH + APP_PATH + "result"));
+    FilePath::CreateDirectory(FilePath(dest));
+    WriteTestFile(srcDir + "/a.txt", "entry a");
+    WriteTestFile(srcDir + "/b.txt", "entry b");
+    std::remove((dest + "/a.txt").c_str());
+    std::remove((dest + "/b.txt").c_str());
+
+    OPTIONS options;
+    auto zipped = std::make_shared<std::promise<int>>();
+    EXPECT_TRUE(Zip(FilePath(srcDir), FilePath(src), options, [zipped](int result) { zipped->set_value(result); },
+        false));
+    auto zipResult = zipped->get_future();
+    ASSERT_EQ(zipResult.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(zipResult.get(), ERROR_CODE_OK);
+
+    EXPECT_FALSE(ExtractEntries(FilePath(src), FilePath(dest), {"not_exist.txt"}, options));
+    EXPECT_TRUE(ExtractEntries(FilePath(src), FilePath(dest), {"a.txt"}, options));
+    EXPECT_EQ(ReadTestFile(dest + "/a.txt"), "entry a");
+    EXPECT_FALSE(FilePath::PathIsValid(FilePath(dest + "/b.txt")));
+
+    options.parallel = 2;
+    EXPECT_TRUE(ExtractEntries(FilePath(src), FilePath(dest), {"a.txt", "b.txt"}, options));
+    EXPECT_EQ(ReadTestFile(dest + "/a.txt"), "entry a");
+    EXPECT_EQ(ReadTestFile(dest + "/b.txt"), "entry b");
+
+    std::remove((dest + "/b.txt").c_str());
+    auto unzipped = std::make_shared<std::promise<int>>();
+    EXPECT_TRUE(UnzipEntries(FilePath(src), FilePath(dest), {"b.txt"}, options,
+        [unzipped](int result) { unzipped->set_value(result); }));
+    auto unzipResult = unzipped->get_future();
+    ASSERT_EQ(unzipResult.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(unzipResult.get(), ERROR_CODE_OK);
+    EXPECT_EQ(ReadTestFile(dest + "/b.txt"), "entry b");
+}
+
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_task_token_0100
+ * @tc.name: task_token_0100
+ * @tc.desc: report the progress of an unzip job and stop a canceled one.
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_task_token_0100, Function | MediumTest | Level1)
+{
+    auto token = std::make_shared<ZipTaskToken>();
+    uint64_t reportedBytes = 0;
+    bool finished = false;
+    token->SetProgressCallback([&reportedBytes, &finished](uint64_t processedBytes, uint64_t, bool isFinished) {
+        reportedBytes = processedBytes;
+        finished = isFinished;
+    }, 1);
+    token->Start();
+    token->SetTotalBytes(10);
+    EXPECT_TRUE(token->AddProcessedBytes(4));
+    EXPECT_EQ(reportedBytes, 4u);
+    token->Cancel();
+    EXPECT_FALSE(token->AddProcessedBytes(6));
+    EXPECT_EQ(GetFailedErrorCode(token), ERROR_CODE_CANCELED);
+    token->Finish();
+    EXPECT_TRUE(finished);
+    EXPECT_EQ(token->GetProcessedBytes(), 10u);
+    EXPECT_EQ(token->GetTotalBytes(), 10u);
+
+    std::string src = BASE_PATH + APP_PATH + "result/zip1file.zip";
+    std::string dest = BASE_PATH + APP_PATH + "unzip/token";
+    FilePath::CreateDirectory(FilePath(dest));
+    OPTIONS options;
+    options.token = std::make_shared<ZipTaskToken>();
+    ExtractEntries(FilePath(src), FilePath(dest), {"zip1.txt"}, options);
+    EXPECT_EQ(options.token->GetProcessedBytes(), options.token->GetTotalBytes());
+}
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
\ No newline at end of file